@@ -33,6 +33,9 @@
 #include "cCountTracker.h"
 #include "cDoubleSum.h"
 
+class cCheckpointReader;
+class cCheckpointWriter;
+
 
 namespace Avida {
   namespace Systematics {
@@ -42,6 +45,7 @@ namespace Avida {
     
     class Genotype;
     class GenotypeArbiter;
+    class HistoricGenotypeStore;
     
     
     // Type Declarations
@@ -57,12 +61,32 @@ namespace Avida {
     class Genotype : public Group
     {
       friend class GenotypeArbiter;
+      friend class HistoricGenotypeStore;
     private:
+      struct Stats
+      {
+        cCountTracker births;
+        cCountTracker deaths;
+        cCountTracker breed_in;
+        cCountTracker breed_true;
+        cCountTracker breed_out;
+        
+        cCountTracker gestation_count;
+        
+        cDoubleSum copied_size;
+        cDoubleSum exe_size;
+        cDoubleSum gestation_time;
+        cDoubleSum repro_rate;
+        cDoubleSum merit;
+        cDoubleSum fitness;
+      };
+      
       mutable GenotypeArbiterPtr m_mgr;
       Apto::List<GenotypePtr, Apto::SparseVector>::EntryHandle* m_handle;
       
       Source m_src;
       Genome m_genome;
+      unsigned long long m_genome_hash;
       Apto::String m_name;
       
       bool m_threshold;
@@ -76,24 +100,13 @@ namespace Avida {
       int m_num_organisms;
       int m_last_num_organisms;
       int m_total_organisms;
+      int m_checkpoint_units;   // units of a loaded checkpoint still to be classified back in, already counted
       
       Apto::Array<GenotypePtr> m_parents;
       Apto::String m_parent_str;
       
-      cCountTracker m_births;
-      cCountTracker m_deaths;
-      cCountTracker m_breed_in;
-      cCountTracker m_breed_true;
-      cCountTracker m_breed_out;
-
-      cCountTracker m_gestation_count;
-            
-      cDoubleSum m_copied_size;
-      cDoubleSum m_exe_size;
-      cDoubleSum m_gestation_time;
-      cDoubleSum m_repro_rate;
-      cDoubleSum m_merit;
-      cDoubleSum m_fitness;
+      Stats* m_stats;   // NULL while compacted into the historic store, along with the genome, name and source arguments
+      int m_record;     // historic store record of the genotype, or -1
             
       int m_last_birth_cell;
       int m_last_group_id;
@@ -143,11 +156,19 @@ namespace Avida {
       // Methods called by GenotypeArbiter
       Genotype(GenotypeArbiterPtr mgr, GroupID in_id, UnitPtr founder, Update update, ConstGroupMembershipPtr parents);
       Genotype(GenotypeArbiterPtr mgr, GroupID in_id, void* props);
+      
+      // Checkpointed genotypes are loaded with the unit counts they were saved with, so the units classified back into
+      // them only take their references.  Parents are referenced by ID, so they must have been loaded first; check the
+      // reader for errors after construction.
+      Genotype(GenotypeArbiterPtr mgr, GroupID in_id, cCheckpointReader& cp);
+      void SaveCheckpoint(cCheckpointWriter& cp) const;
+      inline bool HasCheckpointUnits() const { return m_checkpoint_units > 0; }
+      inline void NotifyCheckpointUnit() { m_checkpoint_units--; AddActiveReference(); }
 
       void NotifyNewUnit(UnitPtr u);
       void UpdateReset();
 
-      inline const Genome& GroupGenome() const { return m_genome; }
+      inline const Genome& GroupGenome() const { if (!m_stats) restore(); return m_genome; }
       inline const Apto::Array<GenotypePtr> Parents() const { return m_parents; }
       
       inline void SetName(const Apto::String& name) { m_name = name; }
@@ -161,9 +182,14 @@ namespace Avida {
       inline void ClearThreshold() { m_threshold = false; }
       
       inline void Deactivate(int update) { m_active = false; m_update_deactivated = update; }
-      inline void Reactivate() { m_active = true; m_update_deactivated = -1; }
+      inline void Reactivate() { if (!m_stats) restore(); m_active = true; m_update_deactivated = -1; m_record = -1; }
+      
+      inline bool IsCompact() const { return !m_stats; }
+      void Compact(HistoricGenotypeStore& store);
             
     private:
+      bool legacySave(void* dfp, const Stats& stats, const Genome& genome, const Apto::String& src_args) const;
+      void restore() const;
       void setupPropertyMap() const;
       inline GenotypePtr thisPtr();
     };
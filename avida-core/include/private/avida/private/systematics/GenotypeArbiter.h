@@ -30,11 +30,15 @@
 #include "avida/systematics/Arbiter.h"
 
 #include "avida/private/systematics/Genotype.h"
+#include "avida/private/systematics/GenotypeTable.h"
 
 
 namespace Avida {
   namespace Systematics {
     
+    class HistoricGenotypeStore;
+    
+    
     // Genotype
     // --------------------------------------------------------------------------------------------------------------
     
@@ -47,15 +51,17 @@ namespace Avida {
         EVENT_REMOVE_THRESHOLD
       };
       
-      static const int HASH_SIZE = 3203;
-      
     private:
       // Config Settings
       int m_threshold;
       bool m_disable_class;
       
+      // Historic genotypes are compacted into the store at the end of each update, when it is enabled
+      HistoricGenotypeStore* m_store;
+      
       // Internal Data Structures
-      Apto::List<GenotypePtr, Apto::SparseVector> m_active_hash[HASH_SIZE];
+      GenotypeTable<GenotypePtr> m_active_hash;  // active genotypes, keyed by genome hash
+      GenotypeTable<GenotypePtr> m_id_index;     // active and historic genotypes, keyed by ID
       Apto::Array<Apto::List<GenotypePtr, Apto::SparseVector>, Apto::ManagedPointer> m_active_sz;
       Apto::List<GenotypePtr, Apto::SparseVector> m_historic;
       GenotypePtr m_coalescent;
@@ -118,7 +124,10 @@ namespace Avida {
       
       
     public:
-      GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class = false);
+      enum { HISTORIC_STORE_OFF = 0, HISTORIC_STORE_MEMORY, HISTORIC_STORE_SPILL };
+      
+      GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class = false,
+                      int historic_store = HISTORIC_STORE_OFF);
       ~GenotypeArbiter();
       
       // Arbiter Interface Methods
@@ -131,6 +140,12 @@ namespace Avida {
       bool LegacySave(void* df) const;
       GroupPtr LegacyLoad(void* props);
       
+      // World checkpoints (see cPopulation::SaveCheckpoint) keep every genotype under its ID.  Loading replaces all
+      // genotypes, so it may only be done while there are no units; the units of the checkpoint are then classified
+      // back into their genotypes with the "id" hint.
+      void SaveCheckpoint(cCheckpointWriter& cp) const;
+      bool LoadCheckpoint(cCheckpointReader& cp);
+      
       IteratorPtr Begin();
       
       
@@ -157,10 +172,12 @@ namespace Avida {
       template <class T> Data::PackagePtr packageData(const T&) const;
       Data::ProviderPtr activateProvider(World*);
       
-      unsigned int hashGenome(const InstructionSequence& genome) const;
+      static unsigned long long hashGenome(const InstructionSequence& genome);
       Apto::String nameGenotype(int size);
       
+      void activateGenotype(GenotypePtr genotype);
       void removeGenotype(GenotypePtr genotype);
+      void clearGenotypes();
       void updateCoalescent();
       
       inline void resizeActiveList(int size);
@@ -0,0 +1,174 @@
+/*
+ *  private/systematics/GenotypeTable.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaSystematicsGenotypeTable_h
+#define AvidaSystematicsGenotypeTable_h
+
+#include "apto/core.h"
+
+#include <cassert>
+
+
+namespace Avida {
+  namespace Systematics {
+
+    // GenotypeTable
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Open addressing table of genotypes keyed by a 64-bit value (genome hash or genotype ID), using linear probing.
+    // Keys need not be unique; all entries for a key are visited with FirstSlot/NextSlot.  PtrType is the genotype
+    // pointer type; a null pointer marks an empty slot, so null pointers may not be inserted.
+
+    template <class PtrType> class GenotypeTable
+    {
+    private:
+      struct Slot
+      {
+        unsigned long long key;
+        PtrType genotype;
+      };
+
+      Apto::Array<Slot> m_slots;  // size is always a power of two
+      int m_count;
+
+    public:
+      GenotypeTable();
+
+      inline int GetSize() const { return m_count; }
+      inline int GetCapacity() const { return m_slots.GetSize(); }
+      inline PtrType GetSlot(int slot) const { return m_slots[slot].genotype; }
+
+      void Insert(unsigned long long key, PtrType genotype);
+      bool Remove(unsigned long long key, PtrType genotype);
+
+      int FirstSlot(unsigned long long key) const;
+      int NextSlot(unsigned long long key, int slot) const;
+
+    private:
+      inline int homeSlot(unsigned long long key) const;
+      void resize(int capacity);
+    };
+
+
+    template <class PtrType> GenotypeTable<PtrType>::GenotypeTable()
+      : m_slots(64)
+      , m_count(0)
+    {
+      for (int i = 0; i < m_slots.GetSize(); i++) {
+        m_slots[i].key = 0;
+        m_slots[i].genotype = PtrType(NULL);
+      }
+    }
+
+
+    template <class PtrType> void GenotypeTable<PtrType>::Insert(unsigned long long key, PtrType genotype)
+    {
+      assert(genotype);
+
+      // Keep the load factor at or below one half so that probe sequences stay short
+      if ((m_count + 1) * 2 > m_slots.GetSize()) resize(m_slots.GetSize() * 2);
+
+      const int mask = m_slots.GetSize() - 1;
+      int slot = homeSlot(key);
+      while (m_slots[slot].genotype) slot = (slot + 1) & mask;
+
+      m_slots[slot].key = key;
+      m_slots[slot].genotype = genotype;
+      m_count++;
+    }
+
+
+    template <class PtrType> bool GenotypeTable<PtrType>::Remove(unsigned long long key, PtrType genotype)
+    {
+      int slot = FirstSlot(key);
+      for (; slot >= 0; slot = NextSlot(key, slot)) if (m_slots[slot].genotype == genotype) break;
+      if (slot < 0) return false;
+
+      // Backward shift deletion: move later entries of the probe run into the hole when their home slot allows it
+      const int mask = m_slots.GetSize() - 1;
+      int hole = slot;
+      for (int next = (hole + 1) & mask; m_slots[next].genotype; next = (next + 1) & mask) {
+        const int home = homeSlot(m_slots[next].key);
+        const bool movable = (hole <= next) ? (home <= hole || home > next) : (home <= hole && home > next);
+        if (movable) {
+          m_slots[hole] = m_slots[next];
+          hole = next;
+        }
+      }
+
+      m_slots[hole].key = 0;
+      m_slots[hole].genotype = PtrType(NULL);
+      m_count--;
+      return true;
+    }
+
+
+    template <class PtrType> int GenotypeTable<PtrType>::FirstSlot(unsigned long long key) const
+    {
+      const int mask = m_slots.GetSize() - 1;
+      for (int slot = homeSlot(key); m_slots[slot].genotype; slot = (slot + 1) & mask) {
+        if (m_slots[slot].key == key) return slot;
+      }
+      return -1;
+    }
+
+
+    template <class PtrType> int GenotypeTable<PtrType>::NextSlot(unsigned long long key, int slot) const
+    {
+      const int mask = m_slots.GetSize() - 1;
+      for (slot = (slot + 1) & mask; m_slots[slot].genotype; slot = (slot + 1) & mask) {
+        if (m_slots[slot].key == key) return slot;
+      }
+      return -1;
+    }
+
+
+    template <class PtrType> inline int GenotypeTable<PtrType>::homeSlot(unsigned long long key) const
+    {
+      // Finalizer from MurmurHash3, spreads sequential IDs as well as genome hashes across the table
+      key ^= key >> 33;
+      key *= 0xff51afd7ed558ccdULL;
+      key ^= key >> 33;
+      key *= 0xc4ceb9fe1a85ec53ULL;
+      key ^= key >> 33;
+      return (int)(key & (unsigned long long)(m_slots.GetSize() - 1));
+    }
+
+
+    template <class PtrType> void GenotypeTable<PtrType>::resize(int capacity)
+    {
+      Apto::Array<Slot> old_slots(m_slots);
+
+      m_slots.Resize(capacity);
+      for (int i = 0; i < m_slots.GetSize(); i++) {
+        m_slots[i].key = 0;
+        m_slots[i].genotype = PtrType(NULL);
+      }
+      m_count = 0;
+
+      for (int i = 0; i < old_slots.GetSize(); i++) {
+        if (old_slots[i].genotype) Insert(old_slots[i].key, old_slots[i].genotype);
+      }
+    }
+
+  };
+};
+
+#endif
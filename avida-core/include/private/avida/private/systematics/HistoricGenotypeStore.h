@@ -0,0 +1,123 @@
+/*
+ *  private/systematics/HistoricGenotypeStore.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaSystematicsHistoricGenotypeStore_h
+#define AvidaSystematicsHistoricGenotypeStore_h
+
+#include "avida/core/Genome.h"
+#include "avida/core/InstructionSequence.h"
+#include "avida/core/WorldDriver.h"
+
+#include "avida/private/systematics/Genotype.h"
+
+#include <cstdio>
+
+
+namespace Avida {
+  namespace Systematics {
+
+    // HistoricGenotypeStore - Compact records of historic genotypes
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Each record holds the statistics block, name, source arguments, instruction set and sequence of a genotype,
+    // packed as a fixed size header followed by its strings and sequence ops.  A sequence may be stored as a delta of an
+    // earlier record's (normally the parent genotype's): the sites it shares with the start and end of the base sequence
+    // are counted and only the ops between them are kept.  Delta chains are cut at MAX_DELTA_CHAIN, after which the
+    // sequence is stored whole, bounding the cost of decoding.
+    //
+    // Records are append only and never change, so other records may safely be based on them.  In memory they are
+    // packed into fixed size chunks, so the store may grow past what a single array can index.  With a spill path the
+    // records are written to that file and only their offsets are kept in memory.  The file is scratch space for the
+    // running process, written in its native layout, and is removed when the store is destroyed.  Failures to write or
+    // read it are reported to the driver set with SetDriver(), which is asked to abort the run.
+
+    class HistoricGenotypeStore
+    {
+    public:
+      static const int MAX_DELTA_CHAIN = 32;
+      static const size_t CHUNK_SIZE = 1 << 20;
+
+    private:
+      struct Record
+      {
+        int hw_type;
+        int length;
+        int base;       // record whose sequence this one is a delta of, or -1 if stored whole
+        int chain;      // number of deltas to decode to reach a whole sequence
+        int prefix;     // sites shared with the start of the base sequence
+        int suffix;     // sites shared with the end of the base sequence
+        int name_size;
+        int src_args_size;
+        int inst_set_size;
+        Genotype::Stats stats;
+      };
+
+      Apto::Array<size_t> m_offsets;
+      int m_num_records;
+
+      Apto::Array<char*> m_chunks;  // records, when not spilled
+      size_t m_size;
+
+      Apto::String m_spill_path;
+      mutable FILE* m_fp;
+      mutable Apto::Array<char> m_buffer;
+      WorldDriver* m_driver;
+
+
+      HistoricGenotypeStore(); // @not_implemented
+      HistoricGenotypeStore(const HistoricGenotypeStore&); // @not_implemented
+      HistoricGenotypeStore& operator=(const HistoricGenotypeStore&); // @not_implemented
+
+    public:
+      // Records are kept in memory if spill_path is empty or the file cannot be created
+      HistoricGenotypeStore(const Apto::String& spill_path);
+      ~HistoricGenotypeStore();
+
+      // A spill file name in the directory that is not shared with other runs, or other stores of this run
+      static Apto::String UniqueSpillPath(const Apto::String& dir);
+
+      // Driver to report to, which must be set before the first record is added
+      void SetDriver(WorldDriver* driver);
+
+      inline int GetNumRecords() const { return m_num_records; }
+      inline size_t GetSize() const { return m_size; }
+      inline bool IsSpilled() const { return m_fp != NULL; }
+
+      // Add a record, delta coding the sequence against that of record base (-1 for none).  Returns the new record.
+      int Add(const Genotype::Stats& stats, const Genome& genome, const Apto::String& name, const Apto::String& src_args,
+              int base = -1);
+
+      void Get(int record, Genotype::Stats& stats, Genome& genome, Apto::String& name, Apto::String& src_args) const;
+      void GetSequence(int record, InstructionSequence& seq) const;
+
+      // Number of deltas to decode for the sequence of the record, which may only serve as a base below MAX_DELTA_CHAIN
+      int GetChainLength(int record) const;
+
+    private:
+      const char* read(int record) const;
+      void write(const char* bytes, int size);
+      bool seek(size_t offset) const;
+      void ioError(const char* operation) const;
+    };
+
+  };
+};
+
+#endif
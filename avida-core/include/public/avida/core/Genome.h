@@ -119,8 +119,10 @@ namespace Avida {
       LIB_LOCAL bool operator==(const PropertyMap& p) const;
       
       LIB_LOCAL bool Has(const PropertyID& p_id) const;
+      LIB_LOCAL bool Has(PropertyAtom atom) const;
       
       LIB_LOCAL const Property& Get(const PropertyID& p_id) const;
+      LIB_LOCAL const Property& Get(PropertyAtom atom) const;
       
       LIB_LOCAL bool SetValue(const PropertyID& p_id, const Apto::String& prop_value);
       LIB_LOCAL bool SetValue(const PropertyID& p_id, const int prop_value);
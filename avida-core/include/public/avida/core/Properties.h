@@ -300,6 +300,27 @@ namespace Avida {
 
 
   
+  // PropertyAtoms
+  // --------------------------------------------------------------------------------------------------------------
+  //
+  // Property IDs are interned to small integer atoms, numbered from zero in the order they are first seen.  Maps index
+  // their properties by atom, so code that reads a property in a loop should intern its ID once (typically into a static)
+  // and pass the atom to PropertyMap::Get.  Interning takes a lock, atom lookups do not.
+  
+  class PropertyAtoms
+  {
+  public:
+    static const PropertyAtom Invalid = -1;
+    
+    LIB_EXPORT static PropertyAtom Intern(const PropertyID& p_id);
+    LIB_EXPORT static PropertyAtom Find(const PropertyID& p_id);  // Invalid if the ID has never been interned
+    LIB_EXPORT static PropertyID Name(PropertyAtom atom);
+    
+  private:
+    PropertyAtoms(); // @not_implemented
+  };
+  
+  
   // PropertyMap
   // --------------------------------------------------------------------------------------------------------------  
   
@@ -323,6 +344,11 @@ namespace Avida {
     LIB_EXPORT virtual const Property& Get(const PropertyID& p_id) const = 0;
     LIB_EXPORT inline const Property& operator[](const PropertyID& p_id) const { return Get(p_id); }
     
+    // Atom lookups, which fall back to the ID lookups in maps without slot storage
+    LIB_EXPORT virtual bool Has(PropertyAtom atom) const;
+    LIB_EXPORT virtual const Property& Get(PropertyAtom atom) const;
+    LIB_EXPORT inline const Property& operator[](PropertyAtom atom) const { return Get(atom); }
+    
     LIB_EXPORT virtual bool SetValue(const PropertyID& p_id, const Apto::String& prop_value) = 0;
     LIB_EXPORT virtual bool SetValue(const PropertyID& p_id, const int prop_value) = 0;
     LIB_EXPORT virtual bool SetValue(const PropertyID& p_id, const double prop_value) = 0;
@@ -352,6 +378,7 @@ namespace Avida {
     
   private:
     Apto::Map<PropertyID, PropertyPtr, PropertyMapStorage, Apto::ExplicitDefault> m_prop_map;
+    Apto::Array<Property*, Apto::Smart> m_slots;  // indexed by atom, NULL where undefined; owned by m_prop_map
     
   public:
     LIB_EXPORT inline HashPropertyMap() { ; }
@@ -362,8 +389,10 @@ namespace Avida {
     LIB_EXPORT bool operator==(const PropertyMap& p) const;
     
     LIB_EXPORT bool Has(const PropertyID& p_id) const;
+    LIB_EXPORT bool Has(PropertyAtom atom) const;
     
     LIB_EXPORT const Property& Get(const PropertyID& p_id) const;
+    LIB_EXPORT const Property& Get(PropertyAtom atom) const;
     
     LIB_EXPORT bool SetValue(const PropertyID& p_id, const Apto::String& prop_value);
     LIB_EXPORT bool SetValue(const PropertyID& p_id, const int prop_value);
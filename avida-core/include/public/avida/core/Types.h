@@ -105,6 +105,7 @@ namespace Avida {
   
   typedef Apto::SmartPtr<Property> PropertyPtr;
   typedef Apto::String PropertyID;
+  typedef int PropertyAtom;
   typedef Apto::String PropertyTypeID;
   typedef Apto::Set<PropertyID> PropertyIDSet;
   typedef Apto::SmartPtr<PropertyIDSet> PropertyIDSetPtr;
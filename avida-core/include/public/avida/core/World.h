@@ -70,6 +70,16 @@ namespace Avida {
     // Actions
     LIB_EXPORT void PerformUpdate(Context& ctx, Update current_update);
     
+    // PerformUpdate in two parts: the facets scheduled before the data manager (systematics and environment), then the
+    // data manager and the facets after it
+    LIB_EXPORT void PerformPreDataUpdate(Context& ctx, Update current_update);
+    LIB_EXPORT void PerformDataUpdate(Context& ctx, Update current_update);
+    
+  private:
+    int dataManagerPosition() const;
+    
+  public:
+    
     LIB_EXPORT bool Serialize(ArchivePtr ar) const;
   };
   
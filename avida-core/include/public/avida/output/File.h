@@ -39,6 +39,7 @@ namespace Avida {
     
     class File : public Socket
     {
+      friend class Manager;
     private:
       Apto::String m_descr;
       Apto::String m_filetype;
@@ -48,7 +49,11 @@ namespace Avida {
       
       int m_num_cols;
       
-      std::ofstream m_fp;
+      std::ofstream* m_fp;
+      Manager* m_writer;          // background writer for the contents of m_pending, NULL when writing to m_fp directly;
+                                  // the manager detaches its files (detachWriter) before it is destroyed
+      std::ostringstream m_pending;
+      bool m_submitted;
 
       
     public:
@@ -70,14 +75,15 @@ namespace Avida {
       LIB_EXPORT inline const OutputID& Name() const { return m_output_id; }
       LIB_EXPORT inline const Apto::String& GetFileType() const { return m_filetype; }
       
-      LIB_EXPORT inline bool Fail() const { return m_fp.fail(); }
-      LIB_EXPORT inline bool Good() const { return m_fp.good(); }
+      LIB_EXPORT bool Fail() const;
+      LIB_EXPORT bool Good() const;
       LIB_EXPORT inline bool HeaderDone() { return m_descr_written; }
       
       LIB_EXPORT inline bool SetFileType(const Apto::String& ft);
 
       
-      LIB_EXPORT inline std::ofstream& OFStream() { return m_fp; }
+      // Direct access to the file stream; files that use it are no longer written by the background writer
+      LIB_EXPORT std::ofstream& OFStream();
       
       
       // The following methods output a value into the data file.
@@ -94,10 +100,10 @@ namespace Avida {
       
       // The following methods output a value into the data file anonymously (no column descriptor).
       //  first argument (x, i, data_str, etc.) - the value to write (as double, int, const char *, etc.)
-      LIB_EXPORT inline void WriteAnonymous(double x) { m_fp << x << " "; }
-      LIB_EXPORT inline void WriteAnonymous(int i) { m_fp << i << " "; }
-      LIB_EXPORT inline void WriteAnonymous(long i) { m_fp << i << " "; }
-      LIB_EXPORT inline void WriteAnonymous(const char* data_str) { m_fp << data_str << " "; }
+      LIB_EXPORT inline void WriteAnonymous(double x) { out() << x << " "; }
+      LIB_EXPORT inline void WriteAnonymous(int i) { out() << i << " "; }
+      LIB_EXPORT inline void WriteAnonymous(long i) { out() << i << " "; }
+      LIB_EXPORT inline void WriteAnonymous(const char* data_str) { out() << data_str << " "; }
       
       // The following methods are useful for outputting tables of values with row size x
       LIB_EXPORT void WriteBlockElement(double x, int element, int x_size);
@@ -125,6 +131,11 @@ namespace Avida {
       LIB_EXPORT static FilePtr createWithPath(World* world, Apto::String path, bool append, Feedback* feedback);
 
       LIB_LOCAL File(World* world, const OutputID& output_id, bool append = false);
+      
+      LIB_EXPORT inline std::ostream& out() { if (m_writer) return m_pending; return *m_fp; }
+      LIB_LOCAL void submitPending(bool close = false);
+      LIB_LOCAL void syncWriter() const;
+      LIB_LOCAL void detachWriter();
     };
     
 
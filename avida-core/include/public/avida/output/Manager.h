@@ -29,16 +29,34 @@
 #include "avida/core/World.h"
 #include "avida/output/Types.h"
 
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+
 
 namespace Avida {
   namespace Output {
     
     // Output::Manager - Manages output sockets (files, etc.) and their identifiers
     // --------------------------------------------------------------------------------------------------------------
+    //
+    // Once StartWriter() is called, files hand their completed lines to a background writer thread, which writes them
+    // in the order they were submitted.  The simulation can then continue with the next update while the output of the
+    // previous one is written.  At most MAX_PENDING_WRITES lines wait for the writer before submitting blocks.  Files
+    // still using the writer when the manager is destroyed are detached from it and write to their streams directly.
     
     class Manager : public WorldFacet
     {
       friend class Socket;
+      friend class File;
+    public:
+      static const int MAX_PENDING_WRITES = 4096;
+      
+    private:
+      struct WriteRequest;
+      class Writer;
+      
     private:
       World* m_world;
       
@@ -48,6 +66,16 @@ namespace Avida {
       Apto::Map<OutputID, SocketWeakRef> m_sockets;
       Apto::Map<OutputID, SocketPtr> m_static_sockets;
       
+      Apto::Mutex m_write_mutex;
+      Apto::ConditionVariable m_write_cond;   // requests queued or closing
+      Apto::ConditionVariable m_space_cond;   // requests written
+      Apto::List<WriteRequest*> m_write_queue;
+      int m_writing;                          // requests taken from the queue and not yet written
+      std::map<const std::ofstream*, int> m_stream_writes;  // requests not yet written, per stream
+      std::set<File*> m_files;                // files submitting to the writer
+      bool m_closing;
+      Writer* m_writer;
+      
     public:
       LIB_EXPORT Manager(const Apto::String& output_path);
       LIB_EXPORT ~Manager();
@@ -61,6 +89,10 @@ namespace Avida {
       
       LIB_EXPORT void FlushAll();
       
+      LIB_EXPORT void StartWriter();
+      LIB_EXPORT inline bool HasWriter() const { return (m_writer != NULL); }
+      LIB_EXPORT void WaitForWrites();  // returns once all submitted output has been written
+      
       LIB_EXPORT bool AttachTo(World* world);
       LIB_EXPORT static ManagerPtr Of(World* world);
       
@@ -76,6 +108,14 @@ namespace Avida {
       LIB_EXPORT bool RegisterStaticSocket(const OutputID& output_id, SocketPtr socket);
       LIB_EXPORT SocketPtr RetrieveStaticSocket(const OutputID& output_id);
       LIB_EXPORT void UnregisterSocket(const OutputID& output_id);
+      
+      LIB_LOCAL void attachFile(File* file);
+      LIB_LOCAL void detachFile(File* file);
+      
+      // Queue data for fp, taking ownership of the stream if close is set
+      LIB_LOCAL void submitWrite(std::ofstream* fp, const std::string& data, bool close);
+      LIB_LOCAL void waitForWrites(const std::ofstream* fp);  // returns once all output submitted for fp is written
+      LIB_LOCAL void runWriter();
     };
     
   };
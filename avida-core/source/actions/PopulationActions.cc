@@ -3917,6 +3917,7 @@ public:
       cellB_list.Remove(&m_world->GetPopulation().GetCell(idA0));
       cellB_list.Remove(&m_world->GetPopulation().GetCell(idA1));
     }
+    m_world->GetPopulation().TopologyChanged();
   }
 };
 
@@ -3994,6 +3995,7 @@ public:
       cellB_list.Remove(&m_world->GetPopulation().GetCell(idA0));
       cellB_list.Remove(&m_world->GetPopulation().GetCell(idA1));
     }
+    m_world->GetPopulation().TopologyChanged();
   }
 };
 
@@ -4070,6 +4072,7 @@ public:
         if (cellB_list.FindPtr(&cellA1) == NULL) cellB_list.Push(&cellA1);
       }
     }
+    m_world->GetPopulation().TopologyChanged();
   }
 };
 
@@ -4146,6 +4149,7 @@ public:
         if (cellB_list.FindPtr(&cellA1) == NULL) cellB_list.Push(&cellA1);
       }
     }
+    m_world->GetPopulation().TopologyChanged();
   }
 };
 
@@ -4186,6 +4190,7 @@ public:
     tList<cPopulationCell>& cellB_list = cellB.ConnectionList();
     cellA_list.PushRear(&cellB);
     cellB_list.PushRear(&cellA);
+    m_world->GetPopulation().TopologyChanged();
   }
 };
 
@@ -4226,6 +4231,7 @@ public:
     tList<cPopulationCell>& cellB_list = cellB.ConnectionList();
     cellA_list.Remove(&cellB);
     cellB_list.Remove(&cellA);
+    m_world->GetPopulation().TopologyChanged();
   }
 };
 
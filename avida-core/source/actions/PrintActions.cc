@@ -42,6 +42,7 @@
 #include "cAnalyzeGenotype.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
+#include "cGridDump.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cHistogram.h"
@@ -68,6 +69,9 @@ class cBioGroup;
 
 using namespace Avida;
 
+static const PropertyAtom s_prop_atom_instset = PropertyAtoms::Intern("instset");
+static const PropertyAtom s_prop_atom_threshold = PropertyAtoms::Intern("threshold");
+
 
 #define STATS_OUT_FILE(METHOD, DEFAULT)                                                   /*  1 */ \
 class cAction ## METHOD : public cAction {                                                /*  2 */ \
@@ -804,7 +808,7 @@ public:
     const int num_cells = population.GetSize();
     for (int x = 0; x < num_cells; x++) {
       cPopulationCell& cell = population.GetCell(x);
-      if (cell.IsOccupied() && cell.GetOrganism()->GetGenome().Properties().Get("instset").StringValue() == is.GetInstSetName()) {
+      if (cell.IsOccupied() && cell.GetOrganism()->GetGenome().Properties().Get(s_prop_atom_instset).StringValue() == is.GetInstSetName()) {
         // access this CPU's code block
         cCPUMemory& cpu_mem = cell.GetOrganism()->GetHardware().GetMemory();
         const int mem_size = cpu_mem.GetSize();
@@ -871,6 +875,68 @@ public:
   }
 };
 
+class cActionPrintTestCPUCacheStats : public cAction
+{
+private:
+  cString m_filename;
+public:
+  cActionPrintTestCPUCacheStats(cWorld* world, const cString& args, Feedback&) : cAction(world, args)
+  {
+    cString largs(args);
+    if (largs == "") m_filename = "test_cpu_cache.dat"; else m_filename = largs.PopWord();
+  }
+  
+  static const cString GetDescription() { return "Arguments: [string fname=\"test_cpu_cache.dat\"]"; }
+  void Process(cAvidaContext&)
+  {
+    cCPUTestCache& cache = m_world->GetHardwareManager().GetTestCache();
+    const int hits = cache.GetHits();
+    const int misses = cache.GetMisses();
+    
+    Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
+    df->WriteComment("Test CPU result cache statistics (see TEST_CPU_CACHE_SIZE)");
+    df->WriteTimeStamp();
+    df->Write(m_world->GetStats().GetUpdate(), "Update");
+    df->Write(cache.GetCapacity(), "Capacity");
+    df->Write(cache.GetSize(), "Cached Results");
+    df->Write(hits, "Hits");
+    df->Write(misses, "Misses");
+    df->Write((hits + misses > 0) ? (double)hits / (double)(hits + misses) : 0.0, "Hit Rate");
+    df->Endl();
+  }
+};
+
+class cActionPrintHardwarePoolStats : public cAction
+{
+private:
+  cString m_filename;
+public:
+  cActionPrintHardwarePoolStats(cWorld* world, const cString& args, Feedback&) : cAction(world, args)
+  {
+    cString largs(args);
+    if (largs == "") m_filename = "hardware_pool.dat"; else m_filename = largs.PopWord();
+  }
+  
+  static const cString GetDescription() { return "Arguments: [string fname=\"hardware_pool.dat\"]"; }
+  void Process(cAvidaContext&)
+  {
+    cHardwareManager& hw_mgr = m_world->GetHardwareManager();
+    const int hits = hw_mgr.GetPoolHits();
+    const int misses = hw_mgr.GetPoolMisses();
+    
+    Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
+    df->WriteComment("Hardware recycling pool statistics (see HARDWARE_POOL_SIZE)");
+    df->WriteTimeStamp();
+    df->Write(m_world->GetStats().GetUpdate(), "Update");
+    df->Write(hw_mgr.GetPoolCapacity(), "Capacity Per Instruction Set");
+    df->Write(hw_mgr.GetPoolSize(), "Pooled Hardware");
+    df->Write(hits, "Hits");
+    df->Write(misses, "Misses");
+    df->Write((hits + misses > 0) ? (double)hits / (double)(hits + misses) : 0.0, "Hit Rate");
+    df->Endl();
+  }
+};
+
 //Depth Histogram for Parasites Only
 class cActionPrintParasiteDepthHistogram : public cAction
 {
@@ -3043,7 +3109,7 @@ public:
       ConstInstructionSequencePtr seq;
       seq.DynamicCastFrom(genome.Representation());
       const int length = seq->GetSize();
-      if (Apto::StrAs(genome.Properties().Get("instset")) != m_inst_set) continue;
+      if (Apto::StrAs(genome.Properties().Get(s_prop_atom_instset)) != m_inst_set) continue;
       
       // Place this genotype into the histograms.
       for (int j = 0; j < length; j++) {
@@ -3268,6 +3334,44 @@ private:
 };
 
 
+/* Output of one Dump*Grid frame: a text file for the current update, or with GRID_DUMP_FORMAT set, a frame of the
+   grid's binary container (named by the given filename, or the default container name, plus ".grid").  Values are
+   written in text order, a row at a time.  Text output is flushed once per frame rather than per row, so a crash can
+   lose at most the frame being written. */
+class cGridDumpOutput
+{
+private:
+  cGridDump* m_dump;
+  cGridDump::cFrame* m_frame;
+  Avida::Output::FilePtr m_df;
+  ofstream* m_fp;
+  
+public:
+  cGridDumpOutput(cWorld* world, const cString& filename, const char* text_format, const char* container,
+                  cGridDump::eValueType type, int rows, int cols)
+  : m_dump(world->GetGridDump()), m_frame(NULL), m_fp(NULL)
+  {
+    if (m_dump) {
+      cString path((filename == "") ? cString(container) : filename);
+      path += ".grid";
+      m_frame = m_dump->CreateFrame(path, type, rows, cols, world->GetStats().GetUpdate());
+    }
+    
+    // Fall back to text if the container is unavailable
+    if (!m_frame) {
+      cString path(filename);
+      if (path == "") path.Set(text_format, world->GetStats().GetUpdate());
+      m_df = Avida::Output::File::CreateWithPath(world->GetNewWorld(), (const char*)path);
+      m_fp = &m_df->OFStream();
+    }
+  }
+  ~cGridDumpOutput() { if (m_frame) m_dump->Submit(m_frame); else m_fp->flush(); }
+  
+  void Write(int value) { if (m_frame) m_frame->Add(value); else *m_fp << value << " "; }
+  void Write(double value) { if (m_frame) m_frame->Add(value); else *m_fp << value << " "; }
+  void EndRow() { if (!m_frame) *m_fp << "\n"; }
+};
+
 class cActionDumpEnergyGrid : public cAction
 {
 private:
@@ -3282,18 +3386,16 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_energy.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_energy.%d.dat", "grid_energy", cGridDump::DOUBLE_VALUES,
+                       m_world->GetPopulation().GetWorldY(), m_world->GetPopulation().GetWorldX());
     
     for (int i = 0; i < m_world->GetPopulation().GetWorldY(); i++) {
       for (int j = 0; j < m_world->GetPopulation().GetWorldX(); j++) {
         cPopulationCell& cell = m_world->GetPopulation().GetCell(i * m_world->GetPopulation().GetWorldX() + j);
         double cell_energy = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().GetStoredEnergy() : 0.0;
-        fp << cell_energy << " ";
+        fp.Write(cell_energy);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -3342,18 +3444,16 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_cell_data.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_cell_data.%d.dat", "grid_cell_data", cGridDump::DOUBLE_VALUES,
+                       m_world->GetPopulation().GetWorldY(), m_world->GetPopulation().GetWorldX());
     
     for (int i = 0; i < m_world->GetPopulation().GetWorldY(); i++) {
       for (int j = 0; j < m_world->GetPopulation().GetWorldX(); j++) {
         cPopulationCell& cell = m_world->GetPopulation().GetCell(i * m_world->GetPopulation().GetWorldX() + j);
         double cell_data = cell.GetCellData();
-        fp << cell_data << " ";
+        fp.Write(cell_data);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -3372,18 +3472,16 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_fitness-%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_fitness-%d.dat", "grid_fitness", cGridDump::DOUBLE_VALUES,
+                       m_world->GetPopulation().GetWorldX(), m_world->GetPopulation().GetWorldY());
     
     for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
       for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
         cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
         double fitness = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().GetFitness() : 0.0;
-        fp << fitness << " ";
+        fp.Write(fitness);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -3405,19 +3503,20 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname_prefix='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename = "grid_class_id";
-    filename.Set("%s-%d.dat", (const char*)filename, m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cString prefix(m_filename);
+    if (prefix == "") prefix = "grid_class_id";
+    cString format(prefix);
+    format += "-%d.dat";
+    cGridDumpOutput fp(m_world, "", format, prefix, cGridDump::INT_VALUES,
+                       m_world->GetPopulation().GetWorldY(), m_world->GetPopulation().GetWorldX());
     
     for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
       for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
         cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
         int id = (cell.IsOccupied() && cell.GetOrganism()->SystematicsGroup((const char*)m_role)) ? cell.GetOrganism()->SystematicsGroup((const char*)m_role)->ID() : -1;
-        fp << id << " ";
+        fp.Write(id);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -3466,10 +3565,8 @@ public:
       }
     }
     
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_genotype_color-%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_genotype_color-%d.dat", "grid_genotype_color", cGridDump::INT_VALUES,
+                       m_world->GetPopulation().GetWorldY(), m_world->GetPopulation().GetWorldX());
     
     for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
       for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
@@ -3478,13 +3575,13 @@ public:
         if (bg) {
           int color = 0;
           for (; color < m_num_colors; color++) if (m_genotype_chart[color] == bg->ID()) break;
-          if (color == m_num_colors && (bool)Apto::StrAs(bg->Properties().Get("threshold"))) color++;
-          fp << color << " ";
+          if (color == m_num_colors && (bool)Apto::StrAs(bg->Properties().Get(s_prop_atom_threshold))) color++;
+          fp.Write(color);
         } else {
-          fp << "-1 ";
+          fp.Write(-1);
         }
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
   
@@ -3526,18 +3623,16 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_phenotype_id.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_phenotype_id.%d.dat", "grid_phenotype_id", cGridDump::INT_VALUES,
+                       m_world->GetPopulation().GetWorldY(), m_world->GetPopulation().GetWorldX());
     
     for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
       for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
         cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
         int id = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().CalcID() : -1;
-        fp << id << " ";
+        fp.Write(id);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -3556,18 +3651,16 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("id_grid.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "id_grid.%d.dat", "id_grid", cGridDump::INT_VALUES,
+                       m_world->GetPopulation().GetWorldY(), m_world->GetPopulation().GetWorldX());
     
     for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
       for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
         cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
         int id = (cell.IsOccupied()) ? cell.GetOrganism()->GetID() : -1;
-        fp << id << " ";
+        fp.Write(id);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -3586,18 +3679,16 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_dumps/vitality_grid.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_dumps/vitality_grid.%d.dat", "grid_dumps/vitality_grid", cGridDump::DOUBLE_VALUES,
+                       m_world->GetPopulation().GetWorldY(), m_world->GetPopulation().GetWorldX());
     
     for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
       for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
         cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
         double id = (cell.IsOccupied()) ? cell.GetOrganism()->GetVitality() : -1;
-        fp << id << " ";
+        fp.Write(id);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -3617,12 +3708,10 @@ public:
   void Process(cAvidaContext&)
   {
     const int worldx = m_world->GetPopulation().GetWorldX();
-    cString filename(m_filename);
     
     if (m_world->GetConfig().USE_AVATARS.Get()) {
-      if (filename == "") filename.Set("grid_dumps/avatar_grid.%d.dat", m_world->GetStats().GetUpdate());
-      Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-      ofstream& fp = df->OFStream();
+      cGridDumpOutput fp(m_world, m_filename, "grid_dumps/avatar_grid.%d.dat", "grid_dumps/avatar_grid", cGridDump::INT_VALUES,
+                         m_world->GetPopulation().GetWorldY(), worldx);
       
       for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
         for (int i = 0; i < worldx; i++) {
@@ -3632,25 +3721,24 @@ public:
             if (cell.HasPredAV()) target = cell.GetRandPredAV()->GetForageTarget();
             else target = cell.GetRandPreyAV()->GetForageTarget();
           } 
-          fp << target << " ";
+          fp.Write(target);
         }
-        fp << endl;
+        fp.EndRow();
       }
     }    
     
     else {
-      if (filename == "") filename.Set("grid_dumps/target_grid.%d.dat", m_world->GetStats().GetUpdate());
-      Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-      ofstream& fp = df->OFStream();
+      cGridDumpOutput fp(m_world, m_filename, "grid_dumps/target_grid.%d.dat", "grid_dumps/target_grid", cGridDump::INT_VALUES,
+                         m_world->GetPopulation().GetWorldY(), worldx);
       
       for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
         for (int i = 0; i < worldx; i++) {
           cPopulationCell& cell = m_world->GetPopulation().GetCell(j * worldx + i);
           int target = -99;
           if (cell.IsOccupied()) target = cell.GetOrganism()->GetForageTarget();
-          fp << target << " ";
+          fp.Write(target);
         }
-        fp << endl;
+        fp.EndRow();
       }
     }
   }
@@ -3671,10 +3759,8 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext& ctx)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_dumps/max_res_grid.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_dumps/max_res_grid.%d.dat", "grid_dumps/max_res_grid", cGridDump::DOUBLE_VALUES,
+                       m_world->GetPopulation().GetWorldY(), m_world->GetPopulation().GetWorldX());
     
     for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
       for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
@@ -3698,9 +3784,9 @@ public:
           }
         }
         max_resource = max_resource + topo_height;
-        fp << max_resource << " ";
+        fp.Write(max_resource);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -3720,18 +3806,16 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_sleep.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_sleep.%d.dat", "grid_sleep", cGridDump::DOUBLE_VALUES,
+                       m_world->GetPopulation().GetWorldY(), m_world->GetPopulation().GetWorldX());
     
     for (int i = 0; i < m_world->GetPopulation().GetWorldY(); i++) {
       for (int j = 0; j < m_world->GetPopulation().GetWorldX(); j++) {
         cPopulationCell& cell = m_world->GetPopulation().GetCell(i * m_world->GetPopulation().GetWorldX() + j);
         double cell_energy = (cell.IsOccupied()) ? cell.GetOrganism()->IsSleeping() : 0.0;
-        fp << cell_energy << " ";
+        fp.Write(cell_energy);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -3751,10 +3835,8 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_genome_length.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_genome_length.%d.dat", "grid_genome_length", cGridDump::INT_VALUES,
+                       m_world->GetPopulation().GetWorldX(), m_world->GetPopulation().GetWorldY());
     
     cPopulation* pop = &m_world->GetPopulation();
     
@@ -3770,9 +3852,9 @@ public:
           genome_length = seq->GetSize();
         }
         else { genome_length = -1; }
-        fp << genome_length << " ";
+        fp.Write(genome_length);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -3792,10 +3874,8 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext& ctx)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_task.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_task.%d.dat", "grid_task", cGridDump::INT_VALUES,
+                       m_world->GetPopulation().GetWorldX(), m_world->GetPopulation().GetWorldY());
     
     cPopulation* pop = &m_world->GetPopulation();
     cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
@@ -3815,9 +3895,9 @@ public:
             if (test_phenotype.GetLastTaskCount()[k] > 0) task_sum += static_cast<int>(pow(2.0, k));
           }
         }
-        fp << task_sum << " ";
+        fp.Write(task_sum);
       }
-      fp << endl;
+      fp.EndRow();
     }
     
     delete testcpu;
@@ -3882,10 +3962,8 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_task_hosts.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_task_hosts.%d.dat", "grid_task_hosts", cGridDump::INT_VALUES,
+                       m_world->GetPopulation().GetWorldX(), m_world->GetPopulation().GetWorldY());
     
     cPopulation* pop = &m_world->GetPopulation();
     
@@ -3904,9 +3982,9 @@ public:
           }
         }
         else { task_sum = -1; }
-        fp << task_sum << " ";
+        fp.Write(task_sum);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -3928,10 +4006,8 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_task_parasite.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_task_parasite.%d.dat", "grid_task_parasite", cGridDump::INT_VALUES,
+                       m_world->GetPopulation().GetWorldX(), m_world->GetPopulation().GetWorldY());
     
     cPopulation* pop = &m_world->GetPopulation();
     
@@ -3955,9 +4031,9 @@ public:
           else { task_sum = -1; }
         }
         else { task_sum = -1; }
-        fp << task_sum << " ";
+        fp.Write(task_sum);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -4075,10 +4151,8 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_virulence.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_virulence.%d.dat", "grid_virulence", cGridDump::DOUBLE_VALUES,
+                       m_world->GetPopulation().GetWorldX(), m_world->GetPopulation().GetWorldY());
     
     cPopulation* pop = &m_world->GetPopulation();
     
@@ -4098,9 +4172,9 @@ public:
           else { virulence = -1; }
         }
         else { virulence = -1; }
-        fp << virulence << " ";
+        fp.Write(virulence);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -4191,10 +4265,8 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_reactions.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_reactions.%d.dat", "grid_reactions", cGridDump::INT_VALUES,
+                       m_world->GetPopulation().GetWorldX(), m_world->GetPopulation().GetWorldY());
     
     cPopulation* pop = &m_world->GetPopulation();
     
@@ -4213,9 +4285,9 @@ public:
           }
         }
         else {task_sum = -1;}
-        fp << task_sum << " ";
+        fp.Write(task_sum);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -4403,18 +4475,16 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_donor.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_donor.%d.dat", "grid_donor", cGridDump::INT_VALUES,
+                       m_world->GetPopulation().GetWorldX(), m_world->GetPopulation().GetWorldY());
     
     for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
       for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
         cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
         int donor = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().IsDonorLast() : -1;
-        fp << donor << " ";
+        fp.Write(donor);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -4433,18 +4503,16 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    cString filename(m_filename);
-    if (filename == "") filename.Set("grid_receiver.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
+    cGridDumpOutput fp(m_world, m_filename, "grid_receiver.%d.dat", "grid_receiver", cGridDump::INT_VALUES,
+                       m_world->GetPopulation().GetWorldX(), m_world->GetPopulation().GetWorldY());
     
     for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
       for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
         cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
         int recv = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().IsReceiver() : -1;
-        fp << recv << " ";
+        fp.Write(recv);
       }
-      fp << endl;
+      fp.EndRow();
     }
   }
 };
@@ -5447,6 +5515,8 @@ void RegisterPrintActions(cActionLibrary* action_lib)
   action_lib->Register<cActionPrintData>("PrintData");
   action_lib->Register<cActionPrintInstructionAbundanceHistogram>("PrintInstructionAbundanceHistogram");
   action_lib->Register<cActionPrintDepthHistogram>("PrintDepthHistogram");
+  action_lib->Register<cActionPrintTestCPUCacheStats>("PrintTestCPUCacheStats");
+  action_lib->Register<cActionPrintHardwarePoolStats>("PrintHardwarePoolStats");
   action_lib->Register<cActionPrintParasiteDepthHistogram>("PrintParasiteDepthHistogram");
   action_lib->Register<cActionPrintHostDepthHistogram>("PrintHostDepthHistogram");
   action_lib->Register<cActionEcho>("Echo");
@@ -281,6 +281,66 @@ public:
   }
 };
 
+class cActionSaveCheckpoint : public cAction
+{
+private:
+  cString m_filename;
+  
+public:
+  cActionSaveCheckpoint(cWorld* world, const cString& args, Feedback& feedback)
+  : cAction(world, args), m_filename("")
+  {
+    cArgSchema schema(':','=');
+    
+    // String Entries
+    schema.AddEntry("filename", 0, "checkpoint");
+    
+    cArgContainer* argc = cArgContainer::Load(args, schema, feedback);
+    
+    if (argc) {
+      m_filename = argc->GetString(0);
+    }
+    
+    delete argc;
+  }
+  
+  static const cString GetDescription() { return "Arguments: [string filename='checkpoint']"; }
+  
+  void Process(cAvidaContext&)
+  {
+    int update = m_world->GetStats().GetUpdate();
+    cString filename = cStringUtil::Stringf("%s-%d.ckpt", (const char*)m_filename, update);
+    if (!m_world->GetPopulation().SaveCheckpoint(filename)) {
+      m_world->GetDriver().Feedback().Error("failed to save checkpoint '%s'", (const char*)filename);
+    }
+  }
+};
+
+
+class cActionLoadCheckpoint : public cAction
+{
+private:
+  cString m_filename;
+  
+public:
+  cActionLoadCheckpoint(cWorld* world, const cString& args, Feedback&) : cAction(world, args), m_filename("")
+  {
+    cString largs(args);
+    if (largs.GetSize()) m_filename = largs.PopWord();
+  }
+  
+  static const cString GetDescription() { return "Arguments: <cString fname>"; }
+  
+  void Process(cAvidaContext& ctx)
+  {
+    if (!m_world->GetPopulation().LoadCheckpoint(m_filename, ctx)) {
+      m_world->GetDriver().Feedback().Error("failed to load checkpoint '%s'", (const char*)m_filename);
+      m_world->GetDriver().Abort(Avida::INVALID_CONFIG);
+    }
+  }
+};
+
+
 void RegisterSaveLoadActions(cActionLibrary* action_lib)
 {
   action_lib->Register<cActionLoadParasiteGenotypeList>("LoadParasiteGenotypeList");
@@ -290,4 +350,6 @@ void RegisterSaveLoadActions(cActionLibrary* action_lib)
   action_lib->Register<cActionLoadStructuredSystematicsGroup>("LoadStructuredSystematicsGroup");
   action_lib->Register<cActionSaveStructuredSystematicsGroup>("SaveStructuredSystematicsGroup");
   action_lib->Register<cActionSaveFlameData>("SaveFlameData");
+  action_lib->Register<cActionSaveCheckpoint>("SaveCheckpoint");
+  action_lib->Register<cActionLoadCheckpoint>("LoadCheckpoint");
 }
@@ -47,7 +47,9 @@
 #include "cAnalyzeTreeStats_Gamma.h"
 #include "cAvidaContext.h"
 #include "cCPUTestInfo.h"
+#include "cColumnFile.h"
 #include "cEnvironment.h"
+#include "cGenomeDistances.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cHardwareStatusPrinter.h"
@@ -243,6 +245,9 @@ void cAnalyze::LoadSequence(cString cur_string)
 // from a file specified by the user, or resource.dat by default.
 void cAnalyze::LoadResources(cString cur_string)
 {
+  // Cached test results are keyed by the address of the old history, which the new one may reuse
+  m_world->GetHardwareManager().GetTestCache().Clear();
+  
   delete m_resources;
   m_resources = new cResourceHistory;
   
@@ -774,7 +779,7 @@ void cAnalyze::LoadFile(cString cur_string)
   
   cout << "Loading: " << filename << endl;
   
-  cInitFile input_file(filename, m_world->GetWorkingDir());
+  cColumnFile input_file(filename, m_world->GetWorkingDir(), m_world->GetConfig().MAX_CONCURRENCY.Get());
   if (!input_file.WasOpened()) {
     const cUserFeedback& feedback = input_file.GetFeedback();
     for (int i = 0; i < feedback.GetNumMessages(); i++) {
@@ -826,29 +831,38 @@ void cAnalyze::LoadFile(cString cur_string)
   Genome default_genome(is.GetHardwareType(), props, GeneticRepresentationPtr(new InstructionSequence(1)));
   int load_count = 0;
   
-  for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
-    cString cur_line = input_file.GetLine(line_id);
-    
-    cAnalyzeGenotype* genotype = new cAnalyzeGenotype(m_world, default_genome);
-    
-    output_it.Reset();
-    tDataEntryCommand<cAnalyzeGenotype>* data_command = NULL;
-    while ((data_command = output_it.Next()) != NULL) {
-      data_command->SetValue(genotype, cur_line.PopWord());
-    }
-    
-    // Give this genotype a name.  Base it on the ID if possible.
-    if (id_inc == false) {
-      cString name = cStringUtil::Stringf("org-%d", load_count++);
-      genotype->SetName(name);
-    }
-    else {
-      cString name = cStringUtil::Stringf("org-%d", genotype->GetID());
-      genotype->SetName(name);
+  // Each data command reads the column at its position in the format
+  for (int i = 0; i < output_list.GetSize(); i++) input_file.RequestColumn(i, cColumnFile::TEXT_COLUMN);
+  
+  while (input_file.ReadBlock()) {
+    for (int row = 0; row < input_file.GetNumRows(); row++) {
+      cAnalyzeGenotype* genotype = new cAnalyzeGenotype(m_world, default_genome);
+      
+      output_it.Reset();
+      tDataEntryCommand<cAnalyzeGenotype>* data_command = NULL;
+      for (int col = 0; (data_command = output_it.Next()) != NULL; col++) {
+        data_command->SetValue(genotype, input_file.GetText(row, col));
+      }
+      
+      // Give this genotype a name.  Base it on the ID if possible.
+      if (id_inc == false) {
+        cString name = cStringUtil::Stringf("org-%d", load_count++);
+        genotype->SetName(name);
+      }
+      else {
+        cString name = cStringUtil::Stringf("org-%d", genotype->GetID());
+        genotype->SetName(name);
+      }
+      
+      // Add this genotype to the proper batch.
+      batch[cur_batch].List().PushRear(genotype);
     }
-    
-    // Add this genotype to the proper batch.
-    batch[cur_batch].List().PushRear(genotype);
+  }
+  
+  if (input_file.HadError()) {
+    const cUserFeedback& file_feedback = input_file.GetFeedback();
+    for (int i = 0; i < file_feedback.GetNumMessages(); i++) cerr << "error: " << file_feedback.GetMessage(i) << endl;
+    if (exit_on_error) exit(1);
   }
   
   // Adjust the flags on this batch
@@ -3220,55 +3234,22 @@ void cAnalyze::CommandPrintDistances(cString cur_string)
   fout << "# 5: Frac distances above threshold (" << dist_threshold << ")" << endl;
   fout << endl;
   
-  // Loop through all pairs of organisms.
-  int dist_total = 0;
-  int dist_max = 0;
-  int pair_count = 0;
-  int threshold_pair_count = 0;
+  // Find the distances between all pairs of genotypes.
+  cGenomeDistances distances(cGenomeDistances::EDIT, dist_threshold);
+  const cGenomeDistances::sTotals totals = distances.CalcUniquePairs(m_jobqueue, batch[cur_batch].List());
+  const long long dist_total = totals.distance;
+  const int dist_max = totals.max_distance;
+  long long pair_count = totals.pairs;
+  const long long threshold_pair_count = totals.threshold_pairs;
 	double count = 0;
 	
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-  tListIterator<cAnalyzeGenotype> batch_it1(batch[cur_batch].List());
-
-  int watermark = 0;
-  
-  while ((genotype1 = batch_it1.Next()) != NULL) {
+  // Pair each genotype with itself for a distance of 0.
+  cAnalyzeGenotype* genotype = NULL;
+  tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
+  while ((genotype = batch_it.Next()) != NULL) {
 		count ++;
-    const int gen1_count = genotype1->GetNumCPUs();
-
-    // Pair this genotype with itself for a distance of 0.
-    pair_count += gen1_count * (gen1_count - 1) / 2;
-
-    // Loop through the other genotypes this one can be paired with.
-    tListIterator<cAnalyzeGenotype> batch_it2(batch_it1);
-    while ((genotype2 = batch_it2.Next()) != NULL) {
-      const int gen2_count = genotype2->GetNumCPUs();
-      const int cur_pairs = gen1_count * gen2_count;
-      
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-      
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int cur_dist = InstructionSequence::FindEditDistance(genotype1_seq, genotype2_seq);
-      dist_total += cur_pairs * cur_dist;
-      if (cur_dist > dist_max) dist_max = cur_dist;
-      pair_count += cur_pairs;
-      if (cur_dist >= dist_threshold) threshold_pair_count += cur_pairs;
-
-      if (pair_count > watermark) {
-	cout << watermark << endl;
-	watermark += 100000;
-      }
-    }
+    const int gen_count = genotype->GetNumCPUs();
+    pair_count += gen_count * (gen_count - 1) / 2;
   }
   
 	count = (count * (count-1) ) /2;
@@ -5908,45 +5889,11 @@ void cAnalyze::CommandHamming(cString cur_string)
     cout.flush();
   }
   
-  // Setup some variables;
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-
-  double total_dist = 0;
-  double total_count = 0;
-  
-  tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
-  tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
-  
-  while ((genotype1 = list1_it.Next()) != NULL) {
-    list2_it.Reset();
-    while ((genotype2 = list2_it.Next()) != NULL) {
-      // Determine the counts...
-      const int count1 = genotype1->GetNumCPUs();
-      const int count2 = genotype2->GetNumCPUs();
-      const int num_pairs = (genotype1 == genotype2) ?
-        ((count1 - 1) * (count2 - 1)) : (count1 * count2);
-      if (num_pairs == 0) continue;
-      
-      // And do the tests...
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-      
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int dist = InstructionSequence::FindHammingDistance(genotype1_seq, genotype2_seq);
-      total_dist += dist * num_pairs;
-      total_count += num_pairs;
-    }
-  }
-  
+  // Pair every genotype in batch1 with every genotype in batch2
+  cGenomeDistances distances(cGenomeDistances::HAMMING);
+  const cGenomeDistances::sTotals totals = distances.CalcAllPairs(m_jobqueue, batch[batch1].List(), batch[batch2].List());
+  double total_dist = totals.distance;
+  double total_count = totals.pairs;
   
   // Calculate the final answer
   double ave_dist = (double) total_dist / (double) total_count;
@@ -5986,44 +5933,11 @@ void cAnalyze::CommandLevenstein(cString cur_string)
     cout.flush();
   }
   
-  // Setup some variables;
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-  double total_dist = 0;
-  double total_count = 0;
-  
-  tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
-  tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
-  
-  // Loop through all of the genotypes in each batch...
-  while ((genotype1 = list1_it.Next()) != NULL) {
-    list2_it.Reset();
-    while ((genotype2 = list2_it.Next()) != NULL) {
-      // Determine the counts...
-      const int count1 = genotype1->GetNumCPUs();
-      const int count2 = genotype2->GetNumCPUs();
-      const int num_pairs = (genotype1 == genotype2) ?
-        ((count1 - 1) * (count2 - 1)) : (count1 * count2);
-      if (num_pairs == 0) continue;
-      
-      // And do the tests...
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int dist = InstructionSequence::FindEditDistance(genotype1_seq, genotype2_seq);
-      total_dist += dist * num_pairs;
-      total_count += num_pairs;
-    }
-  }
+  // Pair every genotype in batch1 with every genotype in batch2
+  cGenomeDistances distances(cGenomeDistances::EDIT);
+  const cGenomeDistances::sTotals totals = distances.CalcAllPairs(m_jobqueue, batch[batch1].List(), batch[batch2].List());
+  double total_dist = totals.distance;
+  double total_count = totals.pairs;
   
   // Calculate the final answer
   double ave_dist = (double) total_dist / (double) total_count;
@@ -8838,6 +8752,71 @@ void cAnalyze::BatchDuplicate(cString cur_string)
   batch[batch_to].SetAligned(false);
 }
 
+// Recalculation of a single genotype on the analyze job queue.  Each job has its own copy of the test info, which the
+// test CPU writes results into, and a seed drawn before the batch starts so that results do not depend on scheduling.
+// The resource history is shared read-only between jobs.
+class cRecalculateJob
+{
+private:
+  cAnalyzeGenotype* m_genotype;
+  cAnalyzeGenotype* m_parent;
+  cCPUTestInfo m_test_info;
+  int m_num_trials;
+  int m_seed;
+  
+public:
+  cRecalculateJob(cAnalyzeGenotype* genotype, cAnalyzeGenotype* parent, const cCPUTestInfo& test_info,
+                  cResourceHistory* resources, int num_trials)
+    : m_genotype(genotype), m_parent(parent), m_test_info(test_info), m_num_trials(num_trials), m_seed(0)
+  {
+    m_test_info.SetResourceHistory(resources);
+  }
+  
+  void SetSeed(int seed) { m_seed = seed; }
+  
+  void Run(cAvidaContext& ctx)
+  {
+    ctx.GetRandom().ResetSeed(m_seed);
+    ctx.SetAnalyzeMode();
+    m_genotype->RecalculatePhenotype(ctx, &m_test_info, m_num_trials);
+    if (m_parent) m_genotype->CalcParentDistance(m_parent);
+  }
+  
+  void Finish() { if (m_parent) m_genotype->CalcParentRatios(m_parent); }
+};
+
+
+void cAnalyze::BatchUtil_Recalculate(const cCPUTestInfo& test_info, int num_trials)
+{
+  Apto::Array<cRecalculateJob*> jobs(batch[cur_batch].List().GetSize());
+  
+  tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
+  cAnalyzeGenotype* genotype = NULL;
+  cAnalyzeGenotype* last_genotype = NULL;
+  for (int i = 0; (genotype = batch_it.Next()) != NULL; i++) {
+    // If the previous genotype was the parent of this one, pass in a pointer
+    // to it for improved recalculate (such as distance to parent, etc.)
+    cAnalyzeGenotype* parent = NULL;
+    if (last_genotype != NULL && genotype->GetParentID() == last_genotype->GetID()) parent = last_genotype;
+    jobs[i] = new cRecalculateJob(genotype, parent, test_info, m_resources, num_trials);
+    last_genotype = genotype;
+  }
+  
+  // Draw all seeds before queueing, workers draw from the same generator as they pick up jobs
+  for (int i = 0; i < jobs.GetSize(); i++) jobs[i]->SetSeed(m_jobqueue.GetSeedForJob(i));
+  
+  tAnalyzeJobBatch<cRecalculateJob> jobbatch(m_jobqueue);
+  for (int i = 0; i < jobs.GetSize(); i++) jobbatch.AddJob(jobs[i], &cRecalculateJob::Run);
+  jobbatch.RunBatch();
+  
+  // Parent ratios and ancestor distances chain down the lineage, apply them in batch order
+  for (int i = 0; i < jobs.GetSize(); i++) {
+    jobs[i]->Finish();
+    delete jobs[i];
+  }
+}
+
+
 void cAnalyze::BatchRecalculate(cString cur_string)
 {
   Apto::Array<int> manual_inputs;  // Used only if manual inputs are specified
@@ -8883,21 +8862,7 @@ void cAnalyze::BatchRecalculate(cString cur_string)
     cerr << "warning: " << msg << endl;
   }
   
-  tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
-  cAnalyzeGenotype * genotype = NULL;
-  cAnalyzeGenotype * last_genotype = NULL;
-  while ((genotype = batch_it.Next()) != NULL) {    
-    // If the previous genotype was the parent of this one, pass in a pointer
-    // to it for improved recalculate (such as distance to parent, etc.)
-    if (last_genotype != NULL && genotype->GetParentID() == last_genotype->GetID()) {
-      genotype->Recalculate(m_ctx, &test_info, last_genotype);
-    } else {
-      genotype->Recalculate(m_ctx, &test_info);
-    }
-    last_genotype = genotype;
-  }
-    
-  return;
+  BatchUtil_Recalculate(test_info);
 }
 
 
@@ -8976,21 +8941,7 @@ void cAnalyze::BatchRecalculateWithArgs(cString cur_string)
     cerr << "warning: " << msg << endl;
   }
   
-  tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
-  cAnalyzeGenotype * genotype = NULL;
-  cAnalyzeGenotype * last_genotype = NULL;
-  while ((genotype = batch_it.Next()) != NULL) {    
-    // If the previous genotype was the parent of this one, pass in a pointer
-    // to it for improved recalculate (such as distance to parent, etc.)
-    if (last_genotype != NULL && genotype->GetParentID() == last_genotype->GetID()) {
-      genotype->Recalculate(m_ctx, &test_info, last_genotype, num_trials);
-    } else {
-      genotype->Recalculate(m_ctx, &test_info, NULL, num_trials);
-    }
-    last_genotype = genotype;
-  }
-  
-  return;
+  BatchUtil_Recalculate(test_info, num_trials);
 }
 
 
@@ -181,6 +181,7 @@ private:
   
   // Batch management...
   int BatchUtil_GetMaxLength(int batch_id = -1);
+  void BatchUtil_Recalculate(const cCPUTestInfo& test_info, int num_trials = 1);
   
   // Command helpers...
   void CommandDetail_Header(std::ostream& fp, int format_type,
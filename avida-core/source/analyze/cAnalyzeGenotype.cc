@@ -558,6 +558,18 @@ void cAnalyzeGenotype::CalcLandscape(cAvidaContext& ctx)
 
 
 void cAnalyzeGenotype::Recalculate(cAvidaContext& ctx, cCPUTestInfo* test_info, cAnalyzeGenotype* parent_genotype, int num_trials)
+{
+  RecalculatePhenotype(ctx, test_info, num_trials);
+  
+  // Setup a new parent stats if we have a parent to work with.
+  if (parent_genotype != NULL) {
+    CalcParentDistance(parent_genotype);
+    CalcParentRatios(parent_genotype);
+  }
+}
+
+
+void cAnalyzeGenotype::RecalculatePhenotype(cAvidaContext& ctx, cCPUTestInfo* test_info, int num_trials)
 {  
   // Allocate our own test info if it wasn't provided
   cCPUTestInfo* local_test_info = NULL;
@@ -597,28 +609,6 @@ void cAnalyzeGenotype::Recalculate(cAvidaContext& ctx, cCPUTestInfo* test_info,
   m_mating_display_a    = likely_phenotype->GetCurMatingDisplayA();
   m_mating_display_b    = likely_phenotype->GetCurMatingDisplayB();
 
-  
-  // Setup a new parent stats if we have a parent to work with.
-  if (parent_genotype != NULL) {
-    fitness_ratio = GetFitness() / parent_genotype->GetFitness();
-    efficiency_ratio = GetEfficiency() / parent_genotype->GetEfficiency();
-    comp_merit_ratio = GetCompMerit() / parent_genotype->GetCompMerit();
-    ConstInstructionSequencePtr seq_p;
-    GeneticRepresentationPtr rep_p = m_genome.Representation();
-    seq_p.DynamicCastFrom(rep_p);
-    const InstructionSequence& seq = *seq_p;
-    
-    const Genome& parent_genome = parent_genotype->GetGenome();
-    ConstInstructionSequencePtr parent_seq_p;
-    ConstGeneticRepresentationPtr parent_rep_p = parent_genome.Representation();
-    parent_seq_p.DynamicCastFrom(parent_rep_p);
-    const InstructionSequence& parent_seq = *parent_seq_p;
-    
-    parent_dist = cStringUtil::EditDistance((const char *)seq.AsString(), (const char *)parent_seq.AsString(), parent_muts);
-    
-    ancestor_dist = parent_genotype->GetAncestorDist() + parent_dist;
-  }
-  
   // Summarize plasticity information if multiple recalculations performed
   if (num_trials > 1){
     if (m_phenplast_stats != NULL)
@@ -630,6 +620,32 @@ void cAnalyzeGenotype::Recalculate(cAvidaContext& ctx, cCPUTestInfo* test_info,
 }
 
 
+void cAnalyzeGenotype::CalcParentDistance(const cAnalyzeGenotype* parent_genotype)
+{
+  ConstInstructionSequencePtr seq_p;
+  ConstGeneticRepresentationPtr rep_p = m_genome.Representation();
+  seq_p.DynamicCastFrom(rep_p);
+  const InstructionSequence& seq = *seq_p;
+  
+  const Genome& parent_genome = parent_genotype->GetGenome();
+  ConstInstructionSequencePtr parent_seq_p;
+  ConstGeneticRepresentationPtr parent_rep_p = parent_genome.Representation();
+  parent_seq_p.DynamicCastFrom(parent_rep_p);
+  const InstructionSequence& parent_seq = *parent_seq_p;
+  
+  parent_dist = cStringUtil::EditDistance((const char *)seq.AsString(), (const char *)parent_seq.AsString(), parent_muts);
+}
+
+
+void cAnalyzeGenotype::CalcParentRatios(const cAnalyzeGenotype* parent_genotype)
+{
+  fitness_ratio = GetFitness() / parent_genotype->GetFitness();
+  efficiency_ratio = GetEfficiency() / parent_genotype->GetEfficiency();
+  comp_merit_ratio = GetCompMerit() / parent_genotype->GetCompMerit();
+  ancestor_dist = parent_genotype->GetAncestorDist() + parent_dist;
+}
+
+
 void cAnalyzeGenotype::PrintTasks(ofstream& fp, int min_task, int max_task)
 {
   if (max_task == -1) max_task = task_counts.GetSize();
@@ -232,6 +232,12 @@ public:
   void SetCPUTestInfo(cCPUTestInfo& in_cpu_test_info) { m_cpu_test_info = in_cpu_test_info; }
   
   void Recalculate(cAvidaContext& ctx, cCPUTestInfo* test_info = NULL, cAnalyzeGenotype* parent_genotype = NULL, int num_trials = 1);
+  
+  // The stages of Recalculate().  The first two only read the parent, so they may run concurrently across a batch;
+  // CalcParentRatios() depends on the parent's recalculated values and must be applied in lineage order.
+  void RecalculatePhenotype(cAvidaContext& ctx, cCPUTestInfo* test_info = NULL, int num_trials = 1);
+  void CalcParentDistance(const cAnalyzeGenotype* parent_genotype);
+  void CalcParentRatios(const cAnalyzeGenotype* parent_genotype);
   void PrintTasks(std::ofstream& fp, int min_task = 0, int max_task = -1);
   void PrintTasksQuality(std::ofstream& fp, int min_task = 0, int max_task = -1);
   void PrintInternalTasks(std::ofstream& fp, int min_task = 0, int max_task = -1);
@@ -0,0 +1,280 @@
+/*
+ *  cGenomeDistances.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cGenomeDistances.h"
+
+#include "avida/core/InstructionSequence.h"
+
+#include "cAnalyzeGenotype.h"
+#include "cAnalyzeJobQueue.h"
+#include "tAnalyzeJobBatch.h"
+
+using namespace Avida;
+
+
+namespace {
+  typedef unsigned long long tWord;
+  const int WORD_BITS = 64;
+
+  // Rows of the pair matrix are grouped into tiles of roughly this many pairs
+  const long long TILE_PAIRS = 1 << 16;
+
+  inline int numBlocks(int size) { return (size + WORD_BITS - 1) / WORD_BITS; }
+
+  int hammingDistance(const unsigned char* seq1, int size1, const unsigned char* seq2, int size2)
+  {
+    const int overlap = (size1 < size2) ? size1 : size2;
+    int dist = size1 + size2 - 2 * overlap;
+    for (int i = 0; i < overlap; i++) dist += (seq1[i] != seq2[i]);
+    return dist;
+  }
+
+  // Match masks of a pattern: peq[block * alphabet + op] has a bit set for each row of the block holding op
+  void buildPeq(const unsigned char* seq, int size, int alphabet, Apto::Array<tWord>& peq)
+  {
+    peq.Resize(numBlocks(size) * alphabet);
+    peq.SetAll(0);
+    for (int i = 0; i < size; i++) peq[(i / WORD_BITS) * alphabet + seq[i]] |= tWord(1) << (i % WORD_BITS);
+  }
+
+  // Hyyro's formulation of Myers' bit-vector algorithm for global edit distance.  Each block holds the vertical deltas
+  // of 64 rows of the distance table, positive in pv and negative in mv.  A column is advanced one block at a time,
+  // with the horizontal delta out of the bottom of each block carried into the next.  Information only moves toward
+  // higher bits, so the unused bits of the last block never affect the pattern's final row.
+  int editDistance(const tWord* peq, int alphabet, int size1, const unsigned char* seq2, int size2, tWord* pv, tWord* mv)
+  {
+    if (size1 == 0) return size2;
+    if (size2 == 0) return size1;
+
+    const int blocks = numBlocks(size1);
+    const tWord high_bit = tWord(1) << (WORD_BITS - 1);
+    const tWord last_bit = tWord(1) << ((size1 - 1) % WORD_BITS);
+    for (int b = 0; b < blocks; b++) {
+      pv[b] = ~tWord(0);
+      mv[b] = 0;
+    }
+
+    int score = size1;
+    for (int j = 0; j < size2; j++) {
+      const tWord* eq_col = peq + seq2[j];
+      int hin = 1;  // the top row of the table counts up by one per column
+      for (int b = 0; b < blocks; b++) {
+        const tWord pvb = pv[b];
+        const tWord mvb = mv[b];
+        const tWord hin_neg = (hin < 0) ? 1 : 0;
+        tWord eq = eq_col[b * alphabet];
+        const tWord xv = eq | mvb;
+        eq |= hin_neg;
+        const tWord xh = (((eq & pvb) + pvb) ^ pvb) | eq;
+        tWord ph = mvb | ~(xh | pvb);
+        tWord mh = pvb & xh;
+
+        const tWord out_bit = (b == blocks - 1) ? last_bit : high_bit;
+        const int hout = ((ph & out_bit) ? 1 : 0) - ((mh & out_bit) ? 1 : 0);
+
+        ph = (ph << 1) | ((hin > 0) ? 1 : 0);
+        mh = (mh << 1) | hin_neg;
+        pv[b] = mh | ~(xv | ph);
+        mv[b] = ph & xv;
+        hin = hout;
+      }
+      score += hin;
+    }
+
+    return score;
+  }
+};
+
+
+void cGenomeDistances::cPackedGenomes::Pack(tList<cAnalyzeGenotype>& list)
+{
+  const int num_genotypes = list.GetSize();
+  offsets.Resize(num_genotypes + 1);
+  counts.Resize(num_genotypes);
+  genotypes.Resize(num_genotypes);
+
+  tListIterator<cAnalyzeGenotype> list_it(list);
+  cAnalyzeGenotype* genotype = NULL;
+  int total_size = 0;
+  for (int i = 0; (genotype = list_it.Next()) != NULL; i++) {
+    ConstInstructionSequencePtr seq_p;
+    seq_p.DynamicCastFrom(genotype->GetGenome().Representation());
+    offsets[i] = total_size;
+    counts[i] = genotype->GetNumCPUs();
+    genotypes[i] = genotype;
+    total_size += seq_p->GetSize();
+  }
+  offsets[num_genotypes] = total_size;
+
+  ops.Resize(total_size);
+  list_it.Reset();
+  for (int i = 0; (genotype = list_it.Next()) != NULL; i++) {
+    ConstInstructionSequencePtr seq_p;
+    seq_p.DynamicCastFrom(genotype->GetGenome().Representation());
+    const InstructionSequence& seq = *seq_p;
+    for (int j = 0; j < seq.GetSize(); j++) ops[offsets[i] + j] = static_cast<unsigned char>(seq[j].GetOp());
+  }
+}
+
+
+class cGenomeDistances::cTile
+{
+private:
+  const cGenomeDistances* m_distances;
+  int m_begin;
+  int m_end;
+
+public:
+  sTotals totals;
+
+  cTile(const cGenomeDistances* distances, int begin, int end) : m_distances(distances), m_begin(begin), m_end(end) { ; }
+
+  void Run(cAvidaContext&) { m_distances->calcRows(m_begin, m_end, totals); }
+};
+
+
+cGenomeDistances::sTotals cGenomeDistances::CalcUniquePairs(cAnalyzeJobQueue& queue, tList<cAnalyzeGenotype>& list)
+{
+  m_rows.Pack(list);
+  m_col_set = &m_rows;
+  m_unique_pairs = true;
+  return calcTiles(queue);
+}
+
+cGenomeDistances::sTotals cGenomeDistances::CalcAllPairs(cAnalyzeJobQueue& queue, tList<cAnalyzeGenotype>& list1,
+                                                         tList<cAnalyzeGenotype>& list2)
+{
+  m_rows.Pack(list1);
+  m_cols.Pack(list2);
+  m_col_set = &m_cols;
+  m_unique_pairs = false;
+  return calcTiles(queue);
+}
+
+int cGenomeDistances::CalcDistance(eMetric metric, const InstructionSequence& seq1, const InstructionSequence& seq2)
+{
+  const int size1 = seq1.GetSize();
+  const int size2 = seq2.GetSize();
+  Apto::Array<unsigned char> ops(size1 + size2);
+  int alphabet = 1;
+  for (int i = 0; i < size1; i++) ops[i] = static_cast<unsigned char>(seq1[i].GetOp());
+  for (int i = 0; i < size2; i++) ops[size1 + i] = static_cast<unsigned char>(seq2[i].GetOp());
+  for (int i = 0; i < ops.GetSize(); i++) if (ops[i] >= alphabet) alphabet = ops[i] + 1;
+
+  const unsigned char* ops1 = size1 ? &ops[0] : NULL;
+  const unsigned char* ops2 = size2 ? &ops[size1] : NULL;
+  if (metric == HAMMING) return hammingDistance(ops1, size1, ops2, size2);
+
+  Apto::Array<tWord> peq;
+  buildPeq(ops1, size1, alphabet, peq);
+  Apto::Array<tWord> pv(numBlocks(size1));
+  Apto::Array<tWord> mv(numBlocks(size1));
+  return editDistance(peq.GetSize() ? &peq[0] : NULL, alphabet, size1, ops2, size2,
+                      pv.GetSize() ? &pv[0] : NULL, mv.GetSize() ? &mv[0] : NULL);
+}
+
+
+cGenomeDistances::sTotals cGenomeDistances::calcTiles(cAnalyzeJobQueue& queue)
+{
+  m_alphabet = 1;
+  for (int i = 0; i < m_rows.ops.GetSize(); i++) if (m_rows.ops[i] >= m_alphabet) m_alphabet = m_rows.ops[i] + 1;
+  for (int i = 0; i < m_col_set->ops.GetSize(); i++) if (m_col_set->ops[i] >= m_alphabet) m_alphabet = m_col_set->ops[i] + 1;
+
+  const int num_rows = m_rows.GetSize();
+  const int num_cols = m_col_set->GetSize();
+  Apto::Array<cTile*> tiles;
+  long long tile_pairs = 0;
+  int tile_begin = 0;
+  for (int i = 0; i < num_rows; i++) {
+    tile_pairs += m_unique_pairs ? (num_cols - i - 1) : num_cols;
+    if (tile_pairs >= TILE_PAIRS || i == num_rows - 1) {
+      tiles.Push(new cTile(this, tile_begin, i + 1));
+      tile_begin = i + 1;
+      tile_pairs = 0;
+    }
+  }
+
+  if (tiles.GetSize()) {
+    tAnalyzeJobBatch<cTile> jobbatch(queue);
+    for (int i = 0; i < tiles.GetSize(); i++) jobbatch.AddJob(tiles[i], &cTile::Run);
+    jobbatch.RunBatch();
+  }
+
+  // Combine in tile order
+  sTotals totals;
+  for (int i = 0; i < tiles.GetSize(); i++) {
+    const sTotals& tile_totals = tiles[i]->totals;
+    totals.pairs += tile_totals.pairs;
+    totals.distance += tile_totals.distance;
+    if (tile_totals.max_distance > totals.max_distance) totals.max_distance = tile_totals.max_distance;
+    totals.threshold_pairs += tile_totals.threshold_pairs;
+    delete tiles[i];
+  }
+
+  return totals;
+}
+
+
+void cGenomeDistances::calcRows(int begin, int end, sTotals& totals) const
+{
+  const cPackedGenomes& cols = *m_col_set;
+
+  Apto::Array<tWord> peq;
+  Apto::Array<tWord> pv;
+  Apto::Array<tWord> mv;
+
+  for (int i = begin; i < end; i++) {
+    const unsigned char* row_ops = m_rows.GetOps(i);
+    const int row_size = m_rows.GetLength(i);
+    const int row_count = m_rows.counts[i];
+
+    if (m_metric == EDIT) {
+      buildPeq(row_ops, row_size, m_alphabet, peq);
+      if (pv.GetSize() < numBlocks(row_size)) {
+        pv.Resize(numBlocks(row_size));
+        mv.Resize(numBlocks(row_size));
+      }
+    }
+
+    for (int j = m_unique_pairs ? i + 1 : 0; j < cols.GetSize(); j++) {
+      long long weight = 0;
+      if (m_unique_pairs) {
+        weight = (long long)row_count * cols.counts[j];
+      } else {
+        weight = (m_rows.genotypes[i] == cols.genotypes[j]) ?
+          (long long)(row_count - 1) * (cols.counts[j] - 1) : (long long)row_count * cols.counts[j];
+        if (weight == 0) continue;
+      }
+
+      int dist = 0;
+      if (m_metric == EDIT) {
+        dist = editDistance(peq.GetSize() ? &peq[0] : NULL, m_alphabet, row_size, cols.GetOps(j), cols.GetLength(j),
+                            pv.GetSize() ? &pv[0] : NULL, mv.GetSize() ? &mv[0] : NULL);
+      } else {
+        dist = hammingDistance(row_ops, row_size, cols.GetOps(j), cols.GetLength(j));
+      }
+
+      totals.pairs += weight;
+      totals.distance += weight * dist;
+      if (dist > totals.max_distance) totals.max_distance = dist;
+      if (dist >= m_threshold) totals.threshold_pairs += weight;
+    }
+  }
+}
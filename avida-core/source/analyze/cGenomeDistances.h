@@ -0,0 +1,108 @@
+/*
+ *  cGenomeDistances.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cGenomeDistances_h
+#define cGenomeDistances_h
+
+#include "apto/core.h"
+
+#include "tList.h"
+
+namespace Avida {
+  class InstructionSequence;
+};
+
+class cAnalyzeGenotype;
+class cAnalyzeJobQueue;
+
+
+// cGenomeDistances - All pairs genome distances over genotype batches
+//
+// Genomes are packed into contiguous arrays of instruction ops, and rows of the pair matrix are divided into tiles that
+// run as analyze jobs.  Edit distance uses a bit-parallel (Myers/Hyyro) kernel, 64 rows of the dynamic programming
+// table per machine word; Hamming distance compares ops over the packed arrays.  Both give exactly the results of
+// InstructionSequence::FindEditDistance and FindHammingDistance.
+//
+// Pairs are weighted by organism counts.  With unique pairs, each unordered pair of distinct genotypes in a single
+// batch counts once with weight count1 * count2.  Otherwise every genotype of the first batch is paired with every
+// genotype of the second, weighted count1 * count2, or (count1 - 1) * (count2 - 1) when a genotype is paired with
+// itself; pairs with no weight are skipped.
+
+class cGenomeDistances
+{
+public:
+  enum eMetric { HAMMING, EDIT };
+
+  struct sTotals
+  {
+    long long pairs;             // total weight of all pairs
+    long long distance;          // sum of weight * distance
+    int max_distance;
+    long long threshold_pairs;   // total weight of pairs at or above the threshold
+
+    sTotals() : pairs(0), distance(0), max_distance(0), threshold_pairs(0) { ; }
+  };
+
+private:
+  class cPackedGenomes
+  {
+  public:
+    Apto::Array<unsigned char> ops;
+    Apto::Array<int> offsets;    // genome i occupies ops[offsets[i]] through ops[offsets[i + 1] - 1]
+    Apto::Array<int> counts;
+    Apto::Array<cAnalyzeGenotype*> genotypes;
+
+    void Pack(tList<cAnalyzeGenotype>& list);
+    int GetSize() const { return counts.GetSize(); }
+    const unsigned char* GetOps(int idx) const { return ops.GetSize() ? &ops[offsets[idx]] : NULL; }
+    int GetLength(int idx) const { return offsets[idx + 1] - offsets[idx]; }
+  };
+  class cTile;
+
+  eMetric m_metric;
+  int m_threshold;
+  cPackedGenomes m_rows;
+  cPackedGenomes m_cols;
+  const cPackedGenomes* m_col_set;  // m_rows itself for unique pairs
+  bool m_unique_pairs;
+  int m_alphabet;
+
+
+  cGenomeDistances(); // @not_implemented
+  cGenomeDistances(const cGenomeDistances&); // @not_implemented
+  cGenomeDistances& operator=(const cGenomeDistances&); // @not_implemented
+
+  sTotals calcTiles(cAnalyzeJobQueue& queue);
+  void calcRows(int begin, int end, sTotals& totals) const;
+
+public:
+  cGenomeDistances(eMetric metric, int threshold = 0)
+    : m_metric(metric), m_threshold(threshold), m_col_set(NULL), m_unique_pairs(false), m_alphabet(0) { ; }
+
+  // Totals over each unordered pair of distinct genotypes in one batch
+  sTotals CalcUniquePairs(cAnalyzeJobQueue& queue, tList<cAnalyzeGenotype>& list);
+  // Totals over every genotype of one batch paired with every genotype of another
+  sTotals CalcAllPairs(cAnalyzeJobQueue& queue, tList<cAnalyzeGenotype>& list1, tList<cAnalyzeGenotype>& list2);
+
+  // Distance between a single pair of sequences, using the same kernels as the batch calculations
+  static int CalcDistance(eMetric metric, const Avida::InstructionSequence& seq1, const Avida::InstructionSequence& seq2);
+};
+
+#endif
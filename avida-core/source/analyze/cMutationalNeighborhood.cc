@@ -63,6 +63,7 @@ void cMutationalNeighborhood::Process(cAvidaContext& ctx)
       // Create test infrastructure
       cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
       cCPUTestInfo test_info;
+      test_info.UseResultCache();
       
       // Setup One Step Data
       sStep& opdata = m_onestep_point[cur_site];
@@ -165,7 +166,7 @@ void cMutationalNeighborhood::ProcessInitialize(cAvidaContext& ctx)
   // Generate base information
   cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
   cCPUTestInfo test_info;
-  testcpu->TestGenome(ctx, test_info, m_base_genome);
+  testcpu->RecordSnapshots(ctx, test_info, m_base_genome, m_base_snapshots);
   
   cPhenotype& phenotype = test_info.GetColonyOrganism()->GetPhenotype();
   m_base_fitness = test_info.GetColonyFitness();
@@ -294,7 +295,7 @@ double cMutationalNeighborhood::ProcessOneStepGenome(cAvidaContext& ctx, cTestCP
                                                      const Genome& mod_genome, sStep& odata, int cur_site)
 {
   // Run the modified genome through the Test CPU
-  testcpu->TestGenome(ctx, test_info, mod_genome);
+  testcpu->TestGenome(ctx, test_info, mod_genome, m_base_snapshots);
   
   // Collect the calculated fitness
   double test_fitness = test_info.GetColonyFitness();
@@ -322,7 +323,7 @@ double cMutationalNeighborhood::ProcessOneStepGenome(cAvidaContext& ctx, cTestCP
   if (test_fitness >= m_neut_min) odata.site_count[cur_site]++;
   
   if (test_fitness != 0.0) { // Only count tasks if the organism is alive
-    const Apto::Array<int>& cur_tasks = test_info.GetColonyOrganism()->GetPhenotype().GetLastTaskCount();
+    const Apto::Array<int>& cur_tasks = test_info.GetColonyTaskCounts();
     bool knockout = false;
     bool anytask = false;
     for (int i = 0; i < m_base_tasks.GetSize(); i++) {
@@ -504,7 +505,7 @@ double cMutationalNeighborhood::ProcessTwoStepGenome(cAvidaContext& ctx, cTestCP
                                                      const sPendFit& cur, const sPendFit& oth)
 {
   // Run the modified genome through the Test CPU
-  testcpu->TestGenome(ctx, test_info, mod_genome);
+  testcpu->TestGenome(ctx, test_info, mod_genome, m_base_snapshots);
   
   // Collect the calculated fitness
   double test_fitness = test_info.GetColonyFitness();
@@ -531,7 +532,7 @@ double cMutationalNeighborhood::ProcessTwoStepGenome(cAvidaContext& ctx, cTestCP
   if (test_fitness >= m_neut_min) tdata.site_count[cur.site]++;
   
   if (test_fitness != 0.0) { // Only count tasks if the organism is alive
-    const Apto::Array<int>& cur_tasks = test_info.GetColonyOrganism()->GetPhenotype().GetLastTaskCount();
+    const Apto::Array<int>& cur_tasks = test_info.GetColonyTaskCounts();
     bool knockout = false;
     bool anytask = false;
     for (int i = 0; i < m_base_tasks.GetSize(); i++) {
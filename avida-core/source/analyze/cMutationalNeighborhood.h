@@ -26,6 +26,7 @@
 #include "avida/core/Genome.h"
 #include "avida/output/Types.h"
 
+#include "cTestCPUSnapshots.h"
 #include "tList.h"
 #include "tMatrix.h"
 
@@ -68,6 +69,7 @@ private:
   double m_base_merit;
   double m_base_gestation;
   Apto::Array<int> m_base_tasks;
+  cTestCPUSnapshots m_base_snapshots;  // gestation snapshots of the base genome, shared by all workers
   double m_neut_min;  // These two variables are a range around the base
   double m_neut_max;  //   fitness to be counted as neutral mutations.
   
@@ -36,6 +36,7 @@
 #include "cStringUtil.h"
 
 static Apto::BasicString<Apto::ThreadSafe> s_prop_id_instset("instset");
+static const PropertyAtom s_prop_atom_instset = PropertyAtoms::Intern(s_prop_id_instset);
 static PropertyDescriptionMap s_prop_desc_map;
 
 void cHardwareManager::Initialize()
@@ -138,6 +139,7 @@ Avida::Genome::InstSetPropertyMap::~InstSetPropertyMap() { ; }
 
 int Avida::Genome::InstSetPropertyMap::GetSize() const { return 1; }
 bool Avida::Genome::InstSetPropertyMap::Has(const PropertyID& p_id) const { return (p_id == s_prop_id_instset); }
+bool Avida::Genome::InstSetPropertyMap::Has(PropertyAtom atom) const { return (atom == s_prop_atom_instset); }
 
 const Avida::Property& Avida::Genome::InstSetPropertyMap::Get(const PropertyID& p_id) const
 {
@@ -147,6 +149,13 @@ const Avida::Property& Avida::Genome::InstSetPropertyMap::Get(const PropertyID&
   return *s_default_prop;
 }
 
+const Avida::Property& Avida::Genome::InstSetPropertyMap::Get(PropertyAtom atom) const
+{
+  if (atom == s_prop_atom_instset) return m_inst_set;
+  
+  return *s_default_prop;
+}
+
 
 bool Avida::Genome::InstSetPropertyMap::SetValue(const PropertyID& p_id, const Apto::String& prop_value)
 {
@@ -87,11 +87,67 @@ Avida::PropertyPtr Avida::PropertyMap::s_default_prop(new StringProperty("", Pro
 
 
 
+// PropertyAtoms
+// --------------------------------------------------------------------------------------------------------------
+
+namespace {
+  // Constructed on first use, as atoms are interned during static initialization
+  struct AtomTable
+  {
+    Apto::Mutex mutex;
+    Apto::Map<Avida::PropertyID, Avida::PropertyAtom> atoms;
+    Apto::Array<Avida::PropertyID, Apto::Smart> names;
+  };
+  
+  AtomTable& atomTable()
+  {
+    static AtomTable table;
+    return table;
+  }
+};
+
+Avida::PropertyAtom Avida::PropertyAtoms::Intern(const PropertyID& p_id)
+{
+  AtomTable& table = atomTable();
+  Apto::MutexAutoLock lock(table.mutex);
+  
+  PropertyAtom atom = Invalid;
+  if (!table.atoms.Get(p_id, atom)) {
+    atom = table.names.GetSize();
+    table.names.Push(p_id);
+    table.atoms.Set(p_id, atom);
+  }
+  return atom;
+}
+
+Avida::PropertyAtom Avida::PropertyAtoms::Find(const PropertyID& p_id)
+{
+  AtomTable& table = atomTable();
+  Apto::MutexAutoLock lock(table.mutex);
+  
+  PropertyAtom atom = Invalid;
+  table.atoms.Get(p_id, atom);
+  return atom;
+}
+
+Avida::PropertyID Avida::PropertyAtoms::Name(PropertyAtom atom)
+{
+  AtomTable& table = atomTable();
+  Apto::MutexAutoLock lock(table.mutex);
+  
+  if (atom < 0 || atom >= table.names.GetSize()) return PropertyID();
+  return table.names[atom];
+}
+
+
 // PropertyMap
 // --------------------------------------------------------------------------------------------------------------
 
 Avida::PropertyMap::~PropertyMap() { ; }
 
+bool Avida::PropertyMap::Has(PropertyAtom atom) const { return Has(PropertyAtoms::Name(atom)); }
+const Avida::Property& Avida::PropertyMap::Get(PropertyAtom atom) const { return Get(PropertyAtoms::Name(atom)); }
+
 
 // HashPropertyMap
 // --------------------------------------------------------------------------------------------------------------
@@ -102,11 +158,22 @@ int Avida::HashPropertyMap::GetSize() const { return m_prop_map.GetSize(); }
 
 bool Avida::HashPropertyMap::Has(const PropertyID& p_id) const { return m_prop_map.Has(p_id); }
 
+bool Avida::HashPropertyMap::Has(PropertyAtom atom) const
+{
+  return (atom >= 0 && atom < m_slots.GetSize() && m_slots[atom]);
+}
+
 const Avida::Property& Avida::HashPropertyMap::Get(const PropertyID& p_id) const
 {
   return *m_prop_map.GetWithDefault(p_id, s_default_prop);
 }
 
+const Avida::Property& Avida::HashPropertyMap::Get(PropertyAtom atom) const
+{
+  if (atom >= 0 && atom < m_slots.GetSize() && m_slots[atom]) return *m_slots[atom];
+  return *s_default_prop;
+}
+
 
 bool Avida::HashPropertyMap::SetValue(const PropertyID& p_id, const Apto::String& prop_value)
 {
@@ -161,8 +228,20 @@ bool Avida::HashPropertyMap::operator==(const PropertyMap& p) const
   return true;
 }
 
-void Avida::HashPropertyMap::Define(PropertyPtr p) { m_prop_map.Set(p->ID(), p); }
-bool Avida::HashPropertyMap::Remove(const PropertyID& p_id) { return m_prop_map.Remove(p_id); }
+void Avida::HashPropertyMap::Define(PropertyPtr p)
+{
+  PropertyAtom atom = PropertyAtoms::Intern(p->ID());
+  if (m_slots.GetSize() <= atom) m_slots.Resize(atom + 1, NULL);
+  m_slots[atom] = Apto::GetInternalPtr(p);
+  m_prop_map.Set(p->ID(), p);
+}
+
+bool Avida::HashPropertyMap::Remove(const PropertyID& p_id)
+{
+  PropertyAtom atom = PropertyAtoms::Find(p_id);
+  if (atom >= 0 && atom < m_slots.GetSize()) m_slots[atom] = NULL;
+  return m_prop_map.Remove(p_id);
+}
 
 Avida::ConstPropertyIDSetPtr Avida::HashPropertyMap::PropertyIDs() const
 {
@@ -101,6 +101,25 @@ void Avida::World::PerformUpdate(Context& ctx, Update current_update)
   }
 }
 
+void Avida::World::PerformPreDataUpdate(Context& ctx, Update current_update)
+{
+  const int data_pos = dataManagerPosition();
+  for (int i = 0; i < data_pos; i++) m_facet_order[i]->PerformUpdate(ctx, current_update);
+}
+
+void Avida::World::PerformDataUpdate(Context& ctx, Update current_update)
+{
+  for (int i = dataManagerPosition(); i < m_facet_order.GetSize(); i++) {
+    m_facet_order[i]->PerformUpdate(ctx, current_update);
+  }
+}
+
+int Avida::World::dataManagerPosition() const
+{
+  for (int i = 0; i < m_facet_order.GetSize(); i++) if (m_facet_order[i] == m_data_manager) return i;
+  return m_facet_order.GetSize();
+}
+
 
 bool Avida::World::Serialize(ArchivePtr ar) const
 {
@@ -22,10 +22,15 @@
 
 #include "cCPUMemory.h"
 
+#include "cCheckpoint.h"
+#include "cInstSet.h"
+
 using namespace std;
 using namespace Avida;
 
-cCPUMemory::cCPUMemory(const cCPUMemory& in_memory) : InstructionSequence(in_memory), m_flag_array(in_memory.GetSize())
+cCPUMemory::cCPUMemory(const cCPUMemory& in_memory)
+  : InstructionSequence(in_memory), m_flag_array(in_memory.GetSize()), m_index_inst_set(NULL), m_touch_log(NULL)
+  , m_touch_stamp(0)
 {
   for (int i = 0; i < m_flag_array.GetSize(); i++) m_flag_array[i] = in_memory.m_flag_array[i];
 }
@@ -33,6 +38,7 @@ cCPUMemory::cCPUMemory(const cCPUMemory& in_memory) : InstructionSequence(in_mem
 
 void cCPUMemory::adjustCapacity(int new_size)
 {
+  invalidateIndex();
   InstructionSequence::adjustCapacity(new_size);
   if (m_seq.GetSize() != m_flag_array.GetSize()) m_flag_array.Resize(m_seq.GetSize()); 
 }
@@ -43,6 +49,9 @@ void cCPUMemory::prepareInsert(int pos, int num_sites)
   assert(pos >= 0 && pos <= m_active_size); // Must insert at a legal position!
   assert(num_sites > 0); // Must insert positive number of lines!
   
+  // Every site from pos on moves
+  if (m_touch_log) noteTouchRange(pos, m_active_size);
+  
   // Re-adjust the size...
   const int old_size = m_active_size;
   const int new_size = m_active_size + num_sites;
@@ -68,6 +77,7 @@ void cCPUMemory::Resize(int new_size)
   assert(new_size >= 0);
 
   const int old_size = m_active_size;
+  if (m_touch_log && new_size < old_size) noteTouchRange(new_size, old_size);
   adjustCapacity(new_size);
   
   for (int i = old_size; i < new_size; i++) {
@@ -82,6 +92,7 @@ void cCPUMemory::ResizeOld(int new_size)
   assert(new_size >= 0);
 
   const int old_size = m_active_size;
+  if (m_touch_log && new_size < old_size) noteTouchRange(new_size, old_size);
   adjustCapacity(new_size);
 
   for (int i = old_size; i < new_size; i++) m_flag_array[i] = 0;
@@ -95,6 +106,9 @@ void cCPUMemory::Copy(int to, int from)
   assert(from >= 0);
   assert(from < m_seq.GetSize());
   
+  invalidateIndex();
+  noteTouch(to);
+  noteTouch(from);
   m_seq[to] = m_seq[from];
   m_flag_array[to] = m_flag_array[from];
 }
@@ -128,6 +142,8 @@ void cCPUMemory::Remove(int pos, int num_sites)
   assert(pos >= 0);                         // Removal must be in genome.
   assert(pos + num_sites <= m_active_size); // Cannot extend past end of genome.
 
+  if (m_touch_log) noteTouchRange(pos, m_active_size);
+  
   const int new_size = m_active_size - num_sites;
   for (int i = pos; i < new_size; i++) {
     m_seq[i] = m_seq[i + num_sites];
@@ -142,6 +158,9 @@ void cCPUMemory::Replace(int pos, int num_sites, const InstructionSequence& geno
   assert(num_sites >= 0);                   // Cannot replace negative
   assert(pos + num_sites <= m_active_size); // Cannot extend past end!
   
+  // The copy below rewrites sites even when the size is unchanged
+  invalidateIndex();
+  
   const int size_change = genome.GetSize() - num_sites;
   
   // First, get the size right
@@ -149,6 +168,7 @@ void cCPUMemory::Replace(int pos, int num_sites, const InstructionSequence& geno
   else if (size_change < 0) Remove(pos, -size_change);
   
   // Now just copy everything over!
+  if (m_touch_log) noteTouchRange(pos, pos + genome.GetSize());
   for (int i = 0; i < genome.GetSize(); i++) {
     m_seq[i + pos] = genome[i];
     m_flag_array[i + pos] = 0;
@@ -156,8 +176,25 @@ void cCPUMemory::Replace(int pos, int num_sites, const InstructionSequence& geno
 }
 
 
+// The inherited versions work through the overrides above, but are overridden as well so that every way of writing
+// the memory discards the label index itself rather than relying on how the base class is implemented
+void cCPUMemory::Replace(const InstructionSequence& genome, int begin, int end)
+{
+  invalidateIndex();
+  InstructionSequence::Replace(genome, begin, end);
+}
+
+void cCPUMemory::Rotate(int n)
+{
+  invalidateIndex();
+  if (m_touch_log) noteTouchRange(0, m_touch_log->GetSize());
+  InstructionSequence::Rotate(n);
+}
+
+
 void cCPUMemory::operator=(const cCPUMemory& other_memory)
 {
+  if (m_touch_log) noteTouchRange(0, m_touch_log->GetSize());
   adjustCapacity(other_memory.m_active_size);
   
   // Fill in the new information...
@@ -170,6 +207,7 @@ void cCPUMemory::operator=(const cCPUMemory& other_memory)
 
 void cCPUMemory::operator=(const InstructionSequence& other_genome)
 {
+  if (m_touch_log) noteTouchRange(0, m_touch_log->GetSize());
   adjustCapacity(other_genome.GetSize());
   
   // Fill in the new information...
@@ -179,3 +217,58 @@ void cCPUMemory::operator=(const InstructionSequence& other_genome)
   }
 }
 
+void cCPUMemory::noteTouchRange(int begin, int end) const
+{
+  if (begin < 0) begin = 0;
+  if (end > m_touch_log->GetSize()) end = m_touch_log->GetSize();
+  for (int i = begin; i < end; i++) if ((*m_touch_log)[i] < 0) (*m_touch_log)[i] = m_touch_stamp;
+}
+
+void cCPUMemory::buildIndex(const cInstSet& inst_set) const
+{
+  m_nop_runs.Resize(0);
+  m_label_sites.Resize(0);
+  
+  for (int pos = 0; pos < m_active_size; pos++) {
+    const Instruction& inst = m_seq[pos];
+    if (inst_set.IsLabel(inst)) m_label_sites.Push(pos);
+    if (inst_set.IsNop(inst)) {
+      const int last = m_nop_runs.GetSize() - 1;
+      if (last >= 0 && m_nop_runs[last].end == pos) {
+        m_nop_runs[last].end++;
+      } else {
+        sNopRun run;
+        run.start = pos;
+        run.end = pos + 1;
+        m_nop_runs.Push(run);
+      }
+    }
+  }
+  
+  m_index_inst_set = &inst_set;
+}
+
+
+void cCPUMemory::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  cp.Write(m_active_size);
+  for (int i = 0; i < m_active_size; i++) {
+    cp.Write(m_seq[i].GetOp());
+    cp.Write(m_flag_array[i]);
+  }
+}
+
+void cCPUMemory::LoadCheckpoint(cCheckpointReader& cp)
+{
+  const int size = cp.Read<int>();
+  if (!cp.Good() || size < 0) {
+    cp.Invalidate();
+    return;
+  }
+  
+  Reset(size);
+  for (int i = 0; i < size; i++) {
+    m_seq[i].SetOp(cp.Read<int>());
+    cp.Read(m_flag_array[i]);
+  }
+}
@@ -25,9 +25,20 @@
 
 #include "avida/core/InstructionSequence.h"
 
+class cCheckpointReader;
+class cCheckpointWriter;
+class cInstSet;
+
 
 class cCPUMemory : public Avida::InstructionSequence
 {
+public:
+  struct sNopRun
+  {
+    int start;  // first nop in the run
+    int end;    // one past the last nop in the run
+  };
+
 private:
 	static const unsigned char MASK_COPIED   = 0x01;
 	static const unsigned char MASK_MUTATED  = 0x02;
@@ -39,16 +50,59 @@ private:
 	static const unsigned char MASK_UNUSED2  = 0x80; // unused bit
   
   Apto::Array<unsigned char> m_flag_array;
+  
+  // Label index: maximal runs of nops and the positions of label instructions.  Built on demand for the requesting
+  // instruction set and discarded whenever the memory may have been written (m_index_inst_set is NULL when stale).
+  mutable const cInstSet* m_index_inst_set;
+  mutable Apto::Array<sNopRun, Apto::Smart> m_nop_runs;
+  mutable Apto::Array<int, Apto::Smart> m_label_sites;
+  
+  // First-touch log, kept only while the test CPU records a gestation (NULL otherwise).  Each entry is the stamp in
+  // effect when that site was first read or written, or -1 if it has not been touched.
+  Apto::Array<int>* m_touch_log;
+  int m_touch_stamp;
 
   void adjustCapacity(int new_size);
   void prepareInsert(int pos, int num_sites);
+  inline void invalidateIndex() { m_index_inst_set = NULL; }
+  void buildIndex(const cInstSet& inst_set) const;
+  inline void noteTouch(int idx) const;
+  void noteTouchRange(int begin, int end) const;
 
 public:
   cCPUMemory(const cCPUMemory& in_memory);
-  cCPUMemory(const InstructionSequence& in_genome) : InstructionSequence(in_genome), m_flag_array(in_genome.GetSize()) { ; }
-  explicit cCPUMemory(int size = 1)  : InstructionSequence(size), m_flag_array(size) { ClearFlags(); }
-  cCPUMemory(const Apto::String& in_string) : InstructionSequence(in_string), m_flag_array(in_string.GetSize()) { ; }
+  cCPUMemory(const InstructionSequence& in_genome)
+    : InstructionSequence(in_genome), m_flag_array(in_genome.GetSize()), m_index_inst_set(NULL), m_touch_log(NULL)
+    , m_touch_stamp(0) { ; }
+  explicit cCPUMemory(int size = 1)
+    : InstructionSequence(size), m_flag_array(size), m_index_inst_set(NULL), m_touch_log(NULL), m_touch_stamp(0)
+    { ClearFlags(); }
+  cCPUMemory(const Apto::String& in_string)
+    : InstructionSequence(in_string), m_flag_array(in_string.GetSize()), m_index_inst_set(NULL), m_touch_log(NULL)
+    , m_touch_stamp(0) { ; }
   ~cCPUMemory() { ; }
+  
+  // Non-const access may be used to write an instruction, so it conservatively discards the label index
+  inline Avida::Instruction& operator[](int idx)
+    { invalidateIndex(); noteTouch(idx); return InstructionSequence::operator[](idx); }
+  inline const Avida::Instruction& operator[](int idx) const { noteTouch(idx); return InstructionSequence::operator[](idx); }
+  
+  // Label index accessors, both sorted by position.  The index itself is not reported to the touch log; searches that
+  // use it must report the range a sequential scan would have read with NoteRead().
+  inline const Apto::Array<sNopRun, Apto::Smart>& GetNopRuns(const cInstSet& inst_set) const;
+  inline const Apto::Array<int, Apto::Smart>& GetLabelSites(const cInstSet& inst_set) const;
+  
+  // Touch log control.  Whole-memory operations and anything that shifts sites touch every site.
+  void StartTouchLog(Apto::Array<int>* touch_log, int stamp = 0) { m_touch_log = touch_log; m_touch_stamp = stamp; }
+  void SetTouchStamp(int stamp) { m_touch_stamp = stamp; }
+  void StopTouchLog() { m_touch_log = NULL; }
+  inline void NoteRead(int begin, int end) const { if (m_touch_log) noteTouchRange(begin, end); }
+  inline void NoteReadAll() const { if (m_touch_log) noteTouchRange(0, m_touch_log->GetSize()); }
+  
+  // Content reads inherited from InstructionSequence, reported to the touch log
+  Avida::InstructionSequence Crop(int start, int end) const
+    { NoteRead(start, end); return InstructionSequence::Crop(start, end); }
+  Apto::String AsString() const { NoteReadAll(); return InstructionSequence::AsString(); }
 
   inline bool FlagCopied(int pos) const     { return (MASK_COPIED   & m_flag_array[pos]) != 0; }
   inline bool FlagMutated(int pos) const    { return (MASK_MUTATED  & m_flag_array[pos]) != 0; }
@@ -74,6 +128,8 @@ public:
   
   void Clear()
 	{
+    invalidateIndex();
+    if (m_touch_log) noteTouchRange(0, m_touch_log->GetSize());
 		for (int i = 0; i < m_active_size; i++) {
 			m_seq[i].SetOp(0);
 			m_flag_array[i] = 0;
@@ -90,9 +146,32 @@ public:
   void Insert(int pos, const InstructionSequence& genome);
   void Remove(int pos, int num_sites = 1);
   void Replace(int pos, int num_sites, const InstructionSequence& genome);
+  void Replace(const InstructionSequence& genome, int begin, int end);
+  void Rotate(int n);
 
   void operator=(const cCPUMemory& other_memory);
   void operator=(const InstructionSequence& other_genome);
+
+  void SaveCheckpoint(cCheckpointWriter& cp) const;
+  void LoadCheckpoint(cCheckpointReader& cp);
 };
 
+
+inline void cCPUMemory::noteTouch(int idx) const
+{
+  if (m_touch_log && idx < m_touch_log->GetSize() && (*m_touch_log)[idx] < 0) (*m_touch_log)[idx] = m_touch_stamp;
+}
+
+inline const Apto::Array<cCPUMemory::sNopRun, Apto::Smart>& cCPUMemory::GetNopRuns(const cInstSet& inst_set) const
+{
+  if (m_index_inst_set != &inst_set) buildIndex(inst_set);
+  return m_nop_runs;
+}
+
+inline const Apto::Array<int, Apto::Smart>& cCPUMemory::GetLabelSites(const cInstSet& inst_set) const
+{
+  if (m_index_inst_set != &inst_set) buildIndex(inst_set);
+  return m_label_sites;
+}
+
 #endif
@@ -23,6 +23,7 @@
 #include "cCPUStack.h"
 
 #include <cassert>
+#include "cCheckpoint.h"
 #include "cString.h"
 
 using namespace std;
@@ -75,3 +76,19 @@ void cCPUStack::LoadState(istream & fp)
     Push(value);
   }
 }
+
+void cCPUStack::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  for (int i = 0; i < nHardware::STACK_SIZE; i++) cp.Write(stack[i]);
+  cp.Write(stack_pointer);
+}
+
+void cCPUStack::LoadCheckpoint(cCheckpointReader& cp)
+{
+  for (int i = 0; i < nHardware::STACK_SIZE; i++) cp.Read(stack[i]);
+  cp.Read(stack_pointer);
+  if (stack_pointer >= nHardware::STACK_SIZE) {
+    stack_pointer = 0;
+    cp.Invalidate();
+  }
+}
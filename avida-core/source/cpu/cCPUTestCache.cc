@@ -0,0 +1,86 @@
+/*
+ *  cCPUTestCache.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cCPUTestCache.h"
+
+
+cCPUTestCache::cCPUTestCache(int capacity)
+: m_capacity((capacity > 0) ? capacity : 0), m_order(m_capacity), m_next(0), m_hits(0), m_misses(0)
+{
+}
+
+
+bool cCPUTestCache::Lookup(const Apto::String& key, sCPUTestSummary& summary)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  if (m_results.Get(key, summary)) {
+    m_hits++;
+    return true;
+  }
+  m_misses++;
+  return false;
+}
+
+
+void cCPUTestCache::Store(const Apto::String& key, const sCPUTestSummary& summary)
+{
+  if (!m_capacity) return;
+  
+  Apto::MutexAutoLock lock(m_mutex);
+  
+  // Another thread may have completed the same test in the meantime
+  if (m_results.Has(key)) return;
+  
+  // Replace the oldest entry once the ring has wrapped
+  if (m_results.GetSize() >= m_capacity) m_results.Remove(m_order[m_next]);
+  
+  m_results.Set(key, summary);
+  m_order[m_next] = key;
+  m_next = (m_next + 1) % m_capacity;
+}
+
+
+void cCPUTestCache::Clear()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  m_results.Clear();
+  m_next = 0;
+  m_hits = 0;
+  m_misses = 0;
+}
+
+
+int cCPUTestCache::GetSize()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  return m_results.GetSize();
+}
+
+int cCPUTestCache::GetHits()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  return m_hits;
+}
+
+int cCPUTestCache::GetMisses()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  return m_misses;
+}
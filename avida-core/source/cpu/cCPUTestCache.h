@@ -0,0 +1,69 @@
+/*
+ *  cCPUTestCache.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cCPUTestCache_h
+#define cCPUTestCache_h
+
+#include "apto/core.h"
+
+#include "cCPUTestInfo.h"
+
+
+// cCPUTestCache - Memoized test CPU results
+//
+// A test CPU evaluation is repeatable for a given genome under fixed input, resource and environment settings, so
+// analyses that test the same genomes many times (landscapes, mutational neighborhoods) can reuse earlier results.
+// Only the summary values in sCPUTestSummary are retained.  The cache is bounded; once it is full, the oldest entries
+// are replaced first.  All methods may be called concurrently.
+
+class cCPUTestCache
+{
+private:
+  const int m_capacity;
+  
+  Apto::Mutex m_mutex;
+  Apto::Map<Apto::String, sCPUTestSummary> m_results;
+  Apto::Array<Apto::String> m_order;  // ring of keys in insertion order, used for eviction
+  int m_next;
+  
+  int m_hits;
+  int m_misses;
+
+  
+  cCPUTestCache(); // @not_implemented
+  cCPUTestCache(const cCPUTestCache&); // @not_implemented
+  cCPUTestCache& operator=(const cCPUTestCache&); // @not_implemented
+  
+public:
+  cCPUTestCache(int capacity);
+  
+  bool IsEnabled() const { return m_capacity > 0; }
+  
+  bool Lookup(const Apto::String& key, sCPUTestSummary& summary);
+  void Store(const Apto::String& key, const sCPUTestSummary& summary);
+  void Clear();
+  
+  int GetCapacity() const { return m_capacity; }
+  int GetSize();
+  int GetHits();
+  int GetMisses();
+};
+
+#endif
@@ -38,6 +38,7 @@ cCPUTestInfo::cCPUTestInfo(int max_tests)
   , use_random_inputs(false)
   , use_manual_inputs(false)
   , m_tracer(NULL)
+  , m_use_cache(false)
   , m_cur_sg(0)
   , org_array(max_tests)
   , m_res_method(RES_INITIAL)
@@ -64,6 +65,7 @@ cCPUTestInfo& cCPUTestInfo::operator=(const cCPUTestInfo& test_info)
   manual_inputs = test_info.manual_inputs; 
   if (test_info.m_tracer) { m_tracer = test_info.m_tracer; }
   m_mut_rates = test_info.m_mut_rates;
+  m_use_cache = test_info.m_use_cache;
   m_cur_sg = test_info.m_cur_sg;
   is_viable = test_info.is_viable;
   max_depth = test_info.max_depth;
@@ -72,6 +74,8 @@ cCPUTestInfo& cCPUTestInfo::operator=(const cCPUTestInfo& test_info)
   cycle_to = test_info.cycle_to;
   used_inputs = test_info.used_inputs; 
   org_array = test_info.org_array;
+  m_from_cache = test_info.m_from_cache;
+  m_summary = test_info.m_summary;
   m_res_method = test_info.m_res_method;
   m_res = NULL;  //Beware -- Resource history is NOT COPIED.
   m_res_update = test_info.m_res_update;
@@ -95,6 +99,7 @@ void cCPUTestInfo::Clear()
   depth_found = -1;
   max_cycle = 0;
   cycle_to = -1;
+  m_from_cache = false;
 
   for (int i = 0; i < generation_tests; i++) {
     if (org_array[i] == NULL) break;
@@ -106,6 +111,7 @@ void cCPUTestInfo::Clear()
 
 double cCPUTestInfo::GetGenotypeFitness()
 {
+  if (m_from_cache) return m_summary.genotype_fitness;
   if (org_array[0] != NULL) return org_array[0]->GetPhenotype().GetFitness();
   return 0.0;
 }
@@ -113,12 +119,32 @@ double cCPUTestInfo::GetGenotypeFitness()
 
 double cCPUTestInfo::GetColonyFitness()
 {
+  if (m_from_cache) return m_summary.colony_fitness;
   if (IsViable()) return GetColonyOrganism()->GetPhenotype().GetFitness();
   return 0.0;
 }
 
+double cCPUTestInfo::GetColonyMerit()
+{
+  if (m_from_cache) return m_summary.colony_merit;
+  return GetColonyOrganism()->GetPhenotype().GetMerit().GetDouble();
+}
+
+int cCPUTestInfo::GetColonyGestationTime()
+{
+  if (m_from_cache) return m_summary.colony_gestation_time;
+  return GetColonyOrganism()->GetPhenotype().GetGestationTime();
+}
+
+const Apto::Array<int>& cCPUTestInfo::GetColonyTaskCounts()
+{
+  if (m_from_cache) return m_summary.colony_task_counts;
+  return GetColonyOrganism()->GetPhenotype().GetLastTaskCount();
+}
+
 cPhenotype& cCPUTestInfo::GetTestPhenotype(int level)
 {
+  assert(!m_from_cache);
   assert(org_array[level] != NULL);
   return org_array[level]->GetPhenotype();
 }
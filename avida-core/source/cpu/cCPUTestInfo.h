@@ -43,6 +43,22 @@ enum eTestCPUResourceMethod { RES_INITIAL = 0, RES_CONSTANT, RES_UPDATED_DEPLETA
 // DYNAMIC - UPDATED_DEPLETABLE + resources inflow/outflow (NOT IMPLEMENTED YET!)
 
 
+// Results of a test that remain available when it is answered from the result cache (see cCPUTestCache)
+struct sCPUTestSummary
+{
+  bool is_viable;
+  int max_depth;
+  int depth_found;
+  int max_cycle;
+  int cycle_to;
+  double genotype_fitness;
+  double colony_fitness;
+  double colony_merit;
+  int colony_gestation_time;
+  Apto::Array<int> colony_task_counts;
+};
+
+
 class cCPUTestInfo
 {
   friend class cTestCPU;
@@ -55,6 +71,7 @@ private:
   Apto::Array<int> manual_inputs;  //   if so, use these.
   HardwareTracerPtr m_tracer;
   cMutationRates m_mut_rates;
+  bool m_use_cache;           // May results come from the test CPU result cache?
   
   int m_cur_sg;
 
@@ -68,6 +85,9 @@ private:
 
   Apto::Array<cOrganism*> org_array;
   
+  bool m_from_cache;          // Results were taken from the cache; no test organisms are available
+  sCPUTestSummary m_summary;
+  
   // Information about how to handle resources
   eTestCPUResourceMethod m_res_method;
   cResourceHistory* m_res;
@@ -91,8 +111,14 @@ public:
   void SetTraceExecution(HardwareTracerPtr tracer) { m_tracer = tracer; }
   void SetResourceOptions(int res_method = RES_INITIAL, cResourceHistory* res = NULL, int update = 0, int cpu_cycle_offset = 0)
     { m_res_method = (eTestCPUResourceMethod)res_method; m_res = res; m_res_update = update; m_res_cpu_cycle_offset = cpu_cycle_offset; }
+  void SetResourceHistory(cResourceHistory* res) { m_res = res; } // resource history is not carried over by copies
   
   void SetCurrentStateGridID(int sg) { m_cur_sg = sg; }
+  
+  // Allow tests to be answered from the result cache, when enabled via TEST_CPU_CACHE_SIZE.  Callers that set this may
+  // only use the summary accessors below, not the test organisms or phenotypes.
+  void UseResultCache(bool use_cache = true) { m_use_cache = use_cache; }
+  
   cMutationRates& MutationRates() { return m_mut_rates; }
 
   // Input Accessors
@@ -110,6 +136,8 @@ public:
   int GetDepthFound() const { return depth_found; }
   int GetMaxCycle() const { return max_cycle; }
   int GetCycleTo() const { return cycle_to; }
+  bool IsFromCache() const { return m_from_cache; }
+  const sCPUTestSummary& GetSummary() const { return m_summary; } // valid only when the result cache was requested
 
   // Genotype Stats...
   inline cOrganism* GetTestOrganism(int level = 0);
@@ -119,6 +147,9 @@ public:
   // And just because these are so commonly used...
   double GetGenotypeFitness();
   double GetColonyFitness();
+  double GetColonyMerit();
+  int GetColonyGestationTime();
+  const Apto::Array<int>& GetColonyTaskCounts();
   
   int GetStateGridID() const { return m_cur_sg; }
 };
@@ -126,12 +157,14 @@ public:
 
 inline cOrganism* cCPUTestInfo::GetTestOrganism(int level)
 {
+  assert(!m_from_cache);
   assert(org_array[level] != NULL);
   return org_array[level];
 }
 
 inline cOrganism* cCPUTestInfo::GetColonyOrganism()
 {
+  assert(!m_from_cache);
   const int depth_used = (depth_found == -1) ? 0 : depth_found;
   assert(org_array[depth_used] != NULL);
   return org_array[depth_used];
@@ -22,6 +22,7 @@
 
 #include "cCodeLabel.h"
 
+#include "cCheckpoint.h"
 
 #include <cmath>
 #include <vector>
@@ -215,3 +216,17 @@ int cCodeLabel::AsIntPolynomialCoefficent(const int base) const
 
   return value;
 }
+
+void cCodeLabel::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  cp.WriteArray(m_nops);
+}
+
+void cCodeLabel::LoadCheckpoint(cCheckpointReader& cp)
+{
+  cp.ReadArray(m_nops);
+  if (m_nops.GetSize() > MAX_LENGTH) {
+    m_nops.Resize(0);
+    cp.Invalidate();
+  }
+}
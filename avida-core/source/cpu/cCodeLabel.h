@@ -28,6 +28,9 @@
 #include "cString.h"
 #include "nHardware.h"
 
+class cCheckpointReader;
+class cCheckpointWriter;
+
 /**
  * The cCodeLabel class is used to identify a label within the genotype of
  * a creature, and aid in its manipulation.
@@ -71,6 +74,9 @@ public:
   int AsIntAdditivePolynomial(const int base) const;
   int AsIntFib(const int base) const;
   int AsIntPolynomialCoefficent(const int base) const;
+
+  void SaveCheckpoint(cCheckpointWriter& cp) const;
+  void LoadCheckpoint(cCheckpointReader& cp);
 };
 
 
@@ -33,6 +33,7 @@
 #include "cHardwareTracer.h"
 #include "cInstSet.h"
 #include "cOrganism.h"
+#include "cPhaseProfiler.h"
 #include "cPhenotype.h"
 #include "cPopulation.h"
 #include "cStateGrid.h"
@@ -627,6 +628,7 @@ bool cHardwareBCR::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instructi
   m_organism->GetPhenotype().IncCurInstCount(actual_inst.GetOp());
   
   // And execute it.
+  cInstProfile::cScope inst_profile(m_inst_profile, actual_inst.GetOp());
   const bool exec_success = (this->*(m_functions[inst_idx]))(ctx);
   
   // decremenet if the instruction was not executed successfully
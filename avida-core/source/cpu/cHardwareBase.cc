@@ -26,6 +26,7 @@
 #include "avida/core/WorldDriver.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
 #include "cCodeLabel.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
@@ -47,7 +48,7 @@ using namespace AvidaTools;
 
 
 cHardwareBase::cHardwareBase(cWorld* world, cOrganism* in_organism, cInstSet* inst_set)
-: m_world(world), m_organism(in_organism), m_inst_set(inst_set), m_tracer(NULL)
+: m_world(world), m_organism(in_organism), m_inst_set(inst_set), m_tracer(NULL), m_inst_profile(NULL)
 , m_minitrace(false), m_microtrace(false), m_topnavtrace(false), m_reprotrace(false)
 , m_has_costs(inst_set->HasCosts()), m_has_ft_costs(inst_set->HasFTCosts()) , m_has_energy_costs(m_inst_set->HasEnergyCosts())
 , m_has_res_costs(m_inst_set->HasResCosts()), m_has_fem_res_costs(m_inst_set->HasFemResCosts())
@@ -119,6 +120,20 @@ void cHardwareBase::Reset(cAvidaContext& ctx)
   internalReset();
 }
 
+void cHardwareBase::reinitializeBase(cOrganism* in_organism)
+{
+  // Clear everything a previous organism may have attached to this hardware; Reset() handles the rest
+  assert(in_organism != NULL);
+  m_organism = in_organism;
+  m_tracer = HardwareTracerPtr(NULL);
+  m_minitrace = false;
+  m_microtrace = false;
+  m_topnavtrace = false;
+  m_reprotrace = false;
+  m_task_switching_cost = 0;
+  m_ext_mem.Resize(0);
+}
+
 void cHardwareBase::ResizeCostArrays(int new_size)
 {
   m_active_thread_costs.Resize(new_size);
@@ -127,6 +142,42 @@ void cHardwareBase::ResizeCostArrays(int new_size)
   m_active_thread_post_costs.SetAll(0);
 }
 
+void cHardwareBase::saveBaseCheckpoint(cCheckpointWriter& cp) const
+{
+  cp.Write(m_inst_cost);
+  cp.Write(m_female_cost);
+  cp.WriteArray(m_inst_ft_cost);
+  cp.WriteArray(m_inst_energy_cost);
+  cp.WriteArray(m_inst_res_cost);
+  cp.WriteArray(m_inst_fem_res_cost);
+  cp.WriteArray(m_inst_bonus_cost);
+  cp.WriteArray(m_thread_inst_cost);
+  cp.WriteArray(m_thread_inst_post_cost);
+  cp.WriteArray(m_active_thread_costs);
+  cp.WriteArray(m_active_thread_post_costs);
+  cp.Write(m_task_switching_cost);
+  cp.WriteArray(m_ext_mem);
+  cp.Write(m_implicit_repro_active);
+}
+
+void cHardwareBase::loadBaseCheckpoint(cCheckpointReader& cp)
+{
+  cp.Read(m_inst_cost);
+  cp.Read(m_female_cost);
+  cp.ReadArray(m_inst_ft_cost);
+  cp.ReadArray(m_inst_energy_cost);
+  cp.ReadArray(m_inst_res_cost);
+  cp.ReadArray(m_inst_fem_res_cost);
+  cp.ReadArray(m_inst_bonus_cost);
+  cp.ReadArray(m_thread_inst_cost);
+  cp.ReadArray(m_thread_inst_post_cost);
+  cp.ReadArray(m_active_thread_costs);
+  cp.ReadArray(m_active_thread_post_costs);
+  cp.Read(m_task_switching_cost);
+  cp.ReadArray(m_ext_mem);
+  cp.Read(m_implicit_repro_active);
+}
+
 int cHardwareBase::calcExecutedSize(const int parent_size)
 {
   int executed_size = 0;
@@ -36,9 +36,12 @@
 #include "tBuffer.h"
 
 class cAvidaContext;
+class cCheckpointReader;
+class cCheckpointWriter;
 class cCodeLabel;
 class cCPUMemory;
 class cHeadCPU;
+class cInstProfile;
 class cMutation;
 class cOrganism;
 class cString;
@@ -56,6 +59,7 @@ protected:
   cInstSet* m_inst_set;             // Instruction set being used.
 
   HardwareTracerPtr m_tracer;        // Set this if you want execution traced.
+  cInstProfile* m_inst_profile;      // Set while in a population cell when instructions are profiled.
   Apto::Array<char, Apto::Smart> m_microtracer;
   Apto::Array<int, Apto::Smart> m_navtraceloc;
   Apto::Array<int, Apto::Smart> m_navtracefacing;
@@ -133,6 +137,8 @@ public:
 
   // --------  Core Functionality  --------
   void Reset(cAvidaContext& ctx);
+  //! Rebind pooled hardware to a new organism, reusing existing storage.  Returns false if not supported.
+  virtual bool Reinitialize(cAvidaContext& ctx, cOrganism* in_organism) { (void)ctx; (void)in_organism; return false; }
   virtual bool SingleProcess(cAvidaContext& ctx, bool speculative = false) = 0;
   virtual void ProcessBonusInst(cAvidaContext& ctx, const Instruction& inst) = 0;
 
@@ -146,6 +152,8 @@ public:
   virtual void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp) = 0;
   virtual void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success) = 0;
   void SetTrace(HardwareTracerPtr tracer) { m_tracer = tracer; }
+  void SetInstProfile(cInstProfile* profile) { m_inst_profile = profile; }
+  bool IsTraced() { return (m_tracer || m_minitrace || m_microtrace); }
   void SetMiniTrace(const cString& filename);
   void SetMicroTrace() { m_microtrace = true; } 
   void SetTopNavTrace(bool nav_trace) { m_topnavtrace = nav_trace; }
@@ -228,6 +236,12 @@ public:
   virtual void InheritState(cHardwareBase&) { ; }
   
   
+  // --------  Checkpointing  --------
+  // Hardware types that can be checkpointed override these; the defaults report the state as unsupported
+  virtual bool SaveCheckpoint(cCheckpointWriter&) const { return false; }
+  virtual bool LoadCheckpoint(cCheckpointReader&) { return false; }
+  
+  
   // --------  Alarm  --------
   virtual bool Jump_To_Alarm_Label(int) { return false; }
   
@@ -244,6 +258,8 @@ public:
   
 protected:
   void ResizeCostArrays(int new_size);
+  void saveBaseCheckpoint(cCheckpointWriter& cp) const;
+  void loadBaseCheckpoint(cCheckpointReader& cp);
 
   // --------  Core Execution Methods  --------
   bool SingleProcess_PayPreCosts(cAvidaContext& ctx, const Instruction& cur_inst, const int thread_id);
@@ -252,6 +268,7 @@ protected:
   bool IsPayingActiveCost(cAvidaContext& ctx, const int thread_id);
   virtual void internalReset() = 0;
 	virtual void internalResetOnFailedDivide() = 0;
+  void reinitializeBase(cOrganism* in_organism);
   
   
   // --------  No-Operation Instruction  --------
@@ -29,6 +29,7 @@
 #include "avida/private/systematics/SexualAncestry.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
 #include "cHardwareManager.h"
@@ -36,6 +37,7 @@
 #include "cInstSet.h"
 #include "cOrganism.h"
 #include "cOrgMessage.h"
+#include "cPhaseProfiler.h"
 #include "cPhenotype.h"
 #include "cPopulation.h"
 #include "cPopulationCell.h"
@@ -780,16 +782,33 @@ cHardwareCPU::cHardwareCPU(cAvidaContext& ctx, cWorld* world, cOrganism* in_orga
   
   m_slip_read_head = !m_world->GetConfig().SLIP_COPY_MODE.Get();
   
-  // Initialize memory...
-  const Genome& in_genome = in_organism->GetGenome();
-  ConstInstructionSequencePtr in_seq_p;
-  in_seq_p.DynamicCastFrom(in_genome.Representation());
-  m_memory = *in_seq_p;
+  loadMemory(in_organism->GetGenome());  // Initialize memory...
   
   Reset(ctx);                            // Setup the rest of the hardware...
   internalReset();
 }
 
+bool cHardwareCPU::Reinitialize(cAvidaContext& ctx, cOrganism* in_organism)
+{
+  // Configuration settings depend only on the world, which is unchanged
+  reinitializeBase(in_organism);
+  
+  m_spec_die = false;
+  m_epigenetic_state = false;
+  
+  loadMemory(in_organism->GetGenome());
+  
+  Reset(ctx);
+  return true;
+}
+
+void cHardwareCPU::loadMemory(const Genome& genome)
+{
+  ConstInstructionSequencePtr in_seq_p;
+  in_seq_p.DynamicCastFrom(genome.Representation());
+  m_memory = *in_seq_p;
+}
+
 bool cHardwareCPU::checkNoMutList(cHeadCPU to)
 {
     //Anya's code for head to head experiments
@@ -895,13 +914,134 @@ void cHardwareCPU::cLocalThread::Reset(cHardwareBase* in_hardware, int in_id)
     
 }
 
+void cHardwareCPU::cLocalThread::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  cp.Write(m_id);
+  cp.Write(m_promoter_inst_executed);
+  cp.Write(m_messageTriggerType);
+  for (int i = 0; i < NUM_REGISTERS; i++) cp.Write(reg[i]);
+  for (int i = 0; i < NUM_HEADS; i++) {
+    cp.Write(heads[i].GetPosition());
+    cp.Write(heads[i].GetMemSpace());
+  }
+  stack.SaveCheckpoint(cp);
+  cp.Write(cur_stack);
+  cp.Write(cur_head);
+  read_label.SaveCheckpoint(cp);
+  next_label.SaveCheckpoint(cp);
+}
+
+void cHardwareCPU::cLocalThread::LoadCheckpoint(cCheckpointReader& cp, cHardwareBase* in_hardware)
+{
+  // Heads are adjusted against the hardware memory, which must already be restored
+  Reset(in_hardware, -1);
+  cp.Read(m_id);
+  cp.Read(m_promoter_inst_executed);
+  cp.Read(m_messageTriggerType);
+  for (int i = 0; i < NUM_REGISTERS; i++) cp.Read(reg[i]);
+  for (int i = 0; i < NUM_HEADS; i++) {
+    const int pos = cp.Read<int>();
+    const int ms = cp.Read<int>();
+    if (cp.Good()) heads[i].Set(pos, ms);
+  }
+  stack.LoadCheckpoint(cp);
+  cp.Read(cur_stack);
+  cp.Read(cur_head);
+  read_label.LoadCheckpoint(cp);
+  next_label.LoadCheckpoint(cp);
+  if (cur_head >= NUM_HEADS) cp.Invalidate();
+}
+
+bool cHardwareCPU::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  saveBaseCheckpoint(cp);
+  
+  m_memory.SaveCheckpoint(cp);
+  m_global_stack.SaveCheckpoint(cp);
+  
+  cp.Write(m_threads.GetSize());
+  for (int i = 0; i < m_threads.GetSize(); i++) m_threads[i].SaveCheckpoint(cp);
+  cp.Write(m_thread_id_chart);
+  cp.Write(m_cur_thread);
+  
+  cp.Write(static_cast<bool>(m_mal_active));
+  cp.Write(static_cast<bool>(m_advance_ip));
+  cp.Write(static_cast<bool>(m_executedmatchstrings));
+  cp.Write(static_cast<bool>(m_spec_die));
+  
+  cp.Write(m_promoter_index);
+  cp.Write(m_promoter_offset);
+  cp.Write(m_promoters.GetSize());
+  for (int i = 0; i < m_promoters.GetSize(); i++) {
+    cp.Write(m_promoters[i].m_pos);
+    cp.Write(m_promoters[i].m_bit_code);
+    cp.Write(m_promoters[i].m_regulation);
+  }
+  
+  cp.Write(m_epigenetic_state);
+  for (int i = 0; i < NUM_REGISTERS; i++) cp.Write(m_epigenetic_saved_reg[i]);
+  m_epigenetic_saved_stack.SaveCheckpoint(cp);
+  
+  cp.Write(m_last_cell_data.first);
+  cp.Write(m_last_cell_data.second);
+  cp.Write(m_flash_info.first);
+  cp.Write(m_flash_info.second);
+  cp.Write(m_cycle_counter);
+  
+  return cp.Good();
+}
+
+bool cHardwareCPU::LoadCheckpoint(cCheckpointReader& cp)
+{
+  loadBaseCheckpoint(cp);
+  
+  m_memory.LoadCheckpoint(cp);
+  m_global_stack.LoadCheckpoint(cp);
+  
+  const int num_threads = cp.Read<int>();
+  if (!cp.Good() || num_threads < 1) return false;
+  m_threads.Resize(num_threads);
+  for (int i = 0; i < num_threads; i++) m_threads[i].LoadCheckpoint(cp, this);
+  cp.Read(m_thread_id_chart);
+  cp.Read(m_cur_thread);
+  if (m_cur_thread < 0 || m_cur_thread >= num_threads) return false;
+  
+  m_mal_active = cp.Read<bool>();
+  m_advance_ip = cp.Read<bool>();
+  m_executedmatchstrings = cp.Read<bool>();
+  m_spec_die = cp.Read<bool>();
+  
+  cp.Read(m_promoter_index);
+  cp.Read(m_promoter_offset);
+  const int num_promoters = cp.Read<int>();
+  if (!cp.Good() || num_promoters < 0) return false;
+  m_promoters.Resize(num_promoters);
+  for (int i = 0; i < num_promoters; i++) {
+    cp.Read(m_promoters[i].m_pos);
+    cp.Read(m_promoters[i].m_bit_code);
+    cp.Read(m_promoters[i].m_regulation);
+  }
+  
+  cp.Read(m_epigenetic_state);
+  for (int i = 0; i < NUM_REGISTERS; i++) cp.Read(m_epigenetic_saved_reg[i]);
+  m_epigenetic_saved_stack.LoadCheckpoint(cp);
+  
+  cp.Read(m_last_cell_data.first);
+  cp.Read(m_last_cell_data.second);
+  cp.Read(m_flash_info.first);
+  cp.Read(m_flash_info.second);
+  cp.Read(m_cycle_counter);
+  
+  return cp.Good();
+}
+
 void cHardwareCPU::SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype) { (void)df, (void)gen_id, (void)genotype; }
 
 
 // This function processes the very next command in the genome, and is made
 // to be as optimized as possible.  This is the heart of avida.
 
-bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
+template <bool PROMOTERS> bool cHardwareCPU::singleProcess(cAvidaContext& ctx, bool speculative)
 {
   assert(!speculative || (speculative && !m_thread_slicing_parallel));
   
@@ -919,11 +1059,11 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
   cPhenotype& phenotype = m_organism->GetPhenotype();
   
   // First instruction - check whether we should be starting at a promoter, when enabled.
-  if (phenotype.GetCPUCyclesUsed() == 0 && m_promoters_enabled) Inst_Terminate(ctx);
+  if (PROMOTERS && phenotype.GetCPUCyclesUsed() == 0) Inst_Terminate(ctx);
   
   // Count the cpu cycles used
   phenotype.IncCPUCyclesUsed();
-  if (!m_world->GetConfig().NO_CPU_CYCLE_TIME.Get()) phenotype.IncTimeUsed();
+  if (!m_no_cpu_cycle_time) phenotype.IncTimeUsed();
   
   int num_threads = m_threads.GetSize();
   
@@ -953,8 +1093,9 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
     
     // Find the instruction to be executed
     const Instruction cur_inst = ip.GetInst();
+    const cInstSet::sDispatchEntry& decoded = m_inst_set->GetDispatchEntry(cur_inst);
     
-    if (speculative && (m_spec_die || m_inst_set->ShouldStall(cur_inst))) {
+    if (speculative && (m_spec_die || decoded.stall)) {
       // Speculative instruction reject, flush and return
       m_cur_thread = last_thread;
       phenotype.DecCPUCyclesUsed();
@@ -971,18 +1112,18 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
     if (m_constitutive_regulation) Inst_SenseRegulate(ctx); 
     
     // If there are no active promoters and a certain mode is set, then don't execute any further instructions
-    if (m_promoters_enabled && m_world->GetConfig().NO_ACTIVE_PROMOTER_EFFECT.Get() == 2 && m_promoter_index == -1) exec = false;
+    if (PROMOTERS && m_world->GetConfig().NO_ACTIVE_PROMOTER_EFFECT.Get() == 2 && m_promoter_index == -1) exec = false;
     
     // Now execute the instruction...
     if (exec == true) {
       // NOTE: This call based on the cur_inst must occur prior to instruction
       //       execution, because this instruction reference may be invalid after
       //       certain classes of instructions (namely divide instructions) @DMB
-      const int time_cost = m_inst_set->GetAddlTimeCost(cur_inst);
+      const int time_cost = decoded.addl_time_cost;
       
       // Prob of exec (moved from SingleProcess_PayCosts so that we advance IP after a fail)
-      if (m_inst_set->GetProbFail(cur_inst) > 0.0) {
-        exec = !( ctx.GetRandom().P(m_inst_set->GetProbFail(cur_inst)) );
+      if (decoded.prob_fail > 0.0) {
+        exec = !( ctx.GetRandom().P(decoded.prob_fail) );
       }
       
       // Flag instruction as executed even if it failed (moved from SingleProcess_ExecuteInst)
@@ -992,7 +1133,7 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
       getIP().SetFlagExecuted();
       
       // Add to the promoter inst executed count before executing the inst (in case it is a terminator)
-      if (m_promoters_enabled) m_threads[m_cur_thread].IncPromoterInstExecuted();
+      if (PROMOTERS) m_threads[m_cur_thread].IncPromoterInstExecuted();
       
       if (exec == true) {
         if (SingleProcess_ExecuteInst(ctx, cur_inst)) { 
@@ -1012,7 +1153,7 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
       phenotype.IncTimeUsed(time_cost);
       
       // In the promoter model, we may force termination after a certain number of inst have been executed
-      if (m_promoters_enabled) {
+      if (PROMOTERS) {
         const double processivity = m_world->GetConfig().PROMOTER_PROCESSIVITY.Get();
         if (ctx.GetRandom().P(1 - processivity)) Inst_Terminate(ctx);
         if (m_world->GetConfig().PROMOTER_INST_MAX.Get() && (m_threads[m_cur_thread].GetPromoterInstExecuted() >= m_world->GetConfig().PROMOTER_INST_MAX.Get())) 
@@ -1053,6 +1194,14 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
   return !m_spec_die;
 }
 
+bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
+{
+  // Select the execution loop specialized for the promoter model setting of this organism
+  if (m_promoters_enabled) return singleProcess<true>(ctx, speculative);
+  return singleProcess<false>(ctx, speculative);
+}
+
+
 // This method will handle the actual execution of an instruction
 // within a single process, once that function has been finalized.
 bool cHardwareCPU::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst) 
@@ -1061,13 +1210,14 @@ bool cHardwareCPU::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instructi
   Instruction actual_inst = cur_inst;
   
   // Get a pointer to the corresponding method...
-  int inst_idx = m_inst_set->GetLibFunctionIndex(actual_inst);
+  const tMethod handler = m_functions[m_inst_set->GetDispatchEntry(actual_inst).lib_fun_id];
   
   // instruction execution count incremented
   m_organism->GetPhenotype().IncCurInstCount(actual_inst.GetOp());
 	
   // And execute it.
-  const bool exec_success = (this->*(m_functions[inst_idx]))(ctx);
+  cInstProfile::cScope inst_profile(m_inst_profile, actual_inst.GetOp());
+  const bool exec_success = (this->*handler)(ctx);
   
   // NOTE: Organism may be dead now if instruction executed killed it (such as some divides, "die", or "explode")
   
@@ -1211,161 +1361,107 @@ cHeadCPU cHardwareCPU::FindLabel(int direction)
 // Search forwards for search_label from _after_ position pos in the
 // memory.  Return the first line _after_ the the found label.  It is okay
 // to find search label's match inside another label.
+//
+// Only the memory's indexed nop runs are examined.  A run can hold the label
+// only if it is at least as long as the label (after clipping it to start no
+// earlier than pos) and extends past pos + label size; these are exactly the
+// runs the original block-stepping scan would reach.  The range that scan would
+// have read is reported to the memory's touch log.
 
 int cHardwareCPU::FindLabel_Forward(const cCodeLabel & search_label,
-                                    const InstructionSequence & search_genome, int pos)
+                                    const cCPUMemory & search_genome, int pos)
 {
   assert (pos < search_genome.GetSize() && pos >= 0);
   
-  int search_start = pos;
-  int label_size = search_label.GetSize();
-  bool found_label = false;
+  const int search_start = pos;
+  const int label_size = search_label.GetSize();
+  const int first_probe = pos + label_size;  // Move off the template we are on.
   
-  // Move off the template we are on.
-  pos += label_size;
+  const Apto::Array<cCPUMemory::sNopRun, Apto::Smart>& runs = search_genome.GetNopRuns(*m_inst_set);
   
-  // Search until we find the complement or exit the memory.
-  while (pos < search_genome.GetSize()) {
-    
-    // If we are within a label, rewind to the beginning of it and see if
-    // it has the proper sub-label that we're looking for.
+  // Binary search for the first run that ends after the first probe position.
+  int lo = 0;
+  int hi = runs.GetSize();
+  while (lo < hi) {
+    const int mid = (lo + hi) / 2;
+    if (runs[mid].end > first_probe) hi = mid;
+    else lo = mid + 1;
+  }
+  
+  for (int r = lo; r < runs.GetSize(); r++) {
+    const int start_pos = (runs[r].start > search_start) ? runs[r].start : search_start;
+    const int end_pos = runs[r].end;
     
-    if (m_inst_set->IsNop(search_genome[pos])) {
-      // Find the start and end of the label we're in the middle of.
-      
-      int start_pos = pos;
-      int end_pos = pos + 1;
-      while (start_pos > search_start &&
-             m_inst_set->IsNop( search_genome[start_pos - 1] )) {
-        start_pos--;
+    // See if this label has the proper sub-label within it.
+    for (int offset = start_pos; offset + label_size <= end_pos; offset++) {
+      int matches;
+      for (matches = 0; matches < label_size; matches++) {
+        if (search_label[matches] != m_inst_set->GetNopMod(search_genome[offset + matches])) break;
       }
-      while (end_pos < search_genome.GetSize() &&
-             m_inst_set->IsNop( search_genome[end_pos] )) {
-        end_pos++;
-      }
-      int test_size = end_pos - start_pos;
-      
-      // See if this label has the proper sub-label within it.
-      int max_offset = test_size - label_size + 1;
-      int offset = start_pos;
-      for (offset = start_pos; offset < start_pos + max_offset; offset++) {
-        
-        // Test the number of matches for this offset.
-        int matches;
-        for (matches = 0; matches < label_size; matches++) {
-          if (search_label[matches] !=
-              m_inst_set->GetNopMod( search_genome[offset + matches] )) {
-            break;
-          }
-        }
-        
-        // If we have found it, break out of this loop!
-        if (matches == label_size) {
-          found_label = true;
-          break;
-        }
-      }
-      
-      // If we've found the complement label, set the position to the end of
-      // the label we found it in, and break out.
       
-      if (found_label == true) {
-        // pos = end_pos;
-        pos = label_size + offset;
-        break;
+      // If we've found the complement label, return the position just after it.
+      if (matches == label_size) {
+        search_genome.NoteRead(search_start, label_size + offset);
+        return label_size + offset;
       }
-      
-      // We haven't found it; jump pos to just after the current label being
-      // checked.
-      pos = end_pos;
     }
-    
-    // Jump up a block to the next possible point to find a label,
-    pos += label_size;
   }
   
-  // If the label was not found return a -1.
-  if (found_label == false) pos = -1;
-  
-  return pos;
+  // The label was not found.
+  search_genome.NoteRead(search_start, search_genome.GetSize());
+  return -1;
 }
 
 // Search backwards for search_label from _before_ position pos in the
 // memory.  Return the first line _after_ the the found label.  It is okay
 // to find search label's match inside another label.
+//
+// As with FindLabel_Forward, only indexed nop runs are examined: those that
+// start at or before pos - label size, with their ends clipped to pos.
 
 int cHardwareCPU::FindLabel_Backward(const cCodeLabel & search_label,
-                                     const InstructionSequence & search_genome, int pos)
+                                     const cCPUMemory & search_genome, int pos)
 {
   assert (pos < search_genome.GetSize());
   
-  int search_start = pos;
-  int label_size = search_label.GetSize();
-  bool found_label = false;
+  const int search_start = pos;
+  const int label_size = search_label.GetSize();
+  const int first_probe = pos - label_size;  // Move off the template we are on.
+  if (first_probe < 0) return -1;
+  
+  const Apto::Array<cCPUMemory::sNopRun, Apto::Smart>& runs = search_genome.GetNopRuns(*m_inst_set);
   
-  // Move off the template we are on.
-  pos -= label_size;
+  // Binary search for the last run that starts at or before the first probe position.
+  int lo = 0;
+  int hi = runs.GetSize();
+  while (lo < hi) {
+    const int mid = (lo + hi) / 2;
+    if (runs[mid].start <= first_probe) lo = mid + 1;
+    else hi = mid;
+  }
   
-  // Search until we find the complement or exit the memory.
-  while (pos >= 0) {
-    // If we are within a label, rewind to the beginning of it and see if
-    // it has the proper sub-label that we're looking for.
+  for (int r = lo - 1; r >= 0; r--) {
+    const int start_pos = runs[r].start;
+    const int end_pos = (runs[r].end < search_start) ? runs[r].end : search_start;
     
-    if (m_inst_set->IsNop( search_genome[pos] )) {
-      // Find the start and end of the label we're in the middle of.
-      
-      int start_pos = pos;
-      int end_pos = pos + 1;
-      while (start_pos > 0 && m_inst_set->IsNop(search_genome[start_pos - 1])) {
-        start_pos--;
-      }
-      while (end_pos < search_start &&
-             m_inst_set->IsNop(search_genome[end_pos])) {
-        end_pos++;
+    // See if this label has the proper sub-label within it.
+    for (int offset = start_pos; offset + label_size <= end_pos; offset++) {
+      int matches;
+      for (matches = 0; matches < label_size; matches++) {
+        if (search_label[matches] != m_inst_set->GetNopMod(search_genome[offset + matches])) break;
       }
-      int test_size = end_pos - start_pos;
       
-      // See if this label has the proper sub-label within it.
-      int max_offset = test_size - label_size + 1;
-      for (int offset = start_pos; offset < start_pos + max_offset; offset++) {
-        
-        // Test the number of matches for this offset.
-        int matches;
-        for (matches = 0; matches < label_size; matches++) {
-          if (search_label[matches] !=
-              m_inst_set->GetNopMod(search_genome[offset + matches])) {
-            break;
-          }
-        }
-        
-        // If we have found it, break out of this loop!
-        if (matches == label_size) {
-          found_label = true;
-          break;
-        }
+      // If we've found the complement label, return the end of the label we found it in.
+      if (matches == label_size) {
+        search_genome.NoteRead(start_pos - 1, search_start);
+        return end_pos;
       }
-      
-      // If we've found the complement label, set the position to the end of
-      // the label we found it in, and break out.
-      
-      if (found_label == true) {
-        pos = end_pos;
-        break;
-      }
-      
-      // We haven't found it; jump pos to just before the current label
-      // being checked.
-      pos = start_pos - 1;
     }
-    
-    // Jump up a block to the next possible point to find a label,
-    pos -= label_size;
   }
   
-  // If the label was not found return a -1.
-  if (found_label == false) pos = -1;
-  
-  return pos;
+  // The label was not found.
+  search_genome.NoteRead(0, search_start);
+  return -1;
 }
 
 // Search for 'in_label' anywhere in the hardware.
@@ -1785,7 +1881,7 @@ bool cHardwareCPU::Divide_Main(cAvidaContext& ctx, const int div_point,
   Genome offspring(GetType(), props, offspring_seq);
     
   // Make sure it is an exact copy at this point (before divide mutations) if required
-  const Genome& base_genome = m_organism->GetGenome();
+  const Genome& base_genome = readOwnGenome();
   ConstInstructionSequencePtr seq_p;
   seq_p.DynamicCastFrom(base_genome.Representation());
   const InstructionSequence& seq = *seq_p;
@@ -3368,12 +3464,12 @@ bool cHardwareCPU::Inst_Repro(cAvidaContext& ctx)
   }
   
   // Setup child
-  m_organism->OffspringGenome() = m_organism->GetGenome();
+  m_organism->OffspringGenome() = readOwnGenome();
   InstructionSequencePtr offspring_seq;
   offspring_seq.DynamicCastFrom(m_organism->OffspringGenome().Representation());
 
   ConstInstructionSequencePtr org_seq;
-  org_seq.DynamicCastFrom(m_organism->GetGenome().Representation());
+  org_seq.DynamicCastFrom(readOwnGenome().Representation());
   
   // Do transposon movement and copying before other mutations
   Divide_DoTransposons(ctx);
@@ -3487,7 +3583,7 @@ bool cHardwareCPU::Inst_SpawnDeme(cAvidaContext& ctx)
 
 bool cHardwareCPU::Inst_SenseQuorum(cAvidaContext& ctx) {
   int cellID = m_organism->GetCellID();
-  Apto::String ref_genome = m_organism->GetGenome().Representation()->AsString();
+  Apto::String ref_genome = readOwnGenome().Representation()->AsString();
   int radius = m_world->GetConfig().KABOOM_RADIUS.Get();
   int distance = m_world->GetConfig().KABOOM_HAMMING.Get();
 
@@ -3559,7 +3655,7 @@ bool cHardwareCPU::Inst_SenseQuorum(cAvidaContext& ctx) {
 
 bool cHardwareCPU::Inst_NoisyQuorum(cAvidaContext& ctx) {
   int cellID = m_organism->GetCellID();
-  Apto::String ref_genome = m_organism->GetGenome().Representation()->AsString();
+  Apto::String ref_genome = readOwnGenome().Representation()->AsString();
   int radius = m_world->GetConfig().KABOOM_RADIUS.Get();
   int distance = m_world->GetConfig().KABOOM_HAMMING.Get();
   
@@ -4982,7 +5078,7 @@ bool cHardwareCPU::Inst_DonateEditDist(cAvidaContext& ctx)
       neighbor = m_organism->GetNeighbor();
       int edit_dist = max_dist + 1;
       if (neighbor != NULL) {
-        const Genome& org_genome = m_organism->GetGenome();
+        const Genome& org_genome = readOwnGenome();
         ConstInstructionSequencePtr org_seq_p;
         org_seq_p.DynamicCastFrom(org_genome.Representation());
         const InstructionSequence& org_seq = *org_seq_p;
@@ -4998,7 +5094,7 @@ bool cHardwareCPU::Inst_DonateEditDist(cAvidaContext& ctx)
         found = true;
 				
         // Code to track the edit distance between edt donors and recipients
-        const Genome& org_genome = m_organism->GetGenome();
+        const Genome& org_genome = readOwnGenome();
         ConstInstructionSequencePtr org_seq_p;
         org_seq_p.DynamicCastFrom(org_genome.Representation());
         const InstructionSequence& org_seq = *org_seq_p;
@@ -5058,7 +5154,7 @@ bool cHardwareCPU::Inst_GetFacedEditDistance(cAvidaContext& ctx)
   cOrganism* target = NULL;
   target = m_organism->GetOrgInterface().GetNeighbor();
 
-  const Genome& org_genome = m_organism->GetGenome();
+  const Genome& org_genome = readOwnGenome();
   ConstInstructionSequencePtr org_seq_p;
   org_seq_p.DynamicCastFrom(org_genome.Representation());
   const InstructionSequence& org_seq = *org_seq_p;
@@ -5217,7 +5313,7 @@ bool cHardwareCPU::Inst_DonateShadedGreenBeard(cAvidaContext& ctx)
       //			if (neighbor_shade_of_gb >=  shade_of_gb) {
       if (neighbor_shade_of_gb ==  shade_of_gb) {	
         // Code to track the edit distance between shaded donors and recipients
-        const Genome& org_genome = m_organism->GetGenome();
+        const Genome& org_genome = readOwnGenome();
         ConstInstructionSequencePtr org_seq_p;
         org_seq_p.DynamicCastFrom(org_genome.Representation());
         const InstructionSequence& org_seq = *org_seq_p;
@@ -5411,7 +5507,7 @@ bool cHardwareCPU::Inst_DonateThreshGreenBeard(cAvidaContext& ctx)
       }
 			
       if (neighbor_thresh_of_gb >= m_world->GetConfig().MIN_GB_DONATE_THRESHOLD.Get() ) {
-        const Genome& org_gen = m_organism->GetGenome();
+        const Genome& org_gen = readOwnGenome();
         ConstInstructionSequencePtr org_seq_p;
         org_seq_p.DynamicCastFrom(org_gen.Representation());
         const InstructionSequence& org_seq = *org_seq_p;
@@ -6150,7 +6246,7 @@ bool cHardwareCPU::Inst_DonateSpecific(cAvidaContext& ctx)
       m_organism->GetPhenotype().SetIsDonorEdit();
       target->GetPhenotype().SetIsReceiverEdit();
       
-      const Genome& org_genome = m_organism->GetGenome();
+      const Genome& org_genome = readOwnGenome();
       ConstInstructionSequencePtr org_seq_p;
       org_seq_p.DynamicCastFrom(org_genome.Representation());
       const InstructionSequence& org_seq = *org_seq_p;
@@ -94,6 +94,9 @@ protected:
     void ResetPromoterInstExecuted() { m_promoter_inst_executed = 0; }
     void setMessageTriggerType(int value) { m_messageTriggerType = value; }
     int getMessageTriggerType() { return m_messageTriggerType; }
+
+    void SaveCheckpoint(cCheckpointWriter& cp) const;
+    void LoadCheckpoint(cCheckpointReader& cp, cHardwareBase* in_hardware);
   };
 
 
@@ -153,6 +156,12 @@ protected:
   // Epigenetic State -->
 
 
+  void loadMemory(const Genome& genome);
+  
+  // Instructions that inspect the organism's genome directly, rather than through memory, read it here so that the read
+  // is reported to the memory's touch log.
+  inline const Genome& readOwnGenome() { m_memory.NoteReadAll(); return m_organism->GetGenome(); }
+  template <bool PROMOTERS> bool singleProcess(cAvidaContext& ctx, bool speculative);
   bool SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst);
   
   // --------  Stack Manipulation...  --------
@@ -173,8 +182,8 @@ protected:
   cCodeLabel& GetLabel() { return m_threads[m_cur_thread].next_label; }
   void ReadLabel(int max_size=cCodeLabel::MAX_LENGTH);
   cHeadCPU FindLabel(int direction);
-  int FindLabel_Forward(const cCodeLabel & search_label, const InstructionSequence& search_genome, int pos);
-  int FindLabel_Backward(const cCodeLabel & search_label, const InstructionSequence& search_genome, int pos);
+  int FindLabel_Forward(const cCodeLabel & search_label, const cCPUMemory& search_genome, int pos);
+  int FindLabel_Backward(const cCodeLabel & search_label, const cCPUMemory& search_genome, int pos);
   cHeadCPU FindLabel(const cCodeLabel & in_label, int direction);
   void FindLabelInMemory(const cCodeLabel& label, cHeadCPU& search_head);
 
@@ -243,6 +252,7 @@ public:
 
   bool SingleProcess(cAvidaContext& ctx, bool speculative = false);
   void ProcessBonusInst(cAvidaContext& ctx, const Instruction& inst);
+  bool Reinitialize(cAvidaContext& ctx, cOrganism* in_organism);
 
 
   // --------  Helper methods  --------
@@ -253,6 +263,10 @@ public:
   void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp) { (void)ctx, (void)fp; }
   void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success) { (void)fp, (void)exec_success; }
 
+  // --------  Checkpointing  --------
+  bool SaveCheckpoint(cCheckpointWriter& cp) const;
+  bool LoadCheckpoint(cCheckpointReader& cp);
+
   // --------  Stack Manipulation...  --------
   inline int GetStack(int depth=0, int stack_id=-1, int in_thread=-1) const;
   inline int GetCurStack(int in_thread = -1) const;
@@ -34,6 +34,7 @@
 #include "cHardwareTracer.h"
 #include "cInstSet.h"
 #include "cOrganism.h"
+#include "cPhaseProfiler.h"
 #include "cPhenotype.h"
 #include "cPopulation.h"
 #include "cStateGrid.h"
@@ -754,6 +755,7 @@ bool cHardwareExperimental::SingleProcess_ExecuteInst(cAvidaContext& ctx, const
   // And execute it.
   m_from_sensor = false;
   m_from_message = false;
+  cInstProfile::cScope inst_profile(m_inst_profile, actual_inst.GetOp());
   const bool exec_success = (this->*(m_functions[inst_idx]))(ctx);
   
 	if (exec_success) {
@@ -973,38 +975,34 @@ cHeadCPU cHardwareExperimental::FindLabelStart(bool mark_executed)
   // Make sure the label is of size > 0.
   if (search_label.GetSize() == 0) return ip;
   
-  cCPUMemory& memory = m_memory;
-  int pos = 0;
+  const cCPUMemory& memory = m_memory;
   
-  while (pos < memory.GetSize()) {
-    if (m_inst_set->IsLabel(memory[pos])) { // starting label found
+  // Only positions holding a 'label' instruction can start a match, so just visit those
+  const Apto::Array<int, Apto::Smart>& label_sites = memory.GetLabelSites(*m_inst_set);
+  for (int site = 0; site < label_sites.GetSize(); site++) {
+    int pos = label_sites[site] + 1;
+    
+    // Check for direct matched label pattern, can be substring of 'label'ed target
+    // - must match all NOPs in search_label
+    // - extra NOPs in 'label'ed target are ignored
+    int size_matched = 0;
+    while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
+      if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
+      size_matched++;
       pos++;
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
-        if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        // Return Head pointed at last NOP of label sequence
-        if (mark_executed) {
-          size_matched++; // Increment size matched so that it includes the label instruction
-          const int start = pos - size_matched;
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
-        }
-        return cHeadCPU(this, pos - 1, ip.GetMemSpace());
+    }
+    
+    // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
+    if (size_matched == search_label.GetSize()) {
+      // Return Head pointed at last NOP of label sequence
+      if (mark_executed) {
+        size_matched++; // Increment size matched so that it includes the label instruction
+        const int start = pos - size_matched;
+        const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+        for (int i = 0; i < size_matched && i < max; i++) m_memory.SetFlagExecuted(start + i);
       }
-      
-      continue; 
+      return cHeadCPU(this, pos - 1, ip.GetMemSpace());
     }
-    pos++;
   }
   
   // Return start point if not found
@@ -1062,42 +1060,53 @@ cHeadCPU cHardwareExperimental::FindLabelForward(bool mark_executed)
   // Make sure the label is of size > 0.
   if (search_label.GetSize() == 0) return ip;
   
-  cHeadCPU pos(ip);
-  pos++;
+  // Visit the 'label' instructions in order, wrapping around, starting with the first one after the IP
+  const Apto::Array<int, Apto::Smart>& label_sites = m_memory.GetLabelSites(*m_inst_set);
+  const int num_sites = label_sites.GetSize();
+  const int ip_pos = ip.GetPosition();
   
-  while (pos.GetPosition() != ip.GetPosition()) {
-    if (m_inst_set->IsLabel(pos.GetInst())) { // starting label found
-      const int label_start = pos.GetPosition();
+  int first_site = 0;
+  int hi = num_sites;
+  while (first_site < hi) {
+    const int mid = (first_site + hi) / 2;
+    if (label_sites[mid] > ip_pos) hi = mid;
+    else first_site = mid + 1;
+  }
+  
+  for (int site = 0; site < num_sites; site++) {
+    const int label_start = label_sites[(first_site + site) % num_sites];
+    if (label_start == ip_pos) break; // searched all the way around
+    
+    cHeadCPU pos(this, label_start, ip.GetMemSpace());
+    pos++;
+    
+    // Check for direct matched label pattern, can be substring of 'label'ed target
+    // - must match all NOPs in search_label
+    // - extra NOPs in 'label'ed target are ignored
+    int size_matched = 0;
+    while (size_matched < search_label.GetSize() && pos.GetPosition() != ip_pos) {
+      if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
+      size_matched++;
       pos++;
+    }
+    
+    // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
+    if (size_matched == search_label.GetSize()) {
+      pos--;
+      const int found_pos = pos.GetPosition();
       
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos.GetPosition() != ip.GetPosition()) {
-        if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
-        size_matched++;
-        pos++;
+      if (mark_executed) {
+        pos.Set(label_start);
+        const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+        for (int i = 0; i < size_matched && i < max; i++, pos++) pos.SetFlagExecuted();
       }
       
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        pos--;
-        const int found_pos = pos.GetPosition();
-        
-        if (mark_executed) {
-          pos.Set(label_start);
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++, pos++) pos.SetFlagExecuted();
-        }
-        
-        // Return Head pointed at last NOP of label sequence
-        return cHeadCPU(this, found_pos, ip.GetMemSpace());
-      }
-      
-      continue; 
+      // Return Head pointed at last NOP of label sequence
+      return cHeadCPU(this, found_pos, ip.GetMemSpace());
     }
-    pos++;
+    
+    // The match ran into the IP, so the search has come all the way around
+    if (pos.GetPosition() == ip_pos) break;
   }
   
   // Return start point if not found
@@ -41,9 +41,14 @@
 using namespace Avida;
 
 static const Apto::BasicString<Apto::ThreadSafe> s_prop_id_instset("instset");
+static const PropertyAtom s_prop_atom_instset = PropertyAtoms::Intern(s_prop_id_instset);
 
 cHardwareManager::cHardwareManager(cWorld* world)
 : m_world(world)
+, m_test_cache(world->GetConfig().TEST_CPU_CACHE_SIZE.Get())
+, m_pool_capacity((world->GetConfig().HARDWARE_POOL_SIZE.Get() > 0) ? world->GetConfig().HARDWARE_POOL_SIZE.Get() : 0)
+, m_pool_hits(0)
+, m_pool_misses(0)
 {
   cString filename = world->GetConfig().INST_SET.Get();
   m_is_name_map.Set("(default)", 0);
@@ -52,6 +57,9 @@ cHardwareManager::cHardwareManager(cWorld* world)
 
 cHardwareManager::~cHardwareManager()
 {
+  for (int i = 0; i < m_hw_pool.GetSize(); i++) {
+    for (int j = 0; j < m_hw_pool[i].GetSize(); j++) delete m_hw_pool[i][j];
+  }
   for (int i = 0; i < m_inst_sets.GetSize(); i++) delete m_inst_sets[i];
 }
 
@@ -150,6 +158,7 @@ bool cHardwareManager::loadInstSet(int hw_type, const Apto::String& name, int st
   
   int inst_set_id = m_inst_sets.GetSize();
   m_inst_sets.Push(inst_set);
+  m_is_names.Push(name);
   m_is_name_map.Set(name, inst_set_id);
   
   Apto::Array<cString> names(inst_set->GetSize());
@@ -241,9 +250,17 @@ cHardwareBase* cHardwareManager::Create(cAvidaContext& ctx, cOrganism* org, cons
 {
   assert(org != NULL);
 	
-  Apto::String inst_set_name = mg.Properties().Get(s_prop_id_instset).StringValue();
+  // Called for every birth; there are only ever a few instruction sets, so a scan beats hashing the name
+  Apto::String inst_set_name = mg.Properties().Get(s_prop_atom_instset).StringValue();
   assert(inst_set_name.GetSize());
-  int inst_set_id = m_is_name_map.GetWithDefault(inst_set_name, -1);
+  int inst_set_id = -1;
+  for (int i = 0; i < m_is_names.GetSize(); i++) {
+    if (m_is_names[i] == inst_set_name) {
+      inst_set_id = i;
+      break;
+    }
+  }
+  if (inst_set_id == -1) inst_set_id = m_is_name_map.GetWithDefault(inst_set_name, -1);
   if (inst_set_id == -1) {
     assert(false);
     return NULL; // No valid instruction set found
@@ -255,7 +272,9 @@ cHardwareBase* cHardwareManager::Create(cAvidaContext& ctx, cOrganism* org, cons
     return NULL; // inst_set/hw_type mismatch
   }
   
-  cHardwareBase* hw = 0;
+  cHardwareBase* hw = reuseHardware(ctx, org, inst_set_id);
+  if (hw) return hw;
+  
   switch (inst_set->GetHardwareType()) {
     case HARDWARE_TYPE_CPU_ORIGINAL:
       hw = new cHardwareCPU(ctx, m_world, org, inst_set);
@@ -282,12 +301,87 @@ cHardwareBase* cHardwareManager::Create(cAvidaContext& ctx, cOrganism* org, cons
   return hw;
 }
 
+cHardwareBase* cHardwareManager::reuseHardware(cAvidaContext& ctx, cOrganism* org, int inst_set_id)
+{
+  if (m_pool_capacity == 0) return NULL;
+  
+  cHardwareBase* hw = NULL;
+  {
+    Apto::MutexAutoLock lock(m_pool_mutex);
+    if (inst_set_id < m_hw_pool.GetSize() && m_hw_pool[inst_set_id].GetSize()) {
+      Apto::Array<cHardwareBase*>& free_list = m_hw_pool[inst_set_id];
+      hw = free_list[free_list.GetSize() - 1];
+      free_list.Resize(free_list.GetSize() - 1);
+      m_pool_hits++;
+    } else {
+      m_pool_misses++;
+    }
+  }
+  
+  // Reinitialize outside of the lock, the hardware now belongs solely to this organism
+  if (hw && !hw->Reinitialize(ctx, org)) {
+    delete hw;
+    hw = NULL;
+  }
+  return hw;
+}
+
+void cHardwareManager::Release(cHardwareBase* hw)
+{
+  if (hw == NULL) return;
+  
+  if (m_pool_capacity > 0) {
+    // Pooled hardware may next be used by a test CPU
+    hw->SetInstProfile(NULL);
+    
+    int inst_set_id = -1;
+    for (int i = 0; i < m_inst_sets.GetSize(); i++) {
+      if (m_inst_sets[i] == &hw->GetInstSet()) {
+        inst_set_id = i;
+        break;
+      }
+    }
+    
+    if (inst_set_id >= 0) {
+      Apto::MutexAutoLock lock(m_pool_mutex);
+      if (m_hw_pool.GetSize() <= inst_set_id) m_hw_pool.Resize(m_inst_sets.GetSize());
+      if (m_hw_pool[inst_set_id].GetSize() < m_pool_capacity) {
+        m_hw_pool[inst_set_id].Push(hw);
+        return;
+      }
+    }
+  }
+  
+  delete hw;
+}
+
+int cHardwareManager::GetPoolSize()
+{
+  Apto::MutexAutoLock lock(m_pool_mutex);
+  int size = 0;
+  for (int i = 0; i < m_hw_pool.GetSize(); i++) size += m_hw_pool[i].GetSize();
+  return size;
+}
+
+int cHardwareManager::GetPoolHits()
+{
+  Apto::MutexAutoLock lock(m_pool_mutex);
+  return m_pool_hits;
+}
+
+int cHardwareManager::GetPoolMisses()
+{
+  Apto::MutexAutoLock lock(m_pool_mutex);
+  return m_pool_misses;
+}
+
 bool cHardwareManager::RegisterInstSet(const Apto::String& name, cInstSet* inst_set)
 {
   if (m_is_name_map.Has(name)) return false;
   
   int inst_set_id = m_inst_sets.GetSize();
   m_inst_sets.Push(inst_set);
+  m_is_names.Push(name);
   m_is_name_map.Set(name, inst_set_id);  
   
   return true;
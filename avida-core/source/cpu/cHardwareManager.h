@@ -22,6 +22,7 @@
 #ifndef cHardwareManager_h
 #define cHardwareManager_h
 
+#include "cCPUTestCache.h"
 #include "cTestCPU.h"
 
 namespace Avida {
@@ -46,6 +47,15 @@ private:
   cWorld* m_world;
   Apto::Array<cInstSet*> m_inst_sets;
   Apto::Map<Apto::String, int> m_is_name_map;
+  Apto::Array<Apto::String> m_is_names;  // name of each entry of m_inst_sets, scanned by Create() before m_is_name_map
+  cCPUTestCache m_test_cache;
+  
+  // Released hardware awaiting reuse, one free list per instruction set
+  const int m_pool_capacity;
+  Apto::Mutex m_pool_mutex;
+  Apto::Array<Apto::Array<cHardwareBase*> > m_hw_pool;
+  int m_pool_hits;
+  int m_pool_misses;
 
   
   cHardwareManager(); // @not_implemented
@@ -65,7 +75,14 @@ public:
   bool ConvertLegacyInstSetFile(cString filename, cStringList& str_list, cUserFeedback* feedback = NULL);
   
   cHardwareBase* Create(cAvidaContext& ctx, cOrganism* org, const Genome& mg);
+  void Release(cHardwareBase* hw);
   inline cTestCPU* CreateTestCPU(cAvidaContext& ctx) { return new cTestCPU(ctx, m_world); }
+  cCPUTestCache& GetTestCache() { return m_test_cache; }
+  
+  int GetPoolCapacity() const { return m_pool_capacity; }
+  int GetPoolSize();
+  int GetPoolHits();
+  int GetPoolMisses();
 
   inline bool IsInstSet(const Apto::String& name) const { return m_is_name_map.Has(name); }
   
@@ -80,6 +97,7 @@ public:
   bool RegisterInstSet(const Apto::String& name, cInstSet* inst_set);
     
 private:
+  cHardwareBase* reuseHardware(cAvidaContext& ctx, cOrganism* org, int inst_set_id);
   bool loadInstSet(int hw_type, const Apto::String& name, int stack_size, int uops_per_cycle, cStringList& sl, cUserFeedback* feedback);
 };
 
@@ -30,6 +30,7 @@
 #include "cHardwareManager.h"
 #include "cHardwareTracer.h"
 #include "cOrganism.h"
+#include "cPhaseProfiler.h"
 #include "cPhenotype.h"
 #include "cTestCPU.h"
 #include "cWorld.h"
@@ -323,6 +324,7 @@ bool cHardwareTransSMT::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Inst
   m_organism->GetPhenotype().IncCurInstCount(actual_inst.GetOp());
 	
   // And execute it.
+  cInstProfile::cScope inst_profile(m_inst_profile, actual_inst.GetOp());
   const bool exec_success = (this->*(m_functions[inst_idx]))(ctx);
 	
   // decremenet if the instruction was not executed successfully
@@ -43,6 +43,7 @@ cInstSet::cInstSet(const cInstSet& _in)
   , m_hw_type(_in.m_hw_type)
   , m_inst_lib(_in.m_inst_lib)
   , m_lib_name_map(_in.m_lib_name_map)
+  , m_dispatch(_in.m_dispatch)
   , m_mutation_index(NULL)
   , m_has_costs(_in.m_has_costs)
   , m_has_ft_costs(_in.m_has_ft_costs)
@@ -64,6 +65,7 @@ cInstSet& cInstSet::operator=(const cInstSet& _in)
   m_hw_type = _in.m_hw_type;
   m_inst_lib = _in.m_inst_lib;
   m_lib_name_map = _in.m_lib_name_map;
+  m_dispatch = _in.m_dispatch;
   m_mutation_index = NULL;
   m_has_costs = _in.m_has_costs;
   m_has_ft_costs = _in.m_has_ft_costs;
@@ -115,11 +117,26 @@ Instruction cInstSet::ActivateNullInst()
   m_lib_name_map[inst_id].fem_res_cost = 0.0; 
   m_lib_name_map[inst_id].post_cost = 0;
   m_lib_name_map[inst_id].bonus_cost = 0.0;
+  m_lib_name_map[inst_id].stall = m_inst_lib->Get(null_fun_id).ShouldStall();
+  updateDispatch(inst_id);
   
   return Instruction(inst_id);
 }
 
 
+void cInstSet::updateDispatch(int id)
+{
+  if (m_dispatch.GetSize() < m_lib_name_map.GetSize()) m_dispatch.Resize(m_lib_name_map.GetSize());
+  
+  const sInstEntry& entry = m_lib_name_map[id];
+  sDispatchEntry& dispatch = m_dispatch[id];
+  dispatch.lib_fun_id = entry.lib_fun_id;
+  dispatch.addl_time_cost = entry.addl_time_cost;
+  dispatch.prob_fail = entry.prob_fail;
+  dispatch.stall = entry.stall;
+}
+
+
 cString cInstSet::FindBestMatch(const cString& in_name) const
 {
   int best_dist = 1024;
@@ -241,6 +258,13 @@ bool cInstSet::LoadWithStringList(const cStringList& sl, cUserFeedback* feedback
     m_lib_name_map[inst_id].post_cost = args->GetInt(6);
     m_lib_name_map[inst_id].bonus_cost = args->GetDouble(4);
     
+    // Behaviors (instructions with an input, action or copy behavioral class) wait for the organism's scheduled
+    // turn, unless speculative execution is allowed to run them
+    const cInstLibEntry& lib_entry = m_inst_lib->Get(fun_id);
+    m_lib_name_map[inst_id].stall = lib_entry.ShouldStall() ||
+      (!m_world->GetConfig().SPECULATIVE_BEHAVIORS.Get() && lib_entry.GetBehavClass() < BEHAV_CLASS_NONE);
+    updateDispatch(inst_id);
+    
     if (m_lib_name_map[inst_id].cost > 1) m_has_costs = true;
     if (m_lib_name_map[inst_id].ft_cost) m_has_ft_costs = true;
     if (m_lib_name_map[inst_id].energy_cost) m_has_energy_costs = true;
@@ -72,9 +72,20 @@ public:
     int choosy_female_cost;   // additional cost paid by females to execute the instruction (on top of female_cost) @CHC
     int post_cost;             // cpu cost to be paid AFTER instruction executed the first time (e.g. post-kill handling time in predators)
     double bonus_cost;          // current bonus required to execute inst
+    bool stall;               // speculative execution must stop before this instruction
   };
   Apto::Array<sInstEntry, Apto::Smart> m_lib_name_map;
   
+  // Compact copy of the entry fields read by the hardware on every cycle, shared by all hardware using this set.  Kept in
+  // step with m_lib_name_map, so any change to these fields must go through updateDispatch().
+  struct sDispatchEntry {
+    int lib_fun_id;
+    int addl_time_cost;
+    double prob_fail;
+    bool stall;
+  };
+  Apto::Array<sDispatchEntry> m_dispatch;
+  
   Apto::Array<int> m_lib_nopmod_map;
   
   cOrderedWeightedIndex* m_mutation_index;     // Weighted index for instructions 
@@ -126,6 +137,7 @@ public:
   double GetBonusCost(const Instruction& inst) const { return m_lib_name_map[inst.GetOp()].bonus_cost; }
   
   int GetLibFunctionIndex(const Instruction& inst) const { return m_lib_name_map[inst.GetOp()].lib_fun_id; }
+  const sDispatchEntry& GetDispatchEntry(const Instruction& inst) const { return m_dispatch[inst.GetOp()]; }
 
   int GetNopMod(const Instruction& inst) const
   {
@@ -157,7 +169,7 @@ public:
   bool IsLabel(const Instruction& inst) const { return m_inst_lib->Get(GetLibFunctionIndex(inst)).IsLabel(); }
   bool IsPromoter(const Instruction& inst) const { return m_inst_lib->Get(GetLibFunctionIndex(inst)).IsPromoter(); }
   bool IsTerminator(const Instruction& inst) const { return m_inst_lib->Get(GetLibFunctionIndex(inst)).IsTerminator(); }
-  bool ShouldStall(const Instruction& inst) const { return m_inst_lib->Get(GetLibFunctionIndex(inst)).ShouldStall(); }
+  bool ShouldStall(const Instruction& inst) const { return m_lib_name_map[inst.GetOp()].stall; }
   bool ShouldSleep(const Instruction& inst) const { return m_inst_lib->Get(GetLibFunctionIndex(inst)).ShouldSleep(); }
   bool IsImmediateValue(const Instruction& inst) const { return (inst != GetInstError() && m_inst_lib->Get(GetLibFunctionIndex(inst)).IsImmediateValue()); }
   
@@ -168,7 +180,7 @@ public:
   Instruction ActivateNullInst();
   
   // Modification of instructions during run.
-  void SetProbFail(const Instruction& inst, double _prob_fail) { m_lib_name_map[inst.GetOp()].prob_fail = _prob_fail; }
+  void SetProbFail(const Instruction& inst, double _prob_fail) { m_lib_name_map[inst.GetOp()].prob_fail = _prob_fail; updateDispatch(inst.GetOp()); }
   void SetRedundancy(const Instruction& inst, int _redundancy) { m_lib_name_map[inst.GetOp()].redundancy = _redundancy; m_mutation_index->SetWeight(inst.GetOp(), _redundancy);}
 
   // accessors for instruction library
@@ -185,6 +197,9 @@ public:
   bool LoadWithStringList(const cStringList& sl, cUserFeedback* errors = NULL);
   
   void SaveInstructionSequence(ofstream& of, const InstructionSequence& seq) const;
+  
+private:
+  void updateDispatch(int id);
 };
 
 
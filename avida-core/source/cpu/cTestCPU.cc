@@ -25,6 +25,9 @@
 #include "avida/output/File.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
+#include "cCPUMemory.h"
+#include "cCPUTestCache.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
 #include "cHardwareBase.h"
@@ -37,12 +40,15 @@
 #include "cResourceCount.h"
 #include "cResourceHistory.h"
 #include "cResourceLib.h"
+#include "cStats.h"
 #include "cStringUtil.h"
 #include "cTestCPUInterface.h"
+#include "cTestCPUSnapshots.h"
 #include "cWorld.h"
 #include "tMatrix.h"
 
 #include <iomanip>
+#include <sstream>
 
 using namespace std;
 using namespace AvidaTools;
@@ -54,6 +60,11 @@ cTestCPU::cTestCPU(cAvidaContext& ctx, cWorld* world)
 	m_use_manual_inputs = false;
   m_test_solo_res = -1;
   m_test_solo_res_lev = 0;
+  m_snapshot_record = NULL;
+  m_snapshot_source = NULL;
+  m_snapshot_resume = -1;
+  m_snapshot_failed = false;
+  m_snapshot_final = NULL;
   InitResources(ctx);
 }  
 
@@ -157,6 +168,17 @@ bool cTestCPU::ProcessGestation(cAvidaContext& ctx, cCPUTestInfo& test_info, int
   // This way of keeping track of time is only used to update resources...
   int time_used = m_res_cpu_cycle_offset; // Note: the offset is zero by default if no resources being used @JEB
   
+  // The parent's gestation may pick up from a snapshot of a recorded genome, or be recorded itself
+  if (cur_depth == 0 && m_snapshot_source != NULL &&
+      !LoadGestationState(organism, *m_snapshot_source, m_snapshot_resume, time_used)) {
+    // The organism is only partially restored, so this test is abandoned and repeated by the caller
+    m_snapshot_failed = true;
+    return false;
+  }
+  cTestCPUSnapshots* record = (cur_depth == 0) ? m_snapshot_record : NULL;
+  cCPUMemory& memory = organism.GetHardware().GetMemory();
+  if (record != NULL) memory.StartTouchLog(&record->m_first_touch);
+  
   organism.GetHardware().SetTrace(test_info.GetTracer());
   while (time_used < time_allocated && organism.GetPhenotype().GetNumDivides() == 0 && !organism.IsDead())
   {
@@ -168,25 +190,57 @@ bool cTestCPU::ProcessGestation(cAvidaContext& ctx, cCPUTestInfo& test_info, int
     UpdateResources(ctx, time_used);
     
     organism.GetHardware().SingleProcess(ctx);
+    
+    if (record != NULL && (time_used - m_res_cpu_cycle_offset) % record->m_interval == 0 && time_used < time_allocated &&
+        organism.GetPhenotype().GetNumDivides() == 0 && !organism.IsDead()) {
+      std::string state;
+      if (SaveGestationState(organism, time_used, state)) {
+        record->m_snapshots.Push(state);
+        memory.SetTouchStamp(record->m_snapshots.GetSize());
+      } else {
+        // This hardware does not support checkpoints, so there is nothing to share
+        record->m_snapshots.Resize(0);
+        memory.StopTouchLog();
+        record = NULL;
+      }
+    }
   }
+  if (record != NULL) memory.StopTouchLog();
   
   organism.GetHardware().SetTrace(HardwareTracerPtr(NULL));
+  
+  if (cur_depth == 0 && m_snapshot_final != NULL) SaveGestationState(organism, time_used, *m_snapshot_final);
 
   // Print out some final info in trace...
   if (test_info.GetTracer()) test_info.GetTracer()->TraceTestCPU(time_used, time_allocated, organism);
 
-  // For now, always return true.
   return true;
 }
 
 
 bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome)
 {
-  ctx.SetTestMode();
   test_info.Clear();
+  
+  Apto::String cache_key;
+  const bool use_cache = BuildCacheKey(ctx, test_info, genome, cache_key);
+  if (use_cache && m_world->GetHardwareManager().GetTestCache().Lookup(cache_key, test_info.m_summary)) {
+    const sCPUTestSummary& summary = test_info.m_summary;
+    test_info.m_from_cache = true;
+    test_info.is_viable = summary.is_viable;
+    test_info.max_depth = summary.max_depth;
+    test_info.depth_found = summary.depth_found;
+    test_info.max_cycle = summary.max_cycle;
+    test_info.cycle_to = summary.cycle_to;
+    return test_info.is_viable;
+  }
+  
+  ctx.SetTestMode();
   TestGenome_Body(ctx, test_info, genome, 0);
   ctx.ClearTestMode();
   
+  if (use_cache && !m_snapshot_failed) StoreCacheResult(test_info, cache_key);
+  
   return test_info.is_viable;
 }
 
@@ -223,6 +277,205 @@ bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Gen
   return test_info.is_viable;
 }
 
+// Describe the settings a test is run under.  Its outcome must be fully determined by the genome and these settings, so
+// random inputs, tracing, and mutations during the test all disqualify it.
+bool cTestCPU::BuildSettingsKey(cAvidaContext& ctx, const cCPUTestInfo& test_info, Apto::String& key) const
+{
+  if (test_info.use_random_inputs || test_info.m_tracer) return false;
+  
+  const cMutationRates& rates = test_info.m_mut_rates;
+  if (rates.GetCopyMutProb() > 0.0 || rates.GetCopyInsProb() > 0.0 || rates.GetCopyDelProb() > 0.0 ||
+      rates.GetCopyUniformProb() > 0.0 || rates.GetCopySlipProb() > 0.0 || rates.GetDivMutProb() > 0.0 ||
+      rates.GetDivInsProb() > 0.0 || rates.GetDivDelProb() > 0.0 || rates.GetDivUniformProb() > 0.0) {
+    return false;
+  }
+  
+  // Outside of analyze mode resource levels change as the run proceeds, so results are only reused within an update.
+  // Changes to the reactions and resources themselves are tracked by the environment version.
+  const int update = ctx.GetAnalyzeMode() ? -1 : m_world->GetStats().GetUpdate();
+  
+  key = Apto::FormatStr("%d|%d|%d|%d|%p|%d|%d|%d|%d|%g|%d|", test_info.generation_tests, update,
+                        m_world->GetEnvironment().GetVersion(), test_info.m_res_method, test_info.m_res,
+                        test_info.m_res_update, test_info.m_res_cpu_cycle_offset, test_info.m_cur_sg,
+                        m_test_solo_res, m_test_solo_res_lev, (int)test_info.use_manual_inputs);
+  if (test_info.use_manual_inputs) {
+    for (int i = 0; i < test_info.manual_inputs.GetSize(); i++) key += Apto::FormatStr("%d,", test_info.manual_inputs[i]);
+  }
+  
+  return true;
+}
+
+// A test may only be answered from the cache when its settings key can be built.
+bool cTestCPU::BuildCacheKey(cAvidaContext& ctx, const cCPUTestInfo& test_info, const Genome& genome,
+                             Apto::String& key) const
+{
+  if (!test_info.m_use_cache || !m_world->GetHardwareManager().GetTestCache().IsEnabled()) return false;
+  if (!BuildSettingsKey(ctx, test_info, key)) return false;
+  key += genome.AsString();
+  
+  return true;
+}
+
+void cTestCPU::StoreCacheResult(const cCPUTestInfo& test_info, const Apto::String& key)
+{
+  sCPUTestSummary summary;
+  summary.is_viable = test_info.is_viable;
+  summary.max_depth = test_info.max_depth;
+  summary.depth_found = test_info.depth_found;
+  summary.max_cycle = test_info.max_cycle;
+  summary.cycle_to = test_info.cycle_to;
+  summary.genotype_fitness = 0.0;
+  summary.colony_fitness = 0.0;
+  summary.colony_merit = 0.0;
+  summary.colony_gestation_time = 0;
+  
+  if (test_info.org_array[0] != NULL) summary.genotype_fitness = test_info.org_array[0]->GetPhenotype().GetFitness();
+  
+  const int depth_used = (test_info.depth_found == -1) ? 0 : test_info.depth_found;
+  cOrganism* colony_org = test_info.org_array[depth_used];
+  if (colony_org != NULL) {
+    const cPhenotype& phenotype = colony_org->GetPhenotype();
+    if (test_info.is_viable) summary.colony_fitness = phenotype.GetFitness();
+    summary.colony_merit = phenotype.GetMerit().GetDouble();
+    summary.colony_gestation_time = phenotype.GetGestationTime();
+    summary.colony_task_counts = phenotype.GetLastTaskCount();
+  }
+  
+  m_world->GetHardwareManager().GetTestCache().Store(key, summary);
+}
+
+
+bool cTestCPU::RecordSnapshots(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome,
+                               cTestCPUSnapshots& snapshots)
+{
+  snapshots.Clear();
+  
+  // Depletable resources change with the organism's actions, so those gestations are not shared
+  const int interval = m_world->GetConfig().TEST_CPU_SNAPSHOT_INTERVAL.Get();
+  Apto::String settings_key;
+  if (interval <= 0 || test_info.m_res_method >= RES_UPDATED_DEPLETABLE ||
+      !BuildSettingsKey(ctx, test_info, settings_key)) {
+    return TestGenome(ctx, test_info, genome);
+  }
+  
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(genome.Representation());
+  snapshots.m_settings_key = settings_key;
+  snapshots.m_genome = genome;
+  snapshots.m_interval = interval;
+  snapshots.m_first_touch.Resize(seq->GetSize());
+  snapshots.m_first_touch.SetAll(-1);
+  
+  // Record during a full test of the genome, which also provides the caller's results
+  std::string final_state;
+  test_info.Clear();
+  m_snapshot_record = &snapshots;
+  m_snapshot_final = &final_state;
+  ctx.SetTestMode();
+  TestGenome_Body(ctx, test_info, genome, 0);
+  ctx.ClearTestMode();
+  m_snapshot_record = NULL;
+  m_snapshot_final = NULL;
+  
+  Apto::String cache_key;
+  if (BuildCacheKey(ctx, test_info, genome, cache_key)) StoreCacheResult(test_info, cache_key);
+  
+  // Keep only the snapshots that resume to exactly the recorded final state.  Anything the organism checkpoint does
+  // not capture shows up here as a mismatch.
+  cCPUTestInfo check_info(1);
+  check_info.use_manual_inputs = test_info.use_manual_inputs;
+  check_info.manual_inputs = test_info.manual_inputs;
+  check_info.m_mut_rates = test_info.m_mut_rates;
+  check_info.m_cur_sg = test_info.m_cur_sg;
+  check_info.SetResourceOptions(test_info.m_res_method, test_info.m_res, test_info.m_res_update,
+                                test_info.m_res_cpu_cycle_offset);
+  for (int i = 0; i < snapshots.m_snapshots.GetSize(); i++) {
+    std::string check_state;
+    check_info.Clear();
+    m_snapshot_source = &snapshots;
+    m_snapshot_resume = i;
+    m_snapshot_final = &check_state;
+    ctx.SetTestMode();
+    TestGenome_Body(ctx, check_info, genome, 0);
+    ctx.ClearTestMode();
+    m_snapshot_source = NULL;
+    m_snapshot_final = NULL;
+    
+    if (m_snapshot_failed || check_state != final_state) {
+      m_snapshot_failed = false;
+      snapshots.m_snapshots.Resize(i);
+      break;
+    }
+  }
+  
+  return test_info.is_viable;
+}
+
+bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome,
+                          const cTestCPUSnapshots& snapshots)
+{
+  const int resume = snapshots.GetResumePoint(genome);
+  Apto::String settings_key;
+  if (resume < 0 || !BuildSettingsKey(ctx, test_info, settings_key) || settings_key != snapshots.m_settings_key) {
+    return TestGenome(ctx, test_info, genome);
+  }
+  
+  m_snapshot_source = &snapshots;
+  m_snapshot_resume = resume;
+  const bool is_viable = TestGenome(ctx, test_info, genome);
+  m_snapshot_source = NULL;
+  
+  // A snapshot that cannot be loaded leaves nothing usable behind, so run the whole test instead
+  if (m_snapshot_failed) {
+    m_snapshot_failed = false;
+    return TestGenome(ctx, test_info, genome);
+  }
+  
+  return is_viable;
+}
+
+// Gestation state holds the test CPU's input positions along with the organism checkpoint.  The final state of a
+// gestation also includes the offspring genome, if any, so that complete runs can be compared.
+bool cTestCPU::SaveGestationState(cOrganism& organism, int time_used, std::string& state)
+{
+  std::ostringstream stream;
+  cCheckpointWriter cp(stream);
+  cp.Write(time_used);
+  cp.Write(cur_input);
+  cp.Write(cur_receive);
+  cp.Write(organism.IsDead());
+  if (!organism.SaveCheckpoint(cp)) return false;
+  if (organism.GetPhenotype().GetNumDivides() > 0) cp.WriteString((const char*)organism.OffspringGenome().AsString());
+  if (!cp.Good()) return false;
+  
+  state = stream.str();
+  return true;
+}
+
+// Returns false, leaving the organism in an unusable state, if the snapshot cannot be loaded into it
+bool cTestCPU::LoadGestationState(cOrganism& organism, const cTestCPUSnapshots& snapshots, int idx, int& time_used)
+{
+  std::istringstream stream(snapshots.m_snapshots[idx]);
+  cCheckpointReader cp(stream);
+  time_used = cp.Read<int>();
+  cp.Read(cur_input);
+  cp.Read(cur_receive);
+  cp.Read<bool>();
+  if (!organism.LoadCheckpoint(cp) || !cp.Good()) return false;
+  
+  // Sites the recorded gestation had not touched yet hold this genome's instructions
+  ConstInstructionSequencePtr seq_p;
+  seq_p.DynamicCastFrom(organism.GetGenome().Representation());
+  const InstructionSequence& seq = *seq_p;
+  cCPUMemory& memory = organism.GetHardware().GetMemory();
+  for (int i = 0; i < seq.GetSize() && i < memory.GetSize(); i++) {
+    if (!snapshots.SiteTouched(i, idx) && memory[i] != seq[i]) memory[i] = seq[i];
+  }
+  
+  return true;
+}
+
+
 bool cTestCPU::TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, int cur_depth)
 {
   assert(cur_depth < test_info.generation_tests);
@@ -265,12 +518,14 @@ bool cTestCPU::TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, cons
   organism->GetPhenotype().SetupInject(*seq);
 
   // Run the current organism.
-  ProcessGestation(ctx, test_info, cur_depth);
+  const bool completed = ProcessGestation(ctx, test_info, cur_depth);
 
   
   // Notify the organism that it has died to allow for various cleanup methods to run
   organism->NotifyDeath(ctx);
   
+  if (!completed) return false;
+  
 
   // Must be able to divide twice in order to form a successful colony,
   // assuming the CPU doesn't get reset on divides.
@@ -30,12 +30,15 @@
 #include "cCPUTestInfo.h"
 #include "cWorld.h"
 
+#include <string>
+
 
 class cAvidaContext;
 class cBioGroup;
 class cInstSet;
 class cResourceCount;
 class cResourceHistory;
+class cTestCPUSnapshots;
 
 using namespace Avida;
 
@@ -66,10 +69,26 @@ private:
   cResourceCount m_faced_cell_resource_count;
   cResourceCount m_deme_resource_count;
   cResourceCount m_cell_resource_count;
+  
+  // Snapshot settings for the depth 0 gestation of the current test.  Set only for the duration of a single test.
+  cTestCPUSnapshots* m_snapshot_record;        // snapshots to record, or NULL
+  const cTestCPUSnapshots* m_snapshot_source;  // snapshots to resume from, or NULL
+  int m_snapshot_resume;                       // index of the snapshot to resume from
+  bool m_snapshot_failed;                      // the snapshot could not be loaded; the test must be repeated in full
+  std::string* m_snapshot_final;               // receives the final gestation state, or NULL
     
 
   bool ProcessGestation(cAvidaContext& ctx, cCPUTestInfo& test_info, int cur_depth);
   bool TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, int cur_depth);
+  
+  // Result cache support
+  bool BuildSettingsKey(cAvidaContext& ctx, const cCPUTestInfo& test_info, Apto::String& key) const;
+  bool BuildCacheKey(cAvidaContext& ctx, const cCPUTestInfo& test_info, const Genome& genome, Apto::String& key) const;
+  void StoreCacheResult(const cCPUTestInfo& test_info, const Apto::String& key);
+  
+  // Gestation snapshot support
+  bool SaveGestationState(cOrganism& organism, int time_used, std::string& state);
+  bool LoadGestationState(cOrganism& organism, const cTestCPUSnapshots& snapshots, int idx, int& time_used);
 
   
   cTestCPU(); // @not_implemented
@@ -89,6 +108,11 @@ public:
   bool TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome);
   bool TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, std::ofstream& out_fp);
   
+  // Test a genome, recording snapshots of its gestation for later tests of its point mutants
+  bool RecordSnapshots(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, cTestCPUSnapshots& snapshots);
+  // Test a genome, resuming from the snapshots of a recorded genome when it shares part of that gestation
+  bool TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, const cTestCPUSnapshots& snapshots);
+  
   void PrintGenome(cAvidaContext& ctx, const Genome& genome, cString filename = "", int update = -1, bool for_groups = false, int last_birth_cell = 0, int last_group_id = -1, int last_forager_type = -1);
 
   inline int GetInput();
@@ -0,0 +1,62 @@
+/*
+ *  cTestCPUSnapshots.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cTestCPUSnapshots.h"
+
+#include "avida/core/InstructionSequence.h"
+
+
+void cTestCPUSnapshots::Clear()
+{
+  m_settings_key = "";
+  m_genome = Genome();
+  m_interval = 0;
+  m_snapshots.Resize(0);
+  m_first_touch.Resize(0);
+}
+
+
+int cTestCPUSnapshots::GetResumePoint(const Genome& genome) const
+{
+  if (m_snapshots.GetSize() == 0) return -1;
+  if (genome.HardwareType() != m_genome.HardwareType() ||
+      genome.Properties().Get("instset").StringValue() != m_genome.Properties().Get("instset").StringValue()) {
+    return -1;
+  }
+
+  ConstInstructionSequencePtr seq_p;
+  seq_p.DynamicCastFrom(genome.Representation());
+  ConstInstructionSequencePtr base_seq_p;
+  base_seq_p.DynamicCastFrom(m_genome.Representation());
+  if (seq_p->GetSize() != base_seq_p->GetSize()) return -1;
+
+  const InstructionSequence& seq = *seq_p;
+  const InstructionSequence& base_seq = *base_seq_p;
+
+  // Resume from the last snapshot taken before any altered site was first touched
+  int resume = m_snapshots.GetSize() - 1;
+  for (int i = 0; i < seq.GetSize(); i++) {
+    if (seq[i] == base_seq[i] || m_first_touch[i] < 0) continue;
+    if (m_first_touch[i] - 1 < resume) resume = m_first_touch[i] - 1;
+    if (resume < 0) return -1;
+  }
+
+  return resume;
+}
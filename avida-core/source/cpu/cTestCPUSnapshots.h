@@ -0,0 +1,66 @@
+/*
+ *  cTestCPUSnapshots.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cTestCPUSnapshots_h
+#define cTestCPUSnapshots_h
+
+#include "apto/core.h"
+#include "avida/core/Genome.h"
+
+#include <string>
+
+using namespace Avida;
+
+
+// cTestCPUSnapshots - Periodic snapshots of a recorded test CPU gestation
+//
+// Landscaping and neighborhood analyses test many point mutants of one base genome.  Until a mutant's first altered
+// site is read or written, its gestation is identical to the base genome's, so it may resume from the last snapshot of
+// the base gestation taken before that site was first touched.  Snapshots are recorded by cTestCPU::RecordSnapshots
+// (every TEST_CPU_SNAPSHOT_INTERVAL cycles) under the same repeatability conditions as the result cache, and each one is
+// checked to resume to the recorded final state before it is kept.  Only the parent (depth 0) gestation is shared.
+// Once recorded, the snapshots are read-only and may be used by several test CPUs concurrently.
+
+class cTestCPUSnapshots
+{
+  friend class cTestCPU;
+private:
+  Apto::String m_settings_key;           // test settings the snapshots were recorded under
+  Genome m_genome;
+  int m_interval;
+  Apto::Array<std::string> m_snapshots;  // test CPU and organism state, as written by cTestCPU::SaveGestationState
+  Apto::Array<int> m_first_touch;        // per site: snapshots taken before the site was first touched, -1 if never
+
+public:
+  cTestCPUSnapshots() : m_interval(0) { ; }
+
+  void Clear();
+
+  int GetSize() const { return m_snapshots.GetSize(); }
+  int GetInterval() const { return m_interval; }
+
+  // Index of the latest snapshot a genome may resume from, or -1 if it must be tested in full
+  int GetResumePoint(const Genome& genome) const;
+
+  // Has the given site been touched by the time snapshot idx was taken?
+  bool SiteTouched(int site, int idx) const { return m_first_touch[site] >= 0 && m_first_touch[site] <= idx; }
+};
+
+#endif
@@ -281,8 +281,13 @@ public:
   CONFIG_ADD_GROUP(GENERAL_GROUP, "General Settings");
   CONFIG_ADD_VAR(VERBOSITY, int, 1, "0 = No output at all\n1 = Normal output\n2 = Verbose output, detailing progress\n3 = High level of details, as available\n4 = Print Debug Information, as applicable");
   CONFIG_ADD_VAR(RANDOM_SEED, int, -1, "Random number seed (-1 for based on time)");
+  CONFIG_ADD_VAR(CHECKPOINT_RNG_STREAMS, bool, 0, "Restart the random number streams from the seed and update number at the start of\nevery update, so that a run restored with LoadCheckpoint continues exactly as the\nrun that saved it.  Required by SaveCheckpoint and LoadCheckpoint.");
   CONFIG_ADD_VAR(SPECULATIVE, bool, 1, "Enable speculative execution\n(pre-execute instructions that don't affect other organisms)");
+  CONFIG_ADD_VAR(SPECULATIVE_BEHAVIORS, bool, 1, "Allow speculative execution to run behavior instructions (input, action and copy\nbehavioral classes) that are not marked to stall.  Set to 0 for two-phase execution:\ninternal computation is pre-executed, in parallel with PARALLEL_UPDATE_THREADS, and\nevery behavior is applied serially in scheduler order.");
+  CONFIG_ADD_VAR(PARALLEL_UPDATE_THREADS, int, 0, "Number of threads used to speculatively pre-execute organisms at the\nstart of each update (0 = disabled, -1 = use all available).\nRequires SPECULATIVE; results depend on the seed, not the thread count.");
+  CONFIG_ADD_VAR(PARALLEL_TILE_SIZE, int, 0, "Number of cells in each parallel pre-execution tile\n(0 = one tile per deme, or one tile per world row when there are no demes)");
   CONFIG_ADD_VAR(POPULATION_CAP, int, 0, "Carrying capacity in number of organisms (use 0 for no cap)");
+  CONFIG_ADD_VAR(PROFILE_INSTRUCTIONS, bool, 0, "Record per-instruction execution counts and times (core.profile.inst_exec_*)\nSlows execution, and disables PARALLEL_UPDATE_THREADS.");
   CONFIG_ADD_VAR(POP_CAP_ELDEST, int, 0, "Carrying capacity in number of organisms (use 0 for no cap). Will kill oldest organism in population, but still use birth method to place new offspring."); 
   
   
@@ -302,6 +307,9 @@ public:
   CONFIG_ADD_VAR(ANALYZE_FILE, cString, "analyze.cfg", "File used for analysis mode");
   CONFIG_ADD_VAR(ENVIRONMENT_FILE, cString, "environment.cfg", "File that describes the environment");
   CONFIG_ADD_VAR(MIGRATION_FILE, cString, "-", "NxN file that describes connectivity weights between demes");   
+  CONFIG_ADD_VAR(GRID_DUMP_FORMAT, int, 0, "Output of the Dump*Grid actions\n0 = One text file per update\n1 = One binary container per grid (convert with utils/grid_dump)\n2 = As 1, with frames stored as compressed deltas of the previous frame");
+  CONFIG_ADD_VAR(GRID_DUMP_QUEUE_SIZE, int, 16, "Number of grid frames that may wait for the background container writer");
+  CONFIG_ADD_VAR(PIPELINE_OUTPUT, bool, 0, "Write output files from a background thread, overlapping the output of each update\nwith the processing of the next.  File contents are unchanged.");
   
   
   // -------- Mutation config options --------
@@ -311,6 +319,7 @@ public:
   CONFIG_ADD_VAR(COPY_DEL_PROB, double, 0.0, "Deletion rate (per copy)");
   CONFIG_ADD_VAR(COPY_UNIFORM_PROB, double, 0.0, "Uniform mutation probability (per copy)\n- Randomly apply insertion, deletion or substition mutation");
   CONFIG_ADD_VAR(COPY_SLIP_PROB, double, 0.0, "Slip rate (per copy)");
+  CONFIG_ADD_VAR(COPY_MUT_SAMPLING, int, 0, "Method used to sample per-copy mutations\n0 = Test every copied instruction\n1 = Count down to the next mutation of each type (geometric skip, far fewer random draws)");
   
   CONFIG_ADD_VAR(POINT_MUT_PROB, double, 0.0, "Point (Cosmic-Ray) substitution rate (per-location per update)");
   CONFIG_ADD_VAR(POINT_INS_PROB, double, 0.0, "Point (Cosmic-Ray) insertion rate (per-location per update)");
@@ -464,6 +473,7 @@ public:
   CONFIG_ADD_GROUP(ARCHETECTURE_GROUP, "Details on how CPU should work");
   CONFIG_ADD_VAR(IO_EXPIRE, bool, 1, "Is the expiration functionality of '-expire' I/O instructions enabled?");
   CONFIG_ADD_VAR(POISON_PENALTY, double, 0.01, "Metabolic rate penalty applied when the 'poison' instruction is executed.");
+  CONFIG_ADD_VAR(HARDWARE_POOL_SIZE, int, 0, "Number of released virtual CPUs to keep per instruction set for reuse\nby new organisms (0 = disabled)");
 
   
   // -------- Pprocessing of multiple, distributed populations config options --------
@@ -587,7 +597,10 @@ public:
   // -------- Geneology config options --------
   CONFIG_ADD_GROUP(GENEOLOGY_GROUP, "Geneology");
   CONFIG_ADD_VAR(THRESHOLD, int, 3, "Number of organisms in a genotype needed for it\n  to be considered viable.");
+  CONFIG_ADD_VAR(HISTORIC_GENOTYPE_STORE, int, 0, "Compact historic genotypes into packed records, coding genomes as deltas of\ntheir parents'.\n0 = Off\n1 = Records in memory\n2 = Records in a scratch file in the data directory");
   CONFIG_ADD_VAR(TEST_CPU_TIME_MOD, int, 20, "Time allocated in test CPUs (multiple of length)");
+  CONFIG_ADD_VAR(TEST_CPU_CACHE_SIZE, int, 0, "Number of test CPU results to remember for reuse by\nlandscaping and neighborhood analyses (0 = disabled)");
+  CONFIG_ADD_VAR(TEST_CPU_SNAPSHOT_INTERVAL, int, 0, "CPU cycles between snapshots of a base genome's test CPU run, from which\nlandscaping and neighborhood analyses resume point mutants (0 = disabled)");
   
 
   // -------- Organism Network config options --------
@@ -633,7 +646,7 @@ public:
   
   // -------- Analyze config options --------
   CONFIG_ADD_GROUP(ANALYZE_GROUP, "Analysis Settings");
-  CONFIG_ADD_VAR(MAX_CONCURRENCY, int, -1, "Maximum number of analyze threads, -1 == use all available.");
+  CONFIG_ADD_VAR(MAX_CONCURRENCY, int, -1, "Maximum number of analyze threads, and of threads parsing loaded\npopulation and genotype files, -1 == use all available.");
   CONFIG_ADD_VAR(INJECT_RESETS_TASKS, int, 0, "Executing INJECT (semi-succesfully) will trigger last_task_count to be writen from current_task_count");
   CONFIG_ADD_VAR(ANALYZE_OPTION_1, cString, "", "String variable accessible from analysis scripts");
   CONFIG_ADD_VAR(ANALYZE_OPTION_2, cString, "", "String variable accessible from analysis scripts");
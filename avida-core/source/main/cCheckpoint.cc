@@ -0,0 +1,82 @@
+/*
+ *  cCheckpoint.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "cCheckpoint.h"
+
+#include <cstring>
+
+
+// Increment whenever the layout of any checkpointed state changes
+static const int CHECKPOINT_VERSION = 3;
+static const char* CHECKPOINT_MAGIC = "AVCK";
+static const unsigned int CHECKPOINT_BYTE_ORDER = 0x01020304;
+
+
+void cCheckpointWriter::WriteHeader()
+{
+  WriteTag(CHECKPOINT_MAGIC);
+  Write(CHECKPOINT_VERSION);
+  Write(CHECKPOINT_BYTE_ORDER);
+  Write(static_cast<int>(sizeof(int)));
+  Write(static_cast<int>(sizeof(long)));
+  Write(static_cast<int>(sizeof(double)));
+}
+
+void cCheckpointWriter::WriteString(const cString& str)
+{
+  Write(str.GetSize());
+  m_fp.write(str, str.GetSize());
+}
+
+
+bool cCheckpointReader::ReadHeader()
+{
+  if (!ReadTag(CHECKPOINT_MAGIC)) return false;
+  if (Read<int>() != CHECKPOINT_VERSION) return false;
+  if (Read<unsigned int>() != CHECKPOINT_BYTE_ORDER) return false;
+  if (Read<int>() != static_cast<int>(sizeof(int))) return false;
+  if (Read<int>() != static_cast<int>(sizeof(long))) return false;
+  if (Read<int>() != static_cast<int>(sizeof(double))) return false;
+  return Good();
+}
+
+bool cCheckpointReader::ReadTag(const char* tag)
+{
+  char buf[4];
+  m_fp.read(buf, 4);
+  if (!m_fp.good() || strncmp(buf, tag, 4) != 0) m_valid = false;
+  return Good();
+}
+
+void cCheckpointReader::ReadString(cString& str)
+{
+  const int size = Read<int>();
+  if (!Good() || size < 0) {
+    m_valid = false;
+    str = "";
+    return;
+  }
+  char* buf = new char[size + 1];
+  m_fp.read(buf, size);
+  buf[size] = '\0';
+  str = buf;
+  delete [] buf;
+}
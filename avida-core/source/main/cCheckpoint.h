@@ -0,0 +1,109 @@
+/*
+ *  cCheckpoint.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef cCheckpoint_h
+#define cCheckpoint_h
+
+#include "apto/core.h"
+
+#include "cString.h"
+
+#include <fstream>
+#include <iostream>
+
+
+// cCheckpointWriter / cCheckpointReader - Binary world checkpoint streams
+//
+// Values are stored in the native byte order and word sizes of the machine that wrote the checkpoint.  The header
+// records both, along with the format version, so that an incompatible file is rejected on load rather than misread.
+// Sections are introduced by four character tags to detect truncated or mismatched data.  Streams may also be attached
+// to an existing stream, such as a std::stringstream, to hold state in memory.
+
+class cCheckpointWriter
+{
+private:
+  std::ofstream m_file;
+  std::ostream& m_fp;
+
+  cCheckpointWriter(); // @not_implemented
+  cCheckpointWriter(const cCheckpointWriter&); // @not_implemented
+  cCheckpointWriter& operator=(const cCheckpointWriter&); // @not_implemented
+
+public:
+  cCheckpointWriter(const cString& filename)
+    : m_file(filename, std::ios::out | std::ios::binary | std::ios::trunc), m_fp(m_file) { ; }
+  explicit cCheckpointWriter(std::ostream& stream) : m_fp(stream) { ; }
+
+  bool Good() const { return m_fp.good(); }
+  bool Flush() { m_fp.flush(); return Good(); }
+
+  void WriteHeader();
+  void WriteTag(const char* tag) { m_fp.write(tag, 4); }
+  void WriteString(const cString& str);
+
+  template <class T> void Write(const T& value) { m_fp.write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+  template <class T, template <class> class SP> void WriteArray(const Apto::Array<T, SP>& arr)
+  {
+    Write(arr.GetSize());
+    for (int i = 0; i < arr.GetSize(); i++) Write(arr[i]);
+  }
+};
+
+
+class cCheckpointReader
+{
+private:
+  std::ifstream m_file;
+  std::istream& m_fp;
+  bool m_valid;
+
+  cCheckpointReader(); // @not_implemented
+  cCheckpointReader(const cCheckpointReader&); // @not_implemented
+  cCheckpointReader& operator=(const cCheckpointReader&); // @not_implemented
+
+public:
+  cCheckpointReader(const cString& filename)
+    : m_file(filename, std::ios::in | std::ios::binary), m_fp(m_file), m_valid(true) { ; }
+  explicit cCheckpointReader(std::istream& stream) : m_fp(stream), m_valid(true) { ; }
+
+  bool Good() const { return m_valid && m_fp.good(); }
+  void Invalidate() { m_valid = false; }
+
+  bool ReadHeader();
+  bool ReadTag(const char* tag);
+  void ReadString(cString& str);
+
+  template <class T> void Read(T& value) { m_fp.read(reinterpret_cast<char*>(&value), sizeof(T)); }
+  template <class T> T Read() { T value = T(); Read(value); return value; }
+  template <class T, template <class> class SP> void ReadArray(Apto::Array<T, SP>& arr)
+  {
+    const int size = Read<int>();
+    if (!Good() || size < 0) {
+      Invalidate();
+      arr.Resize(0);
+      return;
+    }
+    arr.Resize(size);
+    for (int i = 0; i < size; i++) Read(arr[i]);
+  }
+};
+
+#endif
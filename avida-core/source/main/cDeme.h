@@ -274,7 +274,6 @@ public:
   void GiveBackCellEnergy(int absolute_cell_id, double value, cAvidaContext& ctx); 
   void SetupDemeRes(int id, cResource * res, int verbosity, cWorld* world);                 
   void UpdateDemeRes(cAvidaContext& ctx) { deme_resource_count.GetResources(ctx); } 
-  void Update(double time_step) { deme_resource_count.Update(time_step); }
   int GetRelativeCellID(int absolute_cell_id) const { return absolute_cell_id % GetSize(); } //!< assumes all demes are the same size
   int GetAbsoluteCellID(int relative_cell_id) const { return relative_cell_id + (_id * GetSize()); } //!< assumes all demes are the same size
 	
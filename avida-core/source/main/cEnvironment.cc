@@ -53,7 +53,7 @@ using namespace Avida;
 
 cEnvironment::cEnvironment(cWorld* world) : m_world(world) , m_tasklib(world),
 m_input_size(INPUT_SIZE_DEFAULT), m_output_size(OUTPUT_SIZE_DEFAULT), m_true_rand(false),
-m_use_specific_inputs(false), m_specific_inputs(), m_mask(0), m_hammers(false), m_paths(false)
+m_use_specific_inputs(false), m_specific_inputs(), m_mask(0), m_hammers(false), m_paths(false), m_version(0)
 {
   mut_rates.Setup(world);
   if (m_world->GetConfig().DEFAULT_GROUP.Get() != -1) possible_group_ids.insert(m_world->GetConfig().DEFAULT_GROUP.Get());
@@ -725,6 +725,7 @@ bool cEnvironment::LoadReaction(cString desc, Feedback& feedback)
 
   // If only a name was present, assume this reaction is a pre-declaration.
   if (desc.GetSize() == 0) {
+    SetupLogicDispatch();
     return true;
   }
 
@@ -782,9 +783,36 @@ bool cEnvironment::LoadReaction(cString desc, Feedback& feedback)
   if (envreqs.GetMinOutputs() > m_output_size) m_output_size = envreqs.GetMinOutputs();
   if (envreqs.GetTrueRandInputs()) m_true_rand = true;
 
+  SetupLogicDispatch();
+  
   return true;
 }
 
+
+void cEnvironment::SetupLogicDispatch()
+{
+  const int num_logic_ids = cTaskLib::NUM_LOGIC_IDS;
+  m_logic_reactions.ResizeClear(num_logic_ids + 1);
+  for (int i = 0; i < m_logic_reactions.GetSize(); i++) m_logic_reactions[i].Resize(0);
+  
+  for (int i = 0; i < reaction_lib.GetSize(); i++) {
+    const cReaction* cur_reaction = reaction_lib.GetReaction(i);
+    const cTaskEntry* cur_task = cur_reaction->GetTask();
+    
+    // Phenotypic plasticity bonuses may mark a task that was not performed, so such reactions are always examined
+    bool logic_only = (cur_task != NULL && cur_task->IsLogicOnly());
+    tLWConstListIterator<cReactionProcess> proc_it(cur_reaction->GetProcesses());
+    const cReactionProcess* cur_proc;
+    while (logic_only && (cur_proc = proc_it.Next()) != NULL) {
+      if (cur_proc->GetPhenPlastBonusMethod() != DEFAULT) logic_only = false;
+    }
+    
+    for (int logic_id = -1; logic_id < num_logic_ids; logic_id++) {
+      if (!logic_only || cur_task->IsSatisfiedBy(logic_id)) m_logic_reactions[logic_id + 1].Push(i);
+    }
+  }
+}
+
 bool cEnvironment::LoadGradientResource(cString desc, Feedback& feedback) 
 {
   if (desc.GetSize() == 0) {
@@ -1144,6 +1172,8 @@ bool cEnvironment::LoadLine(cString line, Feedback& feedback)
 /* Routine to read in a line from the enviroment file and hand that line
  line to the approprate routine to process it.                         */
 {
+  m_version++;
+  
   cString type = line.PopWord();      // Determine type of this entry.
   type.ToUpper();                     // Make type case insensitive.
 
@@ -1284,9 +1314,15 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
   // Do setup for reaction tests...
   m_tasklib.SetupTests(taskctx);
 
-  // Loop through all reactions to see if any have been triggered...
-  const int num_reactions = reaction_lib.GetSize();
-  for (int i = 0; i < num_reactions; i++) {
+  // Only reactions whose tasks can be satisfied by the logic ID of this output need to be examined.  Context
+  // requisites update the context phenotype for every reaction, so they still require the full loop.
+  const bool use_dispatch = (context_phenotype == 0 && m_logic_reactions.GetSize() > 0);
+  const Apto::Array<int>* candidates = (use_dispatch) ? &m_logic_reactions[taskctx.GetLogicId() + 1] : NULL;
+  
+  // Loop through all (candidate) reactions to see if any have been triggered...
+  const int num_reactions = (use_dispatch) ? candidates->GetSize() : reaction_lib.GetSize();
+  for (int reaction_idx = 0; reaction_idx < num_reactions; reaction_idx++) {
+    const int i = (use_dispatch) ? (*candidates)[reaction_idx] : reaction_idx;
     cReaction* cur_reaction = reaction_lib.GetReaction(i);
     assert(cur_reaction != NULL);
 
@@ -1825,6 +1861,7 @@ double cEnvironment::GetReactionValue(int reaction_id)
 
 bool cEnvironment::SetReactionValue(cAvidaContext& ctx, const cString& name, double value)
 {
+  m_version++;
   const int num_reactions = reaction_lib.GetSize();
 
   // See if this should be applied to all reactions.
@@ -1866,6 +1903,7 @@ bool cEnvironment::SetReactionValue(cAvidaContext& ctx, const cString& name, dou
 
 bool cEnvironment::SetReactionValueMult(const cString& name, double value_mult)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   found_reaction->MultiplyValue(value_mult);
@@ -1874,6 +1912,7 @@ bool cEnvironment::SetReactionValueMult(const cString& name, double value_mult)
 
 bool cEnvironment::SetReactionInst(const cString& name, cString inst_name)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   found_reaction->ModifyInst(inst_name);
@@ -1882,6 +1921,7 @@ bool cEnvironment::SetReactionInst(const cString& name, cString inst_name)
 
 bool cEnvironment::SetReactionMinTaskCount(const cString& name, int min_count)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   return found_reaction->SetMinTaskCount( min_count );
@@ -1889,6 +1929,7 @@ bool cEnvironment::SetReactionMinTaskCount(const cString& name, int min_count)
 
 bool cEnvironment::SetReactionMaxTaskCount(const cString& name, int max_count)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   return found_reaction->SetMaxTaskCount( max_count );
@@ -1896,6 +1937,7 @@ bool cEnvironment::SetReactionMaxTaskCount(const cString& name, int max_count)
 
 bool cEnvironment::SetReactionMinCount(const cString& name, int reaction_min_count)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   return found_reaction->SetMinReactionCount( reaction_min_count );
@@ -1903,6 +1945,7 @@ bool cEnvironment::SetReactionMinCount(const cString& name, int reaction_min_cou
 
 bool cEnvironment::SetReactionMaxCount(const cString& name, int reaction_max_count)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   return found_reaction->SetMaxReactionCount( reaction_max_count );
@@ -1910,6 +1953,7 @@ bool cEnvironment::SetReactionMaxCount(const cString& name, int reaction_max_cou
 
 bool cEnvironment::SetReactionTask(const cString& name, const cString& task)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
 
@@ -1918,6 +1962,7 @@ bool cEnvironment::SetReactionTask(const cString& name, const cString& task)
     if (m_tasklib.GetTask(i).GetName() == task)
     {
       found_reaction->SetTask( m_tasklib.GetTaskReference(i) );
+      SetupLogicDispatch();
       return true;
     }
   }
@@ -1927,6 +1972,7 @@ bool cEnvironment::SetReactionTask(const cString& name, const cString& task)
 
 bool cEnvironment::SetResourceInflow(const cString& name, double _inflow )
 {
+  m_version++;
   cResource* found_resource = resource_lib.GetResource(name);
   if (found_resource == NULL) return false;
   found_resource->SetInflow( _inflow );
@@ -1935,6 +1981,7 @@ bool cEnvironment::SetResourceInflow(const cString& name, double _inflow )
 
 bool cEnvironment::SetResourceOutflow(const cString& name, double _outflow )
 {
+  m_version++;
   cResource* found_resource = resource_lib.GetResource(name);
   if (found_resource == NULL) return false;
   found_resource->SetOutflow( _outflow );
@@ -1943,6 +1990,7 @@ bool cEnvironment::SetResourceOutflow(const cString& name, double _outflow )
 
 bool cEnvironment::ChangeResource(cReaction* reaction, const cString& res, int process_num)
 {
+  m_version++;
   cReactionProcess* process = reaction->GetProcess(process_num);
   process->SetResource(m_world->GetEnvironment().GetResourceLib().GetResource(res));
   return true;
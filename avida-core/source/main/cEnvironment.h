@@ -83,6 +83,12 @@ private:
   bool m_hammers;
   bool m_paths;
   
+  // Candidate reactions for each output logic ID, stored at logic ID + 1 so that entry 0 covers outputs without a
+  // consistent logic ID.  Reactions whose tasks depend on more than the logic ID are candidates for every output.
+  Apto::Array<Apto::Array<int> > m_logic_reactions;
+  
+  int m_version;  // see GetVersion()
+  
   cEnvironment(); // @not_implemented
   cEnvironment(const cEnvironment&); // @not_implemented
   cEnvironment& operator=(const cEnvironment&); // @not_implemented
@@ -93,11 +99,15 @@ public:
 
   bool Load(const cString& filename, const cString& working_dir, Feedback& feedback, const Apto::Map<Apto::String, Apto::String>* defs = NULL);
   bool LoadLine(cString line, Feedback& feedback);  // Reads in a single environment configuration line
+  
+  // Incremented by every change to the reactions, resources or inputs made through this interface, so that results
+  // derived from the environment (see cCPUTestCache) can tell when they are out of date
+  int GetVersion() const { return m_version; }
 
   // Interaction with the organisms
   void SetupInputs(cAvidaContext& ctx, Apto::Array<int>& input_array, bool random = true) const;
-  void SetSpecificInputs(const Apto::Array<int> in_input_array) { m_use_specific_inputs = true; m_specific_inputs = in_input_array; }
-  void SetSpecificRandomMask(unsigned int mask) { m_mask = mask; }
+  void SetSpecificInputs(const Apto::Array<int> in_input_array) { m_use_specific_inputs = true; m_specific_inputs = in_input_array; m_version++; }
+  void SetSpecificRandomMask(unsigned int mask) { m_mask = mask; m_version++; }
   void SwapInputs(cAvidaContext& ctx, Apto::Array<int>& src_input_array, Apto::Array<int>& dest_input_array) const;
 
 
@@ -181,6 +191,7 @@ private:
   bool LoadReaction(cString desc, Feedback& feedback);
   bool LoadStateGrid(cString desc, Feedback& feedback);
   bool LoadSetActive(cString desc, Feedback& feedback);
+  void SetupLogicDispatch();
   
   bool LoadGradientResource(cString desc, Feedback& feedback);
   double GetTaskProbability(cAvidaContext& ctx, cTaskContext& taskctx,
@@ -99,53 +99,182 @@ void cGenomeUtil::substring_match::rotate(int r, std::size_t n) {
 }
 
 
+namespace {
+	typedef unsigned long long tWord;
+	const int WORD_BITS = 64;
+	const int NUM_OPS = 256; //!< Instruction operands are stored as unsigned char.
+	
+	
+	/*! Text of an approximate match: size instructions of base, starting at start and wrapping around its end.
+	 
+	 This lets circular matches read past the end of the genome without building a rotated, extended copy of it.
+	 */
+	struct match_text {
+		match_text(const InstructionSequence& b, int st, int sz) : base(b), start(st), size(sz) { }
+		//! Index in base of text position k.
+		int index(int k) const { return (start + k) % base.GetSize(); }
+		
+		const InstructionSequence& base;
+		int start;
+		int size;
+	};
+	
+	
+	/*! Bit-parallel columns of the approximate substring matching table (Myers, 1999; blocked as in Hyyro, 2003).
+	 
+	 Row i of column j holds the cost of the best match of the first i instructions of the pattern ending just before
+	 text position j, exactly as in the dynamic programming table of FindSubstringMatch.  Columns are stored as vertical
+	 deltas, 64 rows per word: pv holds the rows that are one greater than the row above, mv the rows that are one less.
+	 */
+	class match_columns {
+	public:
+		match_columns(const InstructionSequence& pattern)
+		: m_size(pattern.GetSize()), m_blocks((m_size + WORD_BITS - 1) / WORD_BITS)
+		, m_last_bit(tWord(1) << ((m_size - 1) % WORD_BITS))
+		, m_peq(m_blocks * NUM_OPS, 0), m_pv(m_blocks), m_mv(m_blocks) {
+			for(int i=0; i<m_size; ++i) {
+				m_peq[(i / WORD_BITS) * NUM_OPS + pattern[i].GetOp()] |= tWord(1) << (i % WORD_BITS);
+			}
+			Reset();
+		}
+		
+		//! Return to column 0, where row i costs i.
+		void Reset() {
+			std::fill(m_pv.begin(), m_pv.end(), ~tWord(0));
+			std::fill(m_mv.begin(), m_mv.end(), tWord(0));
+		}
+		
+		//! Advance one column past text instruction op; returns the change in cost of the final row.
+		int Advance(int op) {
+			int hin = 0; // a match may start anywhere, so the top row is always 0
+			for(int b=0; b<m_blocks; ++b) {
+				const tWord pv = m_pv[b];
+				const tWord mv = m_mv[b];
+				const tWord hin_neg = (hin < 0) ? 1 : 0;
+				tWord eq = m_peq[b * NUM_OPS + op];
+				const tWord xv = eq | mv;
+				eq |= hin_neg;
+				const tWord xh = (((eq & pv) + pv) ^ pv) | eq;
+				tWord ph = mv | ~(xh | pv);
+				tWord mh = pv & xh;
+				
+				const tWord out_bit = (b == m_blocks - 1) ? m_last_bit : (tWord(1) << (WORD_BITS - 1));
+				const int hout = ((ph & out_bit) ? 1 : 0) - ((mh & out_bit) ? 1 : 0);
+				
+				ph = (ph << 1) | ((hin > 0) ? 1 : 0);
+				mh = (mh << 1) | hin_neg;
+				m_pv[b] = mh | ~(xv | ph);
+				m_mv[b] = ph & xv;
+				hin = hout;
+			}
+			return hin;
+		}
+		
+		//! Cost of row i (1 <= i <= pattern size) relative to row i-1 in the current column.
+		int Delta(int i) const {
+			const int b = (i - 1) / WORD_BITS;
+			const tWord bit = tWord(1) << ((i - 1) % WORD_BITS);
+			return ((m_pv[b] & bit) ? 1 : 0) - ((m_mv[b] & bit) ? 1 : 0);
+		}
+		
+	private:
+		int m_size;
+		int m_blocks;
+		tWord m_last_bit;
+		std::vector<tWord> m_peq; //!< Per block and operand, the pattern rows holding that operand.
+		std::vector<tWord> m_pv;
+		std::vector<tWord> m_mv;
+	};
+	
+	
+	/*! Find (one of) the best matches of substring in text.
+	 
+	 The cost of the best match ending at each text position is found with bit-parallel columns.  The leftmost position
+	 with the lowest cost is the end of the match.  Its beginning is then recovered by running the begin-tracking dynamic
+	 program of the original implementation over only the columns a match of that cost can span.  Any match path ending at
+	 end with cost c starts at or after end - (size + c), so those columns decide every choice along it; the exact costs of
+	 the column just before them are reloaded from a second bit-parallel pass.  Ties are broken exactly as before.
+	 */
+	cGenomeUtil::substring_match find_substring_match(const match_text& text, const InstructionSequence& substring) {
+		const int rows = substring.GetSize() + 1;
+		if((rows == 1) || (text.size == 0)) {
+			return cGenomeUtil::substring_match(0, 0, rows - 1, text.size);
+		}
+		
+		// find the leftmost end position with the lowest cost:
+		match_columns columns(substring);
+		int cost = rows - 1;
+		int best_cost = cost;
+		int end = 0;
+		for(int j=1, k=text.index(0); j<=text.size; ++j) {
+			cost += columns.Advance(text.base[k].GetOp());
+			if(cost < best_cost) {
+				best_cost = cost;
+				end = j;
+			}
+			if(++k == text.base.GetSize()) { k = 0; }
+		}
+		if(end == 0) {
+			return cGenomeUtil::substring_match(0, 0, best_cost, text.size);
+		}
+		
+		// load the costs of the column preceding any match that could end at end:
+		const int first = std::max(0, end - (rows - 1) - best_cost - 1);
+		columns.Reset();
+		for(int j=1, k=text.index(0); j<=first; ++j) {
+			columns.Advance(text.base[k].GetOp());
+			if(++k == text.base.GetSize()) { k = 0; }
+		}
+		
+		// track match beginnings over columns [first, end]:
+		const int cols = end - first + 1;
+		std::vector<cGenomeUtil::substring_match> m0(cols), m1(cols);
+		cGenomeUtil::substring_match* c = &m0[0];
+		cGenomeUtil::substring_match* p = &m1[0];
+		for(int j=0; j<cols; ++j) {
+			p[j].begin = first + j;
+		}
+		c[0].begin = first;
+		
+		for(int i=1; i<rows; ++i) {
+			c[0].cost = p[0].cost + columns.Delta(i);
+			c[0].begin = first;
+			for(int j=1, k=text.index(first); j<cols; ++j) {
+				cGenomeUtil::substring_match l[3] = {p[j-1], p[j], c[j-1]};
+				cGenomeUtil::substring_match* s = &l[0]; // default match is to the upper left.
+				
+				if(substring[i-1] == text.base[k]) {
+					c[j].cost = s->cost;
+				} else {
+					s = std::min_element(l,l+3);
+					c[j].cost = s->cost + 1;
+				}
+				
+				c[j].begin = s->begin;
+				c[j].end = first + j;
+				if(++k == text.base.GetSize()) { k = 0; }
+			}
+			std::swap(c,p);
+		}
+		
+		assert(p[cols-1].cost == best_cost);
+		cGenomeUtil::substring_match match = p[cols-1];
+		match.size = text.size;
+		return match;
+	}
+}
+
+
 /*! Find (one of) the best substring matches of substring in base.
  
  The algorithm here is based on the well-known dynamic programming approach to
  finding a substring match.  Here, it has been extended to track the beginning and
  ending locations of that match.  Specifically, [begin,end) of the returned substring_match
- denotes the matched region in the base string.
+ denotes the matched region in the base string.  The table is computed with bit-parallel
+ columns, see find_substring_match above.
  */
 cGenomeUtil::substring_match cGenomeUtil::FindSubstringMatch(const InstructionSequence& base, const InstructionSequence& substring) {
-	const int rows=substring.GetSize()+1;
-	const int cols=base.GetSize()+1;
-	substring_match* m[2];
-	m[0] = new substring_match[cols];
-	m[1] = new substring_match[cols];
-	substring_match* c=m[0];
-	substring_match* p=m[1];
-	
-	for(int j=1; j<cols; ++j) {
-		p[j].begin = j;
-	}
-	
-	for(int i=1; i<rows; ++i) {
-		c[0].cost = i;
-		for(int j=1; j<cols; ++j) {
-			substring_match l[3] = {p[j-1], p[j], c[j-1]};
-			substring_match* s = &l[0]; // default match is to the upper left.
-			
-			if(substring[i-1] == base[j-1]) {
-				// if the characters match, take the default
-				c[j].cost = s->cost;
-			} else {
-				// otherwise, find the minimum cost, add 1.
-				s = std::min_element(l,l+3);
-				c[j].cost = s->cost + 1;				
-			}
-			
-			// update the beginning and end of the match.
-			c[j].begin = s->begin;
-			c[j].end = j;
-		}
-		std::swap(c,p);
-	}
-	
-	substring_match* min = std::min_element(p, p+cols);
-	min->size = base.GetSize();
-	delete [] m[0];
-	delete [] m[1];
-	return *min;
+	return find_substring_match(match_text(base, 0, base.GetSize()), substring);
 }
 
 
@@ -158,26 +287,22 @@ cGenomeUtil::substring_match cGenomeUtil::FindSubstringMatch(const InstructionSe
  Genomes in Avida are logically (not physically) circular, but substring matches in general do not 
  respect circularity.  To respect the logical circularity of genomes in Avida, we append the base
  string with substring-size instructions from the beginning of the base string.  This guarantees 
- that circular matches are detected.
+ that circular matches are detected.  Both the rotation and the appended instructions are read in
+ place from base; no copy of the genome is made.
  
  The return value here is de-circularfied and de-rotated such that [begin,end) are correct
  for the base string (note that, due to circularity, begin could be > end).
  */
 cGenomeUtil::substring_match cGenomeUtil::FindUnbiasedCircularMatch(cAvidaContext& ctx, const InstructionSequence& base, const InstructionSequence& substring) {
-	// create a copy of the genome:
-	InstructionSequence circ(base);
-	
-	// rotate it so that we remove bias for matching at the front of the genome:
-	const int rotate = ctx.GetRandom().GetInt(circ.GetSize());
-	circ.Rotate(rotate);
+	assert(substring.GetSize() > 0 && substring.GetSize() <= base.GetSize());
 	
-	// need to take circularity of the genome into account.
-	// we can do this by appending the genome with a copy of its first substring-size instructions.
-	InstructionSequence head = circ.Crop(0, substring.GetSize());
-	circ.Append(head);
+	// rotate so that we remove bias for matching at the front of the genome; rotating by r
+	// moves the last r instructions to the front:
+	const int rotate = ctx.GetRandom().GetInt(base.GetSize());
+	const int start = (rotate == 0) ? 0 : base.GetSize() - rotate;
 	
 	// find the location within the circular genome that best matches substring:
-	cGenomeUtil::substring_match location = FindSubstringMatch(circ, substring);	
+	cGenomeUtil::substring_match location = find_substring_match(match_text(base, start, base.GetSize() + substring.GetSize()), substring);
 	
 	// unwind the resizing & rotation:
 	location.resize(base.GetSize());
@@ -155,7 +155,7 @@ void cGradientCount::updatePeakRes(cAvidaContext& ctx)
     int min_pos_y = max(m_peaky - m_spread - 1, 0);
     for (int ii = min_pos_x; ii < max_pos_x + 1; ii++) {
       for (int jj = min_pos_y; jj < max_pos_y + 1; jj++) {
-        if (Element(jj * GetX() + ii).GetAmount() >= 1) {
+        if (GetElementAmount(jj * GetX() + ii) >= 1) {
           has_edible = true;
           break;
         }
@@ -378,7 +378,7 @@ void cGradientCount::fillinResourceValues()
               thisheight = 0;
             }
             else {
-              double past_height = Element(old_cell_y * GetX() + old_cell_x).GetAmount(); 
+              double past_height = GetElementAmount(old_cell_y * GetX() + old_cell_x); 
               double newheight = past_height; 
               if (m_cone_inflow > 0 || m_cone_outflow > 0) newheight += m_cone_inflow - (past_height * m_cone_outflow);
               if (m_gradient_inflow > 0) newheight += m_gradient_inflow / (thisdist + 1); 
@@ -389,7 +389,7 @@ void cGradientCount::fillinResourceValues()
           }
         }
       }
-      Element(jj * GetX() + ii).SetAmount(thisheight);
+      SetElementAmount(jj * GetX() + ii, thisheight);
       if (thisheight > 0) updateBounds(ii, jj);
     }
   }         
@@ -415,7 +415,7 @@ void cGradientCount::getCurrentPlatValues()
       double find_plat_dist = temp_height / (thisdist + 1);
       if ((find_plat_dist >= 1 && m_plateau >= 0) || (m_plateau < 0 && thisdist == 0 && m_plateau_array.GetSize() > 0)) {
         double past_cell_height = m_plateau_array[plateau_cell];
-        double pre_move_height = Element(m_plateau_cell_IDs[plateau_cell]).GetAmount();  
+        double pre_move_height = GetElementAmount(m_plateau_cell_IDs[plateau_cell]);  
         if (pre_move_height < past_cell_height) {
           m_plateau_array[plateau_cell] = pre_move_height; 
           amount_devoured = amount_devoured + past_cell_height - pre_move_height;
@@ -661,13 +661,13 @@ void cGradientCount::generateBarrier(cAvidaContext& ctx)
     // clear any old resource
     if (m_wall_cells.GetSize()) {
       for (int i = 0; i < m_wall_cells.GetSize(); i++) {
-        Element(m_wall_cells[i]).SetAmount(0);
+        SetElementAmount(m_wall_cells[i], 0);
       }
     }
     else {
       for (int ii = 0; ii < GetX(); ii++) {
         for (int jj = 0; jj < GetY(); jj++) {
-          Element(jj * GetX() + ii).SetAmount(0);
+          SetElementAmount(jj * GetX() + ii, 0);
         }
       }
     }
@@ -685,7 +685,7 @@ void cGradientCount::generateBarrier(cAvidaContext& ctx)
         start_randx = ctx.GetRandom().GetUInt(0, GetX());
         start_randy = ctx.GetRandom().GetUInt(0, GetY());  
       }
-      Element(start_randy * GetX() + start_randx).SetAmount(m_plateau);
+      SetElementAmount(start_randy * GetX() + start_randx, m_plateau);
       // if (m_plateau > 0) updateBounds(start_randx, start_randy);
       updateBounds(start_randx, start_randy);
       m_wall_cells.Push(start_randy * GetX() + start_randx);
@@ -779,12 +779,12 @@ void cGradientCount::generateBarrier(cAvidaContext& ctx)
                randy < (m_halo_anchor_y + m_halo_inner_radius) && 
                randx > (m_halo_anchor_x - m_halo_inner_radius) && 
                randy > (m_halo_anchor_y - m_halo_inner_radius)) || 
-              (m_config == 0 && Element(randy * GetX() + randx).GetAmount())) {
+              (m_config == 0 && GetElementAmount(randy * GetX() + randx))) {
             num_blocks --;
             count_block = false;
           }
           if (count_block) {
-            Element(randy * GetX() + randx).SetAmount(m_plateau);
+            SetElementAmount(randy * GetX() + randx, m_plateau);
             if (m_plateau > 0) updateBounds(randx, randy);
             m_wall_cells.Push(randy * GetX() + randx);
             if (place_corner) {
@@ -793,7 +793,7 @@ void cGradientCount::generateBarrier(cAvidaContext& ctx)
                      cornery < (m_halo_anchor_y + m_halo_inner_radius) && 
                      cornerx > (m_halo_anchor_x - m_halo_inner_radius) && 
                      cornery > (m_halo_anchor_y - m_halo_inner_radius))) ){
-                  Element(cornery * GetX() + cornerx).SetAmount(m_plateau);
+                  SetElementAmount(cornery * GetX() + cornerx, m_plateau);
                   if (m_plateau > 0) updateBounds(cornerx, cornery);
                   m_wall_cells.Push(randy * GetX() + randx);
                 }
@@ -832,14 +832,14 @@ void cGradientCount::generateHills(cAvidaContext& ctx)
     if (m_min_usedx == -1 || m_min_usedy == -1 || m_max_usedx == -1 || m_max_usedy == -1) {
       for (int ii = 0; ii < GetX(); ii++) {
         for (int jj = 0; jj < GetY(); jj++) {
-          Element(jj * GetX() + ii).SetAmount(0);
+          SetElementAmount(jj * GetX() + ii, 0);
         }
       }
     }
     else {
       for (int ii = m_min_usedx; ii < m_max_usedx + 1; ii++) {
         for (int jj = m_min_usedy; jj < m_max_usedy + 1; jj++) {
-          Element(jj * GetX() + ii).SetAmount(0);
+          SetElementAmount(jj * GetX() + ii, 0);
         }
       }
     }
@@ -879,9 +879,9 @@ void cGradientCount::generateHills(cAvidaContext& ctx)
           double thisheight = 0.0;
           double thisdist = sqrt((double) (m_peakx - ii) * (m_peakx - ii) + (m_peaky - jj) * (m_peaky - jj));
           // only plot values when within set config radius & if no larger amount has already been plotted for another overlapping hill
-          if ((thisdist <= rand_hill_radius) && (Element(jj * GetX() + ii).GetAmount() <  m_plateau / (thisdist + 1))) {
+          if ((thisdist <= rand_hill_radius) && (GetElementAmount(jj * GetX() + ii) <  m_plateau / (thisdist + 1))) {
           thisheight = m_plateau / (thisdist + 1);
-          Element(jj * GetX() + ii).SetAmount(thisheight);
+          SetElementAmount(jj * GetX() + ii, thisheight);
           if (thisheight > 0) updateBounds(ii, jj);
           }
         }
@@ -970,7 +970,7 @@ void cGradientCount::UpdatePredatoryRes(cAvidaContext& ctx)
   // kill off up to 1 org per update within the predator radius (plateau area), with prob of death for selected prey = m_pred_odds
   if (m_predator) {
     for (int i = 0; i < m_plateau_cell_IDs.GetSize(); i ++) {
-      if (Element(m_plateau_cell_IDs[i]).GetAmount() >= 1) {
+      if (GetElementAmount(m_plateau_cell_IDs[i]) >= 1) {
         m_world->GetPopulation().ExecutePredatoryResource(ctx, m_plateau_cell_IDs[i], m_pred_odds, m_guarded_juvs_per_adult, m_hammer);
       }
     }
@@ -989,7 +989,7 @@ void cGradientCount::UpdateDamagingRes(cAvidaContext& ctx)
   // we don't call this for walls and hills because they never move
   if (m_damage) {
     for (int i = 0; i < m_plateau_cell_IDs.GetSize(); i ++) {
-      if (Element(m_plateau_cell_IDs[i]).GetAmount() >= m_threshold) {
+      if (GetElementAmount(m_plateau_cell_IDs[i]) >= m_threshold) {
         // skip if initiating world and resources (cells don't exist yet)
         if (ctx.HasDriver()) m_world->GetPopulation().ExecuteDamagingResource(ctx, m_plateau_cell_IDs[i], m_damage, m_hammer);
       }
@@ -1002,7 +1002,7 @@ void cGradientCount::UpdateDeadlyRes(cAvidaContext& ctx)
   // we don't call this for walls and hills because they never move
   if (m_deadly) {
     for (int i = 0; i < m_plateau_cell_IDs.GetSize(); i ++) {
-      if (Element(m_plateau_cell_IDs[i]).GetAmount() >= m_threshold) {
+      if (GetElementAmount(m_plateau_cell_IDs[i]) >= m_threshold) {
         // skip if initiating world and resources (cells don't exist yet)
         if (ctx.HasDriver()) m_world->GetPopulation().ExecuteDeadlyResource(ctx, m_plateau_cell_IDs[i], m_death_odds, m_hammer);
       }
@@ -1044,7 +1044,7 @@ void cGradientCount::BuildProbabilisticRes(cAvidaContext& ctx, double lambda, do
 
   // only if theta == 1 do want want a 'hill' with resource for certain in the center
   if (theta == 0) {
-    Element(m_peaky * worldx + m_peakx).SetAmount(m_initial_plat);
+    SetElementAmount(m_peaky * worldx + m_peakx, m_initial_plat);
     if (m_initial_plat > 0) updateBounds(m_peakx, m_peaky);
     if (m_plateau_outflow > 0 || m_plateau_inflow > 0) { 
       if (num_cells == -1) m_prob_res_cells.Push(m_peaky * worldx + m_peakx);
@@ -1079,7 +1079,7 @@ void cGradientCount::BuildProbabilisticRes(cAvidaContext& ctx, double lambda, do
     double this_prob = (1/lambda) * (sqrt(2 / 3.14159)) * exp(-0.5 * pow(((cell_dist - theta) / lambda), 2));
     
     if (ctx.GetRandom().P(this_prob)) {
-      Element(cell_id).SetAmount(m_initial_plat);
+      SetElementAmount(cell_id, m_initial_plat);
       if (m_initial_plat > 0) updateBounds(this_x, this_y);
       if (m_plateau_outflow > 0 || m_plateau_inflow > 0) {
         if (loop_once) m_prob_res_cells.Push(cell_id);
@@ -1090,7 +1090,7 @@ void cGradientCount::BuildProbabilisticRes(cAvidaContext& ctx, double lambda, do
     }
     // just push this cell out of the way for this loop, but keep it around for next time
     else { 
-      Element(cell_id).SetAmount(0); 
+      SetElementAmount(cell_id, 0); 
       cell_id_array.Swap(cell_idx, max_unused_idx--);
     }
 
@@ -1106,9 +1106,9 @@ void cGradientCount::UpdateProbabilisticRes()
 {
   if (m_plateau_outflow > 0 || m_plateau_inflow > 0) {
     for (int i = 0; i < m_prob_res_cells.GetSize(); i++) {
-      double curr_val = Element(m_prob_res_cells[i]).GetAmount();
+      double curr_val = GetElementAmount(m_prob_res_cells[i]);
       double amount = curr_val + m_plateau_inflow - (curr_val * m_plateau_outflow);
-      Element(m_prob_res_cells[i]).SetAmount(amount); 
+      SetElementAmount(m_prob_res_cells[i], amount); 
       if (amount > 0) updateBounds(m_prob_res_cells[i] % GetX(), m_prob_res_cells[i] / GetX());
     }
   }
@@ -1118,7 +1118,7 @@ void cGradientCount::clearExistingProbRes()
 {
   for (int x = m_min_usedx; x < m_max_usedx + 1; x ++) {
     for (int y = m_min_usedy; y < m_max_usedy + 1; y ++) {
-      Element(y * GetX() + x).SetAmount(0);
+      SetElementAmount(y * GetX() + x, 0);
     }
   }
 }
@@ -0,0 +1,278 @@
+/*
+ *  cGridDump.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cGridDump.h"
+
+#include "avida/core/Feedback.h"
+#include "avida/core/WorldDriver.h"
+#include "avida/output/Manager.h"
+
+#include "apto/core/Thread.h"
+
+#include "cWorld.h"
+
+#include <cstring>
+#include <fstream>
+
+using namespace Avida;
+
+
+namespace {
+  const char CONTAINER_MAGIC[] = "AVGRID01";
+  const unsigned int DELTA_FRAMES = 1;
+  const int HEADER_SIZE = 32;
+  const int INDEX_OFFSET_POS = 24;
+
+  void putU32(Apto::Array<unsigned char>& buf, unsigned int value)
+  {
+    for (int i = 0; i < 4; i++) buf.Push(static_cast<unsigned char>(value >> (8 * i)));
+  }
+
+  void putU64(Apto::Array<unsigned char>& buf, unsigned long long value)
+  {
+    for (int i = 0; i < 8; i++) buf.Push(static_cast<unsigned char>(value >> (8 * i)));
+  }
+
+  void putVarint(Apto::Array<unsigned char>& buf, unsigned int value)
+  {
+    while (value >= 0x80) {
+      buf.Push(static_cast<unsigned char>(value | 0x80));
+      value >>= 7;
+    }
+    buf.Push(static_cast<unsigned char>(value));
+  }
+
+  void writeBuffer(std::ofstream& fp, const Apto::Array<unsigned char>& buf)
+  {
+    if (buf.GetSize()) fp.write(reinterpret_cast<const char*>(&buf[0]), buf.GetSize());
+  }
+};
+
+
+class cGridDump::cContainer
+{
+public:
+  const eValueType type;
+  const int rows;
+  const int cols;
+
+private:
+  std::ofstream m_fp;
+  bool m_delta_frames;
+  unsigned long long m_offset;
+
+  // Writer thread state
+  Apto::Array<unsigned char> m_plane;
+  Apto::Array<unsigned char> m_prev_plane;
+  Apto::Array<unsigned char> m_buf;
+  Apto::Array<int> m_index_updates;
+  Apto::Array<unsigned long long> m_index_offsets;
+
+public:
+  cContainer(const cString& path, eValueType in_type, int in_rows, int in_cols, bool delta_frames)
+    : type(in_type), rows(in_rows), cols(in_cols), m_fp((const char*)path, std::ios::out | std::ios::binary | std::ios::trunc)
+    , m_delta_frames(delta_frames), m_offset(0)
+  {
+    m_buf.Resize(0);
+    for (int i = 0; i < 8; i++) m_buf.Push(static_cast<unsigned char>(CONTAINER_MAGIC[i]));
+    putU32(m_buf, static_cast<unsigned int>(type));
+    putU32(m_buf, static_cast<unsigned int>(rows));
+    putU32(m_buf, static_cast<unsigned int>(cols));
+    putU32(m_buf, m_delta_frames ? DELTA_FRAMES : 0);
+    putU64(m_buf, 0);
+    assert(m_buf.GetSize() == HEADER_SIZE);
+    writeBuffer(m_fp, m_buf);
+    m_offset = HEADER_SIZE;
+  }
+
+  ~cContainer()
+  {
+    // Append the index and record where it starts in the header
+    const unsigned long long index_offset = m_offset;
+    m_buf.Resize(0);
+    putU32(m_buf, static_cast<unsigned int>(m_index_updates.GetSize()));
+    for (int i = 0; i < m_index_updates.GetSize(); i++) {
+      putU32(m_buf, static_cast<unsigned int>(m_index_updates[i]));
+      putU64(m_buf, m_index_offsets[i]);
+    }
+    writeBuffer(m_fp, m_buf);
+
+    m_buf.Resize(0);
+    putU64(m_buf, index_offset);
+    m_fp.seekp(INDEX_OFFSET_POS);
+    writeBuffer(m_fp, m_buf);
+    m_fp.close();
+  }
+
+  bool Good() const { return m_fp.good(); }
+
+  void WriteFrame(int update, const Apto::Array<double>& values);
+};
+
+
+void cGridDump::cContainer::WriteFrame(int update, const Apto::Array<double>& values)
+{
+  // Encode the plane
+  m_plane.Resize(0);
+  for (int i = 0; i < values.GetSize(); i++) {
+    if (type == INT_VALUES) {
+      putU32(m_plane, static_cast<unsigned int>(static_cast<int>(values[i])));
+    } else {
+      unsigned long long bits;
+      memcpy(&bits, &values[i], sizeof(bits));
+      putU64(m_plane, bits);
+    }
+  }
+
+  unsigned int frame_flags = 0;
+  const Apto::Array<unsigned char>* payload = &m_plane;
+  if (m_delta_frames) {
+    const bool keyframe = (m_index_updates.GetSize() % KEYFRAME_INTERVAL) == 0;
+    if (!keyframe) frame_flags |= DELTA_FRAMES;
+
+    Apto::Array<unsigned char> delta(m_plane);
+    if (!keyframe) for (int i = 0; i < delta.GetSize(); i++) delta[i] ^= m_prev_plane[i];
+    m_prev_plane = m_plane;
+
+    // Zero run / literal run coding
+    m_buf.Resize(0);
+    int pos = 0;
+    while (pos < delta.GetSize()) {
+      int zeros = 0;
+      while (pos + zeros < delta.GetSize() && delta[pos + zeros] == 0) zeros++;
+      int literals = 0;
+      while (pos + zeros + literals < delta.GetSize() && delta[pos + zeros + literals] != 0) literals++;
+      putVarint(m_buf, zeros);
+      putVarint(m_buf, literals);
+      for (int i = 0; i < literals; i++) m_buf.Push(delta[pos + zeros + i]);
+      pos += zeros + literals;
+    }
+    payload = &m_buf;
+  }
+
+  m_index_updates.Push(update);
+  m_index_offsets.Push(m_offset);
+
+  Apto::Array<unsigned char> frame_header;
+  putU32(frame_header, static_cast<unsigned int>(update));
+  putU32(frame_header, frame_flags);
+  putU32(frame_header, static_cast<unsigned int>(payload->GetSize()));
+  writeBuffer(m_fp, frame_header);
+  writeBuffer(m_fp, *payload);
+  m_offset += frame_header.GetSize() + payload->GetSize();
+}
+
+
+class cGridDump::cWriter : public Apto::Thread
+{
+private:
+  cGridDump* m_dump;
+
+  void Run() { m_dump->runWriter(); }
+
+public:
+  cWriter(cGridDump* dump) : m_dump(dump) { ; }
+};
+
+
+cGridDump::cGridDump(cWorld* world, bool delta_frames, int queue_size)
+  : m_world(world), m_delta_frames(delta_frames), m_queue_size((queue_size > 0) ? queue_size : 1), m_closing(false)
+{
+  m_writer = new cWriter(this);
+  m_writer->Start();
+}
+
+cGridDump::~cGridDump()
+{
+  Finish();
+}
+
+
+void cGridDump::Finish()
+{
+  if (!m_writer) return;
+
+  // Let the writer drain the queue, then finish each container
+  m_mutex.Lock();
+  m_closing = true;
+  m_mutex.Unlock();
+  m_queue_cond.Signal();
+
+  m_writer->Join();
+  delete m_writer;
+  m_writer = NULL;
+
+  Apto::Map<Apto::String, cContainer*>::ValueIterator it = m_containers.Values();
+  while (it.Next()) delete *it.Get();
+  m_containers.Clear();
+}
+
+
+cGridDump::cFrame* cGridDump::CreateFrame(const cString& path, eValueType type, int rows, int cols, int update)
+{
+  if (!m_writer) return NULL;
+
+  cContainer* container = NULL;
+  if (!m_containers.Get((const char*)path, container)) {
+    cString full_path((const char*)Output::Manager::Of(m_world->GetNewWorld())->OutputIDFromPath((const char*)path));
+    container = new cContainer(full_path, type, rows, cols, m_delta_frames);
+    if (!container->Good()) {
+      m_world->GetDriver().Feedback().Error("unable to open grid dump container '%s'", (const char*)full_path);
+      delete container;
+      return NULL;
+    }
+    m_containers.Set((const char*)path, container);
+  }
+
+  if (container->type != type || container->rows != rows || container->cols != cols) {
+    m_world->GetDriver().Feedback().Error("grid dump container '%s' holds a different grid", (const char*)path);
+    return NULL;
+  }
+
+  return new cFrame(container, update, rows * cols);
+}
+
+
+void cGridDump::Submit(cFrame* frame)
+{
+  m_mutex.Lock();
+  while (m_queue.GetSize() >= m_queue_size) m_space_cond.Wait(m_mutex);
+  m_queue.PushRear(frame);
+  m_mutex.Unlock();
+  m_queue_cond.Signal();
+}
+
+
+void cGridDump::runWriter()
+{
+  while (true) {
+    m_mutex.Lock();
+    while (m_queue.GetSize() == 0 && !m_closing) m_queue_cond.Wait(m_mutex);
+    cFrame* frame = m_queue.Pop();
+    m_mutex.Unlock();
+
+    // Queue is empty only when closing
+    if (!frame) break;
+    m_space_cond.Signal();
+
+    frame->m_container->WriteFrame(frame->m_update, frame->m_values);
+    delete frame;
+  }
+}
@@ -0,0 +1,116 @@
+/*
+ *  cGridDump.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cGridDump_h
+#define cGridDump_h
+
+#include "apto/core.h"
+
+#include "cString.h"
+#include "tList.h"
+
+class cWorld;
+
+
+// cGridDump - Binary time-series containers for the Dump*Grid actions
+//
+// With GRID_DUMP_FORMAT set, each grid type is written to a single container file instead of one text file per update.
+// Frames are filled on the simulation thread and handed through a bounded queue (GRID_DUMP_QUEUE_SIZE frames) to a
+// background writer thread, which encodes and writes them.  The simulation thread only waits if the writer falls that
+// many frames behind.  utils/grid_dump converts containers back to the text layout.
+//
+// Container layout, all integers little-endian:
+//
+//   header    "AVGRID01", uint32 value type (0 = int32, 1 = float64), uint32 rows, uint32 cols,
+//             uint32 flags (1 = delta frames), uint64 offset of the index (0 if the run did not finish cleanly)
+//   frame     int32 update, uint32 frame flags (1 = delta), uint32 payload size, payload
+//   index     uint32 frame count, then per frame: int32 update, uint64 offset of the frame
+//
+// A plane is rows * cols values in text order.  Payloads of containers without delta frames are the raw plane.
+// Otherwise the plane bytes are XORed with those of the previous frame (or left as is for key frames, every
+// KEYFRAME_INTERVAL frames, so that any frame can be found from the index) and coded as repeated
+// [varint zero bytes][varint literal bytes][literal bytes] runs.
+
+class cGridDump
+{
+public:
+  enum eValueType { INT_VALUES = 0, DOUBLE_VALUES = 1 };
+
+  static const int KEYFRAME_INTERVAL = 32;
+
+private:
+  class cContainer;
+  class cWriter;
+
+public:
+  class cFrame
+  {
+    friend class cGridDump;
+  private:
+    cContainer* m_container;
+    int m_update;
+    Apto::Array<double> m_values;
+    int m_count;
+
+    cFrame(cContainer* container, int update, int size)
+      : m_container(container), m_update(update), m_values(size), m_count(0) { m_values.SetAll(0.0); }
+
+  public:
+    void Add(double value) { if (m_count < m_values.GetSize()) m_values[m_count++] = value; }
+  };
+
+private:
+  cWorld* m_world;
+  bool m_delta_frames;
+  int m_queue_size;
+
+  Apto::Map<Apto::String, cContainer*> m_containers;  // simulation thread only
+
+  Apto::Mutex m_mutex;
+  Apto::ConditionVariable m_queue_cond;   // frames queued or closing
+  Apto::ConditionVariable m_space_cond;   // frames removed from the queue
+  tList<cFrame> m_queue;
+  bool m_closing;
+  cWriter* m_writer;
+
+
+  cGridDump(); // @not_implemented
+  cGridDump(const cGridDump&); // @not_implemented
+  cGridDump& operator=(const cGridDump&); // @not_implemented
+
+  void runWriter();
+
+public:
+  cGridDump(cWorld* world, bool delta_frames, int queue_size);
+  ~cGridDump();
+
+  // Start a frame of the container at path (relative to the data directory), opening the container if needed.
+  // Returns NULL if the container cannot be opened or holds a different type or shape of grid.
+  cFrame* CreateFrame(const cString& path, eValueType type, int rows, int cols, int update);
+
+  // Queue a completed frame for the writer thread, which takes ownership of it
+  void Submit(cFrame* frame);
+
+  // Write out all queued frames, stop the writer thread and complete every container with its index.  Drivers call
+  // this before exiting, as the world is not always destroyed.  No further frames are accepted afterwards.
+  void Finish();
+};
+
+#endif
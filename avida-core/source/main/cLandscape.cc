@@ -38,6 +38,7 @@
 cLandscape::cLandscape(cWorld* world, const Genome& in_genome)
 : m_world(world), trials(1), m_min_found(0), m_max_trials(0), site_count(NULL)
 {
+  m_cpu_test_info.UseResultCache();
   Reset(in_genome);
 }
 
@@ -96,7 +97,7 @@ void cLandscape::Reset(const Genome& in_genome)
 
 double cLandscape::ProcessGenome(cAvidaContext& ctx, cTestCPU* testcpu, Genome& in_genome)
 {
-  testcpu->TestGenome(ctx, m_cpu_test_info, in_genome);
+  testcpu->TestGenome(ctx, m_cpu_test_info, in_genome, base_snapshots);
   
   double test_fitness = m_cpu_test_info.GetColonyFitness();
   
@@ -126,12 +127,11 @@ void cLandscape::ProcessBase(cAvidaContext& ctx, cTestCPU* testcpu)
 {
   // Collect info on base creature.
   
-  testcpu->TestGenome(ctx, m_cpu_test_info, base_genome);
+  testcpu->RecordSnapshots(ctx, m_cpu_test_info, base_genome, base_snapshots);
   
-  cPhenotype & phenotype = m_cpu_test_info.GetColonyOrganism()->GetPhenotype();
   base_fitness = m_cpu_test_info.GetColonyFitness();
-  base_merit = phenotype.GetMerit().GetDouble();
-  base_gestation = phenotype.GetGestationTime();
+  base_merit = m_cpu_test_info.GetColonyMerit();
+  base_gestation = m_cpu_test_info.GetColonyGestationTime();
   
   peak_fitness = base_fitness;
   peak_genome = base_genome;
@@ -883,8 +883,10 @@ void cLandscape::HillClimb(cAvidaContext& ctx, Avida::Output::File& df)
     
     pos_frac = GetProbPos();
     
-    // Print the information on the current best.
+    // Print the information on the current best.  This reads the colony phenotype, so it is never a cached result.
+    m_cpu_test_info.UseResultCache(false);
     testcpu->TestGenome(ctx, m_cpu_test_info, cur_genome);
+    m_cpu_test_info.UseResultCache();
     cPhenotype& colony_phenotype = m_cpu_test_info.GetColonyOrganism()->GetPhenotype();
     df.Write(gen, "Generation");
     df.Write(colony_phenotype.GetMerit().GetDouble(), "Merit");
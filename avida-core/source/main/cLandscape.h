@@ -28,6 +28,7 @@
 #include "avida/output/Types.h"
 
 #include "cCPUTestInfo.h"
+#include "cTestCPUSnapshots.h"
 #include "tMatrix.h"
 
 class cAvidaContext;
@@ -44,6 +45,7 @@ private:
   cWorld* m_world;
   cCPUTestInfo m_cpu_test_info;
   Genome base_genome;
+  cTestCPUSnapshots base_snapshots;  // gestation snapshots of the base genome, for resuming point mutants
   Genome peak_genome;
   double base_fitness;
   double base_merit;
@@ -114,6 +116,7 @@ public:
   inline void SetCPUTestInfo(const cCPUTestInfo& in_cpu_test_info) 
   { 
       m_cpu_test_info = in_cpu_test_info; 
+      m_cpu_test_info.UseResultCache();
   }
 
   void SampleProcess(cAvidaContext& ctx);
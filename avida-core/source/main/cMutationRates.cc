@@ -24,6 +24,10 @@
 
 #include "cWorld.h"
 #include "cAvidaConfig.h"
+#include "cCheckpoint.h"
+
+#include <climits>
+#include <cmath>
 
 
 void cMutationRates::Setup(cWorld* world)
@@ -73,6 +77,9 @@ void cMutationRates::Setup(cWorld* world)
   meta.standard_dev = world->GetConfig().META_STD_DEV.Get();
 
   update.death_prob = world->GetConfig().DEATH_PROB.Get();  
+  
+  m_copy_countdown = (world->GetConfig().COPY_MUT_SAMPLING.Get() == 1);
+  resetCopyCountdowns();
 }
 
 void cMutationRates::Clear()
@@ -122,6 +129,9 @@ void cMutationRates::Clear()
   meta.standard_dev = 0.0;
 
   update.death_prob = 0.0;
+  
+  m_copy_countdown = false;
+  resetCopyCountdowns();
 }
 
 void cMutationRates::Copy(const cMutationRates& in_muts)
@@ -132,4 +142,31 @@ void cMutationRates::Copy(const cMutationRates& in_muts)
   inject = in_muts.inject;
   meta = in_muts.meta;
   update = in_muts.update;
+  
+  // Countdowns are not inherited; each series of copies starts from a fresh draw
+  m_copy_countdown = in_muts.m_copy_countdown;
+  resetCopyCountdowns();
+}
+
+
+void cMutationRates::SaveCopyCheckpoint(cCheckpointWriter& cp) const
+{
+  cp.Write(copy);
+  for (int i = 0; i < NUM_COPY_MUT_TYPES; i++) cp.Write(m_copy_countdowns[i]);
+}
+
+void cMutationRates::LoadCopyCheckpoint(cCheckpointReader& cp)
+{
+  cp.Read(copy);
+  for (int i = 0; i < NUM_COPY_MUT_TYPES; i++) cp.Read(m_copy_countdowns[i]);
+}
+
+
+// Number of copies that succeed before the next mutation occurs, drawn from the geometric distribution with success
+// probability prob.  Each copy then remains an independent Bernoulli trial, so mutation statistics are unchanged.
+int cMutationRates::drawCopyCountdown(cAvidaContext& ctx, double prob)
+{
+  if (prob >= 1.0) return 0;
+  const double skip = floor(log(1.0 - ctx.GetRandom().GetDouble()) / log(1.0 - prob));
+  return (skip < INT_MAX) ? (int)skip : INT_MAX;
 }
@@ -25,6 +25,8 @@
 
 #include "cAvidaContext.h"
 
+class cCheckpointReader;
+class cCheckpointWriter;
 class cWorld;
 
 class cMutationRates
@@ -98,6 +100,15 @@ private:
   };
   sUpdateMuts update;
 
+  // Geometric countdowns to the next copy mutation of each type (COPY_MUT_SAMPLING = 1)
+  enum { COPY_MUT = 0, COPY_INS, COPY_DEL, COPY_UNIFORM, COPY_SLIP, NUM_COPY_MUT_TYPES };
+  bool m_copy_countdown;
+  mutable int m_copy_countdowns[NUM_COPY_MUT_TYPES];
+  
+  inline bool testCopyMut(cAvidaContext& ctx, int type, double prob) const;
+  static int drawCopyCountdown(cAvidaContext& ctx, double prob);
+  void resetCopyCountdowns() const { for (int i = 0; i < NUM_COPY_MUT_TYPES; i++) m_copy_countdowns[i] = -1; }
+
 public:
   cMutationRates() { Clear(); }
   cMutationRates(const cMutationRates& in_muts) { Copy(in_muts); }
@@ -107,15 +118,19 @@ public:
   void Setup(cWorld* world);
   void Clear();
   void Copy(const cMutationRates& in_muts);
+  
+  // Copy mutation rates and countdowns, so that a restored organism continues its series of copies
+  void SaveCopyCheckpoint(cCheckpointWriter& cp) const;
+  void LoadCopyCheckpoint(cCheckpointReader& cp);
 
   // Copy muts should always check if they are 0.0 before consulting the random number generator for performance
-  bool TestCopyMut(cAvidaContext& ctx) const { return (copy.mut_prob == 0.0) ? false : ctx.GetRandom().P(copy.mut_prob); }
-  bool TestCopyIns(cAvidaContext& ctx) const { return (copy.ins_prob == 0.0) ? false : ctx.GetRandom().P(copy.ins_prob); }
-  bool TestCopyDel(cAvidaContext& ctx) const { return (copy.del_prob == 0.0) ? false : ctx.GetRandom().P(copy.del_prob); }
-  bool TestCopySlip(cAvidaContext& ctx) const { return (copy.slip_prob == 0.0) ? false : ctx.GetRandom().P(copy.slip_prob); }
+  bool TestCopyMut(cAvidaContext& ctx) const { return (copy.mut_prob == 0.0) ? false : testCopyMut(ctx, COPY_MUT, copy.mut_prob); }
+  bool TestCopyIns(cAvidaContext& ctx) const { return (copy.ins_prob == 0.0) ? false : testCopyMut(ctx, COPY_INS, copy.ins_prob); }
+  bool TestCopyDel(cAvidaContext& ctx) const { return (copy.del_prob == 0.0) ? false : testCopyMut(ctx, COPY_DEL, copy.del_prob); }
+  bool TestCopySlip(cAvidaContext& ctx) const { return (copy.slip_prob == 0.0) ? false : testCopyMut(ctx, COPY_SLIP, copy.slip_prob); }
   bool TestCopyUniform(cAvidaContext& ctx) const
   {
-    return (copy.uniform_prob == 0.0) ? false : ctx.GetRandom().P(copy.uniform_prob);
+    return (copy.uniform_prob == 0.0) ? false : testCopyMut(ctx, COPY_UNIFORM, copy.uniform_prob);
   }
   
   bool TestDivideMut(cAvidaContext& ctx) const { return ctx.GetRandom().P(divide.divide_mut_prob); }
@@ -155,6 +170,7 @@ public:
     const double exp = ctx.GetRandom().GetRandNormal() * meta.standard_dev;
     const double change = pow(2.0, exp);
     copy.mut_prob *= change;
+    m_copy_countdowns[COPY_MUT] = -1;
     return change;
   }
 
@@ -201,11 +217,11 @@ public:
   double GetDeathProb() const         { return update.death_prob; }
 
   
-  void SetCopyMutProb(double in_prob)       { copy.mut_prob = in_prob; }
-  void SetCopyInsProb(double in_prob)       { copy.ins_prob = in_prob; }
-  void SetCopyDelProb(double in_prob)       { copy.del_prob = in_prob; }
-  void SetCopyUniformProb(double in_prob)   { copy.uniform_prob = in_prob; }
-  void SetCopySlipProb(double in_prob)      { copy.slip_prob = in_prob; }
+  void SetCopyMutProb(double in_prob)       { copy.mut_prob = in_prob; m_copy_countdowns[COPY_MUT] = -1; }
+  void SetCopyInsProb(double in_prob)       { copy.ins_prob = in_prob; m_copy_countdowns[COPY_INS] = -1; }
+  void SetCopyDelProb(double in_prob)       { copy.del_prob = in_prob; m_copy_countdowns[COPY_DEL] = -1; }
+  void SetCopyUniformProb(double in_prob)   { copy.uniform_prob = in_prob; m_copy_countdowns[COPY_UNIFORM] = -1; }
+  void SetCopySlipProb(double in_prob)      { copy.slip_prob = in_prob; m_copy_countdowns[COPY_SLIP] = -1; }
   
   void SetDivMutProb(double in_prob)        { divide.mut_prob = in_prob; }
   void SetDivInsProb(double in_prob)        { divide.ins_prob = in_prob; }
@@ -241,4 +257,20 @@ public:
   void SetDeathProb(double in_prob)         { update.death_prob      = in_prob; }
 };
 
+
+inline bool cMutationRates::testCopyMut(cAvidaContext& ctx, int type, double prob) const
+{
+  if (!m_copy_countdown) return ctx.GetRandom().P(prob);
+  
+  // Count down the copies remaining until the next mutation of this type, drawing a new distance after each event
+  int& countdown = m_copy_countdowns[type];
+  if (countdown < 0) countdown = drawCopyCountdown(ctx, prob);
+  if (countdown > 0) {
+    countdown--;
+    return false;
+  }
+  countdown = -1;
+  return true;
+}
+
 #endif
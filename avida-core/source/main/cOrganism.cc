@@ -26,6 +26,7 @@
 #include "avida/core/WorldDriver.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
 #include "cContextPhenotype.h"
 #include "cDeme.h"
 #include "cEnvironment.h"
@@ -109,6 +110,15 @@ public:
 struct OrgGlobalPropMap
 {
   Apto::Map<Apto::String, OrgPropRetrievalContainer*> prop_map;
+  Apto::Array<OrgPropRetrievalContainer*, Apto::Smart> by_atom;  // the same containers indexed by atom, NULL elsewhere
+  
+  void Define(const PropertyID& prop_id, OrgPropRetrievalContainer* container)
+  {
+    prop_map.Set(prop_id, container);
+    PropertyAtom atom = PropertyAtoms::Intern(prop_id);
+    if (by_atom.GetSize() <= atom) by_atom.Resize(atom + 1, NULL);
+    by_atom[atom] = container;
+  }
   
   ~OrgGlobalPropMap()
   {
@@ -127,7 +137,7 @@ typedef Apto::SingletonHolder<OrgGlobalPropMap, Apto::CreateWithNew, Apto::Destr
 void cOrganism::Initialize()
 {
 #define DEFINE_PROP(NAME, TYPE, FUNCTION, DESC) s_prop_desc_map.Set(s_prop_name_ ## NAME, DESC); \
-  OrgGlobalPropMapSingleton::Instance().prop_map.Set(s_prop_name_ ## NAME, new OrgPropOfType<TYPE>(s_prop_name_ ## NAME, &cOrganism::FUNCTION));
+  OrgGlobalPropMapSingleton::Instance().Define(s_prop_name_ ## NAME, new OrgPropOfType<TYPE>(s_prop_name_ ## NAME, &cOrganism::FUNCTION));
   DEFINE_PROP(genome, Apto::String, getGenomeString, "Genome");
   DEFINE_PROP(src_transmission_type, int, getSrcTransmissionType, "Source Transmission Type");
   DEFINE_PROP(age, int, getAge, "Age");
@@ -247,7 +257,7 @@ void cOrganism::initialize(cAvidaContext& ctx)
 cOrganism::~cOrganism()
 {  
   assert(m_is_running == false);
-  delete m_hardware;
+  m_world->GetHardwareManager().Release(m_hardware);
   delete m_interface;
   
   if(m_msg) delete m_msg;
@@ -443,13 +453,13 @@ void cOrganism::doOutput(cAvidaContext& ctx,
   }
   
   // Do the testing of tasks performed...
+  const int num_global_res = global_resource_count.GetSize();
+  const int num_deme_res = deme_resource_count.GetSize();
   
-  
-  Apto::Array<double> global_res_change(global_resource_count.GetSize());
-  global_res_change.SetAll(0.0);
-  Apto::Array<double> deme_res_change(deme_resource_count.GetSize());
-  deme_res_change.SetAll(0.0);
-  Apto::Array<cString> insts_triggered;
+  Apto::Array<double>& global_res_change = m_output_scratch.global_res_change;
+  Apto::Array<double>& deme_res_change = m_output_scratch.deme_res_change;
+  if (global_res_change.GetSize() != num_global_res) global_res_change.Resize(num_global_res);
+  if (deme_res_change.GetSize() != num_deme_res) deme_res_change.Resize(num_deme_res);
   
   tBuffer<int>* received_messages_point = &m_received_messages;
   if (!m_world->GetConfig().SAVE_RECEIVED.Get()) received_messages_point = NULL;
@@ -458,8 +468,15 @@ void cOrganism::doOutput(cAvidaContext& ctx,
                        m_hardware->GetExtendedMemory(), on_divide, received_messages_point);
   
   //combine global and deme resource counts
-  Apto::Array<double> globalAndDeme_resource_count = global_resource_count + deme_resource_count;
-  Apto::Array<double> globalAndDeme_res_change = global_res_change + deme_res_change;
+  Apto::Array<double>& globalAndDeme_resource_count = m_output_scratch.res_count;
+  Apto::Array<double>& globalAndDeme_res_change = m_output_scratch.res_change;
+  if (globalAndDeme_resource_count.GetSize() != num_global_res + num_deme_res) {
+    globalAndDeme_resource_count.Resize(num_global_res + num_deme_res);
+    globalAndDeme_res_change.Resize(num_global_res + num_deme_res);
+  }
+  for (int i = 0; i < num_global_res; i++) globalAndDeme_resource_count[i] = global_resource_count[i];
+  for (int i = 0; i < num_deme_res; i++) globalAndDeme_resource_count[num_global_res + i] = deme_resource_count[i];
+  globalAndDeme_res_change.SetAll(0.0);
   
   // set any resource amount to 0 if a cell cannot access this resource
   int cell_id=GetCellID();
@@ -483,7 +500,7 @@ void cOrganism::doOutput(cAvidaContext& ctx,
   
   bool task_completed = m_phenotype.TestOutput(ctx, taskctx, globalAndDeme_resource_count, 
                                                m_phenotype.GetCurRBinsAvail(), globalAndDeme_res_change, 
-                                               insts_triggered, is_parasite, context_phenotype);
+                                               m_output_scratch.insts_triggered, is_parasite, context_phenotype);
   
   // Handle merit increases that take the organism above it's current population merit
   if (m_world->GetConfig().MERIT_INC_APPLY_IMMEDIATE.Get()) {
@@ -492,8 +509,8 @@ void cOrganism::doOutput(cAvidaContext& ctx,
   }
   
   //disassemble global and deme resource counts 
-  for (int i = 0; i < global_res_change.GetSize(); i++) global_res_change[i] = globalAndDeme_res_change[i];
-  for (int i = 0; i < deme_res_change.GetSize(); i++) deme_res_change[i] = globalAndDeme_res_change[i + global_res_change.GetSize()];
+  for (int i = 0; i < num_global_res; i++) global_res_change[i] = globalAndDeme_res_change[i];
+  for (int i = 0; i < num_deme_res; i++) deme_res_change[i] = globalAndDeme_res_change[i + num_global_res];
   
   if(m_world->GetConfig().ENERGY_ENABLED.Get() && m_world->GetConfig().APPLY_ENERGY_METHOD.Get() == 1 && task_completed) {
     m_phenotype.RefreshEnergy();
@@ -509,8 +526,8 @@ void cOrganism::doOutput(cAvidaContext& ctx,
   //update deme resources
   m_interface->UpdateDemeResources(ctx, deme_res_change);
 
-  for (int i = 0; i < insts_triggered.GetSize(); i++) 
-    m_hardware->ProcessBonusInst(ctx, m_hardware->GetInstSet().GetInst(insts_triggered[i]));
+  // Triggered instructions are only reported when the output completed a task
+  if (task_completed) processTriggeredInsts(ctx);
 }
 
 void cOrganism::doAVOutput(cAvidaContext& ctx, 
@@ -555,14 +572,13 @@ void cOrganism::doAVOutput(cAvidaContext& ctx,
   }
   
   // Do the testing of tasks performed...
-  Apto::Array<double> avatar_res_change(m_world->GetEnvironment().GetResourceLib().GetSize());
-  avatar_res_change.SetAll(0.0);
+  const int num_res = m_world->GetEnvironment().GetResourceLib().GetSize();
+  Apto::Array<double>& avatar_res_change = m_output_scratch.global_res_change;
+  if (avatar_res_change.GetSize() != num_res) avatar_res_change.Resize(num_res);
 
   //  tArray<double> deme_res_change(deme_resource_count.GetSize());
   //  deme_res_change.SetAll(0.0);
 
-  Apto::Array<cString> insts_triggered;
-  
   tBuffer<int>* received_messages_point = &m_received_messages;
   if (!m_world->GetConfig().SAVE_RECEIVED.Get()) received_messages_point = NULL;
   
@@ -571,8 +587,12 @@ void cOrganism::doAVOutput(cAvidaContext& ctx,
   
   //combine global and deme resource counts
   const Apto::Array<double>& av_res_count = m_interface->GetAVResources(ctx);
-  Apto::Array<double> avatarAndDeme_res_count = av_res_count; // + deme_resource_count;
-  Apto::Array<double> avatarAndDeme_res_change = avatar_res_change; // + deme_res_change;
+  Apto::Array<double>& avatarAndDeme_res_count = m_output_scratch.res_count; // + deme_resource_count;
+  Apto::Array<double>& avatarAndDeme_res_change = m_output_scratch.res_change; // + deme_res_change;
+  if (avatarAndDeme_res_count.GetSize() != av_res_count.GetSize()) avatarAndDeme_res_count.Resize(av_res_count.GetSize());
+  if (avatarAndDeme_res_change.GetSize() != num_res) avatarAndDeme_res_change.Resize(num_res);
+  for (int i = 0; i < av_res_count.GetSize(); i++) avatarAndDeme_res_count[i] = av_res_count[i];
+  avatarAndDeme_res_change.SetAll(0.0);
   
   // set any resource amount to 0 if a cell cannot access this resource
   int cell_id = m_interface->GetAVCellID();
@@ -596,7 +616,7 @@ void cOrganism::doAVOutput(cAvidaContext& ctx,
   
   bool task_completed = m_phenotype.TestOutput(ctx, taskctx, avatarAndDeme_res_count, 
                                                m_phenotype.GetCurRBinsAvail(), avatarAndDeme_res_change, 
-                                               insts_triggered, is_parasite, context_phenotype);
+                                               m_output_scratch.insts_triggered, is_parasite, context_phenotype);
   
   // Handle merit increases that take the organism above it's current population merit
   if (m_world->GetConfig().MERIT_INC_APPLY_IMMEDIATE.Get()) {
@@ -621,6 +641,16 @@ void cOrganism::doAVOutput(cAvidaContext& ctx,
   //update deme resources
 //  m_interface->UpdateDemeResources(ctx, deme_res_change);
   
+  // Triggered instructions are only reported when the output completed a task
+  if (task_completed) processTriggeredInsts(ctx);
+}
+
+void cOrganism::processTriggeredInsts(cAvidaContext& ctx)
+{
+  if (m_output_scratch.insts_triggered.GetSize() == 0) return;
+  
+  // Bonus instructions may perform output themselves, reusing the scratch storage, so work from a copy
+  Apto::Array<cString> insts_triggered(m_output_scratch.insts_triggered);
   for (int i = 0; i < insts_triggered.GetSize(); i++) 
     m_hardware->ProcessBonusInst(ctx, m_hardware->GetInstSet().GetInst(insts_triggered[i]));
 }
@@ -746,6 +776,51 @@ void cOrganism::PrintStatus(ostream& fp)
   fp << endl;
   
   fp << setfill(' ') << setbase(10);
+
+}
+
+bool cOrganism::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  cp.Write(m_input_pointer);
+  m_input_buf.SaveCheckpoint(cp);
+  m_output_buf.SaveCheckpoint(cp);
+  m_received_messages.SaveCheckpoint(cp);
+  cp.Write(m_cur_sg);
+  cp.Write(m_sent_value);
+  cp.Write(m_sent_active);
+  cp.Write(m_gradient_movement);
+  cp.Write(m_pher_drop);
+  cp.Write(frac_energy_donating);
+  cp.Write(m_max_executed);
+  cp.Write(killed_event);
+  cp.Write(m_lineage_label);
+  
+  m_mut_rates.SaveCopyCheckpoint(cp);
+  
+  if (!m_phenotype.SaveCheckpoint(cp)) return false;
+  return m_hardware->SaveCheckpoint(cp);
+}
+
+bool cOrganism::LoadCheckpoint(cCheckpointReader& cp)
+{
+  cp.Read(m_input_pointer);
+  m_input_buf.LoadCheckpoint(cp);
+  m_output_buf.LoadCheckpoint(cp);
+  m_received_messages.LoadCheckpoint(cp);
+  cp.Read(m_cur_sg);
+  cp.Read(m_sent_value);
+  cp.Read(m_sent_active);
+  cp.Read(m_gradient_movement);
+  cp.Read(m_pher_drop);
+  cp.Read(frac_energy_donating);
+  cp.Read(m_max_executed);
+  cp.Read(killed_event);
+  cp.Read(m_lineage_label);
+  
+  m_mut_rates.LoadCopyCheckpoint(cp);
+  
+  if (!cp.Good() || !m_phenotype.LoadCheckpoint(cp)) return false;
+  return m_hardware->LoadCheckpoint(cp);
 }
 
 void cOrganism::PrintMiniTraceStatus(cAvidaContext& ctx, ostream & fp)
@@ -1603,6 +1678,12 @@ bool cOrganism::OrgPropertyMap::Has(const PropertyID& p_id) const
   return OrgGlobalPropMapSingleton::Instance().prop_map.Has(p_id);
 }
 
+bool cOrganism::OrgPropertyMap::Has(PropertyAtom atom) const
+{
+  const Apto::Array<OrgPropRetrievalContainer*, Apto::Smart>& by_atom = OrgGlobalPropMapSingleton::Instance().by_atom;
+  return (atom >= 0 && atom < by_atom.GetSize() && by_atom[atom]);
+}
+
 const Avida::Property& cOrganism::OrgPropertyMap::Get(const PropertyID& p_id) const
 {
   OrgPropRetrievalContainer* container = NULL;
@@ -1613,6 +1694,14 @@ const Avida::Property& cOrganism::OrgPropertyMap::Get(const PropertyID& p_id) co
   return *s_default_prop;
 }
 
+const Avida::Property& cOrganism::OrgPropertyMap::Get(PropertyAtom atom) const
+{
+  const Apto::Array<OrgPropRetrievalContainer*, Apto::Smart>& by_atom = OrgGlobalPropMapSingleton::Instance().by_atom;
+  if (atom >= 0 && atom < by_atom.GetSize() && by_atom[atom]) return by_atom[atom]->Get(m_organism, this);
+  
+  return *s_default_prop;
+}
+
 
 bool cOrganism::OrgPropertyMap::SetValue(const PropertyID& p_id, const Apto::String& prop_value) { return false; }
 bool cOrganism::OrgPropertyMap::SetValue(const PropertyID& p_id, const int prop_value) { return false; }
@@ -46,6 +46,8 @@
 
 class cAvidaContext;
 class cBioGroup;
+class cCheckpointReader;
+class cCheckpointWriter;
 class cContextPhenotype;
 class cEnvironment;
 class cHardwareBase;
@@ -89,6 +91,17 @@ private:
   tBuffer<int> m_input_buf;
   tBuffer<int> m_output_buf;
   tBuffer<int> m_received_messages;
+  
+  // Scratch storage for doOutput/doAVOutput, kept between calls so that steady state IO does not allocate
+  struct sOutputScratch
+  {
+    Apto::Array<double> res_count;       // global resources followed by deme resources
+    Apto::Array<double> res_change;      // changes to res_count
+    Apto::Array<double> global_res_change;
+    Apto::Array<double> deme_res_change;
+    Apto::Array<cString> insts_triggered;
+  };
+  sOutputScratch m_output_scratch;
 
   int m_cur_sg;
 
@@ -141,6 +154,11 @@ public:
   void PrintFinalStatus(std::ostream& fp, int time_used, int time_allocated) const;
   void Fault(int fault_loc, int fault_type, cString fault_desc="");
 
+  // Checkpointing covers the dynamic state of a running organism; it is restored onto an organism freshly built
+  // from the same genome.  Returns false if the hardware type does not support checkpointing.
+  bool SaveCheckpoint(cCheckpointWriter& cp) const;
+  bool LoadCheckpoint(cCheckpointReader& cp);
+
   void NewTrial();
 
   // --------  Accessor Methods  --------
@@ -783,8 +801,10 @@ private:
     LIB_LOCAL bool operator==(const PropertyMap& p) const;
     
     LIB_LOCAL bool Has(const PropertyID& p_id) const;
+    LIB_LOCAL bool Has(PropertyAtom atom) const;
     
     LIB_LOCAL const Property& Get(const PropertyID& p_id) const;
+    LIB_LOCAL const Property& Get(PropertyAtom atom) const;
     
     LIB_LOCAL bool SetValue(const PropertyID& p_id, const Apto::String& prop_value);
     LIB_LOCAL bool SetValue(const PropertyID& p_id, const int prop_value);
@@ -829,6 +849,7 @@ private:
   void doOutput(cAvidaContext& ctx, tBuffer<int>& input_buffer, tBuffer<int>& output_buffer, const bool on_divide, bool is_parasite=false, cContextPhenotype* context_phenotype = 0);
   // Need seperate doOutput function for avatars to avoid triggering reactions by true orgs
   void doAVOutput(cAvidaContext& ctx, tBuffer<int>& input_buffer, tBuffer<int>& output_buffer, const bool on_divide, bool is_parasite=false, cContextPhenotype* context_phenotype = 0);
+  void processTriggeredInsts(cAvidaContext& ctx);
 };
 
 
@@ -0,0 +1,282 @@
+/*
+ *  cPhaseProfiler.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cPhaseProfiler.h"
+
+#include "avida/data/Manager.h"
+#include "avida/data/Package.h"
+#include "avida/data/Util.h"
+
+#include "apto/platform.h"
+
+#include "cHardwareManager.h"
+#include "cInstSet.h"
+#include "cStats.h"
+#include "cWorld.h"
+
+#if APTO_PLATFORM(WINDOWS)
+# include <windows.h>
+#elif APTO_PLATFORM(APPLE)
+# include <mach/mach_time.h>
+#else
+# include <time.h>
+#endif
+
+
+namespace {
+  const char* const PHASE_IDS[cPhaseProfiler::NUM_PHASES] = {
+    "core.profile.events",
+    "core.profile.stats",
+    "core.profile.process_steps",
+    "core.profile.resources",
+    "core.profile.births",
+    "core.profile.deaths",
+    "core.profile.update_processing",
+    "core.profile.systematics",
+    "core.profile.output"
+  };
+
+  const char* const PHASE_DESCRIPTIONS[cPhaseProfiler::NUM_PHASES] = {
+    "Seconds processing events, including print actions",
+    "Seconds in stats update processing",
+    "Seconds executing organisms, including births, deaths and resource updates during execution",
+    "Seconds updating spatial resources",
+    "Seconds placing offspring, including the deaths of organisms they replace",
+    "Seconds removing dead organisms",
+    "Seconds in population and world pre and post update processing and point mutations",
+    "Seconds updating systematics (genotypes and clades)",
+    "Seconds in data recording and output of the previous update"
+  };
+};
+
+
+cInstProfile::cInstProfile(int num_insts)
+  : m_counts(num_insts), m_times(num_insts), m_last_counts(num_insts), m_last_times(num_insts)
+{
+  m_counts.SetAll(0);
+  m_times.SetAll(0.0);
+  m_last_counts.SetAll(0);
+  m_last_times.SetAll(0.0);
+}
+
+void cInstProfile::EndUpdate()
+{
+  for (int i = 0; i < m_counts.GetSize(); i++) {
+    m_last_counts[i] = m_counts[i];
+    m_last_times[i] = m_times[i];
+    m_counts[i] = 0;
+    m_times[i] = 0.0;
+  }
+}
+
+
+cPhaseProfiler::cPhaseProfiler(cWorld* world)
+  : m_world(world), m_window_start(GetTime()), m_last_update_time(0.0), m_last_inst_rate(0.0), m_last_birth_rate(0.0)
+{
+  for (int i = 0; i < NUM_PHASES; i++) {
+    m_times[i] = 0.0;
+    m_last_times[i] = 0.0;
+  }
+
+  if (m_world->GetConfig().PROFILE_INSTRUCTIONS.Get()) {
+    cHardwareManager& hwm = m_world->GetHardwareManager();
+    for (int i = 0; i < hwm.GetNumInstSets(); i++) {
+      const cInstSet& inst_set = hwm.GetInstSet(i);
+      m_inst_profiles[Apto::String((const char*)inst_set.GetInstSetName())] = new cInstProfile(inst_set.GetSize());
+    }
+  }
+
+  Data::ProviderActivateFunctor activate(m_world, &cWorld::GetPhaseProfilerProvider);
+  Data::ManagerPtr mgr = m_world->GetDataManager();
+  for (int i = 0; i < NUM_PHASES; i++) mgr->Register(PHASE_IDS[i], activate);
+  mgr->Register("core.profile.update_time", activate);
+  mgr->Register("core.profile.instructions_per_second", activate);
+  mgr->Register("core.profile.births_per_second", activate);
+
+  if (m_inst_profiles.GetSize()) {
+    Data::ArgumentedProviderActivateFunctor arg_activate(m_world, &cWorld::GetPhaseProfilerArgProvider);
+    mgr->Register("core.profile.inst_exec_counts[]", arg_activate);
+    mgr->Register("core.profile.inst_exec_time[]", arg_activate);
+  }
+}
+
+cPhaseProfiler::~cPhaseProfiler()
+{
+  for (Apto::Map<Apto::String, cInstProfile*>::ValueIterator it = m_inst_profiles.Values(); it.Next();) delete *it.Get();
+}
+
+
+double cPhaseProfiler::GetTime()
+{
+#if APTO_PLATFORM(WINDOWS)
+  static LARGE_INTEGER frequency = { 0 };
+  if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+  LARGE_INTEGER count;
+  QueryPerformanceCounter(&count);
+  return (double)count.QuadPart / (double)frequency.QuadPart;
+#elif APTO_PLATFORM(APPLE)
+  static mach_timebase_info_data_t timebase = { 0, 0 };
+  if (timebase.denom == 0) mach_timebase_info(&timebase);
+  return (double)mach_absolute_time() * timebase.numer / timebase.denom * 1.0e-9;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+#endif
+}
+
+
+void cPhaseProfiler::EndUpdate()
+{
+  const double now = GetTime();
+  m_last_update_time = now - m_window_start;
+  m_window_start = now;
+
+  // Output is still to come, its last figure stays that of the previous update until EndOutput()
+  for (int i = 0; i < NUM_PHASES; i++) {
+    if (i == OUTPUT) continue;
+    m_last_times[i] = m_times[i];
+    m_times[i] = 0.0;
+  }
+
+  // Stats counts cover the update since its last ProcessUpdate, which is the start of this window
+  cStats& stats = m_world->GetStats();
+  if (m_last_update_time > 0.0) {
+    m_last_inst_rate = stats.GetNumExecuted() / m_last_update_time;
+    m_last_birth_rate = stats.GetNumBirths() / m_last_update_time;
+  } else {
+    m_last_inst_rate = 0.0;
+    m_last_birth_rate = 0.0;
+  }
+
+  for (Apto::Map<Apto::String, cInstProfile*>::ValueIterator it = m_inst_profiles.Values(); it.Next();) {
+    (*it.Get())->EndUpdate();
+  }
+}
+
+void cPhaseProfiler::EndOutput()
+{
+  m_last_times[OUTPUT] = m_times[OUTPUT];
+  m_times[OUTPUT] = 0.0;
+}
+
+
+cInstProfile* cPhaseProfiler::GetInstProfile(const Apto::String& inst_set)
+{
+  cInstProfile* profile = NULL;
+  m_inst_profiles.Get(inst_set, profile);
+  return profile;
+}
+
+
+bool cPhaseProfiler::getPhaseID(const Apto::String& data_id, int& phase)
+{
+  for (phase = 0; phase < NUM_PHASES; phase++) if (data_id == PHASE_IDS[phase]) return true;
+  return false;
+}
+
+Data::PackagePtr cPhaseProfiler::packageInstProfile(const cInstProfile* profile, bool times)
+{
+  Apto::SmartPtr<Data::ArrayPackage, Apto::InternalRCObject> pkg(new Data::ArrayPackage);
+  if (times) {
+    const Apto::Array<double>& inst_times = profile->GetLastTimes();
+    for (int i = 0; i < inst_times.GetSize(); i++) pkg->AddComponent(Data::PackagePtr(new Data::Wrap<double>(inst_times[i])));
+  } else {
+    const Apto::Array<int>& inst_counts = profile->GetLastCounts();
+    for (int i = 0; i < inst_counts.GetSize(); i++) pkg->AddComponent(Data::PackagePtr(new Data::Wrap<int>(inst_counts[i])));
+  }
+  return pkg;
+}
+
+
+Data::ConstDataSetPtr cPhaseProfiler::Provides() const
+{
+  if (!m_provides) {
+    Data::DataSetPtr provides(new Data::DataSet);
+    for (int i = 0; i < NUM_PHASES; i++) provides->Insert(PHASE_IDS[i]);
+    provides->Insert("core.profile.update_time");
+    provides->Insert("core.profile.instructions_per_second");
+    provides->Insert("core.profile.births_per_second");
+    if (m_inst_profiles.GetSize()) {
+      provides->Insert("core.profile.inst_exec_counts[]");
+      provides->Insert("core.profile.inst_exec_time[]");
+    }
+    m_provides = provides;
+  }
+  return m_provides;
+}
+
+void cPhaseProfiler::UpdateProvidedValues(Update)
+{
+  // Nothing to do, the figures are taken by EndUpdate()
+}
+
+Apto::String cPhaseProfiler::DescribeProvidedValue(const Data::DataID& data_id) const
+{
+  int phase = 0;
+  if (getPhaseID(data_id, phase)) return PHASE_DESCRIPTIONS[phase];
+  if (data_id == "core.profile.update_time") return "Seconds of wall clock time from the data recording of the previous update to that of this one";
+  if (data_id == "core.profile.instructions_per_second") return "CPU cycles executed per second of the update";
+  if (data_id == "core.profile.births_per_second") return "Births per second of the update";
+  if (data_id == "core.profile.inst_exec_counts[]") return "Instruction executions in the update for the specified instruction set";
+  if (data_id == "core.profile.inst_exec_time[]") return "Seconds executing each instruction in the update for the specified instruction set";
+  return "";
+}
+
+
+void cPhaseProfiler::SetActiveArguments(const Data::DataID&, Data::ConstArgumentSetPtr)
+{
+}
+
+Data::ConstArgumentSetPtr cPhaseProfiler::GetValidArguments(const Data::DataID& data_id) const
+{
+  Data::ArgumentSetPtr args;
+  if (Data::IsStandardID(data_id)) return args;
+
+  args = Data::ArgumentSetPtr(new Data::ArgumentSet);
+  for (Apto::Map<Apto::String, cInstProfile*>::KeyIterator it = m_inst_profiles.Keys(); it.Next();) args->Insert(*it.Get());
+  return args;
+}
+
+bool cPhaseProfiler::IsValidArgument(const Data::DataID& data_id, Data::Argument arg) const
+{
+  if (Data::IsStandardID(data_id)) return false;
+  return m_inst_profiles.Has(arg);
+}
+
+
+Data::PackagePtr cPhaseProfiler::GetProvidedValueForArgument(const Data::DataID& data_id, const Data::Argument& arg) const
+{
+  Data::PackagePtr rtn;
+
+  if (Data::IsStandardID(data_id)) {
+    int phase = 0;
+    if (getPhaseID(data_id, phase)) rtn = Data::PackagePtr(new Data::Wrap<double>(m_last_times[phase]));
+    else if (data_id == "core.profile.update_time") rtn = Data::PackagePtr(new Data::Wrap<double>(m_last_update_time));
+    else if (data_id == "core.profile.instructions_per_second") rtn = Data::PackagePtr(new Data::Wrap<double>(m_last_inst_rate));
+    else if (data_id == "core.profile.births_per_second") rtn = Data::PackagePtr(new Data::Wrap<double>(m_last_birth_rate));
+    assert(rtn);
+  } else if (Data::IsArgumentedID(data_id)) {
+    cInstProfile* profile = NULL;
+    if (m_inst_profiles.Get(arg, profile)) rtn = packageInstProfile(profile, data_id == "core.profile.inst_exec_time[]");
+  }
+
+  return rtn;
+}
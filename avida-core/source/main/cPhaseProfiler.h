@@ -0,0 +1,190 @@
+/*
+ *  cPhaseProfiler.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cPhaseProfiler_h
+#define cPhaseProfiler_h
+
+#include "avida/data/Provider.h"
+
+class cWorld;
+
+using namespace Avida;
+
+
+// cInstProfile - Per-instruction execution counts and times for one instruction set
+//
+// Only hardware attached to population cells records into a profile (see cHardwareBase::SetInstProfile), always from
+// the simulation thread, so recording needs no locking.
+
+class cInstProfile
+{
+  friend class cPhaseProfiler;
+private:
+  Apto::Array<int> m_counts;
+  Apto::Array<double> m_times;
+  Apto::Array<int> m_last_counts;
+  Apto::Array<double> m_last_times;
+
+  cInstProfile(); // @not_implemented
+  cInstProfile(const cInstProfile&); // @not_implemented
+  cInstProfile& operator=(const cInstProfile&); // @not_implemented
+
+  explicit cInstProfile(int num_insts);
+
+  void EndUpdate();
+
+public:
+  class cScope
+  {
+  private:
+    cInstProfile* m_profile;
+    int m_op;
+    double m_start;
+
+  public:
+    inline cScope(cInstProfile* profile, int op);
+    inline ~cScope();
+  };
+
+  inline void Record(int op, double seconds) { m_counts[op]++; m_times[op] += seconds; }
+
+  const Apto::Array<int>& GetLastCounts() const { return m_last_counts; }
+  const Apto::Array<double>& GetLastTimes() const { return m_last_times; }
+};
+
+
+// cPhaseProfiler - Wall clock time spent in each phase of the update loop
+//
+// The driver and population time their phases with cScope objects, which do nothing when handed a NULL profiler.
+// EndUpdate() closes the measurement window and makes the figures available through the data manager as
+// core.profile.*.  The driver calls it after the systematics of the update and just before its data recording, so
+// every phase but output is reported for the update it ran in.  Output cannot time itself: EndOutput() adds the output
+// of the update to its figures once it is done, so data recorded at an update carries the output time of the update
+// before it.  The update time runs from one EndUpdate() to the next.
+//
+// Process steps include the births, deaths and spatial resource updates that happen during them, and births include
+// the deaths of the organisms they replace.  Print actions run as events.
+
+class cPhaseProfiler : public Data::ArgumentedProvider
+{
+public:
+  enum ePhase {
+    EVENTS = 0,
+    STATS,
+    PROCESS_STEPS,
+    RESOURCES,
+    BIRTHS,
+    DEATHS,
+    UPDATE_PROCESSING,
+    SYSTEMATICS,
+    OUTPUT,
+    NUM_PHASES
+  };
+
+  class cScope
+  {
+  private:
+    cPhaseProfiler* m_profiler;
+    ePhase m_phase;
+    double m_start;
+
+  public:
+    inline cScope(cPhaseProfiler* profiler, ePhase phase);
+    inline ~cScope();
+  };
+
+private:
+  cWorld* m_world;
+
+  double m_window_start;
+  double m_times[NUM_PHASES];
+  double m_last_times[NUM_PHASES];
+  double m_last_update_time;
+  double m_last_inst_rate;
+  double m_last_birth_rate;
+
+  Apto::Map<Apto::String, cInstProfile*> m_inst_profiles;  // empty unless PROFILE_INSTRUCTIONS is set
+
+  mutable Data::ConstDataSetPtr m_provides;
+
+
+  cPhaseProfiler(); // @not_implemented
+  cPhaseProfiler(const cPhaseProfiler&); // @not_implemented
+  cPhaseProfiler& operator=(const cPhaseProfiler&); // @not_implemented
+
+  static bool getPhaseID(const Apto::String& data_id, int& phase);
+  static Data::PackagePtr packageInstProfile(const cInstProfile* profile, bool times);
+
+public:
+  cPhaseProfiler(cWorld* world);
+  ~cPhaseProfiler();
+
+  // Seconds from an arbitrary fixed point, at the best resolution the platform offers
+  static double GetTime();
+
+  inline void AddTime(ePhase phase, double seconds) { m_times[phase] += seconds; }
+  void EndUpdate();
+  void EndOutput();
+
+  // Profile for hardware of the named instruction set, or NULL when instructions are not being profiled
+  cInstProfile* GetInstProfile(const Apto::String& inst_set);
+
+  double GetLastPhaseTime(ePhase phase) const { return m_last_times[phase]; }
+  double GetLastUpdateTime() const { return m_last_update_time; }
+  double GetLastInstRate() const { return m_last_inst_rate; }
+  double GetLastBirthRate() const { return m_last_birth_rate; }
+
+
+  // Data::Provider
+  Data::ConstDataSetPtr Provides() const;
+  void UpdateProvidedValues(Update current_update);
+  Apto::String DescribeProvidedValue(const Data::DataID& data_id) const;
+
+  // Data::ArgumentedProvider
+  void SetActiveArguments(const Data::DataID& data_id, Data::ConstArgumentSetPtr args);
+  Data::ConstArgumentSetPtr GetValidArguments(const Data::DataID& data_id) const;
+  bool IsValidArgument(const Data::DataID& data_id, Data::Argument arg) const;
+
+  Data::PackagePtr GetProvidedValueForArgument(const Data::DataID& data_id, const Data::Argument& arg) const;
+};
+
+
+inline cPhaseProfiler::cScope::cScope(cPhaseProfiler* profiler, ePhase phase)
+  : m_profiler(profiler), m_phase(phase), m_start(profiler ? cPhaseProfiler::GetTime() : 0.0)
+{
+}
+
+inline cPhaseProfiler::cScope::~cScope()
+{
+  if (m_profiler) m_profiler->AddTime(m_phase, cPhaseProfiler::GetTime() - m_start);
+}
+
+
+inline cInstProfile::cScope::cScope(cInstProfile* profile, int op)
+  : m_profile(profile), m_op(op), m_start(profile ? cPhaseProfiler::GetTime() : 0.0)
+{
+}
+
+inline cInstProfile::cScope::~cScope()
+{
+  if (m_profile) m_profile->Record(m_op, cPhaseProfiler::GetTime() - m_start);
+}
+
+#endif
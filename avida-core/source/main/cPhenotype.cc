@@ -22,6 +22,7 @@
 
 #include "cPhenotype.h"
 #include "avida/systematics/Types.h"
+#include "cCheckpoint.h"
 #include "cContextPhenotype.h"
 #include "cEnvironment.h"
 #include "cDeme.h"
@@ -1732,6 +1733,428 @@ void cPhenotype::PrintStatus(ostream& fp) const
   }
 }
 
+
+// Task states, tolerance records, and donation flags are not checkpointed; they return to their post-birth defaults
+bool cPhenotype::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  cp.Write(merit.GetDouble());
+
+  cp.Write(energy_store);
+  cp.Write(fitness);
+  cp.Write(div_type);
+  cp.Write(cur_bonus);
+  cp.Write(cur_energy_bonus);
+  cp.Write(energy_tobe_applied);
+  cp.Write(energy_testament);
+  cp.Write(energy_received_buffer);
+  cp.Write(total_energy_donated);
+  cp.Write(total_energy_received);
+  cp.Write(total_energy_applied);
+  cp.Write(last_child_germline_propensity);
+  cp.Write(last_merit_base);
+  cp.Write(last_bonus);
+  cp.Write(last_energy_bonus);
+  cp.Write(last_fitness);
+  cp.Write(cur_child_germline_propensity);
+  cp.Write(neutral_metric);
+  cp.Write(life_fitness);
+  cp.Write(gmu_exec_time_born);
+  cp.Write(res_consumed);
+  cp.Write(permanent_germline_propensity);
+
+  cp.Write(genome_length);
+  cp.Write(bonus_instruction_count);
+  cp.Write(copied_size);
+  cp.Write(executed_size);
+  cp.Write(gestation_time);
+  cp.Write(gestation_start);
+  cp.Write(num_energy_requests);
+  cp.Write(num_energy_donations);
+  cp.Write(num_energy_receptions);
+  cp.Write(num_energy_applications);
+  cp.Write(cur_num_errors);
+  cp.Write(cur_num_donates);
+  cp.Write(cur_attacks);
+  cp.Write(cur_kills);
+  cp.Write(trial_time_used);
+  cp.Write(trial_cpu_cycles_used);
+  cp.Write(mating_type);
+  cp.Write(mate_preference);
+  cp.Write(cur_mating_display_a);
+  cp.Write(cur_mating_display_b);
+  cp.Write(last_num_errors);
+  cp.Write(last_num_donates);
+  cp.Write(last_attacks);
+  cp.Write(last_kills);
+  cp.Write(last_cpu_cycles_used);
+  cp.Write(last_mating_display_a);
+  cp.Write(last_mating_display_b);
+  cp.Write(num_divides_failed);
+  cp.Write(num_divides);
+  cp.Write(generation);
+  cp.Write(cpu_cycles_used);
+  cp.Write(time_used);
+  cp.Write(num_execs);
+  cp.Write(age);
+  cp.Write(exec_time_born);
+  cp.Write(birth_update);
+  cp.Write(birth_cell_id);
+  cp.Write(av_birth_cell_id);
+  cp.Write(birth_group_id);
+  cp.Write(birth_forager_type);
+  cp.Write(last_task_id);
+  cp.Write(num_new_unique_reactions);
+  cp.Write(last_task_time);
+  cp.Write(parent_cross_num);
+  cp.Write(mate_select_id);
+  cp.Write(child_copied_size);
+
+  cp.Write(initialized);
+  cp.Write(is_germ_cell);
+  cp.Write(to_die);
+  cp.Write(to_delete);
+  cp.Write(is_injected);
+  cp.Write(is_clone);
+  cp.Write(is_modifier);
+  cp.Write(is_modified);
+  cp.Write(is_fertile);
+  cp.Write(is_mutated);
+  cp.Write(is_multi_thread);
+  cp.Write(parent_true);
+  cp.Write(parent_sex);
+  cp.Write(born_parent_group);
+  cp.Write(kaboom_executed);
+  cp.Write(copy_true);
+  cp.Write(divide_sex);
+  cp.Write(child_fertile);
+  cp.Write(last_child_fertile);
+
+  cp.Write(is_donor_cur);
+  cp.Write(is_donor_last);
+  cp.Write(is_donor_rand);
+  cp.Write(is_donor_rand_last);
+  cp.Write(is_donor_null);
+  cp.Write(is_donor_null_last);
+  cp.Write(is_donor_kin);
+  cp.Write(is_donor_kin_last);
+  cp.Write(is_donor_edit);
+  cp.Write(is_donor_edit_last);
+  cp.Write(is_donor_gbg);
+  cp.Write(is_donor_gbg_last);
+  cp.Write(is_donor_truegb);
+  cp.Write(is_donor_truegb_last);
+  cp.Write(is_donor_threshgb);
+  cp.Write(is_donor_threshgb_last);
+  cp.Write(is_donor_quanta_threshgb);
+  cp.Write(is_donor_quanta_threshgb_last);
+  cp.Write(is_donor_shadedgb);
+  cp.Write(is_donor_shadedgb_last);
+  cp.Write(is_energy_requestor);
+  cp.Write(is_energy_donor);
+  cp.Write(is_energy_receiver);
+  cp.Write(has_used_donated_energy);
+  cp.Write(has_open_energy_request);
+  cp.Write(is_receiver);
+  cp.Write(is_receiver_last);
+  cp.Write(is_receiver_rand);
+  cp.Write(is_receiver_kin);
+  cp.Write(is_receiver_kin_last);
+  cp.Write(is_receiver_edit);
+  cp.Write(is_receiver_edit_last);
+  cp.Write(is_receiver_gbg);
+  cp.Write(is_receiver_truegb);
+  cp.Write(is_receiver_truegb_last);
+  cp.Write(is_receiver_threshgb);
+  cp.Write(is_receiver_threshgb_last);
+  cp.Write(is_receiver_quanta_threshgb);
+  cp.Write(is_receiver_quanta_threshgb_last);
+  cp.Write(is_receiver_shadedgb);
+  cp.Write(is_receiver_shadedgb_last);
+  cp.Write(is_receiver_gb_same_locus);
+  cp.Write(is_receiver_gb_same_locus_last);
+  cp.Write(num_thresh_gb_donations);
+  cp.Write(num_thresh_gb_donations_last);
+  cp.Write(num_quanta_thresh_gb_donations);
+  cp.Write(num_quanta_thresh_gb_donations_last);
+  cp.Write(num_shaded_gb_donations);
+  cp.Write(num_shaded_gb_donations_last);
+  cp.Write(num_donations_locus);
+  cp.Write(num_donations_locus_last);
+  cp.WriteArray(is_donor_locus);
+  cp.WriteArray(is_donor_locus_last);
+
+  cp.WriteArray(cur_task_count);
+  cp.WriteArray(cur_para_tasks);
+  cp.WriteArray(cur_host_tasks);
+  cp.WriteArray(cur_internal_task_count);
+  cp.WriteArray(eff_task_count);
+  cp.WriteArray(cur_task_quality);
+  cp.WriteArray(cur_task_value);
+  cp.WriteArray(cur_internal_task_quality);
+  cp.WriteArray(cur_rbins_total);
+  cp.WriteArray(cur_rbins_avail);
+  cp.WriteArray(cur_collect_spec_counts);
+  cp.WriteArray(cur_reaction_count);
+  cp.WriteArray(first_reaction_cycles);
+  cp.WriteArray(first_reaction_execs);
+  cp.WriteArray(cur_stolen_reaction_count);
+  cp.WriteArray(cur_reaction_add_reward);
+  cp.WriteArray(cur_inst_count);
+  cp.WriteArray(cur_from_sensor_count);
+  cp.WriteArray(cur_killed_targets);
+  cp.WriteArray(cur_sense_count);
+  cp.WriteArray(sensed_resources);
+  cp.WriteArray(cur_task_time);
+  cp.WriteArray(cur_trial_fitnesses);
+  cp.WriteArray(cur_trial_bonuses);
+  cp.WriteArray(cur_trial_times_used);
+  cp.WriteArray(cur_from_message_count);
+  cp.WriteArray(last_task_count);
+  cp.WriteArray(last_para_tasks);
+  cp.WriteArray(last_host_tasks);
+  cp.WriteArray(last_internal_task_count);
+  cp.WriteArray(last_task_quality);
+  cp.WriteArray(last_task_value);
+  cp.WriteArray(last_internal_task_quality);
+  cp.WriteArray(last_rbins_total);
+  cp.WriteArray(last_rbins_avail);
+  cp.WriteArray(last_collect_spec_counts);
+  cp.WriteArray(last_reaction_count);
+  cp.WriteArray(last_reaction_add_reward);
+  cp.WriteArray(last_inst_count);
+  cp.WriteArray(last_from_sensor_count);
+  cp.WriteArray(last_sense_count);
+  cp.WriteArray(last_killed_targets);
+  cp.WriteArray(last_from_message_count);
+
+  cp.Write(cur_group_attack_count.GetSize());
+  for (int i = 0; i < cur_group_attack_count.GetSize(); i++) cp.WriteArray(cur_group_attack_count[i]);
+  cp.Write(cur_top_pred_group_attack_count.GetSize());
+  for (int i = 0; i < cur_top_pred_group_attack_count.GetSize(); i++) cp.WriteArray(cur_top_pred_group_attack_count[i]);
+  cp.Write(last_group_attack_count.GetSize());
+  for (int i = 0; i < last_group_attack_count.GetSize(); i++) cp.WriteArray(last_group_attack_count[i]);
+  cp.Write(last_top_pred_group_attack_count.GetSize());
+  for (int i = 0; i < last_top_pred_group_attack_count.GetSize(); i++) cp.WriteArray(last_top_pred_group_attack_count[i]);
+
+  cp.WriteString(fault_desc);
+
+  return cp.Good();
+}
+
+bool cPhenotype::LoadCheckpoint(cCheckpointReader& cp)
+{
+  merit = cp.Read<double>();
+
+  cp.Read(energy_store);
+  cp.Read(fitness);
+  cp.Read(div_type);
+  cp.Read(cur_bonus);
+  cp.Read(cur_energy_bonus);
+  cp.Read(energy_tobe_applied);
+  cp.Read(energy_testament);
+  cp.Read(energy_received_buffer);
+  cp.Read(total_energy_donated);
+  cp.Read(total_energy_received);
+  cp.Read(total_energy_applied);
+  cp.Read(last_child_germline_propensity);
+  cp.Read(last_merit_base);
+  cp.Read(last_bonus);
+  cp.Read(last_energy_bonus);
+  cp.Read(last_fitness);
+  cp.Read(cur_child_germline_propensity);
+  cp.Read(neutral_metric);
+  cp.Read(life_fitness);
+  cp.Read(gmu_exec_time_born);
+  cp.Read(res_consumed);
+  cp.Read(permanent_germline_propensity);
+
+  cp.Read(genome_length);
+  cp.Read(bonus_instruction_count);
+  cp.Read(copied_size);
+  cp.Read(executed_size);
+  cp.Read(gestation_time);
+  cp.Read(gestation_start);
+  cp.Read(num_energy_requests);
+  cp.Read(num_energy_donations);
+  cp.Read(num_energy_receptions);
+  cp.Read(num_energy_applications);
+  cp.Read(cur_num_errors);
+  cp.Read(cur_num_donates);
+  cp.Read(cur_attacks);
+  cp.Read(cur_kills);
+  cp.Read(trial_time_used);
+  cp.Read(trial_cpu_cycles_used);
+  cp.Read(mating_type);
+  cp.Read(mate_preference);
+  cp.Read(cur_mating_display_a);
+  cp.Read(cur_mating_display_b);
+  cp.Read(last_num_errors);
+  cp.Read(last_num_donates);
+  cp.Read(last_attacks);
+  cp.Read(last_kills);
+  cp.Read(last_cpu_cycles_used);
+  cp.Read(last_mating_display_a);
+  cp.Read(last_mating_display_b);
+  cp.Read(num_divides_failed);
+  cp.Read(num_divides);
+  cp.Read(generation);
+  cp.Read(cpu_cycles_used);
+  cp.Read(time_used);
+  cp.Read(num_execs);
+  cp.Read(age);
+  cp.Read(exec_time_born);
+  cp.Read(birth_update);
+  cp.Read(birth_cell_id);
+  cp.Read(av_birth_cell_id);
+  cp.Read(birth_group_id);
+  cp.Read(birth_forager_type);
+  cp.Read(last_task_id);
+  cp.Read(num_new_unique_reactions);
+  cp.Read(last_task_time);
+  cp.Read(parent_cross_num);
+  cp.Read(mate_select_id);
+  cp.Read(child_copied_size);
+
+  cp.Read(initialized);
+  cp.Read(is_germ_cell);
+  cp.Read(to_die);
+  cp.Read(to_delete);
+  cp.Read(is_injected);
+  cp.Read(is_clone);
+  cp.Read(is_modifier);
+  cp.Read(is_modified);
+  cp.Read(is_fertile);
+  cp.Read(is_mutated);
+  cp.Read(is_multi_thread);
+  cp.Read(parent_true);
+  cp.Read(parent_sex);
+  cp.Read(born_parent_group);
+  cp.Read(kaboom_executed);
+  cp.Read(copy_true);
+  cp.Read(divide_sex);
+  cp.Read(child_fertile);
+  cp.Read(last_child_fertile);
+
+  cp.Read(is_donor_cur);
+  cp.Read(is_donor_last);
+  cp.Read(is_donor_rand);
+  cp.Read(is_donor_rand_last);
+  cp.Read(is_donor_null);
+  cp.Read(is_donor_null_last);
+  cp.Read(is_donor_kin);
+  cp.Read(is_donor_kin_last);
+  cp.Read(is_donor_edit);
+  cp.Read(is_donor_edit_last);
+  cp.Read(is_donor_gbg);
+  cp.Read(is_donor_gbg_last);
+  cp.Read(is_donor_truegb);
+  cp.Read(is_donor_truegb_last);
+  cp.Read(is_donor_threshgb);
+  cp.Read(is_donor_threshgb_last);
+  cp.Read(is_donor_quanta_threshgb);
+  cp.Read(is_donor_quanta_threshgb_last);
+  cp.Read(is_donor_shadedgb);
+  cp.Read(is_donor_shadedgb_last);
+  cp.Read(is_energy_requestor);
+  cp.Read(is_energy_donor);
+  cp.Read(is_energy_receiver);
+  cp.Read(has_used_donated_energy);
+  cp.Read(has_open_energy_request);
+  cp.Read(is_receiver);
+  cp.Read(is_receiver_last);
+  cp.Read(is_receiver_rand);
+  cp.Read(is_receiver_kin);
+  cp.Read(is_receiver_kin_last);
+  cp.Read(is_receiver_edit);
+  cp.Read(is_receiver_edit_last);
+  cp.Read(is_receiver_gbg);
+  cp.Read(is_receiver_truegb);
+  cp.Read(is_receiver_truegb_last);
+  cp.Read(is_receiver_threshgb);
+  cp.Read(is_receiver_threshgb_last);
+  cp.Read(is_receiver_quanta_threshgb);
+  cp.Read(is_receiver_quanta_threshgb_last);
+  cp.Read(is_receiver_shadedgb);
+  cp.Read(is_receiver_shadedgb_last);
+  cp.Read(is_receiver_gb_same_locus);
+  cp.Read(is_receiver_gb_same_locus_last);
+  cp.Read(num_thresh_gb_donations);
+  cp.Read(num_thresh_gb_donations_last);
+  cp.Read(num_quanta_thresh_gb_donations);
+  cp.Read(num_quanta_thresh_gb_donations_last);
+  cp.Read(num_shaded_gb_donations);
+  cp.Read(num_shaded_gb_donations_last);
+  cp.Read(num_donations_locus);
+  cp.Read(num_donations_locus_last);
+  cp.ReadArray(is_donor_locus);
+  cp.ReadArray(is_donor_locus_last);
+
+  cp.ReadArray(cur_task_count);
+  cp.ReadArray(cur_para_tasks);
+  cp.ReadArray(cur_host_tasks);
+  cp.ReadArray(cur_internal_task_count);
+  cp.ReadArray(eff_task_count);
+  cp.ReadArray(cur_task_quality);
+  cp.ReadArray(cur_task_value);
+  cp.ReadArray(cur_internal_task_quality);
+  cp.ReadArray(cur_rbins_total);
+  cp.ReadArray(cur_rbins_avail);
+  cp.ReadArray(cur_collect_spec_counts);
+  cp.ReadArray(cur_reaction_count);
+  cp.ReadArray(first_reaction_cycles);
+  cp.ReadArray(first_reaction_execs);
+  cp.ReadArray(cur_stolen_reaction_count);
+  cp.ReadArray(cur_reaction_add_reward);
+  cp.ReadArray(cur_inst_count);
+  cp.ReadArray(cur_from_sensor_count);
+  cp.ReadArray(cur_killed_targets);
+  cp.ReadArray(cur_sense_count);
+  cp.ReadArray(sensed_resources);
+  cp.ReadArray(cur_task_time);
+  cp.ReadArray(cur_trial_fitnesses);
+  cp.ReadArray(cur_trial_bonuses);
+  cp.ReadArray(cur_trial_times_used);
+  cp.ReadArray(cur_from_message_count);
+  cp.ReadArray(last_task_count);
+  cp.ReadArray(last_para_tasks);
+  cp.ReadArray(last_host_tasks);
+  cp.ReadArray(last_internal_task_count);
+  cp.ReadArray(last_task_quality);
+  cp.ReadArray(last_task_value);
+  cp.ReadArray(last_internal_task_quality);
+  cp.ReadArray(last_rbins_total);
+  cp.ReadArray(last_rbins_avail);
+  cp.ReadArray(last_collect_spec_counts);
+  cp.ReadArray(last_reaction_count);
+  cp.ReadArray(last_reaction_add_reward);
+  cp.ReadArray(last_inst_count);
+  cp.ReadArray(last_from_sensor_count);
+  cp.ReadArray(last_sense_count);
+  cp.ReadArray(last_killed_targets);
+  cp.ReadArray(last_from_message_count);
+
+  const int cur_group_attack_count_size = cp.Read<int>();
+  if (!cp.Good() || cur_group_attack_count_size < 0) return false;
+  cur_group_attack_count.Resize(cur_group_attack_count_size);
+  for (int i = 0; i < cur_group_attack_count_size; i++) cp.ReadArray(cur_group_attack_count[i]);
+  const int cur_top_pred_group_attack_count_size = cp.Read<int>();
+  if (!cp.Good() || cur_top_pred_group_attack_count_size < 0) return false;
+  cur_top_pred_group_attack_count.Resize(cur_top_pred_group_attack_count_size);
+  for (int i = 0; i < cur_top_pred_group_attack_count_size; i++) cp.ReadArray(cur_top_pred_group_attack_count[i]);
+  const int last_group_attack_count_size = cp.Read<int>();
+  if (!cp.Good() || last_group_attack_count_size < 0) return false;
+  last_group_attack_count.Resize(last_group_attack_count_size);
+  for (int i = 0; i < last_group_attack_count_size; i++) cp.ReadArray(last_group_attack_count[i]);
+  const int last_top_pred_group_attack_count_size = cp.Read<int>();
+  if (!cp.Good() || last_top_pred_group_attack_count_size < 0) return false;
+  last_top_pred_group_attack_count.Resize(last_top_pred_group_attack_count_size);
+  for (int i = 0; i < last_top_pred_group_attack_count_size; i++) cp.ReadArray(last_top_pred_group_attack_count[i]);
+
+  cp.ReadString(fault_desc);
+
+  return cp.Good();
+}
+
 int cPhenotype::CalcSizeMerit() const
 {
   assert(genome_length > 0);
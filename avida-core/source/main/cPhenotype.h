@@ -60,6 +60,8 @@
  *************************************************************************/
 
 class cAvidaContext;
+class cCheckpointReader;
+class cCheckpointWriter;
 class cContextPhenotype;
 class cEnvironment;
 template <class T> class tBuffer;
@@ -349,6 +351,9 @@ public:
 
   // State saving and loading, and printing...
   void PrintStatus(std::ostream& fp) const;
+  bool SaveCheckpoint(cCheckpointWriter& cp) const;
+  bool LoadCheckpoint(cCheckpointReader& cp);
+  bool HasTaskStates() const { return m_task_states.GetSize() > 0; }
 
   // Some useful methods...
   int CalcSizeMerit() const;
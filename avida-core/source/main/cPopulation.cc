@@ -29,13 +29,16 @@
 #include "avida/data/Package.h"
 #include "avida/data/Util.h"
 #include "avida/output/File.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Arbiter.h"
 #include "avida/systematics/Group.h"
 #include "avida/systematics/Manager.h"
 
 #include "avida/private/systematics/GenomeTestMetrics.h"
 #include "avida/private/systematics/Genotype.h"
+#include "avida/private/systematics/GenotypeArbiter.h"
 
+#include "apto/core/FileSystem.h"
 #include "apto/rng.h"
 #include "apto/scheduler.h"
 #include "apto/stat/Accumulator.h"
@@ -43,8 +46,10 @@
 #include "AvidaTools.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
 #include "cCPUTestInfo.h"
 #include "cCodeLabel.h"
+#include "cColumnFile.h"
 #include "cDemePlaceholderUnit.h"
 #include "cEnvironment.h"
 #include "cHardwareBase.h"
@@ -54,8 +59,10 @@
 #include "cMigrationMatrix.h"   
 #include "cOrganism.h"
 #include "cParasite.h"
+#include "cPhaseProfiler.h"
 #include "cPhenotype.h"
 #include "cPopulationCell.h"
+#include "cPopulationTileEngine.h"
 #include "cResource.h"
 #include "cResourceCount.h"
 #include "cStats.h"
@@ -79,6 +86,10 @@ using namespace std;
 using namespace AvidaTools;
 
 static const PropertyID s_prop_id_instset("instset");
+static const PropertyAtom s_prop_atom_instset = PropertyAtoms::Intern(s_prop_id_instset);
+static const PropertyAtom s_prop_atom_threshold = PropertyAtoms::Intern("threshold");
+static const PropertyAtom s_prop_atom_last_forager_type = PropertyAtoms::Intern("last_forager_type");
+static const PropertyAtom s_prop_atom_last_group_id = PropertyAtoms::Intern("last_group_id");
 
 
 cPopulationOrgStatProvider::~cPopulationOrgStatProvider() { ; }
@@ -156,7 +167,7 @@ public:
   
   void HandleOrganism(cOrganism* organism)
   {
-    Apto::String inst_set = organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue();
+    Apto::String inst_set = organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue();
     Apto::Array<Apto::Stat::Accumulator<int> >& inst_exe_counts = m_is_exe_inst_map[inst_set];
     for (int j = 0; j < organism->GetPhenotype().GetLastInstCount().GetSize(); j++) {
       inst_exe_counts[j].Add(organism->GetPhenotype().GetLastInstCount()[j]);
@@ -244,7 +255,7 @@ public:
   
   void HandleOrganism(cOrganism* organism)
   {
-    Apto::String inst_set = organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue();
+    Apto::String inst_set = organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue();
     Apto::Array<Apto::Stat::Accumulator<int> >& inst_exe_counts = m_is_exe_inst_map[inst_set];
     for (int j = 0; j < organism->GetPhenotype().GetLastFromMessageInstCount().GetSize(); j++) {
       inst_exe_counts[j].Add(organism->GetPhenotype().GetLastFromMessageInstCount()[j]);
@@ -276,6 +287,8 @@ cPopulation::cPopulation(cWorld* world)
 , num_pred_organisms(0)
 , num_top_pred_organisms(0)
 , sync_events(false)
+, m_tile_engine(NULL)
+, m_rng_base_seed(world->GetRandom().Seed())
 , m_hgt_resid(-1)
 {
   world_x = world->GetConfig().WORLD_X.Get();
@@ -364,6 +377,8 @@ void cPopulation::SetupCellGrid()
       cell_array[cell_id].SetDemeID(deme_id);
     }
     deme_array[deme_id].Setup(deme_id, deme_cells, deme_size_x, m_world);
+    deme_array[deme_id].GetDemeResources().SetClock(&m_deme_clock);
+    deme_array[deme_id].GetDemeResources().SetProfiler(&m_world->GetPhaseProfiler());
   }
   
   // Setup the topology.
@@ -401,10 +416,12 @@ void cPopulation::SetupCellGrid()
     }
   }
   
+  TopologyChanged();
   BuildTimeSlicer();
   
   
   // Setup the resources...
+  resource_count.SetProfiler(&m_world->GetPhaseProfiler());
   const cResourceLib& resource_lib = environment.GetResourceLib();
   int global_res_index = -1;
   int deme_res_index = -1;
@@ -496,6 +513,102 @@ void cPopulation::ResizeCellGrid(int x, int y)
 }
 
 
+void cPopulation::TopologyChanged()
+{
+  Apto::MutexAutoLock lock(m_neighborhood_mutex);
+  clearNeighborhoodTables();
+  
+  const int num_cells = cell_array.GetSize();
+  int num_links = 0;
+  for (int i = 0; i < num_cells; i++) num_links += cell_array[i].ConnectionList().GetSize();
+  
+  m_adj_offsets.ResizeClear(num_cells + 1);
+  m_adj_cells.ResizeClear(num_links);
+  int pos = 0;
+  for (int i = 0; i < num_cells; i++) {
+    m_adj_offsets[i] = pos;
+    tConstListIterator<cPopulationCell> conn_it(cell_array[i].ConnectionList());
+    const cPopulationCell* conn_cell;
+    while ((conn_cell = conn_it.Next())) m_adj_cells[pos++] = conn_cell->GetID();
+  }
+  m_adj_offsets[num_cells] = pos;
+}
+
+
+cCellNeighborhood cPopulation::GetNeighborhood(int cell_id, int depth)
+{
+  assert(cell_id >= 0 && cell_id < cell_array.GetSize());
+  if (depth < 1) return cCellNeighborhood();
+  
+  const sNeighborhoodTable* table = NULL;
+  {
+    Apto::MutexAutoLock lock(m_neighborhood_mutex);
+    if (m_neighborhoods.GetSize() < depth) {
+      const int old_size = m_neighborhoods.GetSize();
+      m_neighborhoods.Resize(depth);
+      for (int i = old_size; i < depth; i++) m_neighborhoods[i] = NULL;
+    }
+    if (m_neighborhoods[depth - 1] == NULL) m_neighborhoods[depth - 1] = buildNeighborhoodTable(depth);
+    table = m_neighborhoods[depth - 1];
+  }
+  
+  const int start = table->offsets[cell_id];
+  const int size = table->offsets[cell_id + 1] - start;
+  return (size) ? cCellNeighborhood(&table->cells[start], size) : cCellNeighborhood();
+}
+
+
+cPopulation::sNeighborhoodTable* cPopulation::buildNeighborhoodTable(int depth) const
+{
+  const int num_cells = cell_array.GetSize();
+  sNeighborhoodTable* table = new sNeighborhoodTable;
+  table->offsets.ResizeClear(num_cells + 1);
+  
+  // Breadth-first search out from each cell.  Visits are stamped with the source cell, so the marks never need clearing.
+  Apto::Array<int> visited(num_cells);
+  visited.SetAll(-1);
+  Apto::Array<int, Apto::Smart> frontier[2];
+  
+  for (int source = 0; source < num_cells; source++) {
+    const int first = table->cells.GetSize();
+    table->offsets[source] = first;
+    visited[source] = source;
+    
+    int cur = 0;
+    frontier[cur].Resize(0);
+    frontier[cur].Push(source);
+    for (int hop = 0; hop < depth && frontier[cur].GetSize(); hop++) {
+      Apto::Array<int, Apto::Smart>& next = frontier[1 - cur];
+      next.Resize(0);
+      for (int f = 0; f < frontier[cur].GetSize(); f++) {
+        const int cell_id = frontier[cur][f];
+        for (int a = m_adj_offsets[cell_id]; a < m_adj_offsets[cell_id + 1]; a++) {
+          const int neighbor_id = m_adj_cells[a];
+          if (visited[neighbor_id] == source) continue;
+          visited[neighbor_id] = source;
+          next.Push(neighbor_id);
+          table->cells.Push(neighbor_id);
+        }
+      }
+      cur = 1 - cur;
+    }
+    
+    const int count = table->cells.GetSize() - first;
+    if (count > 1) std::sort(&table->cells[first], &table->cells[first] + count);
+  }
+  table->offsets[num_cells] = table->cells.GetSize();
+  
+  return table;
+}
+
+
+void cPopulation::clearNeighborhoodTables()
+{
+  for (int i = 0; i < m_neighborhoods.GetSize(); i++) delete m_neighborhoods[i];
+  m_neighborhoods.Resize(0);
+}
+
+
 
 
 Data::ConstDataSetPtr cPopulation::Provides() const
@@ -604,6 +717,7 @@ cPopulation::~cPopulation()
 {
   for (int i = 0; i < cell_array.GetSize(); i++) delete cell_array[i].GetOrganism(); 
   delete m_scheduler;
+  clearNeighborhoodTables();
 }
 
 
@@ -614,6 +728,16 @@ inline void cPopulation::AdjustSchedule(const cPopulationCell& cell, const cMeri
   m_scheduler->AdjustPriority(cell.GetID(), deme.HasDemeMerit() ? (merit.GetDouble() * deme.GetDemeMerit().GetDouble()) : merit.GetDouble());
 }
 
+inline void cPopulation::AdvanceDemeClock(double step_size)
+{
+  // Deme resources apply elapsed steps lazily, so bring them all up to date before the step size changes
+  if (step_size != m_deme_clock.GetStepSize()) {
+    for (int i = 0; i < deme_array.GetSize(); i++) deme_array[i].GetDemeResourceCount().SyncClock();
+    m_deme_clock.SetStepSize(step_size);
+  }
+  m_deme_clock.Advance();
+}
+
 
 
 // Activate the child, given information from the parent.
@@ -621,6 +745,7 @@ inline void cPopulation::AdjustSchedule(const cPopulationCell& cell, const cMeri
 bool cPopulation::ActivateOffspring(cAvidaContext& ctx, const Genome& offspring_genome, cOrganism* parent_organism)
 {
   assert(parent_organism != NULL);
+  cPhaseProfiler::cScope profile(&m_world->GetPhaseProfiler(), cPhaseProfiler::BIRTHS);
   bool is_doomed = false;
   int doomed_cell = (world_x * world_y) - 1; //Also at the end of cPopulation::ActivateOrganism
   Apto::Array<cOrganism*> offspring_array;
@@ -1161,7 +1286,7 @@ bool cPopulation::ActivateParasite(cOrganism* host, Systematics::UnitPtr parent,
   // Pre-check target hardware
   const cHardwareBase& hw = target_organism->GetHardware();
   if (hw.GetType() != parent->UnitGenome().HardwareType() ||
-      hw.GetInstSet().GetInstSetName() != (const char*)parent->UnitGenome().Properties().Get(s_prop_id_instset).StringValue() ||
+      hw.GetInstSet().GetInstSetName() != (const char*)parent->UnitGenome().Properties().Get(s_prop_atom_instset).StringValue() ||
       hw.GetNumThreads() == m_world->GetConfig().MAX_CPU_THREADS.Get()) return false;
   
   //Handle host specific injection
@@ -1240,6 +1365,7 @@ bool cPopulation::ActivateOrganism(cAvidaContext& ctx, cOrganism* in_organism, c
   assert(in_organism != NULL);
   
   in_organism->SetOrgInterface(ctx, new cPopulationInterface(m_world));
+  in_organism->GetHardware().SetInstProfile(m_world->GetPhaseProfiler().GetInstProfile((const char*)in_organism->GetHardware().GetInstSet().GetInstSetName()));
   
   // Update the contents of the target cell.
   KillOrganism(target_cell, ctx); 
@@ -1690,10 +1816,10 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
     if (bg_id_list.GetSize() < max_bgs && (!doms_done || !fts_done || !grps_done)) {
       if (i == 0 && save_dominants && num_doms > 0) {
         for (int j = 0; j < num_doms; j++) {
-          if (bg && ((bool)Apto::StrAs(bg->Properties().Get("threshold")) || bg_id_list.GetSize() == 0)) {
+          if (bg && ((bool)Apto::StrAs(bg->Properties().Get(s_prop_atom_threshold)) || bg_id_list.GetSize() == 0)) {
             bg_id_list.Push(bg->ID());
             if (save_foragers) {
-              int ft = Apto::StrAs(bg->Properties().Get("last_forager_type")); 
+              int ft = Apto::StrAs(bg->Properties().Get(s_prop_atom_last_forager_type)); 
               if (fts_left > 0) {
                 for (int k = 0; k < fts_to_use.GetSize(); k++) {
                   if (ft == fts_to_use[k]) {
@@ -1712,7 +1838,7 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
               }
             }
             if (save_groups) {
-              int grp = bg->Properties().Get("last_group_id"); 
+              int grp = bg->Properties().Get(s_prop_atom_last_group_id); 
               if (groups_left > 0) {
                 for (int k = 0; k < groups_to_use.GetSize(); k++) {
                   if (grp == groups_to_use[k]) {
@@ -1736,7 +1862,7 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
             }
             else bg = it->Next();
           }
-          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get("threshold")))) {      // no more above threshold
+          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get(s_prop_atom_threshold)))) {      // no more above threshold
             doms_done = true; 
             break; 
           }
@@ -1746,8 +1872,8 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
       
       else if (i == 1 && save_foragers && fts_left > 0) {
         for (int j = 0; j < fts_left; j++) {
-          if (bg && ((bool)Apto::StrAs(bg->Properties().Get("threshold")) || bg_id_list.GetSize() == 0)) {
-            int ft = bg->Properties().Get("last_forager_type"); 
+          if (bg && ((bool)Apto::StrAs(bg->Properties().Get(s_prop_atom_threshold)) || bg_id_list.GetSize() == 0)) {
+            int ft = bg->Properties().Get(s_prop_atom_last_forager_type); 
             bool found_one = false;
             for (int k = 0; k < fts_to_use.GetSize(); k++) {
               if (ft == fts_to_use[k]) {
@@ -1765,7 +1891,7 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
               }
             }
             if (save_groups) {
-              int grp = bg->Properties().Get("last_group_id"); 
+              int grp = bg->Properties().Get(s_prop_atom_last_group_id); 
               if (groups_left > 0) {
                 for (int k = 0; k < groups_to_use.GetSize(); k++) {
                   if (grp == groups_to_use[k]) {
@@ -1790,7 +1916,7 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
             else bg = it->Next();
             if (!found_one) j--;
           }
-          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get("threshold")))) {  // no more above threshold
+          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get(s_prop_atom_threshold)))) {  // no more above threshold
             fts_done = true; 
             break; 
           }
@@ -1800,8 +1926,8 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
       
       else if (i == 2 && save_groups && groups_left > 0) {
         for (int j = 0; j < groups_left; j++) {
-          if (bg && ((bool)Apto::StrAs(bg->Properties().Get("threshold")) || bg_id_list.GetSize() == 0)) {
-            int grp = bg->Properties().Get("last_group_id"); 
+          if (bg && ((bool)Apto::StrAs(bg->Properties().Get(s_prop_atom_threshold)) || bg_id_list.GetSize() == 0)) {
+            int grp = bg->Properties().Get(s_prop_atom_last_group_id); 
             bool found_one = false;
             for (int k = 0; k < groups_to_use.GetSize(); k++) {
               if (grp == groups_to_use[k]) {
@@ -1825,7 +1951,7 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
             else bg = it->Next();
             if (!found_one) j--;
           }
-          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get("threshold")))) {  // no more above threshold
+          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get(s_prop_atom_threshold)))) {  // no more above threshold
             grps_done = true; 
             break; 
           }
@@ -2139,6 +2265,8 @@ void cPopulation::KillOrganism(cPopulationCell& in_cell, cAvidaContext& ctx)
   // do we actually have something to kill?
   if (in_cell.IsOccupied() == false) return;
   
+  cPhaseProfiler::cScope profile(&m_world->GetPhaseProfiler(), cPhaseProfiler::DEATHS);
+  
   // Statistics...
   cOrganism* organism = in_cell.GetOrganism();
   m_world->GetStats().RecordDeath();
@@ -3040,7 +3168,7 @@ void cPopulation::ReplaceDeme(cDeme& source_deme, cDeme& target_deme, cAvidaCont
     Genome next_germ(source_deme.GetGermline().GetLatest());
     InstructionSequencePtr seq;
     seq.DynamicCastFrom(next_germ.Representation());
-    const cInstSet& instset = m_world->GetHardwareManager().GetInstSet(next_germ.Properties().Get(s_prop_id_instset).StringValue());
+    const cInstSet& instset = m_world->GetHardwareManager().GetInstSet(next_germ.Properties().Get(s_prop_atom_instset).StringValue());
     
     if (m_world->GetConfig().GERMLINE_COPY_MUT.Get() > 0.0) {
       for(int i = 0; i < seq->GetSize(); ++i) {
@@ -3094,7 +3222,7 @@ void cPopulation::ReplaceDeme(cDeme& source_deme, cDeme& target_deme, cAvidaCont
     InstructionSequencePtr seq;
     seq.DynamicCastFrom(mg.Representation());
     cCPUMemory new_genome(*seq);
-    const cInstSet& instset = m_world->GetHardwareManager().GetInstSet(mg.Properties().Get(s_prop_id_instset).StringValue());
+    const cInstSet& instset = m_world->GetHardwareManager().GetInstSet(mg.Properties().Get(s_prop_atom_instset).StringValue());
     
     if (m_world->GetConfig().GERMLINE_COPY_MUT.Get() > 0.0) {
       for(int i=0; i < new_genome.GetSize(); ++i) {
@@ -3272,7 +3400,7 @@ void cPopulation::ReplaceDemeFlaggedGermline(cDeme& source_deme, cDeme& target_d
     seq.DynamicCastFrom(mg.Representation());
     cCPUMemory new_genome(*seq);
 
-    const cInstSet& instset = m_world->GetHardwareManager().GetInstSet(mg.Properties().Get(s_prop_id_instset).StringValue());
+    const cInstSet& instset = m_world->GetHardwareManager().GetInstSet(mg.Properties().Get(s_prop_atom_instset).StringValue());
     
     if (m_world->GetConfig().GERMLINE_COPY_MUT.Get() > 0.0) {
       for(int i=0; i<new_genome.GetSize(); ++i) {
@@ -3903,7 +4031,7 @@ void cPopulation::SeedDeme_InjectDemeFounder(int _cell_id, Systematics::GroupPtr
     InstructionSequencePtr seq;
     seq.DynamicCastFrom(mg.Representation());
     cCPUMemory new_genome(*seq);
-    const cInstSet& instset = m_world->GetHardwareManager().GetInstSet(mg.Properties().Get(s_prop_id_instset).StringValue());
+    const cInstSet& instset = m_world->GetHardwareManager().GetInstSet(mg.Properties().Get(s_prop_atom_instset).StringValue());
     
     if (m_world->GetConfig().GERMLINE_COPY_MUT.Get() > 0.0) {
       for(int i=0; i<new_genome.GetSize(); ++i) {
@@ -4656,7 +4784,7 @@ void cPopulation::PrintDemeInstructions()
       for (int i = 0; i < cur_deme.GetSize(); i++) {
         int cur_cell = cur_deme.GetCellID(i);
         if (!cell_array[cur_cell].IsOccupied()) continue;
-        if (cell_array[cur_cell].GetOrganism()->GetGenome().Properties().Get(s_prop_id_instset).StringValue() != inst_set) continue;
+        if (cell_array[cur_cell].GetOrganism()->GetGenome().Properties().Get(s_prop_atom_instset).StringValue() != inst_set) continue;
         cPhenotype& phenotype = GetCell(cur_cell).GetOrganism()->GetPhenotype();
         
         for (int j = 0; j < num_inst; j++) single_deme_inst[j].Add(phenotype.GetLastInstCount()[j]);
@@ -5552,9 +5680,7 @@ void cPopulation::ProcessStep(cAvidaContext& ctx, double step_size, int cell_id)
   resource_count.Update(step_size);
   
   // These must be done even if there is only one deme.
-  for(int i = 0; i < GetNumDemes(); i++) {
-    GetDeme(i).Update(step_size);
-  }
+  AdvanceDemeClock(step_size);
   
   cDeme & deme = GetDeme(GetCell(cell_id).GetDemeID());
   deme.IncTimeUsed(merit);
@@ -5598,7 +5724,7 @@ void cPopulation::ProcessStepSpeculative(cAvidaContext& ctx, double step_size, i
   
   // Deme specific
   if (GetNumDemes() > 1) {
-    for(int i = 0; i < GetNumDemes(); i++) GetDeme(i).Update(step_size);
+    AdvanceDemeClock(step_size);
     
     cDeme& deme = GetDeme(GetCell(cell_id).GetDemeID());
     deme.IncTimeUsed(cur_org->GetPhenotype().GetMerit().GetDouble());
@@ -5732,7 +5858,7 @@ void cPopulation::UpdateOrganismStats(cAvidaContext& ctx)
     const int cur_gestation_time = phenotype.GetGestationTime();
     const int cur_genome_length = phenotype.GetGenomeLength();
     
-    Apto::Array<Apto::Stat::Accumulator<int> >& from_message_exec_counts = stats.InstFromMessageExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+    Apto::Array<Apto::Stat::Accumulator<int> >& from_message_exec_counts = stats.InstFromMessageExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue());
     for (int j = 0; j < phenotype.GetLastFromMessageInstCount().GetSize(); j++) {
       from_message_exec_counts[j].Add(organism->GetPhenotype().GetLastFromMessageInstCount()[j]);
     }
@@ -5915,11 +6041,11 @@ void cPopulation::UpdateFTOrgStats(cAvidaContext&)
       stats.SumPreyCreatureAge().Add(phenotype.GetAge());
       stats.SumPreyGeneration().Add(phenotype.GetGeneration());
       
-      Apto::Array<Apto::Stat::Accumulator<int> >& prey_inst_exe_counts = stats.InstPreyExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+      Apto::Array<Apto::Stat::Accumulator<int> >& prey_inst_exe_counts = stats.InstPreyExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue());
       for (int j = 0; j < phenotype.GetLastInstCount().GetSize(); j++) {
         prey_inst_exe_counts[j].Add(organism->GetPhenotype().GetLastInstCount()[j]);
       }
-      Apto::Array<Apto::Stat::Accumulator<int> >& prey_from_sensor_exec_counts = stats.InstPreyFromSensorExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+      Apto::Array<Apto::Stat::Accumulator<int> >& prey_from_sensor_exec_counts = stats.InstPreyFromSensorExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue());
       for (int j = 0; j < phenotype.GetLastFromSensorInstCount().GetSize(); j++) {
         prey_from_sensor_exec_counts[j].Add(organism->GetPhenotype().GetLastFromSensorInstCount()[j]);
       }
@@ -5933,19 +6059,19 @@ void cPopulation::UpdateFTOrgStats(cAvidaContext&)
       stats.SumAttacks().Add(phenotype.GetLastAttacks());
       stats.SumKills().Add(phenotype.GetLastKills());
 
-      Apto::Array<Apto::Stat::Accumulator<int> >& pred_inst_exe_counts = stats.InstPredExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+      Apto::Array<Apto::Stat::Accumulator<int> >& pred_inst_exe_counts = stats.InstPredExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue());
       for (int j = 0; j < phenotype.GetLastInstCount().GetSize(); j++) {
         pred_inst_exe_counts[j].Add(organism->GetPhenotype().GetLastInstCount()[j]);
       }
 
-      Apto::Array<Apto::Stat::Accumulator<int> >& pred_from_sensor_exec_counts = stats.InstPredFromSensorExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+      Apto::Array<Apto::Stat::Accumulator<int> >& pred_from_sensor_exec_counts = stats.InstPredFromSensorExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue());
       for (int j = 0; j < phenotype.GetLastFromSensorInstCount().GetSize(); j++) {
         pred_from_sensor_exec_counts[j].Add(organism->GetPhenotype().GetLastFromSensorInstCount()[j]);
       }
 
-      Apto::Array<cString> att_inst = m_world->GetStats().GetGroupAttackInsts((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+      Apto::Array<cString> att_inst = m_world->GetStats().GetGroupAttackInsts((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue());
       for (int k = 0; k < att_inst.GetSize(); k++) {
-        Apto::Array<Apto::Stat::Accumulator<int> >& group_attack_inst_exe_counts = stats.ExecCountsForGroupAttackInst((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue(), att_inst[k]);
+        Apto::Array<Apto::Stat::Accumulator<int> >& group_attack_inst_exe_counts = stats.ExecCountsForGroupAttackInst((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue(), att_inst[k]);
         for (int j = 0; j < phenotype.GetLastGroupAttackInstCount()[k].GetSize(); j++) {
           group_attack_inst_exe_counts[j].Add(organism->GetPhenotype().GetLastGroupAttackInstCount()[k][j]);
         }
@@ -5960,17 +6086,17 @@ void cPopulation::UpdateFTOrgStats(cAvidaContext&)
       stats.SumAttacks().Add(phenotype.GetLastAttacks());
       stats.SumKills().Add(phenotype.GetLastKills());
      
-      Apto::Array<Apto::Stat::Accumulator<int> >& tpred_inst_exe_counts = stats.InstTopPredExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+      Apto::Array<Apto::Stat::Accumulator<int> >& tpred_inst_exe_counts = stats.InstTopPredExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue());
       for (int j = 0; j < phenotype.GetLastInstCount().GetSize(); j++) {
         tpred_inst_exe_counts[j].Add(organism->GetPhenotype().GetLastInstCount()[j]);
       }
-      Apto::Array<Apto::Stat::Accumulator<int> >& tpred_from_sensor_exec_counts = stats.InstTopPredFromSensorExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+      Apto::Array<Apto::Stat::Accumulator<int> >& tpred_from_sensor_exec_counts = stats.InstTopPredFromSensorExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue());
       for (int j = 0; j < phenotype.GetLastFromSensorInstCount().GetSize(); j++) {
         tpred_from_sensor_exec_counts[j].Add(organism->GetPhenotype().GetLastFromSensorInstCount()[j]);
       }
-      Apto::Array<cString> att_inst = m_world->GetStats().GetGroupAttackInsts((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+      Apto::Array<cString> att_inst = m_world->GetStats().GetGroupAttackInsts((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue());
       for (int k = 0; k < att_inst.GetSize(); k++) {
-        Apto::Array<Apto::Stat::Accumulator<int> >& group_attack_inst_exe_counts = stats.ExecCountsForGroupAttackInst((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue(), att_inst[k]);
+        Apto::Array<Apto::Stat::Accumulator<int> >& group_attack_inst_exe_counts = stats.ExecCountsForGroupAttackInst((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue(), att_inst[k]);
         for (int j = 0; j < phenotype.GetLastTopPredGroupAttackInstCount()[k].GetSize(); j++) {
           group_attack_inst_exe_counts[j].Add(organism->GetPhenotype().GetLastTopPredGroupAttackInstCount()[k][j]);
         }
@@ -6027,7 +6153,7 @@ void cPopulation::UpdateMaleFemaleOrgStats(cAvidaContext& ctx)
       stats.SumMaleCreatureAge().Add(phenotype.GetAge());
       stats.SumMaleGeneration().Add(phenotype.GetGeneration());
       
-      Apto::Array<Apto::Stat::Accumulator<int> >& male_inst_exe_counts = stats.InstMaleExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+      Apto::Array<Apto::Stat::Accumulator<int> >& male_inst_exe_counts = stats.InstMaleExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue());
       for (int j = 0; j < phenotype.GetLastInstCount().GetSize(); j++) {
         male_inst_exe_counts[j].Add(organism->GetPhenotype().GetLastInstCount()[j]);
       }
@@ -6039,7 +6165,7 @@ void cPopulation::UpdateMaleFemaleOrgStats(cAvidaContext& ctx)
       stats.SumFemaleCreatureAge().Add(phenotype.GetAge());
       stats.SumFemaleGeneration().Add(phenotype.GetGeneration());
       
-      Apto::Array<Apto::Stat::Accumulator<int> >& female_inst_exe_counts = stats.InstFemaleExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+      Apto::Array<Apto::Stat::Accumulator<int> >& female_inst_exe_counts = stats.InstFemaleExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_atom_instset).StringValue());
       for (int j = 0; j < phenotype.GetLastInstCount().GetSize(); j++) {
         female_inst_exe_counts[j].Add(organism->GetPhenotype().GetLastInstCount()[j]);
       }
@@ -6055,9 +6181,38 @@ void cPopulation::UpdateResStats(cAvidaContext& ctx)
   stats.SetResourcesGeometry(resource_count.GetResourcesGeometry()); 
 }
 
+// Seed for restarting a random number stream at the start of an update, so that the draws of each update depend only
+// on the base seed and the update number rather than on everything drawn before it
+static int updateStreamSeed(int seed, int update, int stream, int max_seed)
+{
+  unsigned int h = static_cast<unsigned int>(seed) ^ (static_cast<unsigned int>(update) * 0x9E3779B9u);
+  h ^= static_cast<unsigned int>(stream) * 0x85EBCA6Bu;
+  h ^= h >> 16;
+  h *= 0x7FEB352Du;
+  h ^= h >> 15;
+  h *= 0x846CA68Bu;
+  h ^= h >> 16;
+  return static_cast<int>(h % static_cast<unsigned int>(max_seed));
+}
+
 void cPopulation::ProcessPreUpdate()
 {
-  resource_count.SetSpatialUpdate(m_world->GetStats().GetUpdate());
+  const int update = m_world->GetStats().GetUpdate();
+  
+  // Restarting every stream here is what lets a run restored from a checkpoint, which only records the base seed,
+  // continue with exactly the draws of the run that saved it
+  if (m_world->GetConfig().CHECKPOINT_RNG_STREAMS.Get()) {
+    Apto::Random& rng = m_world->GetRandom();
+    rng.ResetSeed(updateStreamSeed(m_rng_base_seed, update, 0, rng.MaxSeed()));
+    if (m_scheduler_rng) m_scheduler_rng->ResetSeed(updateStreamSeed(m_rng_base_seed, update, 1, rng.MaxSeed()));
+    if (m_tile_engine) {
+      Apto::Array<int> tile_seeds(m_tile_engine->GetNumTiles());
+      for (int i = 0; i < tile_seeds.GetSize(); i++) tile_seeds[i] = updateStreamSeed(m_rng_base_seed, update, i + 2, rng.MaxSeed());
+      m_tile_engine->ResetSeeds(tile_seeds);
+    }
+  }
+  
+  resource_count.SetSpatialUpdate(update);
   for (int i = 0; i < deme_array.GetSize(); i++) deme_array[i].ProcessPreUpdate();   
 }
 
@@ -6486,6 +6641,23 @@ bool cPopulation::SaveFlameData(const cString& filename)
   return true;
 }
 
+// Saved genotype properties read by the legacy Genotype constructor
+static const int NUM_LEGACY_GENOTYPE_PROPS = 10;
+static const char* const LEGACY_GENOTYPE_PROPS[NUM_LEGACY_GENOTYPE_PROPS] = {
+  "src_args", "inst_set", "hw_type", "sequence", "gen_born", "update_born", "update_deactivated", "depth", "parents", "parent_id"
+};
+
+static inline bool hasColumnValue(const cColumnFile& file, int row, int col)
+{
+  return (col >= 0 && file.HasValue(row, col));
+}
+
+template <typename T> static inline void loadColumnList(const cColumnFile& file, int row, int col, Apto::Array<T>& list)
+{
+  if (col >= 0) file.GetList(row, col, list);
+  else list.Resize(0);
+}
+
 struct sTmpGenotype
 {
 public:
@@ -6493,6 +6665,8 @@ public:
   Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props;
   
   int num_cpus;
+  double merit;
+  double gest_time;
   Apto::Array<int> cells;
   Apto::Array<int> offsets;
   Apto::Array<int> lineage_labels;
@@ -6507,7 +6681,7 @@ public:
   Systematics::GroupPtr bg;
   
   
-  inline sTmpGenotype() : id_num(-1), props(NULL) { ; }
+  inline sTmpGenotype() : id_num(-1), props(NULL), num_cpus(0), merit(0.0), gest_time(0.0) { ; }
   inline bool operator<(const sTmpGenotype& rhs) const { return id_num > rhs.id_num; }
   inline bool operator>(const sTmpGenotype& rhs) const { return id_num < rhs.id_num; }
   inline bool operator<=(const sTmpGenotype& rhs) const { return id_num >= rhs.id_num; }
@@ -6552,134 +6726,117 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
 {
   // @TODO - build in support for verifying population dimensions
   
-  cInitFile input_file(filename, m_world->GetWorkingDir(), ctx.Driver().Feedback());
+  cColumnFile input_file(filename, m_world->GetWorkingDir(), ctx.Driver().Feedback(), m_world->GetConfig().MAX_CONCURRENCY.Get());
   if (!input_file.WasOpened()) return false;
   
-  // Clear out the population, unless an offset is being used
-  if (cellid_offset == 0) {
-    for (int i = 0; i < cell_array.GetSize(); i++) KillOrganism(cell_array[i], ctx); 
+  // Resolve the columns once, the parser threads convert them as each block of the file is read
+  const int col_id = input_file.RequestColumn("id", cColumnFile::INT_COLUMN);
+  const int col_num_units = input_file.RequestColumn("num_units", cColumnFile::INT_COLUMN);
+  const int col_num_cpus = input_file.RequestColumn("num_cpus", cColumnFile::INT_COLUMN);
+  const int col_cells = input_file.RequestColumn("cells", cColumnFile::INT_LIST_COLUMN);
+  const int col_gest_offset = input_file.RequestColumn("gest_offset", cColumnFile::INT_LIST_COLUMN);
+  const int col_lineage = input_file.RequestColumn("lineage", cColumnFile::INT_LIST_COLUMN);
+  const int col_birth_cell = input_file.RequestColumn("birth_cell", cColumnFile::INT_LIST_COLUMN);
+  const int col_av_bcell = input_file.RequestColumn("av_bcell", cColumnFile::INT_LIST_COLUMN);
+  const int col_avatar_cell = input_file.RequestColumn("avatar_cell", cColumnFile::INT_LIST_COLUMN);
+  const int col_parent_is_teach = input_file.RequestColumn("parent_is_teach", cColumnFile::INT_LIST_COLUMN);
+  const int col_parent_ft = input_file.RequestColumn("parent_ft", cColumnFile::INT_LIST_COLUMN);
+  const int col_parent_merit = input_file.RequestColumn("parent_merit", cColumnFile::DOUBLE_LIST_COLUMN);
+  const int col_group_id = input_file.RequestColumn("group_id", cColumnFile::INT_LIST_COLUMN);
+  const int col_forager_type = input_file.RequestColumn("forager_type", cColumnFile::INT_LIST_COLUMN);
+  const int col_merit = input_file.RequestColumn("merit", cColumnFile::DOUBLE_COLUMN);
+  const int col_gest_time = input_file.RequestColumn("gest_time", cColumnFile::DOUBLE_COLUMN);
+  
+  // Genotype properties are handed to the genotype arbiter as text
+  Apto::Array<int> genotype_cols(NUM_LEGACY_GENOTYPE_PROPS);
+  for (int i = 0; i < NUM_LEGACY_GENOTYPE_PROPS; i++) {
+    genotype_cols[i] = input_file.RequestColumn(LEGACY_GENOTYPE_PROPS[i], cColumnFile::TEXT_COLUMN);
   }
   
   // First, we read in all the genotypes and store them in an array
-  Apto::Array<sTmpGenotype, Apto::ManagedPointer> genotypes(input_file.GetNumLines());
+  Apto::Array<sTmpGenotype, Apto::ManagedPointer> genotypes;
+  Apto::Array<int> parent_teacher;
   
   bool structured = false;
-  for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
-    cString cur_line = input_file.GetLine(line_id);
-    
-    // Setup the genotype for this line...
-    sTmpGenotype& tmp = genotypes[line_id];
-    tmp.props = input_file.GetLineAsDict(line_id);
-    tmp.id_num = Apto::StrAs(tmp.props->Get("id"));
-
-    // Loads "num_units" preferrentially, but will fall back to "num_cpus" if present
-    assert(tmp.props->Has("num_cpus") || tmp.props->Has("num_units"));
-    tmp.num_cpus = (tmp.props->Has("num_units")) ? Apto::StrAs(tmp.props->Get("num_units")) : Apto::StrAs(tmp.props->Get("num_cpus"));
-    
-    // Process resident cell ids
-    cString cellstr(tmp.props->Get("cells"));
-    if (structured || cellstr.GetSize()) {
-      structured = true;
-      while (cellstr.GetSize()) tmp.cells.Push(cellstr.Pop(',').AsInt());
-      assert(tmp.cells.GetSize() == tmp.num_cpus);
-    }
-    
-    // Process gestation time offsets
-    if (!load_rebirth) {
-      cString offsetstr(tmp.props->Get("gest_offset"));
-      if (offsetstr.GetSize()) {
-        while (offsetstr.GetSize()) tmp.offsets.Push(offsetstr.Pop(',').AsInt());
-        assert(tmp.offsets.GetSize() == tmp.num_cpus);
-      }
-    }
-    // Lineage label (only set if given in file)
-    cString lineagestr(tmp.props->Get("lineage"));
-    while (lineagestr.GetSize()) tmp.lineage_labels.Push(lineagestr.Pop(',').AsInt());
-    // @blw preserve compatability with older .spop files that don't have lineage labels
-    assert(tmp.lineage_labels.GetSize() == 0 || tmp.lineage_labels.GetSize() == tmp.num_cpus);
-    
-    // Other org specs (if given in file)
-    if (load_rebirth) {
-      if (tmp.props->Has("birth_cell")) {
-        cString birthstr(tmp.props->Get("birth_cell"));
-        while (birthstr.GetSize()) tmp.birth_cells.Push(birthstr.Pop(',').AsInt());
-        assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);      
-      }
-      if (tmp.props->Has("av_bcell") && m_world->GetConfig().USE_AVATARS.Get()) {
-        cString avatarstr(tmp.props->Get("av_bcell"));
-        while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
-        assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_is_teach")) {
-        cString teachstr(tmp.props->Get("parent_is_teach"));
-        while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
-        assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_ft")) {
-        cString parentftstr(tmp.props->Get("parent_ft"));
-        while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
-        assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_merit")) {
-        cString meritstr(tmp.props->Get("parent_merit"));
-        while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
-        assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);
-      }
-    }
-    else {
-      if (load_groups) {
-        if (tmp.props->Has("group_id")) {
-          cString groupstr(tmp.props->Get("group_id"));
-          while (groupstr.GetSize()) tmp.group_ids.Push(groupstr.Pop(',').AsInt());
-          assert(tmp.group_ids.GetSize() == 0 || tmp.group_ids.GetSize() == tmp.num_cpus);
-        }
-        if (tmp.props->Has("forager_type")) {
-          cString foragestr(tmp.props->Get("forager_type"));
-          while (foragestr.GetSize()) tmp.forager_types.Push(foragestr.Pop(',').AsInt());
-          assert(tmp.forager_types.GetSize() == 0 || tmp.forager_types.GetSize() == tmp.num_cpus);
-        }
-      }
-      if (load_birth_cells) {   
-        if (tmp.props->Has("birth_cell")) {
-          cString birthstr(tmp.props->Get("birth_cell"));
-          while (birthstr.GetSize()) tmp.birth_cells.Push(birthstr.Pop(',').AsInt());
-          assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);
-        }
-        if (tmp.props->Has("av_bcell") && m_world->GetConfig().USE_AVATARS.Get()) {
-          cString avatarstr(tmp.props->Get("av_bcell"));
-          while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
-          assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
+  while (input_file.ReadBlock()) {
+    const int first_genotype = genotypes.GetSize();
+    genotypes.Resize(first_genotype + input_file.GetNumRows());
+    
+    for (int row = 0; row < input_file.GetNumRows(); row++) {
+      // Setup the genotype for this line...
+      sTmpGenotype& tmp = genotypes[first_genotype + row];
+      tmp.props = Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> >(new Apto::Map<Apto::String, Apto::String>);
+      for (int i = 0; i < NUM_LEGACY_GENOTYPE_PROPS; i++) {
+        if (hasColumnValue(input_file, row, genotype_cols[i])) {
+          tmp.props->Set(LEGACY_GENOTYPE_PROPS[i], input_file.GetText(row, genotype_cols[i]));
         }
       }
-      else if (!load_birth_cells && load_avatars && tmp.props->Has("avatar_cell")) {
-        cString avatarstr(tmp.props->Get("avatar_cell"));
-        while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
-        assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
-      }
-    if (load_parent_dat) {
-      if (tmp.props->Has("parent_is_teach")) {
-        cString teachstr(tmp.props->Get("parent_is_teach"));
-        while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
-        assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
+      tmp.id_num = hasColumnValue(input_file, row, col_id) ? input_file.GetInt(row, col_id) : 0;
+      
+      // Loads "num_units" preferrentially, but will fall back to "num_cpus" if present
+      assert(hasColumnValue(input_file, row, col_num_cpus) || hasColumnValue(input_file, row, col_num_units));
+      if (hasColumnValue(input_file, row, col_num_units)) tmp.num_cpus = input_file.GetInt(row, col_num_units);
+      else tmp.num_cpus = hasColumnValue(input_file, row, col_num_cpus) ? input_file.GetInt(row, col_num_cpus) : 0;
+      
+      assert(m_world->GetConfig().ENERGY_ENABLED.Get() == 1 || hasColumnValue(input_file, row, col_merit));
+      if (hasColumnValue(input_file, row, col_merit)) tmp.merit = input_file.GetDouble(row, col_merit);
+      if (hasColumnValue(input_file, row, col_gest_time)) tmp.gest_time = input_file.GetDouble(row, col_gest_time);
+      
+      // Process resident cell ids
+      loadColumnList(input_file, row, col_cells, tmp.cells);
+      if (structured || tmp.cells.GetSize()) {
+        structured = true;
+        assert(tmp.cells.GetSize() == tmp.num_cpus);
       }
-      if (tmp.props->Has("parent_ft")) {
-        cString parentftstr(tmp.props->Get("parent_ft"));
-        while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
-        assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
+      
+      // Process gestation time offsets
+      if (!load_rebirth) {
+        loadColumnList(input_file, row, col_gest_offset, tmp.offsets);
+        assert(tmp.offsets.GetSize() == 0 || tmp.offsets.GetSize() == tmp.num_cpus);
       }
-      if (tmp.props->Has("parent_merit")) {
-        cString meritstr(tmp.props->Get("parent_merit"));
-        while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
-        assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);      
+      // Lineage label (only set if given in file)
+      loadColumnList(input_file, row, col_lineage, tmp.lineage_labels);
+      // @blw preserve compatability with older .spop files that don't have lineage labels
+      assert(tmp.lineage_labels.GetSize() == 0 || tmp.lineage_labels.GetSize() == tmp.num_cpus);
+      
+      // Other org specs (if given in file)
+      const bool load_av_bcell = m_world->GetConfig().USE_AVATARS.Get();
+      if (load_rebirth || load_birth_cells) {
+        loadColumnList(input_file, row, col_birth_cell, tmp.birth_cells);
+        if (load_av_bcell) loadColumnList(input_file, row, col_av_bcell, tmp.avatar_cells);
+      } else if (load_avatars) {
+        loadColumnList(input_file, row, col_avatar_cell, tmp.avatar_cells);
+      }
+      if (!load_rebirth && load_groups) {
+        loadColumnList(input_file, row, col_group_id, tmp.group_ids);
+        loadColumnList(input_file, row, col_forager_type, tmp.forager_types);
+      }
+      if (load_rebirth || load_parent_dat) {
+        loadColumnList(input_file, row, col_parent_is_teach, parent_teacher);
+        tmp.parent_teacher.Resize(parent_teacher.GetSize());
+        for (int i = 0; i < parent_teacher.GetSize(); i++) tmp.parent_teacher[i] = (bool)parent_teacher[i];
+        loadColumnList(input_file, row, col_parent_ft, tmp.parent_ft);
+        loadColumnList(input_file, row, col_parent_merit, tmp.parent_merit);
+      }
+      if (m_world->GetConfig().USE_AVATARS.Get() && !tmp.avatar_cells.GetSize()) {
+        loadColumnList(input_file, row, col_avatar_cell, tmp.avatar_cells);
       }
-    }
-    }
-    if (m_world->GetConfig().USE_AVATARS.Get() && !tmp.avatar_cells.GetSize()) {
-      cString avatarstr(tmp.props->Get("avatar_cell"));
-      while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
+      
+      assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);
       assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
+      assert(tmp.group_ids.GetSize() == 0 || tmp.group_ids.GetSize() == tmp.num_cpus);
+      assert(tmp.forager_types.GetSize() == 0 || tmp.forager_types.GetSize() == tmp.num_cpus);
+      assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
+      assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
+      assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);
     }
   }
+  if (input_file.HadError()) return false;
+  
+  // Clear out the population, unless an offset is being used
+  if (cellid_offset == 0) {
+    for (int i = 0; i < cell_array.GetSize(); i++) KillOrganism(cell_array[i], ctx); 
+  }
   
   // Sort genotypes in descending order according to their id_num
   Apto::QSort(genotypes);
@@ -6759,9 +6916,8 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
         phenotype.SetMerit(cMerit(phenotype.ConvertEnergyToMerit(phenotype.GetStoredEnergy())));
       } else {
         // Set the phenotype merit from the save file
-        assert(tmp.props->Has("merit"));
-        double merit = Apto::StrAs(tmp.props->Get("merit"));
-        if ((load_rebirth || load_parent_dat) && m_world->GetConfig().INHERIT_MERIT.Get() && tmp.props->Has("parent_merit")) {
+        double merit = tmp.merit;
+        if ((load_rebirth || load_parent_dat) && m_world->GetConfig().INHERIT_MERIT.Get() && tmp.parent_merit.GetSize()) {
           merit = tmp.parent_merit[cell_i]; 
         }
         
@@ -6775,7 +6931,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
           // Adjust initial merit to account for organism execution at the time the population was saved
           // - this factors the merit by the fraction of the gestation time remaining
           // - this will be approximate, since gestation time may vary for each organism, but it should work for many cases
-          double gest_time = Apto::StrAs(tmp.props->Get("gest_time"));
+          double gest_time = tmp.gest_time;
           double gest_remain = gest_time - (double)tmp.offsets[cell_i];
           if (gest_remain > 0.0 && gest_time > 0.0) {
             double new_merit = phenotype.GetMerit().GetDouble() * (gest_time / gest_remain);
@@ -6822,7 +6978,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
         if (load_parent_dat) {
           new_organism->SetParentFT(tmp.parent_ft[cell_i]);
           new_organism->SetParentTeacher(tmp.parent_teacher[cell_i]);
-          if (tmp.props->Has("parent_merit")) new_organism->SetParentMerit(tmp.parent_merit[cell_i]);        
+          if (tmp.parent_merit.GetSize()) new_organism->SetParentMerit(tmp.parent_merit[cell_i]);
         }
       }
       else if (load_rebirth) {
@@ -6855,6 +7011,181 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
   return true;
 }
 
+bool cPopulation::SaveCheckpoint(const cString& filename)
+{
+  if (!checkpointSupported()) return false;
+  
+  cString path((const char*)Avida::Output::Manager::Of(m_world->GetNewWorld())->OutputIDFromPath(Apto::String((const char*)filename)));
+  cCheckpointWriter cp(path);
+  if (!cp.Good()) return false;
+  
+  Systematics::GenotypeArbiterPtr genotypes;
+  genotypes.DynamicCastFrom(Systematics::Manager::Of(m_world->GetNewWorld())->ArbiterForRole("genotype"));
+  if (!genotypes) return false;
+  
+  // Saving draws nothing from the random number streams, and so does not change the course of this run
+  const int update = m_world->GetStats().GetUpdate();
+  
+  cp.WriteHeader();
+  
+  cp.WriteTag("WRLD");
+  cp.Write(world_x);
+  cp.Write(world_y);
+  cp.Write(cell_array.GetSize());
+  cp.Write(deme_array.GetSize());
+  cp.Write(update);
+  cp.Write(m_rng_base_seed);
+  
+  cp.WriteTag("STAT");
+  if (!m_world->GetStats().SaveCheckpoint(cp)) return false;
+  
+  cp.WriteTag("RSRC");
+  resource_count.SaveCheckpoint(cp);
+  for (int i = 0; i < deme_array.GetSize(); i++) deme_array[i].GetDemeResources().SaveCheckpoint(cp);
+  
+  cp.WriteTag("GENO");
+  genotypes->SaveCheckpoint(cp);
+  
+  cp.WriteTag("CELL");
+  for (int i = 0; i < cell_array.GetSize(); i++) {
+    cPopulationCell& cell = cell_array[i];
+    cp.Write(cell.IsOccupied());
+    if (cell.IsOccupied()) {
+      cOrganism* org = cell.GetOrganism();
+      cp.WriteString(cString((const char*)org->GetGenome().AsString()));
+      cp.Write(org->SystematicsGroup("genotype")->ID());
+      if (!org->SaveCheckpoint(cp)) return false;
+    }
+    cell.SaveCheckpoint(cp);
+  }
+  
+  cp.WriteTag("END ");
+  return cp.Flush();
+}
+
+bool cPopulation::LoadCheckpoint(const cString& filename, cAvidaContext& ctx)
+{
+  if (!checkpointSupported()) return false;
+  
+  cString path(Apto::FileSystem::GetAbsolutePath(Apto::String((const char*)filename), Apto::String((const char*)m_world->GetWorkingDir())));
+  cCheckpointReader cp(path);
+  if (!cp.Good() || !cp.ReadHeader()) return false;
+  
+  Systematics::ManagerPtr classmgr = Systematics::Manager::Of(m_world->GetNewWorld());
+  Systematics::GenotypeArbiterPtr genotypes;
+  genotypes.DynamicCastFrom(classmgr->ArbiterForRole("genotype"));
+  if (!genotypes) return false;
+  
+  // The population structure comes from the configuration and must match the checkpoint
+  if (!cp.ReadTag("WRLD")) return false;
+  if (cp.Read<int>() != world_x || cp.Read<int>() != world_y) return false;
+  if (cp.Read<int>() != cell_array.GetSize() || cp.Read<int>() != deme_array.GetSize()) return false;
+  const int update = cp.Read<int>();
+  const int base_seed = cp.Read<int>();
+  if (!cp.Good()) return false;
+  
+  for (int i = 0; i < cell_array.GetSize(); i++) KillOrganism(cell_array[i], ctx);
+  
+  if (!cp.ReadTag("STAT") || !m_world->GetStats().LoadCheckpoint(cp)) return false;
+  
+  if (!cp.ReadTag("RSRC")) return false;
+  resource_count.LoadCheckpoint(cp);
+  for (int i = 0; i < deme_array.GetSize(); i++) deme_array[i].GetDemeResources().LoadCheckpoint(cp);
+  
+  // Genotypes are restored with their IDs, and the organisms below are classified back into them
+  if (!cp.ReadTag("GENO") || !genotypes->LoadCheckpoint(cp)) return false;
+  
+  if (!cp.ReadTag("CELL")) return false;
+  for (int i = 0; i < cell_array.GetSize(); i++) {
+    cPopulationCell& cell = cell_array[i];
+    const bool occupied = cp.Read<bool>();
+    if (!cp.Good()) return false;
+    
+    if (occupied) {
+      cString genome_str;
+      cp.ReadString(genome_str);
+      const int genotype_id = cp.Read<int>();
+      if (!cp.Good()) return false;
+      
+      Genome mg(Apto::String((const char*)genome_str));
+      cOrganism* new_organism = new cOrganism(m_world, ctx, mg, -1, Systematics::Source(Systematics::DIVISION, (const char*)filename, true));
+      
+      InstructionSequencePtr seq;
+      seq.DynamicCastFrom(mg.Representation());
+      new_organism->GetPhenotype().SetupInject(*seq);
+      
+      Systematics::UnitPtr unit(new_organism);
+      new_organism->AddReference(); // creating new smart pointer to org, explicitly add reference
+      Systematics::RoleClassificationHints hints;
+      hints["genotype"]["id"] = Apto::FormatStr("%d", genotype_id);
+      classmgr->ClassifyNewUnit(unit, &hints);
+      
+      new_organism->MutationRates().Copy(cell.MutationRates());
+      if (!ActivateOrganism(ctx, new_organism, cell, true, true)) return false;
+      
+      // Overwrite the freshly injected state with the checkpointed state
+      if (!new_organism->LoadCheckpoint(cp)) return false;
+      AdjustSchedule(cell, new_organism->GetPhenotype().GetMerit());
+    }
+    cell.LoadCheckpoint(cp);
+  }
+  
+  if (!cp.ReadTag("END ")) return false;
+  
+  // The streams restart from the saved base seed at the start of the next update, as they do in the saving run
+  m_world->GetStats().SetCurrentUpdate(update);
+  m_rng_base_seed = base_seed;
+  sync_events = true;
+  return true;
+}
+
+// Checkpoints hold organisms running on cHardwareCPU, population and deme resources, systematics, per-cell state and
+// the statistics carried between updates.  Features keeping other state would silently restart from scratch in a
+// restored run, so checkpoints are refused while they are in use.
+bool cPopulation::checkpointSupported() const
+{
+  Feedback& feedback = m_world->GetDriver().Feedback();
+  const cAvidaConfig& config = m_world->GetConfig();
+  
+  if (!config.CHECKPOINT_RNG_STREAMS.Get()) {
+    feedback.Error("checkpoints require CHECKPOINT_RNG_STREAMS, the random number streams cannot be saved otherwise");
+    return false;
+  }
+  if (config.SLICING_METHOD.Get() != SLICE_PROB_MERIT) {
+    feedback.Error("checkpoints require SLICING_METHOD %d, the state of other schedulers is not saved", SLICE_PROB_MERIT);
+    return false;
+  }
+  if (deme_array.GetSize() > 1) {
+    feedback.Error("checkpoints do not support demes (NUM_DEMES > 1)");
+    return false;
+  }
+  if (config.USE_FORM_GROUPS.Get()) {
+    feedback.Error("checkpoints do not support groups and tolerance (USE_FORM_GROUPS)");
+    return false;
+  }
+  
+  const cResourceLib& resource_lib = environment.GetResourceLib();
+  for (int i = 0; i < resource_lib.GetSize(); i++) {
+    if (resource_lib.GetResource(i)->GetGradient()) {
+      feedback.Error("checkpoints do not support gradient resources ('%s')", (const char*)resource_lib.GetResource(i)->GetName());
+      return false;
+    }
+  }
+  
+  for (int i = 0; i < live_org_list.GetSize(); i++) {
+    if (live_org_list[i]->GetHardware().GetType() != HARDWARE_TYPE_CPU_ORIGINAL) {
+      feedback.Error("checkpoints only support organisms running on the original CPU hardware");
+      return false;
+    }
+    if (live_org_list[i]->GetPhenotype().HasTaskStates()) {
+      feedback.Error("checkpoints do not support tasks that keep per organism state");
+      return false;
+    }
+  }
+  
+  return true;
+}
+
 /**
  * This function loads a genome from a given file, and initializes
  * a cpu with it.
@@ -7163,14 +7494,14 @@ void cPopulation::BuildTimeSlicer()
       break;
     case SLICE_PROB_MERIT:
     {
-      Apto::SmartPtr<Apto::Random> rng(new Apto::RNG::AvidaRNG(m_world->GetRandom().GetInt(0x7FFFFFFF)));
-      m_scheduler = new Apto::Scheduler::Probabilistic(cell_array.GetSize(), rng);
+      m_scheduler_rng = new Apto::RNG::AvidaRNG(m_world->GetRandom().GetInt(0x7FFFFFFF));
+      m_scheduler = new Apto::Scheduler::Probabilistic(cell_array.GetSize(), m_scheduler_rng);
     }
       break;
     case SLICE_PROB_INTEGRATED_MERIT:
     {
-      Apto::SmartPtr<Apto::Random> rng(new Apto::RNG::AvidaRNG(m_world->GetRandom().GetInt(m_world->GetRandom().MaxSeed())));
-      m_scheduler = new Apto::Scheduler::ProbabilisticIntegrated(cell_array.GetSize(), rng);
+      m_scheduler_rng = new Apto::RNG::AvidaRNG(m_world->GetRandom().GetInt(m_world->GetRandom().MaxSeed()));
+      m_scheduler = new Apto::Scheduler::ProbabilisticIntegrated(cell_array.GetSize(), m_scheduler_rng);
     }
       break;
     default:
@@ -44,6 +44,7 @@ class cEnvironment;
 class cLineage;
 class cOrganism;
 class cPopulationCell;
+class cPopulationTileEngine;
 
 using namespace Avida;
 
@@ -66,6 +67,7 @@ private:
   // Components...
   cWorld* m_world;
   Apto::PriorityScheduler* m_scheduler;                // Handles allocation of CPU cycles
+  Apto::SmartPtr<Apto::Random> m_scheduler_rng;        // Stream of the probabilistic schedulers, if any
   Apto::Array<cPopulationCell> cell_array;  // Local cells composing the population
   Apto::Array<int> empty_cell_id_array;     // Used for PREFER_EMPTY birth methods
   cResourceCount resource_count;       // Global resources available
@@ -112,9 +114,12 @@ private:
   int num_top_pred_organisms;
   
   Apto::Array<cDeme> deme_array;            // Deme structure of the population.
+  cResourceClock m_deme_clock;              // Shared, lazily applied clock driving all deme resources
  
   // Outside interactions...
   bool sync_events;   // Do we need to sync up the event list with population?
+  cPopulationTileEngine* m_tile_engine;   // parallel pre-execution of the driver, if any, for checkpoints
+  int m_rng_base_seed;                    // per update random number streams derive from this (CHECKPOINT_RNG_STREAMS)
 	
   // Group formation information
   std::map<int, int> m_groups; //<! Maps the group id to the number of orgs in the group
@@ -122,6 +127,20 @@ private:
   std::map<int, int> m_group_males; //<! Maps the group id to the number of males in the group
 
   int m_hgt_resid; //!< HGT resource ID.
+  
+  // Compact copy of the cell topology, rebuilt by TopologyChanged().  The neighbors of cell i are
+  // m_adj_cells[m_adj_offsets[i]] through m_adj_cells[m_adj_offsets[i + 1] - 1], in connection list order.
+  Apto::Array<int> m_adj_offsets;
+  Apto::Array<int> m_adj_cells;
+  
+  // Cells within k hops of each cell, laid out like the adjacency arrays.  Built on first use of each depth.
+  struct sNeighborhoodTable
+  {
+    Apto::Array<int> offsets;
+    Apto::Array<int, Apto::Smart> cells;
+  };
+  Apto::Mutex m_neighborhood_mutex;
+  Apto::Array<sNeighborhoodTable*> m_neighborhoods;  // indexed by depth - 1
 
   cPopulation(); // @not_implemented
   cPopulation(const cPopulation&); // @not_implemented
@@ -151,6 +170,11 @@ public:
   void AttachOrgStatProvider(cPopulationOrgStatProviderPtr provider) { m_org_stat_providers.Push(provider); }
   
   void ResizeCellGrid(int x, int y);
+  
+  // Must be called whenever cell connection lists are added to or removed from (rotation does not count)
+  void TopologyChanged();
+  int GetNumNeighbors(int cell_id) const { return m_adj_offsets[cell_id + 1] - m_adj_offsets[cell_id]; }
+  cCellNeighborhood GetNeighborhood(int cell_id, int depth);
     
   void InjectGenome(int cell_id, Systematics::Source src, const Genome& genome, cAvidaContext& ctx, int lineage_label = 0, bool assign_group = true, Systematics::RoleClassificationHints* hints = NULL);
 
@@ -280,6 +304,12 @@ public:
                       bool load_groups = false, bool load_birth_cells = false, bool load_avatars = false, bool load_rebirth = false, bool load_parent_dat = false, int traceq = 0);
   bool SaveFlameData(const cString& filename);
   
+  // Binary checkpoints capture the full dynamic state of the population, so that a restored run continues exactly;
+  // features whose state they do not cover are refused (see checkpointSupported)
+  bool SaveCheckpoint(const cString& filename);
+  bool LoadCheckpoint(const cString& filename, cAvidaContext& ctx);
+  void SetTileEngine(cPopulationTileEngine* tile_engine) { m_tile_engine = tile_engine; }
+  
   void SetMiniTraceQueue(Apto::Array<int, Apto::Smart> new_queue, const bool print_genomes, const bool print_reacs, const bool use_micro = false);
   void AppendMiniTraces(Apto::Array<int, Apto::Smart> new_queue, const bool print_genomes, const bool print_reacs, const bool use_micro = false);
   void LoadMiniTraceQ(const cString& filename, int orgs_per, bool print_genomes, bool print_reacs);
@@ -450,6 +480,9 @@ private:
   void SetupCellGrid();
   void ClearCellGrid();
   void BuildTimeSlicer(); // Build the schedule object
+  bool checkpointSupported() const; // Report any feature in use whose state checkpoints do not capture
+  sNeighborhoodTable* buildNeighborhoodTable(int depth) const;
+  void clearNeighborhoodTables();
   
   // Methods to place offspring in the population.
   cPopulationCell& PositionOffspring(cPopulationCell& parent_cell, cAvidaContext& ctx, bool parent_ok = true); 
@@ -488,6 +521,7 @@ private:
   int PlaceAvatar(cAvidaContext& ctx, cOrganism* parent);
   
   inline void AdjustSchedule(const cPopulationCell& cell, const cMerit& merit);
+  inline void AdvanceDemeClock(double step_size);
   
   bool LoadGenotypeList(const cString& filename, cAvidaContext& ctx, Apto::Array<GeneticRepresentationPtr>& list_obj);
 };
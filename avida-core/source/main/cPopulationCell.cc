@@ -23,6 +23,7 @@
 #include "cPopulationCell.h"
 
 #include "avida/core/Feedback.h"
+#include "cCheckpoint.h"
 #include "cDoubleSum.h"
 #include "nHardware.h"
 #include "cOrganism.h"
@@ -140,38 +141,32 @@ void cPopulationCell::Rotate(cPopulationCell& new_facing)
   }
 }
 
-/*! This method recursively builds a set of cells that neighbor this cell, out to 
- the given depth.  The set must be passed in by-reference, as calls to this method 
- must share a common set of already-visited cells.
+cCellNeighborhood cPopulationCell::GetNeighborhood(int depth) const
+{
+  return m_world->GetPopulation().GetNeighborhood(m_cell_id, depth);
+}
+
+/*! This method builds a set of cells that neighbor this cell, out to the given depth.
+ Neighborhoods are looked up in the population's cached k-hop tables.  As any path of two
+ or more hops can lead back to this cell, it is included in the set for depths beyond one.
  */
 void cPopulationCell::GetNeighboringCells(std::set<cPopulationCell*>& cell_set, int depth) const {
-	typedef std::set<cPopulationCell*> cell_set_t;
-  
-  // For each cell in our connection list...
-  tConstListIterator<cPopulationCell> i(m_connections);
-  while(!i.AtEnd()) {
-		// store the cell pointer, and check to see if we've already visited that cell...
-    cPopulationCell* cell = i.Next();
-		assert(cell != 0); // cells should never be null.
-		std::pair<cell_set_t::iterator, bool> ins = cell_set.insert(cell);
-		// and if so, recurse to it...
-		if(ins.second && (depth > 1)) {
-			cell->GetNeighboringCells(cell_set, depth-1);
-		}
-	}
+  cPopulation& pop = m_world->GetPopulation();
+  cCellNeighborhood neighborhood = pop.GetNeighborhood(m_cell_id, depth);
+  for (int i = 0; i < neighborhood.GetSize(); i++) cell_set.insert(&pop.GetCell(neighborhood[i]));
+  if (depth > 1 && neighborhood.GetSize()) cell_set.insert(&pop.GetCell(m_cell_id));
 }
 
-/*! Recursively build a set of occupied cells that neighbor this one, out to the given depth.
+/*! Build a set of occupied cells that neighbor this one, out to the given depth.
 */
 void cPopulationCell::GetOccupiedNeighboringCells(std::set<cPopulationCell*>& occupied_cell_set, int depth) const {
-	// we'll do this the easy way, and just filter the neighbor set.
-	std::set<cPopulationCell*> cell_set;
-	GetNeighboringCells(cell_set, depth);
-	for(std::set<cPopulationCell*>::iterator i=cell_set.begin(); i!=cell_set.end(); ++i) {
-		if((*i)->IsOccupied()) {
-			occupied_cell_set.insert(*i);
-		}
-	}
+  cPopulation& pop = m_world->GetPopulation();
+  cCellNeighborhood neighborhood = pop.GetNeighborhood(m_cell_id, depth);
+  for (int i = 0; i < neighborhood.GetSize(); i++) {
+    cPopulationCell& cell = pop.GetCell(neighborhood[i]);
+    if (cell.IsOccupied()) occupied_cell_set.insert(&cell);
+  }
+  if (depth > 1 && neighborhood.GetSize() && IsOccupied()) occupied_cell_set.insert(&pop.GetCell(m_cell_id));
 }
 
 void cPopulationCell::GetOccupiedNeighboringCells(Apto::Array<cPopulationCell*>& occupied_cells) const
@@ -578,6 +573,32 @@ void cPopulationCell::ClearCellData()
   m_cell_data.forager = -99;
 }
 
+void cPopulationCell::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  cp.WriteArray(m_inputs);
+  cp.Write(m_cell_data.contents);
+  cp.Write(m_cell_data.org_id);
+  cp.Write(m_cell_data.update);
+  cp.Write(m_cell_data.territory);
+  cp.Write(m_cell_data.current);
+  cp.Write(m_cell_data.forager);
+  cp.Write(m_spec_state);
+  cp.Write(m_visits);
+}
+
+void cPopulationCell::LoadCheckpoint(cCheckpointReader& cp)
+{
+  cp.ReadArray(m_inputs);
+  cp.Read(m_cell_data.contents);
+  cp.Read(m_cell_data.org_id);
+  cp.Read(m_cell_data.update);
+  cp.Read(m_cell_data.territory);
+  cp.Read(m_cell_data.current);
+  cp.Read(m_cell_data.forager);
+  cp.Read(m_spec_state);
+  cp.Read(m_visits);
+}
+
 void cPopulationCell::UpdateCellDataExpired()
 {
   const int expiration = m_world->GetConfig().MARKING_EXPIRE_DATE.Get();
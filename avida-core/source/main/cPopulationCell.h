@@ -33,6 +33,8 @@
 #include "tList.h"
 #include "cGenomeUtil.h"
 
+class cCheckpointReader;
+class cCheckpointWriter;
 class cHardwareBase;
 class cPopulation;
 class cOrganism;
@@ -42,6 +44,22 @@ class cWorld;
 using namespace Avida;
 
 
+// cCellNeighborhood - a read-only run of cell IDs, stored in the population's topology tables
+class cCellNeighborhood
+{
+private:
+  const int* m_cells;
+  int m_size;
+
+public:
+  cCellNeighborhood() : m_cells(NULL), m_size(0) { ; }
+  cCellNeighborhood(const int* cells, int size) : m_cells(cells), m_size(size) { ; }
+
+  inline int GetSize() const { return m_size; }
+  inline int operator[](int idx) const { assert(idx >= 0 && idx < m_size); return m_cells[idx]; }
+};
+
+
 class cPopulationCell
 {
   friend class cPopulation;
@@ -104,6 +122,8 @@ public:
   inline cOrganism* GetOrganism() const { return m_organism; }
   inline cHardwareBase* GetHardware() const { return m_hardware; }
   inline tList<cPopulationCell>& ConnectionList() { return m_connections; }
+  //! Get the IDs of all cells within the given number of hops of this one (excluding this cell), in cell ID order.
+  cCellNeighborhood GetNeighborhood(int depth) const;
   //! Recursively build a set of cells that neighbor this one, out to the given depth.
   void GetNeighboringCells(std::set<cPopulationCell*>& cell_set, int depth) const;
   //! Recursively build a set of occupied cells that neighbor this one, out to the given depth.
@@ -140,6 +160,9 @@ public:
   inline void SetSpeculativeState(int count) { m_spec_state = count; }
   inline void DecSpeculative() { m_spec_state--; }
 
+  void SaveCheckpoint(cCheckpointWriter& cp) const;
+  void LoadCheckpoint(cCheckpointReader& cp);
+
   inline bool IsOccupied() const { return m_organism != NULL; }
 
   double UptakeCellEnergy(double frac_to_uptake, cAvidaContext& ctx); 
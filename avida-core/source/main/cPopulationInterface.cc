@@ -600,16 +600,10 @@ bool cPopulationInterface::BroadcastMessage(cOrgMessage& msg, int depth) {
   cPopulationCell& cell = m_world->GetPopulation().GetCell(m_cell_id);
   assert(cell.IsOccupied()); // This organism; sanity.
 	
-	// Get the set of cells that are within range.
-	std::set<cPopulationCell*> cell_set;
-	cell.GetNeighboringCells(cell_set, depth);
-	
-	// Remove this cell from the set!
-	cell_set.erase(&cell);
-	
-	// Now, send a message towards each cell:
-	for(std::set<cPopulationCell*>::iterator i=cell_set.begin(); i!=cell_set.end(); ++i) {
-		SendMessage(msg, **i);
+	// Get the cells that are within range (never including this cell), and send a message towards each:
+	cCellNeighborhood neighborhood = cell.GetNeighborhood(depth);
+	for (int i = 0; i < neighborhood.GetSize(); i++) {
+		SendMessage(msg, m_world->GetPopulation().GetCell(neighborhood[i]));
 	}
 	return true;
 }
@@ -0,0 +1,231 @@
+/*
+ *  cPopulationTileEngine.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cPopulationTileEngine.h"
+
+#include "apto/platform.h"
+#include "avida/core/WorldDriver.h"
+
+#include "cAvidaContext.h"
+#include "cDeme.h"
+#include "cHardwareBase.h"
+#include "cPopulation.h"
+#include "cPopulationCell.h"
+#include "cStats.h"
+#include "cWorld.h"
+
+
+// Matches the speculative window used by cPopulation::ProcessStepSpeculative
+static const int MAX_TILE_SPECULATIVE_DEPTH = 32;
+
+
+class cPopulationTileEngine::cWorker : public Apto::Thread
+{
+private:
+  cPopulationTileEngine* m_engine;
+
+  void Run();
+
+public:
+  cWorker(cPopulationTileEngine* engine) : m_engine(engine) { ; }
+};
+
+
+cPopulationTileEngine::cPopulationTileEngine(cWorld* world, int num_threads)
+: m_world(world), m_next_tile(0), m_pending(0), m_pass(0), m_terminate(false), m_pop_size(0), m_num_demes(0)
+{
+  m_depth = m_world->GetConfig().AVE_TIME_SLICE.Get();
+  if (m_depth > MAX_TILE_SPECULATIVE_DEPTH) m_depth = MAX_TILE_SPECULATIVE_DEPTH;
+  if (m_depth < 1) m_depth = 1;
+
+  m_tile_size = m_world->GetConfig().PARALLEL_TILE_SIZE.Get();
+
+  buildTiles();
+
+  // The calling thread always participates in tile processing, so only spawn the additional workers
+  if (num_threads < 0 || num_threads > Apto::Platform::AvailableCPUs()) num_threads = Apto::Platform::AvailableCPUs();
+  if (num_threads > 1) {
+    m_workers.Resize(num_threads - 1);
+    for (int i = 0; i < m_workers.GetSize(); i++) {
+      m_workers[i] = new cWorker(this);
+      m_workers[i]->Start();
+    }
+  }
+}
+
+cPopulationTileEngine::~cPopulationTileEngine()
+{
+  m_mutex.Lock();
+  m_terminate = true;
+  m_mutex.Unlock();
+  m_cond.Broadcast();
+
+  for (int i = 0; i < m_workers.GetSize(); i++) {
+    m_workers[i]->Join();
+    delete m_workers[i];
+  }
+
+  clearTiles();
+}
+
+
+void cPopulationTileEngine::ResetSeeds(const Apto::Array<int>& seeds)
+{
+  assert(seeds.GetSize() == m_tiles.GetSize());
+  for (int i = 0; i < m_tiles.GetSize(); i++) m_tiles[i]->rng.ResetSeed(seeds[i]);
+}
+
+
+void cPopulationTileEngine::Execute()
+{
+  cPopulation& pop = m_world->GetPopulation();
+
+  m_mutex.Lock();
+  if (pop.GetSize() != m_pop_size || pop.GetNumDemes() != m_num_demes) buildTiles();
+  for (int i = 0; i < m_tiles.GetSize(); i++) {
+    m_tiles[i]->spec_total = 0;
+    m_tiles[i]->spec_num = 0;
+  }
+  m_next_tile = 0;
+  m_pending = m_tiles.GetSize();
+  m_pass++;
+  m_mutex.Unlock();
+
+  m_cond.Broadcast();
+
+  processTiles();
+
+  // Wait for any tiles still being processed by the worker threads
+  m_mutex.Lock();
+  while (m_pending > 0) m_term_cond.Wait(m_mutex);
+  m_mutex.Unlock();
+
+  // Merge per-tile statistics in tile order
+  cStats& stats = m_world->GetStats();
+  for (int i = 0; i < m_tiles.GetSize(); i++) {
+    if (m_tiles[i]->spec_num) stats.AddSpeculative(m_tiles[i]->spec_total, m_tiles[i]->spec_num);
+  }
+}
+
+
+void cPopulationTileEngine::buildTiles()
+{
+  clearTiles();
+
+  cPopulation& pop = m_world->GetPopulation();
+  m_pop_size = pop.GetSize();
+  m_num_demes = pop.GetNumDemes();
+
+  if (m_tile_size <= 0 && m_num_demes > 1) {
+    // One tile per deme
+    m_tiles.Resize(m_num_demes);
+    for (int i = 0; i < m_num_demes; i++) {
+      m_tiles[i] = new sTile(m_world->GetRandom().GetInt(m_world->GetRandom().MaxSeed()));
+      cDeme& deme = pop.GetDeme(i);
+      m_tiles[i]->cells.Resize(deme.GetSize());
+      for (int j = 0; j < deme.GetSize(); j++) m_tiles[i]->cells[j] = deme.GetCellID(j);
+    }
+  } else {
+    // Contiguous runs of cells, defaulting to one tile per world row
+    int tile_size = (m_tile_size > 0) ? m_tile_size : pop.GetWorldX();
+    if (tile_size <= 0) tile_size = m_pop_size;
+    const int num_tiles = (m_pop_size + tile_size - 1) / tile_size;
+    m_tiles.Resize(num_tiles);
+    for (int i = 0; i < num_tiles; i++) {
+      m_tiles[i] = new sTile(m_world->GetRandom().GetInt(m_world->GetRandom().MaxSeed()));
+      const int first = i * tile_size;
+      const int last = (first + tile_size < m_pop_size) ? (first + tile_size) : m_pop_size;
+      m_tiles[i]->cells.Resize(last - first);
+      for (int j = first; j < last; j++) m_tiles[i]->cells[j - first] = j;
+    }
+  }
+}
+
+
+void cPopulationTileEngine::clearTiles()
+{
+  for (int i = 0; i < m_tiles.GetSize(); i++) delete m_tiles[i];
+  m_tiles.Resize(0);
+}
+
+
+void cPopulationTileEngine::processTiles()
+{
+  while (true) {
+    m_mutex.Lock();
+    if (m_next_tile >= m_tiles.GetSize()) {
+      m_mutex.Unlock();
+      return;
+    }
+    sTile* tile = m_tiles[m_next_tile++];
+    m_mutex.Unlock();
+
+    processTile(*tile);
+
+    m_mutex.Lock();
+    int pending = --m_pending;
+    m_mutex.Unlock();
+    if (!pending) m_term_cond.Signal();
+  }
+}
+
+
+void cPopulationTileEngine::processTile(sTile& tile)
+{
+  cPopulation& pop = m_world->GetPopulation();
+  cAvidaContext ctx(&m_world->GetDriver(), tile.rng);
+  if (m_world->GetDefaultContext().OrgFaultReporting()) ctx.EnableOrgFaultReporting();
+
+  for (int i = 0; i < tile.cells.GetSize(); i++) {
+    cPopulationCell& cell = pop.GetCell(tile.cells[i]);
+    if (!cell.IsOccupied() || cell.GetSpeculativeState()) continue;
+
+    cHardwareBase* hw = cell.GetHardware();
+    if (!hw->SupportsSpeculative() || hw->IsTraced()) continue;
+
+    int spec_count = 0;
+    while (spec_count < m_depth && hw->SingleProcess(ctx, true)) spec_count++;
+
+    if (spec_count) {
+      cell.SetSpeculativeState(spec_count);
+      tile.spec_total += spec_count;
+      tile.spec_num++;
+    }
+  }
+}
+
+
+void cPopulationTileEngine::cWorker::Run()
+{
+  int last_pass = 0;
+
+  while (true) {
+    m_engine->m_mutex.Lock();
+    while (m_engine->m_pass == last_pass && !m_engine->m_terminate) m_engine->m_cond.Wait(m_engine->m_mutex);
+    if (m_engine->m_terminate) {
+      m_engine->m_mutex.Unlock();
+      break;
+    }
+    last_pass = m_engine->m_pass;
+    m_engine->m_mutex.Unlock();
+
+    m_engine->processTiles();
+  }
+}
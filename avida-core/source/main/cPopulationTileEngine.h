@@ -0,0 +1,99 @@
+/*
+ *  cPopulationTileEngine.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cPopulationTileEngine_h
+#define cPopulationTileEngine_h
+
+#include "apto/core.h"
+#include "apto/core/Thread.h"
+#include "apto/rng.h"
+
+class cWorld;
+
+
+// cPopulationTileEngine - Parallel speculative pre-execution of the population
+//
+// The population is partitioned into fixed tiles (one per deme, or contiguous runs of cells).  At the start of each update
+// every tile is handed to a worker thread, which speculatively executes the organisms in that tile up to the next
+// instruction that could affect another organism (see cInstSet::ShouldStall).  With SPECULATIVE_BEHAVIORS off, that is
+// any behavior instruction, so workers run only internal computation.  Each tile owns its random number stream, so
+// for a given seed the results do not depend on the number of threads.  All world-affecting work (births, deaths,
+// resource updates, stats) still happens serially in cPopulation::ProcessStepSpeculative, which consumes the banked
+// speculative cycles.  Per-tile statistics are merged in tile order once all tiles have completed.
+
+class cPopulationTileEngine
+{
+private:
+  class cWorker;
+  friend class cWorker;
+
+  struct sTile
+  {
+    Apto::Array<int> cells;
+    Apto::RNG::AvidaRNG rng;
+    int spec_total;
+    int spec_num;
+
+    sTile(int seed) : rng(seed), spec_total(0), spec_num(0) { ; }
+  };
+
+  cWorld* m_world;
+  Apto::Array<sTile*> m_tiles;
+  Apto::Array<cWorker*> m_workers;
+
+  Apto::Mutex m_mutex;
+  Apto::ConditionVariable m_cond;
+  Apto::ConditionVariable m_term_cond;
+
+  volatile int m_next_tile;   // index of the next tile to be claimed
+  volatile int m_pending;     // count of tiles not yet completed in the current pass
+  volatile int m_pass;        // incremented for each pass, used by workers to detect new work
+  volatile bool m_terminate;
+
+  int m_depth;
+  int m_tile_size;
+  int m_pop_size;
+  int m_num_demes;
+
+
+  void buildTiles();
+  void clearTiles();
+  void processTiles();
+  void processTile(sTile& tile);
+
+
+  cPopulationTileEngine(); // @not_implemented
+  cPopulationTileEngine(const cPopulationTileEngine&); // @not_implemented
+  cPopulationTileEngine& operator=(const cPopulationTileEngine&); // @not_implemented
+
+public:
+  cPopulationTileEngine(cWorld* world, int num_threads);
+  ~cPopulationTileEngine();
+
+  void Execute();
+
+  int GetNumTiles() const { return m_tiles.GetSize(); }
+  int GetNumWorkers() const { return m_workers.GetSize(); }
+
+  // Restart the random number stream of each tile (see CHECKPOINT_RNG_STREAMS); there must be a seed for every tile
+  void ResetSeeds(const Apto::Array<int>& seeds);
+};
+
+#endif
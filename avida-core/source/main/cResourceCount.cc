@@ -21,8 +21,10 @@
  */
 
 #include "cResourceCount.h"
+#include "cCheckpoint.h"
 #include "cResource.h"
 #include "cGradientCount.h"
+#include "cPhaseProfiler.h"
 #include "cWorld.h"
 #include "cStats.h"
 
@@ -37,71 +39,15 @@ const double cResourceCount::EPSILON (1.0e-15);
 const int cResourceCount::PRECALC_DISTANCE(100);
 
 
-void FlowMatter(cSpatialCountElem &elem1, cSpatialCountElem &elem2, 
-                double inxdiffuse, 
-                double inydiffuse, double inxgravity, double inygravity,
-                int xdist, int ydist, double dist) {
-
-  /* Routine to calculate the amount of flow from one Element to another.
-     Amount of flow is a function of:
-
-       1) Amount of material in each cell (will try to equalize)
-       2) Distance between each cell
-       3) x and y "gravity"
-
-     This method only effect the delta amount of each element.  The State
-     method will need to be called at the end of each time step to complete
-     the movement of material.
-  */
-
-  double  diff, flowamt, xgravity, xdiffuse, ygravity,  ydiffuse;
-
-  if (((elem1.amount == 0.0) && (elem2.amount == 0.0)) && (dist < 0.0)) return;
-  diff = (elem1.amount - elem2.amount);
-  if (xdist != 0) {
-
-    /* if there is material to be effected by x gravity */
-
-    if (((xdist>0) && (inxgravity>0.0)) || ((xdist<0) && (inxgravity<0.0))) {
-      xgravity = elem1.amount * fabs(inxgravity)/3.0;
-    } else {
-      xgravity = -elem2.amount * fabs(inxgravity)/3.0;
-    }
-    
-    /* Diffusion uses the diffusion constant x half the difference (as the 
-       elements attempt to equalize) / the number of possible neighbors (8) */
-
-    xdiffuse = inxdiffuse * diff / 16.0;
-  } else {
-    xdiffuse = 0.0;
-    xgravity = 0.0;
-  }  
-  if (ydist != 0) {
-
-    /* if there is material to be effected by y gravity */
-
-    if (((ydist>0) && (inygravity>0.0)) || ((ydist<0) && (inygravity<0.0))) {
-      ygravity = elem1.amount * fabs(inygravity)/3.0;
-    } else {
-      ygravity = -elem2.amount * fabs(inygravity)/3.0;
-    }
-    ydiffuse = inydiffuse * diff / 16.0;
-  } else {
-    ydiffuse = 0.0;
-    ygravity = 0.0;
-  }  
-
-  flowamt = ((xdiffuse + ydiffuse + xgravity + ygravity)/
-             (fabs(xdist*1.0) + fabs(ydist*1.0)))/dist;
-  elem1.delta -= flowamt;
-  elem2.delta += flowamt;
-}
-
 cResourceCount::cResourceCount(int num_resources)
   : update_time(0.0)
   , spatial_update_time(0.0)
   , m_last_updated(0)
   , m_spatial_update(0)
+  , m_clock(NULL)
+  , m_clock_epoch(0)
+  , m_clock_steps(0)
+  , m_profiler(NULL)
 {
   if(num_resources > 0) {
     SetSize(num_resources);
@@ -110,7 +56,7 @@ cResourceCount::cResourceCount(int num_resources)
   return;
 }
 
-cResourceCount::cResourceCount(const cResourceCount &rc) {
+cResourceCount::cResourceCount(const cResourceCount &rc) : m_clock(NULL), m_clock_epoch(0), m_clock_steps(0), m_profiler(NULL) {
   *this = rc;
 
   return;
@@ -133,6 +79,13 @@ const cResourceCount &cResourceCount::operator=(const cResourceCount &rc) {
   
   curr_grid_res_cnt = rc.curr_grid_res_cnt;
   curr_spatial_res_cnt = rc.curr_spatial_res_cnt;
+  // The clock belongs to the owner of this count, not to its value; keep it attached, marking every step taken so far as
+  // already applied, since the pending time of rc is taken over below
+  rc.SyncClock();
+  if (m_clock) {
+    m_clock_epoch = m_clock->GetEpoch();
+    m_clock_steps = m_clock->GetSteps();
+  }
   update_time = rc.update_time;
   spatial_update_time = rc.spatial_update_time;
   cell_lists = rc.cell_lists;
@@ -539,6 +492,51 @@ void cResourceCount::Update(double in_time)
   spatial_update_time += in_time;
  }
 
+void cResourceCount::SetClock(const cResourceClock* clock)
+{
+  SyncClock();
+  m_clock = clock;
+  if (m_clock) {
+    m_clock_epoch = m_clock->GetEpoch();
+    m_clock_steps = m_clock->GetSteps();
+  }
+}
+
+void cResourceCount::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  // Fold any pending clock steps into the update times so that they are captured
+  SyncClock();
+  
+  cp.WriteArray(resource_count);
+  cp.Write(update_time);
+  cp.Write(spatial_update_time);
+  cp.Write(m_last_updated);
+  cp.Write(m_spatial_update);
+  for (int i = 0; i < spatial_resource_count.GetSize(); i++) spatial_resource_count[i]->SaveCheckpoint(cp);
+}
+
+void cResourceCount::LoadCheckpoint(cCheckpointReader& cp)
+{
+  Apto::Array<double> counts;
+  cp.ReadArray(counts);
+  if (counts.GetSize() != resource_count.GetSize()) {
+    cp.Invalidate();
+    return;
+  }
+  resource_count = counts;
+  cp.Read(update_time);
+  cp.Read(spatial_update_time);
+  cp.Read(m_last_updated);
+  cp.Read(m_spatial_update);
+  for (int i = 0; i < spatial_resource_count.GetSize(); i++) spatial_resource_count[i]->LoadCheckpoint(cp);
+  
+  // Steps already taken on the shared clock are part of the restored update times
+  if (m_clock) {
+    m_clock_epoch = m_clock->GetEpoch();
+    m_clock_steps = m_clock->GetSteps();
+  }
+}
+
  
 const Apto::Array<double> & cResourceCount::GetResources(cAvidaContext& ctx) const
 {
@@ -655,7 +653,7 @@ void cResourceCount::ModifyCell(cAvidaContext& ctx, const Apto::Array<double> &
         resource_count[i] += res_change[i];
       assert(resource_count[i] >= 0.0);
     } else {
-      double temp = spatial_resource_count[i]->Element(cell_id).GetAmount();
+      double temp = spatial_resource_count[i]->GetElementAmount(cell_id);
       spatial_resource_count[i]->Rate(cell_id, res_change[i]);
       /* Ideally the state of the cell's resource should not be set till
          the end of the update so that all processes (inflow, outflow, 
@@ -664,10 +662,10 @@ void cResourceCount::ModifyCell(cAvidaContext& ctx, const Apto::Array<double> &
          the organism demand to work immediately on the state of the resource */ 
     
       spatial_resource_count[i]->State(cell_id);
-      if(spatial_resource_count[i]->Element(cell_id).GetAmount() != temp){
+      if(spatial_resource_count[i]->GetElementAmount(cell_id) != temp){
         spatial_resource_count[i]->SetModified(true);
       }
-      assert(spatial_resource_count[i]->Element(cell_id).GetAmount() >= 0.0);
+      assert(spatial_resource_count[i]->GetElementAmount(cell_id) >= 0.0);
     }
   }
 }
@@ -753,6 +751,7 @@ int cResourceCount::GetMaxUsedY(int res_id)
 ///// Private Methods /////////
 void cResourceCount::DoUpdates(cAvidaContext& ctx, bool global_only) const
 { 
+  SyncClock();
   assert(update_time >= -EPSILON);
 
   // Determine how many update steps have progressed
@@ -782,6 +781,9 @@ void cResourceCount::DoUpdates(cAvidaContext& ctx, bool global_only) const
   if (global_only) return;
 
   // If one (or more) complete update has occured update the spatial resources
+  if (m_spatial_update <= m_last_updated) return;
+  
+  cPhaseProfiler::cScope profile(m_profiler, cPhaseProfiler::RESOURCES);
   while (m_spatial_update > m_last_updated) {
     m_last_updated++;
     for (int i = 0; i < resource_count.GetSize(); i++) {
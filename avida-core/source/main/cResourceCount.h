@@ -31,9 +31,34 @@
 #include "tMatrix.h"
 #include "nGeometry.h"
 
+class cCheckpointReader;
+class cCheckpointWriter;
+class cPhaseProfiler;
 class cWorld;
 
 
+// Shared simulation clock that allows many resource counts to be advanced in O(1) per step.  Time is accumulated here,
+// and each attached cResourceCount lazily applies the steps it has not yet seen when it performs its updates.  The owner
+// must call SyncClock() on every attached count before changing the step size.
+class cResourceClock
+{
+private:
+  double m_step_size;
+  int m_epoch;    // incremented each time the step size changes
+  int m_steps;    // number of steps taken at the current step size
+
+public:
+  cResourceClock() : m_step_size(0.0), m_epoch(0), m_steps(0) { ; }
+  
+  inline void Advance() { m_steps++; }
+  inline void SetStepSize(double step_size) { m_step_size = step_size; m_epoch++; m_steps = 0; }
+  
+  inline double GetStepSize() const { return m_step_size; }
+  inline int GetEpoch() const { return m_epoch; }
+  inline int GetSteps() const { return m_steps; }
+};
+
+
 class cResourceCount
 {
 private:
@@ -56,6 +81,14 @@ private:
   mutable double spatial_update_time;
   mutable int m_last_updated;
   mutable int m_spatial_update;
+  
+  // Optional shared clock, see cResourceClock.  Assignment keeps the clock of the destination.
+  const cResourceClock* m_clock;
+  mutable int m_clock_epoch;
+  mutable int m_clock_steps;
+  
+  // Times spatial updates when set; not carried over by copies, which may be used away from the simulation thread
+  cPhaseProfiler* m_profiler;
 
   void DoUpdates(cAvidaContext& ctx, bool global_only = false) const;         // Update resource count based on update time
 
@@ -127,6 +160,9 @@ public:
   void SetDecay(const cString& name, const double _decay);
   
   void Update(double in_time);
+  void SetClock(const cResourceClock* clock);
+  void SetProfiler(cPhaseProfiler* profiler) { m_profiler = profiler; }
+  inline void SyncClock() const;
 
   int GetSize(void) const { return resource_count.GetSize(); }
   const Apto::Array<double>& ReadResources(void) const { return resource_count; }
@@ -164,8 +200,30 @@ public:
   int GetMaxUsedY(int res_id);
   
   void SetSpatialUpdate(int update) { m_spatial_update = update; }
+  
+  void SaveCheckpoint(cCheckpointWriter& cp) const;
+  void LoadCheckpoint(cCheckpointReader& cp);
   void UpdateGlobalResources(cAvidaContext& ctx) { DoUpdates(ctx, true); }
   void UpdateResources(cAvidaContext& ctx) { DoUpdates(ctx, false); }
 };
 
+
+inline void cResourceCount::SyncClock() const
+{
+  if (!m_clock) return;
+  
+  // Steps taken at a previous step size have already been applied by the clock owner
+  if (m_clock_epoch != m_clock->GetEpoch()) {
+    m_clock_epoch = m_clock->GetEpoch();
+    m_clock_steps = 0;
+  }
+  
+  // Accumulate one step at a time so that the result matches calling Update() for each step
+  const double step_size = m_clock->GetStepSize();
+  for (; m_clock_steps < m_clock->GetSteps(); m_clock_steps++) {
+    update_time += step_size;
+    spatial_update_time += step_size;
+  }
+}
+
 #endif
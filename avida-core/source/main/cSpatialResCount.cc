@@ -21,6 +21,8 @@
 
 #include "cSpatialResCount.h"
 
+#include "cCheckpoint.h"
+
 #include "AvidaTools.h"
 #include "nGeometry.h"
 
@@ -33,48 +35,28 @@ using namespace AvidaTools;
 
 cSpatialResCount::cSpatialResCount(int inworld_x, int inworld_y, int ingeometry, double inxdiffuse, double inydiffuse,
                                    double inxgravity, double inygravity)
-: grid(inworld_x * inworld_y), m_initial(0.0), m_modified(false)
+: m_initial(0.0), m_modified(false)
 {
-  int i;
- 
   xdiffuse = inxdiffuse;
   ydiffuse = inydiffuse;
   xgravity = inxgravity;
   ygravity = inygravity;
-  world_x = inworld_x;
-  world_y = inworld_y;
-  geometry = ingeometry;
-  num_cells = world_x * world_y;
-  for (i = 0; i < GetSize(); i++) {
-    cSpatialCountElem tmpelem;
-    grid[i] = tmpelem;
-  } 
-  SetPointers();
+  ResizeClear(inworld_x, inworld_y, ingeometry);
 }
 
 /* Setup a single spatial resource using default flow amounts  */
 
 cSpatialResCount::cSpatialResCount(int inworld_x, int inworld_y, int ingeometry)
-: grid(inworld_x * inworld_y), m_initial(0.0), m_modified(false)
+: m_initial(0.0), m_modified(false)
 {
-  int i;
- 
   xdiffuse = 1.0;
   ydiffuse = 1.0;
   xgravity = 0.0;
   ygravity = 0.0;
-  world_x = inworld_x;
-  world_y = inworld_y;
-  geometry = ingeometry;
-  num_cells = world_x * world_y;
-  for (i = 0; i < GetSize(); i++) {
-    cSpatialCountElem tmpelem;
-    grid[i] = tmpelem;
-   } 
-   SetPointers();
+  ResizeClear(inworld_x, inworld_y, ingeometry);
 }
 
-cSpatialResCount::cSpatialResCount() : m_initial(0.0), xdiffuse(1.0), ydiffuse(1.0), xgravity(0.0), ygravity(0.0), m_modified(false)
+cSpatialResCount::cSpatialResCount() : m_initial(0.0), xdiffuse(1.0), ydiffuse(1.0), xgravity(0.0), ygravity(0.0), num_cells(0), m_modified(false)
 {
   geometry = nGeometry::GLOBAL;
 }
@@ -84,67 +66,57 @@ cSpatialResCount::~cSpatialResCount() { ; }
 
 void cSpatialResCount::ResizeClear(int inworld_x, int inworld_y, int ingeometry)
 {
-  int i;
- 
-  grid.ResizeClear(inworld_x * inworld_y); 
   world_x = inworld_x;
   world_y = inworld_y;
   geometry = ingeometry;
   num_cells = world_x * world_y;
-  for (i = 0; i < GetSize(); i++) {
-    cSpatialCountElem tmpelem;
-    grid[i] = tmpelem;
-   } 
-   SetPointers();
+  
+  m_amount.ResizeClear(num_cells);
+  m_amount.SetAll(0.0);
+  m_delta.ResizeClear(num_cells);
+  m_delta.SetAll(0.0);
+  m_cell_initial.ResizeClear(num_cells);
+  m_cell_initial.SetAll(0.0);
+  for (int k = 0; k < NUM_FLOW_DIRS; k++) m_flow[k].ResizeClear(num_cells);
+  
+  SetPointers();
 }
 
 void cSpatialResCount::SetPointers()
 {
-  /* Pointer 0 will point to the cell above and to the left the current cell
-     and will go clockwise around the cell.                               */
+  /* The stencil covers the right (0), lower right (1), lower (2) and lower left (3) neighbors of each cell.  Flow
+     to the remaining neighbors is handled when those cells visit this one. */
 
-  int     i,ii;
-  double  SQRT2 = sqrt(2.0);
+  for (int k = 0; k < NUM_FLOW_DIRS; k++) m_flow_nbr[k].ResizeClear(num_cells);
 
   /* First treat all cells like they are in a torus */
 
-  for (i = 0; i < GetSize(); i++) {
-    grid[i].SetPtr(0 ,GridNeighbor(i, world_x, world_y, -1, -1), -1, -1, SQRT2);
-    grid[i].SetPtr(1 ,GridNeighbor(i, world_x, world_y,  0, -1),  0, -1, 1.0);
-    grid[i].SetPtr(2 ,GridNeighbor(i, world_x, world_y, +1, -1), +1, -1, SQRT2);
-    grid[i].SetPtr(3 ,GridNeighbor(i, world_x, world_y, +1,  0), +1,  0, 1.0);
-    grid[i].SetPtr(4 ,GridNeighbor(i, world_x, world_y, +1, +1), +1, +1, SQRT2);
-    grid[i].SetPtr(5 ,GridNeighbor(i, world_x, world_y,  0, +1),  0, +1, 1.0);
-    grid[i].SetPtr(6 ,GridNeighbor(i, world_x, world_y, -1, +1), -1, +1, SQRT2);
-    grid[i].SetPtr(7 ,GridNeighbor(i, world_x, world_y, -1,  0), -1,  0, 1.0);
+  for (int i = 0; i < num_cells; i++) {
+    m_flow_nbr[0][i] = GridNeighbor(i, world_x, world_y, +1,  0);
+    m_flow_nbr[1][i] = GridNeighbor(i, world_x, world_y, +1, +1);
+    m_flow_nbr[2][i] = GridNeighbor(i, world_x, world_y,  0, +1);
+    m_flow_nbr[3][i] = GridNeighbor(i, world_x, world_y, -1, +1);
   }
  
-  /* Fix links for top, bottom and sides for non-torus */
+  /* Fix links for bottom and sides for non-torus */
   
   if (geometry == nGeometry::GRID) {
-    /* Top and bottom */
-
-    for (i = 0; i < world_x; i++) {
-      grid[i].SetPtr(0, -99, -99, -99, -99.0);
-      grid[i].SetPtr(1, -99, -99, -99, -99.0);
-      grid[i].SetPtr(2, -99, -99, -99, -99.0);
-      ii = num_cells-1-i;
-      grid[ii].SetPtr(4, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(5, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(6, -99, -99, -99, -99.0);
+    /* Bottom */
+
+    for (int i = 0; i < world_x; i++) {
+      const int ii = num_cells - 1 - i;
+      m_flow_nbr[1][ii] = -1;
+      m_flow_nbr[2][ii] = -1;
+      m_flow_nbr[3][ii] = -1;
     }
 
     /* fix links for right and left sides */
 
-    for (i = 0; i < world_y; i++) {
-      ii = i * world_x;    
-      grid[ii].SetPtr(0, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(7, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(6, -99, -99, -99, -99.0);
-      ii = ((i + 1) * world_x) - 1;
-      grid[ii].SetPtr(2, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(3, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(4, -99, -99, -99, -99.0);
+    for (int i = 0; i < world_y; i++) {
+      m_flow_nbr[3][i * world_x] = -1;
+      const int ii = ((i + 1) * world_x) - 1;
+      m_flow_nbr[0][ii] = -1;
+      m_flow_nbr[1][ii] = -1;
     }
   }
 }
@@ -222,10 +194,10 @@ void cSpatialResCount::SetCellList(Apto::Array<cCellResource>* in_cell_list_ptr)
     /* Be sure the user entered a valid cell id or if the the program is loading
        the resource for the testCPU that does not have a grid set up */
        
-    if (cell_id >= 0 && cell_id <= grid.GetSize()) {
-      Rate((*cell_list_ptr)[i].GetId(), (*cell_list_ptr)[i].GetInitial());
-      State((*cell_list_ptr)[i].GetId());
-      Element(cell_id).SetInitial((*cell_list_ptr)[i].GetInitial());
+    if (cell_id >= 0 && cell_id < num_cells) {
+      Rate(cell_id, (*cell_list_ptr)[i].GetInitial());
+      State(cell_id);
+      m_cell_initial[cell_id] = (*cell_list_ptr)[i].GetInitial();
     }
   }
 }
@@ -233,8 +205,8 @@ void cSpatialResCount::SetCellList(Apto::Array<cCellResource>* in_cell_list_ptr)
 /* Set the rate variable for one element using the array index */
 
 void cSpatialResCount::Rate(int x, double ratein) const {
-  if (x >= 0 && x < grid.GetSize()) {
-    grid[x].Rate(ratein);
+  if (x >= 0 && x < num_cells) {
+    m_delta[x] += ratein;
   } else {
     assert(false); // x not valid id
   }
@@ -244,7 +216,7 @@ void cSpatialResCount::Rate(int x, double ratein) const {
 
 void cSpatialResCount::Rate(int x, int y, double ratein) const { 
   if (x >= 0 && x < world_x && y>= 0 && y < world_y) {
-    grid[y * world_x + x].Rate(ratein);
+    m_delta[y * world_x + x] += ratein;
   } else {
     assert(false); // x or y not valid id
   }
@@ -254,8 +226,9 @@ void cSpatialResCount::Rate(int x, int y, double ratein) const {
    the array index */
    
 void cSpatialResCount::State(int x) { 
-  if (x >= 0 && x < grid.GetSize()) {
-    grid[x].State();
+  if (x >= 0 && x < num_cells) {
+    m_amount[x] += m_delta[x];
+    m_delta[x] = 0.0;
   } else {
     assert(false); // x not valid id
   }
@@ -266,7 +239,9 @@ void cSpatialResCount::State(int x) {
    
 void cSpatialResCount::State(int x, int y) { 
   if (x >= 0 && x < world_x && y >= 0 && y < world_y) {
-    grid[y*world_x + x].State();
+    const int cell_id = y * world_x + x;
+    m_amount[cell_id] += m_delta[cell_id];
+    m_delta[cell_id] = 0.0;
   } else {
     assert(false); // x or y not valid id
   }
@@ -275,8 +250,8 @@ void cSpatialResCount::State(int x, int y) {
 /* Get the state of one element using the array index */
 
 double cSpatialResCount::GetAmount(int x) const { 
-  if (x >= 0 && x < grid.GetSize()) {
-    return grid[x].GetAmount(); 
+  if (x >= 0 && x < num_cells) {
+    return m_amount[x]; 
   } else {
     return -99.9;
   }
@@ -286,59 +261,109 @@ double cSpatialResCount::GetAmount(int x) const {
 
 double cSpatialResCount::GetAmount(int x, int y) const { 
   if (x >= 0 && x < world_x && y >= 0 && y < world_y) {
-    return grid[y*world_x + x].GetAmount(); 
+    return m_amount[y * world_x + x]; 
   } else {
     return -99.9;
   }
 }
 
 void cSpatialResCount::RateAll(double ratein) {
-
-  int i;
- 
-  for (i = 0; i < num_cells; i++) {
-    grid[i].Rate(ratein);
-  } 
+  for (int i = 0; i < num_cells; i++) m_delta[i] += ratein;
 }
 
 /* For each cell in the grid add the changes stored in the rate variable
    with the total of the resource */
 
 void cSpatialResCount::StateAll() {
-
-  int i;
- 
-  for (i = 0; i < num_cells; i++) {
-    grid[i].State();
-  } 
+  if (num_cells == 0) return;
+  
+  double* amount = &m_amount[0];
+  double* delta = &m_delta[0];
+  for (int i = 0; i < num_cells; i++) {
+    amount[i] += delta[i];
+    delta[i] = 0.0;
+  }
 }
 
 void cSpatialResCount::FlowAll() {
 
   // @JEB save time if diffusion and gravity off...
   if ((xdiffuse == 0.0) && (ydiffuse == 0.0) && (xgravity == 0.0) && (ygravity == 0.0)) return;
+  if (num_cells == 0) return;
 
-  int     i,k,ii,xdist,ydist;
-  double  dist;
- 
-  for (i = 0; i < num_cells; i++) {
-      
-    /* because flow is two way we must check only half the neighbors to 
-       prevent double flow calculations */
-
-    for (k = 3; k <= 6; k++) {
-      ii = grid[i].GetElemPtr(k);
-      xdist = grid[i].GetPtrXdist(k);
-      ydist = grid[i].GetPtrYdist(k);
-      dist = grid[i].GetPtrDist(k);
+  const double SQRT2 = sqrt(2.0);
+  const double* amount = &m_amount[0];
+  
+  /* First calculate the flow across every stencil edge.  This only reads the current amounts, so each direction is
+     an independent sweep over contiguous memory. */
+  
+  FlowDirection<+1,  0>(amount, &m_flow_nbr[0][0], &m_flow[0][0], 1.0);
+  FlowDirection<+1, +1>(amount, &m_flow_nbr[1][0], &m_flow[1][0], SQRT2);
+  FlowDirection< 0, +1>(amount, &m_flow_nbr[2][0], &m_flow[2][0], 1.0);
+  FlowDirection<-1, +1>(amount, &m_flow_nbr[3][0], &m_flow[3][0], SQRT2);
+  
+  /* Then fold the flows into the deltas, visiting cells and neighbors in the same order as the flows would be
+     generated one pair at a time so that the accumulated deltas are unchanged. */
+  
+  double* delta = &m_delta[0];
+  for (int i = 0; i < num_cells; i++) {
+    for (int k = 0; k < NUM_FLOW_DIRS; k++) {
+      const int ii = m_flow_nbr[k][i];
       if (ii >= 0) {
-        FlowMatter(grid[i],grid[ii],xdiffuse,ydiffuse,xgravity,ygravity,
-                   xdist, ydist, dist);
+        delta[i] -= m_flow[k][i];
+        delta[ii] += m_flow[k][i];
       }
     }
   }
 }
 
+/* Calculate the amount of flow from each cell to its neighbor in the direction (DX, DY).  Amount of flow is a function
+   of:
+
+     1) Amount of material in each cell (will try to equalize)
+     2) Distance between each cell
+     3) x and y "gravity"
+*/
+
+template <int DX, int DY>
+void cSpatialResCount::FlowDirection(const double* amount, const int* nbr, double* flow, double dist) const
+{
+  /* Gravity moves material from the cell into the neighbor when it points toward the neighbor */
+  
+  const bool xgravity_out = ((DX > 0) && (xgravity > 0.0)) || ((DX < 0) && (xgravity < 0.0));
+  const bool ygravity_out = ((DY > 0) && (ygravity > 0.0)) || ((DY < 0) && (ygravity < 0.0));
+  const double abs_xgravity = fabs(xgravity);
+  const double abs_ygravity = fabs(ygravity);
+  const double steps = fabs(DX * 1.0) + fabs(DY * 1.0);
+  
+  for (int i = 0; i < num_cells; i++) {
+    const int ii = nbr[i];
+    if (ii < 0) {
+      flow[i] = 0.0;
+      continue;
+    }
+    
+    const double amount1 = amount[i];
+    const double amount2 = amount[ii];
+    const double diff = amount1 - amount2;
+    double xflow_diffuse = 0.0, xflow_gravity = 0.0, yflow_diffuse = 0.0, yflow_gravity = 0.0;
+    
+    /* Diffusion uses the diffusion constant x half the difference (as the 
+       elements attempt to equalize) / the number of possible neighbors (8) */
+    
+    if (DX != 0) {
+      xflow_gravity = xgravity_out ? (amount1 * abs_xgravity / 3.0) : (-amount2 * abs_xgravity / 3.0);
+      xflow_diffuse = xdiffuse * diff / 16.0;
+    }
+    if (DY != 0) {
+      yflow_gravity = ygravity_out ? (amount1 * abs_ygravity / 3.0) : (-amount2 * abs_ygravity / 3.0);
+      yflow_diffuse = ydiffuse * diff / 16.0;
+    }
+    
+    flow[i] = ((xflow_diffuse + yflow_diffuse + xflow_gravity + yflow_gravity) / steps) / dist;
+  }
+}
+
 /* Total up all the resources in each cell */
 
 double cSpatialResCount::SumAll() const{
@@ -379,7 +404,7 @@ void cSpatialResCount::CellInflow() const {
     /* Be sure the user entered a valid cell id or if the the program is loading
        the resource for the testCPU that does not have a grid set up */
        
-    if (cell_id >= 0 && cell_id < grid.GetSize()) {
+    if (cell_id >= 0 && cell_id < num_cells) {
       Rate(cell_id, (*cell_list_ptr)[i].GetInflow());
     }
   }
@@ -415,7 +440,7 @@ void cSpatialResCount::CellOutflow() const {
     /* Be sure the user entered a valid cell id or if the the program is loading
        the resource for the testCPU that does not have a grid set up */
        
-    if (cell_id >= 0 && cell_id < grid.GetSize()) {
+    if (cell_id >= 0 && cell_id < num_cells) {
       deltaamount = Apto::Max((GetAmount(cell_id) * (*cell_list_ptr)[i].GetOutflow()), 0.0);
     }                     
     Rate((*cell_list_ptr)[i].GetId(), -deltaamount); 
@@ -424,14 +449,42 @@ void cSpatialResCount::CellOutflow() const {
 
 void cSpatialResCount::SetCellAmount(int cell_id, double res)
 {
-  if (cell_id >= 0 && cell_id < grid.GetSize())
+  if (cell_id >= 0 && cell_id < num_cells)
   {
-    Element(cell_id).SetAmount(res);
+    m_amount[cell_id] = res;
+  }
+}
+
+void cSpatialResCount::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  cp.WriteArray(m_amount);
+  cp.WriteArray(m_delta);
+  cp.Write(curr_peakx);
+  cp.Write(curr_peaky);
+  cp.Write(m_modified);
+}
+
+void cSpatialResCount::LoadCheckpoint(cCheckpointReader& cp)
+{
+  Apto::Array<double> amount;
+  Apto::Array<double> delta;
+  cp.ReadArray(amount);
+  cp.ReadArray(delta);
+  cp.Read(curr_peakx);
+  cp.Read(curr_peaky);
+  cp.Read(m_modified);
+  
+  // The grid dimensions come from the world configuration and must match the checkpoint
+  if (amount.GetSize() != num_cells || delta.GetSize() != num_cells) {
+    cp.Invalidate();
+    return;
   }
+  m_amount = amount;
+  m_delta = delta;
 }
 
 
 void cSpatialResCount::ResetResourceCounts()
 {
-  for (int i = 0; i < grid.GetSize(); i++) grid[i].ResetResourceCount(m_initial);
+  for (int i = 0; i < num_cells; i++) m_amount[i] = m_initial + m_cell_initial[i];
 }
@@ -26,14 +26,28 @@
 #define cSpatialResCount_h
 
 #include "cAvidaContext.h"
-#include "cSpatialCountElem.h"
 #include "cResource.h"
 
+class cCheckpointReader;
+class cCheckpointWriter;
+
 
 class cSpatialResCount
 {
 private:
-  Apto::Array<cSpatialCountElem> grid;
+  // Number of stencil directions that flow is calculated across.  Flow is symmetric, so only the right, lower-right,
+  // lower and lower-left neighbors of each cell need to be visited.
+  static const int NUM_FLOW_DIRS = 4;
+
+  // Resource state is kept as contiguous planes, one value per cell
+  mutable Apto::Array<double> m_amount;
+  mutable Apto::Array<double> m_delta;
+  Apto::Array<double> m_cell_initial;
+  
+  // Flow stencil, one neighbor plane per direction (-1 where the neighbor does not exist), plus scratch flow planes
+  Apto::Array<int> m_flow_nbr[NUM_FLOW_DIRS];
+  Apto::Array<double> m_flow[NUM_FLOW_DIRS];
+  
   double m_initial;
   double xdiffuse, ydiffuse;
   double xgravity, ygravity;
@@ -46,6 +60,8 @@ private:
   Apto::Array<cCellResource> *cell_list_ptr;
   bool m_modified;
   
+  template <int DX, int DY> void FlowDirection(const double* amount, const int* nbr, double* flow, double dist) const;
+  
 public:
   cSpatialResCount();
   cSpatialResCount(int inworld_x, int inworld_y, int ingeometry);
@@ -58,17 +74,19 @@ public:
   void SetPointers();
   void CheckRanges();
   void SetCellList(Apto::Array<cCellResource> *in_cell_list_ptr);
-  int GetSize() const { return grid.GetSize(); }
+  int GetSize() const { return m_amount.GetSize(); }
   int GetX() const { return world_x; }
   int GetY() const { return world_y; }
   int GetCellListSize() const { return cell_list_ptr->GetSize(); }
-  cSpatialCountElem& Element(int x) { return grid[x]; }
   void Rate(int x, double ratein) const;
   void Rate(int x, int y, double ratein) const;
   void State(int x);
   void State(int x, int y);
   double GetAmount(int x) const;
   double GetAmount(int x, int y) const;
+  // Unlike GetAmount/SetCellAmount, the element accessors require a valid cell
+  double GetElementAmount(int cell_id) const { assert(cell_id >= 0 && cell_id < num_cells); return m_amount[cell_id]; }
+  void SetElementAmount(int cell_id, double res) { assert(cell_id >= 0 && cell_id < num_cells); m_amount[cell_id] = res; }
   void RateAll(double ratein); 
   virtual void StateAll();
   void FlowAll(); 
@@ -78,6 +96,8 @@ public:
   void Sink(double percent) const;
   void CellOutflow() const;
   void SetCellAmount(int cell_id, double res);
+  void SaveCheckpoint(cCheckpointWriter& cp) const;
+  void LoadCheckpoint(cCheckpointReader& cp);
   void SetInitial(double initial) { m_initial = initial; }
   double GetInitial() const { return m_initial; }
   void SetGeometry(int in_geometry) { geometry = in_geometry; }
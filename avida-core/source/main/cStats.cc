@@ -29,6 +29,7 @@
 #include "avida/data/Util.h"
 #include "avida/output/File.h"
 
+#include "cCheckpoint.h"
 #include "cEnvironment.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
@@ -628,6 +629,62 @@ void cStats::ProcessUpdate()
   m_num_successful_mates = 0;
 }
 
+// Only the values carried from one update to the next are saved; the organism sums are rebuilt every update, except
+// for the merit sum and the counts of the current update, which the first ProcessUpdate after a restore still reads
+bool cStats::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  cp.Write(avida_time);
+  cp.Write(last_update);
+  rave_true_replication_rate.SaveCheckpoint(cp);
+  cp.Write(sum_merit);
+  cp.Write(max_viable_fitness);
+  cp.Write(num_births);
+  cp.Write(cumulative_births);
+  cp.Write(num_deaths);
+  cp.Write(num_breed_in);
+  cp.Write(num_breed_true);
+  cp.Write(num_creatures);
+  cp.Write(num_executed);
+  cp.Write(tot_organisms);
+  cp.Write(tot_executed);
+  cp.WriteArray(new_task_count);
+  cp.WriteArray(prev_task_count);
+  cp.WriteArray(cur_task_count);
+  cp.WriteArray(new_reaction_count);
+  
+  return cp.Good();
+}
+
+bool cStats::LoadCheckpoint(cCheckpointReader& cp)
+{
+  cp.Read(avida_time);
+  cp.Read(last_update);
+  rave_true_replication_rate.LoadCheckpoint(cp);
+  cp.Read(sum_merit);
+  cp.Read(max_viable_fitness);
+  cp.Read(num_births);
+  cp.Read(cumulative_births);
+  cp.Read(num_deaths);
+  cp.Read(num_breed_in);
+  cp.Read(num_breed_true);
+  cp.Read(num_creatures);
+  cp.Read(num_executed);
+  cp.Read(tot_organisms);
+  cp.Read(tot_executed);
+  
+  // The task and reaction counts are sized by the environment, which must match the checkpoint
+  const int num_tasks = new_task_count.GetSize();
+  const int num_reactions = new_reaction_count.GetSize();
+  cp.ReadArray(new_task_count);
+  cp.ReadArray(prev_task_count);
+  cp.ReadArray(cur_task_count);
+  cp.ReadArray(new_reaction_count);
+  if (new_task_count.GetSize() != num_tasks || prev_task_count.GetSize() != num_tasks ||
+      cur_task_count.GetSize() != num_tasks || new_reaction_count.GetSize() != num_reactions) return false;
+  
+  return cp.Good();
+}
+
 int cStats::GetNumPreyCreatures() const
 {
   return m_world->GetPopulation().GetNumPreyOrganisms();
@@ -58,6 +58,8 @@ class cOrgMessagePredicate;
 class cOrgMovementPredicate;
 class cDeme;
 class cGermline;
+class cCheckpointReader;
+class cCheckpointWriter;
 
 using namespace Avida;
 
@@ -431,6 +433,8 @@ public:
   
   // cStats
   void ProcessUpdate();
+  bool SaveCheckpoint(cCheckpointWriter& cp) const;
+  bool LoadCheckpoint(cCheckpointReader& cp);
 
   inline void SetCurrentUpdate(int new_update) { m_update = new_update; }
   inline void IncCurrentUpdate() { m_update++; }
@@ -718,6 +722,7 @@ public:
   void SetCompetitionOrgsReplicated(int _in) { num_orgs_replicated = _in; }
 
   void AddSpeculative(int spec) { m_spec_total += spec; m_spec_num++; }
+  void AddSpeculative(int spec, int num) { m_spec_total += spec; m_spec_num += num; }
   void AddSpeculativeWaste(int waste) { m_spec_waste += waste; }
 
   // Sexual selection recording
@@ -728,6 +733,7 @@ public:
   int GetNumBirths() const          { return num_births; }
   int GetCumulativeBirths() const   { return cumulative_births; }
   int GetNumDeaths() const          { return num_deaths; }
+  int GetNumExecuted() const        { return num_executed; }
   int GetBreedIn() const            { return num_breed_in; }
   int GetBreedTrue() const          { return num_breed_true; }
   int GetBreedTrueCreatures() const { return num_breed_true_creatures; }
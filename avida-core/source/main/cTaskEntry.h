@@ -44,6 +44,7 @@ private:
   cArgContainer* m_args;
   Apto::String m_prop_id_ave;
   Apto::String m_prop_id_count;
+  Apto::Array<bool> m_logic_ids;  // For tasks that depend only on the logic ID, which IDs satisfy the task
 
 public:
   cTaskEntry(const cString& name, const cString& desc, int in_id, tTaskTest fun, cArgContainer* args)
@@ -68,6 +69,10 @@ public:
   
   bool HasArguments() const { return (m_args != NULL); }
   cArgContainer& GetArguments() const { return *m_args; }
+  
+  bool IsLogicOnly() const { return m_logic_ids.GetSize() > 0; }
+  bool IsSatisfiedBy(int logic_id) const { return logic_id >= 0 && logic_id < m_logic_ids.GetSize() && m_logic_ids[logic_id]; }
+  void SetLogicIDs(const Apto::Array<bool>& logic_ids) { m_logic_ids = logic_ids; }
 };
 
 #endif
@@ -54,6 +54,18 @@
 
 static const double dCastPrecision = 100000.0;
 
+// Tasks whose outcome is fully determined by the logic ID computed in SetupTests
+static bool IsLogicOnlyTask(const cString& name)
+{
+  static const char* logic_tasks[] = { "not", "nand", "and", "orn", "or", "andn", "nor", "xor", "equ", NULL };
+  
+  if (name.GetSize() == 9 && name.IsSubstring("logic_3", 0)) return true;
+  for (int i = 0; logic_tasks[i] != NULL; i++) {
+    if (name == logic_tasks[i] || name == cString(logic_tasks[i]) + "_dup") return true;
+  }
+  return false;
+}
+
 
 cTaskLib::~cTaskLib()
 {
@@ -346,6 +358,8 @@ cTaskEntry* cTaskLib::AddTask(const cString& name, const cString& info, cEnvReqs
     return NULL;
   }
   
+  if (IsLogicOnlyTask(name)) SetupLogicIDs(task_array[start_size]);
+  
   // And return the found task.
   return task_array[start_size];
 }
@@ -361,6 +375,24 @@ void cTaskLib::NewTask(const cString& name, const cString& desc, tTaskTest task_
 }
 
 
+// Evaluate a logic-only task against every logic ID, so that the environment can look up candidate reactions directly
+void cTaskLib::SetupLogicIDs(cTaskEntry* task)
+{
+  tBuffer<int> buffer(1);
+  tList<tBuffer<int> > other_buffers;
+  Apto::Array<int, Apto::Smart> ext_mem;
+  cTaskContext ctx(NULL, buffer, buffer, other_buffers, other_buffers, ext_mem);
+  ctx.SetTaskEntry(task);
+  
+  Apto::Array<bool> logic_ids(NUM_LOGIC_IDS);
+  for (int logic_id = 0; logic_id < NUM_LOGIC_IDS; logic_id++) {
+    ctx.SetLogicId(logic_id);
+    logic_ids[logic_id] = ((this->*(task->GetTestFun()))(ctx) > 0.0);
+  }
+  task->SetLogicIDs(logic_ids);
+}
+
+
 void cTaskLib::SetupTests(cTaskContext& ctx) const
 {
   const tBuffer<int>& input_buffer = ctx.GetInputBuffer();
@@ -384,25 +416,22 @@ void cTaskLib::SetupTests(cTaskContext& ctx) const
   //       Input A: 1 0 1 0 1 0 1 0
   
   int logic_out[8];
-  for (int i = 0; i < 8; i++) logic_out[i] = -1;
   
-  // Test all input combos!
+  // Test all input combos at once: for each combination, mask the bit positions where the inputs take on that
+  // combination and check that the output bits under the mask are either all zero or all one.
   bool func_OK = true;  // Have all outputs been consistant?
-  for (int test_pos = 0; test_pos < 32; test_pos++) {
-    int logic_pos = 0;
-    for (int i = 0; i < 3; i++)  logic_pos += (test_inputs[i] & 1) << i;
-    
-    if ( logic_out[logic_pos] != -1 &&
-        logic_out[logic_pos] != (test_output & 1) ) {
-      func_OK = false;
-      break;
-    }
-    else {
-      logic_out[logic_pos] = test_output & 1;
-    }
-    
-    test_output >>= 1;
-    for (int i = 0; i < 3; i++) test_inputs[i] >>= 1;
+  const unsigned int in_a = test_inputs[0];
+  const unsigned int in_b = test_inputs[1];
+  const unsigned int in_c = test_inputs[2];
+  const unsigned int out = test_output;
+  for (int logic_pos = 0; logic_pos < 8; logic_pos++) {
+    const unsigned int mask = ((logic_pos & 1) ? in_a : ~in_a) & ((logic_pos & 2) ? in_b : ~in_b) &
+                              ((logic_pos & 4) ? in_c : ~in_c);
+    const unsigned int out_bits = out & mask;
+    if (mask == 0) logic_out[logic_pos] = -1;
+    else if (out_bits == mask) logic_out[logic_pos] = 1;
+    else if (out_bits == 0) logic_out[logic_pos] = 0;
+    else func_OK = false;
   }
   
   // If there were any inconsistancies, deal with them.
@@ -57,6 +57,8 @@ private:
   cTaskLib& operator=(const cTaskLib&); // @not_implemented
 
 public:
+  static const int NUM_LOGIC_IDS = 256;  // distinct 3-input logic functions identified by SetupTests
+  
   cTaskLib(cWorld* world) : m_world(world), use_neighbor_input(false), use_neighbor_output(false) { ; }
   ~cTaskLib();
 
@@ -85,6 +87,7 @@ private:
 private:
   
   void NewTask(const cString& name, const cString& desc, tTaskTest task_fun, int reqs = 0, cArgContainer* args = NULL);
+  void SetupLogicIDs(cTaskEntry* task);
 
   inline double FractionalReward(unsigned int supplied, unsigned int correct);  
 
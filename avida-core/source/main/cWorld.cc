@@ -36,9 +36,11 @@
 #include "cAnalyzeGenotype.h"
 #include "cEnvironment.h"
 #include "cEventList.h"
+#include "cGridDump.h"
 #include "cHardwareManager.h"
 #include "cMigrationMatrix.h"  
 #include "cInstSet.h"
+#include "cPhaseProfiler.h"
 #include "cPopulation.h"
 #include "cStats.h"
 #include "cTestCPU.h"
@@ -51,7 +53,7 @@ using namespace AvidaTools;
 
 cWorld::cWorld(cAvidaConfig* cfg, const cString& wd)
   : m_working_dir(wd), m_analyze(NULL), m_conf(cfg), m_ctx(NULL)
-  , m_env(NULL), m_event_list(NULL), m_hw_mgr(NULL), m_pop(NULL), m_stats(NULL), m_mig_mat(NULL), m_driver(NULL), m_data_mgr(NULL)
+  , m_env(NULL), m_event_list(NULL), m_grid_dump(NULL), m_hw_mgr(NULL), m_pop(NULL), m_stats(NULL), m_mig_mat(NULL), m_driver(NULL), m_data_mgr(NULL)
   , m_own_driver(false)
 {
 }
@@ -73,6 +75,9 @@ cWorld::~cWorld()
   // These must be deleted first
   delete m_analyze; m_analyze = NULL;
   
+  // Finish writing grid dump containers
+  delete m_grid_dump; m_grid_dump = NULL;
+  
   // Forcefully clean up population before classification manager
   m_pop = Apto::SmartPtr<cPopulation, Apto::InternalRCObject>();
   
@@ -114,7 +119,9 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
     
     // Output Manager
     Apto::String opath = Apto::FileSystem::GetAbsolutePath(Apto::String(m_conf->DATA_DIR.Get()), Apto::String(m_working_dir));
-    Output::ManagerPtr(new Output::Manager(opath))->AttachTo(new_world);
+    Output::ManagerPtr output_mgr(new Output::Manager(opath));
+    output_mgr->AttachTo(new_world);
+    if (m_conf->PIPELINE_OUTPUT.Get()) output_mgr->StartWriter();
   }
   
 
@@ -145,7 +152,7 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
   // Systematics
   Systematics::ManagerPtr systematics(new Systematics::Manager);
   systematics->AttachTo(new_world);
-  systematics->RegisterArbiter(Systematics::ArbiterPtr(new Systematics::GenotypeArbiter(new_world, "genotype", m_conf->THRESHOLD.Get(), m_conf->DISABLE_GENOTYPE_CLASSIFICATION.Get())));
+  systematics->RegisterArbiter(Systematics::ArbiterPtr(new Systematics::GenotypeArbiter(new_world, "genotype", m_conf->THRESHOLD.Get(), m_conf->DISABLE_GENOTYPE_CLASSIFICATION.Get(), m_conf->HISTORIC_GENOTYPE_STORE.Get())));
 
   
   // Setup Stats Object
@@ -193,6 +200,7 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
   const bool sterilize_taskloss = m_conf->STERILIZE_TASKLOSS.Get() > 0.0;
   m_test_sterilize = (sterilize_fatal || sterilize_neg || sterilize_neut || sterilize_pos || sterilize_taskloss);
 
+  m_profiler = Apto::SmartPtr<cPhaseProfiler, Apto::InternalRCObject>(new cPhaseProfiler(this));
   m_pop = Apto::SmartPtr<cPopulation, Apto::InternalRCObject>(new cPopulation(this));
   
   // Setup Event List
@@ -207,6 +215,8 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
 
 Data::ProviderPtr cWorld::GetStatsProvider(World*) { return m_stats; }
 Data::ArgumentedProviderPtr cWorld::GetPopulationProvider(World*) { return m_pop; }
+Data::ProviderPtr cWorld::GetPhaseProfilerProvider(World*) { return m_profiler; }
+Data::ArgumentedProviderPtr cWorld::GetPhaseProfilerArgProvider(World*) { return m_profiler; }
 
 
 cAnalyze& cWorld::GetAnalyze()
@@ -215,6 +225,18 @@ cAnalyze& cWorld::GetAnalyze()
   return *m_analyze;
 }
 
+cGridDump* cWorld::GetGridDump()
+{
+  const int format = m_conf->GRID_DUMP_FORMAT.Get();
+  if (m_grid_dump == NULL && format > 0) m_grid_dump = new cGridDump(this, format == 2, m_conf->GRID_DUMP_QUEUE_SIZE.Get());
+  return m_grid_dump;
+}
+
+void cWorld::FinishGridDump()
+{
+  if (m_grid_dump) m_grid_dump->Finish();
+}
+
 void cWorld::GetEvents(cAvidaContext& ctx)
 {  
   if (m_pop->GetSyncEvents() == true) {
@@ -36,9 +36,11 @@ class cAnalyze;
 class cAnalyzeGenotype;
 class cEnvironment;
 class cEventList;
+class cGridDump;
 class cHardwareManager;
 class cMigrationMatrix; 
 class cOrganism;
+class cPhaseProfiler;
 class cPopulation;
 class cMerit;
 class cPopulationCell;
@@ -61,7 +63,9 @@ protected:
   cAvidaContext* m_ctx;
   cEnvironment* m_env;
   cEventList* m_event_list;
+  cGridDump* m_grid_dump;
   cHardwareManager* m_hw_mgr;
+  Apto::SmartPtr<cPhaseProfiler, Apto::InternalRCObject> m_profiler;
   Apto::SmartPtr<cPopulation, Apto::InternalRCObject> m_pop;
   Apto::SmartPtr<cStats, Apto::InternalRCObject> m_stats;
   cMigrationMatrix* m_mig_mat;  
@@ -92,8 +96,11 @@ public:
   cAvidaConfig& GetConfig() { return *m_conf; }
   cAvidaContext& GetDefaultContext() { return *m_ctx; }
   cEnvironment& GetEnvironment() { return *m_env; }
+  cGridDump* GetGridDump();  // NULL when grids are dumped as text
+  void FinishGridDump();     // Write out queued grid frames and close the containers, if any are open
   cHardwareManager& GetHardwareManager() { return *m_hw_mgr; }
   cMigrationMatrix& GetMigrationMatrix(){ return *m_mig_mat; };
+  cPhaseProfiler& GetPhaseProfiler() { return *m_profiler; }
   cPopulation& GetPopulation() { return *m_pop; }
   Apto::Random& GetRandom() { return m_rng; }
   cStats& GetStats() { return *m_stats; }
@@ -104,6 +111,8 @@ public:
   
   Data::ProviderPtr GetStatsProvider(World*);
   Data::ArgumentedProviderPtr GetPopulationProvider(World*);
+  Data::ProviderPtr GetPhaseProfilerProvider(World*);
+  Data::ArgumentedProviderPtr GetPhaseProfilerArgProvider(World*);
   
   // Config Dependent Modes
   bool GetTestOnDivide() const { return m_test_on_div; }
@@ -89,13 +89,74 @@ Avida::Output::FilePtr Avida::Output::File::StaticWithPath(World* world, Apto::S
 
 
 Avida::Output::File::File(World* world, const OutputID& name, bool append)
-  : Socket(world, name), m_descr_written(false), m_num_cols(0)
+  : Socket(world, name), m_descr_written(false), m_num_cols(0), m_fp(new std::ofstream), m_writer(NULL), m_submitted(false)
 {
-  m_fp.open(name, (append) ? (std::ios::out | std::ios::app) : std::ios::out);
-  assert(m_fp.good());
+  m_fp->open(name, (append) ? (std::ios::out | std::ios::app) : std::ios::out);
+  assert(m_fp->good());
+  
+  ManagerPtr mgr = Manager::Of(world);
+  if (mgr->HasWriter()) {
+    m_writer = Apto::GetInternalPtr(mgr);
+    m_writer->attachFile(this);
+  }
+}
+
+Avida::Output::File::~File()
+{
+  // The writer closes the stream once the output queued ahead of it has been written
+  if (m_writer) {
+    m_writer->detachFile(this);
+    submitPending(true);
+  } else {
+    delete m_fp;
+  }
+}
+
+
+bool Avida::Output::File::Fail() const
+{
+  syncWriter();
+  return m_fp->fail();
+}
+
+bool Avida::Output::File::Good() const
+{
+  syncWriter();
+  return m_fp->good();
 }
 
-Avida::Output::File::~File() { ; }
+std::ofstream& Avida::Output::File::OFStream()
+{
+  if (m_writer) {
+    submitPending();
+    syncWriter();
+    m_writer->detachFile(this);
+    m_writer = NULL;
+  }
+  return *m_fp;
+}
+
+
+void Avida::Output::File::submitPending(bool close)
+{
+  m_writer->submitWrite(m_fp, m_pending.str(), close);
+  m_pending.str("");
+  m_submitted = true;
+}
+
+void Avida::Output::File::syncWriter() const
+{
+  // Only this file's own output needs to have been written
+  if (m_writer && m_submitted) m_writer->waitForWrites(m_fp);
+}
+
+void Avida::Output::File::detachWriter()
+{
+  // Called by the manager once its writer has finished, so everything submitted earlier is already in the stream
+  *m_fp << m_pending.str();
+  m_pending.str("");
+  m_writer = NULL;
+}
 
 
 
@@ -105,7 +166,7 @@ void Avida::Output::File::Write(double x, const char* descr, const char* format)
     m_data << x << " ";
     WriteColumnDesc(descr, format);
   } else {
-    m_fp << x << " ";
+    out() << x << " ";
   }
 }
 
@@ -116,7 +177,7 @@ void Avida::Output::File::Write(int i, const char* descr, const char* format)
     m_data << i << " ";
     WriteColumnDesc(descr, format);
   } else {
-    m_fp << i << " ";
+    out() << i << " ";
   }
 }
 
@@ -127,7 +188,7 @@ void Avida::Output::File::Write(long i, const char* descr, const char* format)
     m_data << i << " ";
     WriteColumnDesc(descr, format);
   } else {
-    m_fp << i << " ";
+    out() << i << " ";
   }
 }
 
@@ -137,7 +198,7 @@ void Avida::Output::File::Write(unsigned int i, const char* descr, const char*)
     m_data << i << " ";
     WriteColumnDesc(descr);
   } else {
-    m_fp << i << " ";
+    out() << i << " ";
   }
 }
 
@@ -148,7 +209,7 @@ void Avida::Output::File::Write(const char* data_str, const char* descr, const c
     m_data << data_str << " ";
     WriteColumnDesc(descr, format);
   } else {
-    m_fp << data_str << " ";
+    out() << data_str << " ";
   }
 }
 
@@ -162,7 +223,7 @@ void Avida::Output::File::Write(Apto::Array<int> list, const char* descr, const
     WriteColumnDesc(descr, format);
   } else {
     for (int i =0; i < (int)list.GetSize(); i++) {
-      m_fp << list[i] << " ";
+      out() << list[i] << " ";
     }
   }
 }
@@ -170,14 +231,14 @@ void Avida::Output::File::Write(Apto::Array<int> list, const char* descr, const
 
 void Avida::Output::File::WriteBlockElement(double x, int element, int x_size)
 {
-  m_fp << x << " ";
-  if (((element + 1) % x_size) == 0) m_fp << "\n";
+  out() << x << " ";
+  if (((element + 1) % x_size) == 0) out() << "\n";
 }
 
 void Avida::Output::File::WriteBlockElement(int i, int element, int x_size)
 {
-  m_fp << i << " ";
-  if (((element + 1) % x_size) == 0) m_fp << "\n";
+  out() << i << " ";
+  if (((element + 1) % x_size) == 0) out() << "\n";
 }
 
 void Avida::Output::File::WriteColumnDesc(const char* descr, const char* format)
@@ -203,7 +264,7 @@ void Avida::Output::File::WriteRawComment(const char* comment)
 
 void Avida::Output::File::WriteRaw(const char* str)
 {
-  m_fp << str << "\n";
+  out() << str << "\n";
 }
 
 
@@ -220,7 +281,7 @@ void Avida::Output::File::WriteTimeStamp()
 void Avida::Output::File::FlushComments()
 {
   if (!m_descr_written) {
-    m_fp << m_descr;
+    out() << m_descr;
     m_descr = "";
     
     m_descr_written = true;
@@ -233,26 +294,29 @@ void Avida::Output::File::Endl()
 {
   if (!m_descr_written) {
     // Handle filetype and format first
-    if (m_filetype != "") m_fp << "#filetype " << m_filetype << std::endl;
-    if (m_format != "") m_fp << "#format " << m_format << std::endl;
+    if (m_filetype != "") out() << "#filetype " << m_filetype << std::endl;
+    if (m_format != "") out() << "#format " << m_format << std::endl;
     
     // Output column descriptions and comments
-    m_fp << m_descr << std::endl;
+    out() << m_descr << std::endl;
     m_descr = "";
     
     // Print the first row of data
-    m_fp << m_data.str() << std::endl;
+    out() << m_data.str() << std::endl;
     m_data.clear();
     m_data.str("");
     
     m_descr_written = true;
   } else {
-    m_fp << std::endl;
+    out() << std::endl;
   }
+  
+  if (m_writer) submitPending();
 }
 
 
 void Avida::Output::File::Flush()
 {
-  m_fp.flush();
+  if (m_writer) submitPending();
+  else m_fp->flush();
 }
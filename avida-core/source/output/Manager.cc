@@ -24,9 +24,36 @@
 
 #include "avida/output/Manager.h"
 
+#include "avida/output/File.h"
 #include "avida/output/Socket.h"
 
-Avida::Output::Manager::Manager(const Apto::String& output_path) : m_world(NULL)
+#include "apto/core/Thread.h"
+
+
+struct Avida::Output::Manager::WriteRequest
+{
+  std::ofstream* fp;
+  std::string data;
+  bool close;
+  
+  WriteRequest(std::ofstream* in_fp, const std::string& in_data, bool in_close) : fp(in_fp), data(in_data), close(in_close) { ; }
+};
+
+
+class Avida::Output::Manager::Writer : public Apto::Thread
+{
+private:
+  Manager* m_mgr;
+  
+  void Run() { m_mgr->runWriter(); }
+  
+public:
+  Writer(Manager* mgr) : m_mgr(mgr) { ; }
+};
+
+
+Avida::Output::Manager::Manager(const Apto::String& output_path)
+  : m_world(NULL), m_writing(0), m_closing(false), m_writer(NULL)
 {
   m_output_path = output_path;
   m_output_path.Trim();
@@ -40,7 +67,29 @@ Avida::Output::Manager::Manager(const Apto::String& output_path) : m_world(NULL)
   }
 }
 
-Avida::Output::Manager::~Manager() { ; }
+Avida::Output::Manager::~Manager()
+{
+  if (m_writer) {
+    // Close the static files, queueing their remaining output, then let the writer drain the queue
+    m_mutex.Lock();
+    Apto::Map<OutputID, SocketPtr> static_sockets(m_static_sockets);
+    m_static_sockets.Clear();
+    m_mutex.Unlock();
+    static_sockets.Clear();
+    
+    m_write_mutex.Lock();
+    m_closing = true;
+    m_write_mutex.Unlock();
+    m_write_cond.Signal();
+    
+    m_writer->Join();
+    delete m_writer;
+    
+    // Files that outlive the manager write their remaining and future output themselves
+    for (std::set<File*>::iterator it = m_files.begin(); it != m_files.end(); it++) (*it)->detachWriter();
+    m_files.clear();
+  }
+}
 
 
 Avida::Output::OutputID Avida::Output::Manager::OutputIDFromPath(Apto::String path) const
@@ -115,6 +164,15 @@ void Avida::Output::Manager::FlushAll()
 }
 
 
+void Avida::Output::Manager::StartWriter()
+{
+  if (m_writer) return;
+  
+  m_writer = new Writer(this);
+  m_writer->Start();
+}
+
+
 bool Avida::Output::Manager::AttachTo(World* world)
 {
   if (m_world) return false;
@@ -194,3 +252,73 @@ void Avida::Output::Manager::UnregisterSocket(const OutputID& output_id)
   m_mutex.Unlock();
 }
 
+
+void Avida::Output::Manager::attachFile(File* file)
+{
+  Apto::MutexAutoLock lock(m_write_mutex);
+  m_files.insert(file);
+}
+
+void Avida::Output::Manager::detachFile(File* file)
+{
+  Apto::MutexAutoLock lock(m_write_mutex);
+  m_files.erase(file);
+}
+
+
+void Avida::Output::Manager::submitWrite(std::ofstream* fp, const std::string& data, bool close)
+{
+  WriteRequest* request = new WriteRequest(fp, data, close);
+  
+  m_write_mutex.Lock();
+  while (m_write_queue.GetSize() >= MAX_PENDING_WRITES) m_space_cond.Wait(m_write_mutex);
+  m_write_queue.PushRear(request);
+  m_stream_writes[fp]++;
+  m_write_mutex.Unlock();
+  m_write_cond.Signal();
+}
+
+void Avida::Output::Manager::waitForWrites(const std::ofstream* fp)
+{
+  m_write_mutex.Lock();
+  while (m_stream_writes.count(fp)) m_space_cond.Wait(m_write_mutex);
+  m_write_mutex.Unlock();
+}
+
+void Avida::Output::Manager::WaitForWrites()
+{
+  m_write_mutex.Lock();
+  while (m_write_queue.GetSize() || m_writing) m_space_cond.Wait(m_write_mutex);
+  m_write_mutex.Unlock();
+}
+
+void Avida::Output::Manager::runWriter()
+{
+  while (true) {
+    m_write_mutex.Lock();
+    while (m_write_queue.GetSize() == 0 && !m_closing) m_write_cond.Wait(m_write_mutex);
+    if (m_write_queue.GetSize() == 0) {
+      // Closing, and everything has been written
+      m_write_mutex.Unlock();
+      break;
+    }
+    WriteRequest* request = m_write_queue.Pop();
+    m_writing++;
+    m_write_mutex.Unlock();
+    
+    // Lines are flushed as they are written, matching std::endl in File::Endl()
+    if (request->data.size()) request->fp->write(request->data.data(), request->data.size());
+    request->fp->flush();
+    
+    // The stream is only deleted once its count is gone, so that no new stream can share its address before then
+    m_write_mutex.Lock();
+    m_writing--;
+    std::map<const std::ofstream*, int>::iterator it = m_stream_writes.find(request->fp);
+    if (--it->second == 0) m_stream_writes.erase(it);
+    m_write_mutex.Unlock();
+    m_space_cond.Broadcast();
+    
+    if (request->close) delete request->fp;
+    delete request;
+  }
+}
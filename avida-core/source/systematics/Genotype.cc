@@ -28,7 +28,9 @@
 #include "avida/output/File.h"
 
 #include "avida/private/systematics/GenotypeArbiter.h"
+#include "avida/private/systematics/HistoricGenotypeStore.h"
 
+#include "cCheckpoint.h"
 #include "cHardwareManager.h"
 #include "cStringList.h"
 #include "cStringUtil.h"
@@ -39,6 +41,11 @@ static const Apto::BasicString<Apto::ThreadSafe> s_unit_prop_name_last_executed_
 static const Apto::BasicString<Apto::ThreadSafe> s_unit_prop_name_last_gestation_time("last_gestation_time");
 static const Apto::BasicString<Apto::ThreadSafe> s_unit_prop_name_last_metabolic_rate("last_metabolic_rate");
 static const Apto::BasicString<Apto::ThreadSafe> s_unit_prop_name_last_fitness("last_fitness");
+static const PropertyAtom s_unit_prop_atom_last_copied_size = PropertyAtoms::Intern(s_unit_prop_name_last_copied_size);
+static const PropertyAtom s_unit_prop_atom_last_executed_size = PropertyAtoms::Intern(s_unit_prop_name_last_executed_size);
+static const PropertyAtom s_unit_prop_atom_last_gestation_time = PropertyAtoms::Intern(s_unit_prop_name_last_gestation_time);
+static const PropertyAtom s_unit_prop_atom_last_metabolic_rate = PropertyAtoms::Intern(s_unit_prop_name_last_metabolic_rate);
+static const PropertyAtom s_unit_prop_atom_last_fitness = PropertyAtoms::Intern(s_unit_prop_name_last_fitness);
 
 
 static Avida::PropertyDescriptionMap s_prop_desc_map;
@@ -131,6 +138,7 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, Un
   , m_handle(NULL)
   , m_src(founder->UnitSource())
   , m_genome(founder->UnitGenome())
+  , m_genome_hash(0)
   , m_name("001-no_name")
   , m_threshold(false)
   , m_active(true)
@@ -142,6 +150,9 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, Un
   , m_num_organisms(1)
   , m_last_num_organisms(0)
   , m_total_organisms(1)
+  , m_checkpoint_units(0)
+  , m_stats(new Stats)
+  , m_record(-1)
   , m_last_birth_cell(0)
   , m_last_group_id(-1)
   , m_last_forager_type(-1)
@@ -160,12 +171,12 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, Un
       if (i > 0) m_parent_str += ",";
       m_parent_str += Apto::AsStr(m_parents[i]->ID());
       
-//      m_copied_size.Add(p->Properties().Get(s_prop_name_ave_copy_size));
-//      m_exe_size.Add(p->Properties().Get(s_prop_name_ave_exe_size));
-//      m_gestation_time.Add(p->Properties().Get(s_prop_name_ave_gestation_time));
-//      m_repro_rate.Add(p->Properties().Get(s_prop_name_ave_repro_rate));
-//      m_merit.Add(p->Properties().Get(s_prop_name_ave_metabolic_rate));
-//      m_fitness.Add(p->Properties().Get(s_prop_name_ave_fitness));
+//      m_stats->copied_size.Add(p->Properties().Get(s_prop_name_ave_copy_size));
+//      m_stats->exe_size.Add(p->Properties().Get(s_prop_name_ave_exe_size));
+//      m_stats->gestation_time.Add(p->Properties().Get(s_prop_name_ave_gestation_time));
+//      m_stats->repro_rate.Add(p->Properties().Get(s_prop_name_ave_repro_rate));
+//      m_stats->merit.Add(p->Properties().Get(s_prop_name_ave_metabolic_rate));
+//      m_stats->fitness.Add(p->Properties().Get(s_prop_name_ave_fitness));
       
       // Collect all relevant action trigger counts
 //      for (int i = 0; i < m_mgr->EnvironmentActionTriggerAverageIDs().GetSize(); i++) {
@@ -174,7 +185,7 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, Un
     }
   }
   if (m_parents.GetSize()) m_depth = m_parents[0]->Depth() + 1;
-  if (!m_src.external) m_breed_in.Inc();
+  if (!m_src.external) m_stats->breed_in.Inc();
   
   InstructionSequencePtr seq;
   seq.DynamicCastFrom(m_genome.Representation());
@@ -187,6 +198,7 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
 : Group(in_id)
 , m_mgr(mgr)
 , m_handle(NULL)
+, m_genome_hash(0)
 , m_name("001-no_name")
 , m_threshold(false)
 , m_active(false)
@@ -197,6 +209,9 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
 , m_num_organisms(0)
 , m_last_num_organisms(0)
 , m_total_organisms(0)
+, m_checkpoint_units(0)
+, m_stats(new Stats)
+, m_record(-1)
 , m_last_birth_cell(0)
 , m_last_group_id(-1)
 , m_last_forager_type(-1)
@@ -253,6 +268,7 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
 
 Avida::Systematics::Genotype::~Genotype()
 {  
+  delete m_stats;
   delete m_prop_map;
 }
 
@@ -269,10 +285,10 @@ Avida::Systematics::ArbiterPtr Avida::Systematics::Genotype::Arbiter() const
 
 Avida::Systematics::GroupPtr Avida::Systematics::Genotype::ClassifyNewUnit(UnitPtr u, ConstGroupMembershipPtr parents)
 {
-  m_births.Inc();
+  m_stats->births.Inc();
   
   if (Matches(u)) {
-    m_breed_true.Inc();
+    m_stats->breed_true.Inc();
     m_total_organisms++;
     m_num_organisms++;
     
@@ -282,22 +298,22 @@ Avida::Systematics::GroupPtr Avida::Systematics::Genotype::ClassifyNewUnit(UnitP
     return g;
   }  
   
-  m_breed_out.Inc();
+  m_stats->breed_out.Inc();
   return m_mgr->ClassifyNewUnit(u, parents);
 }
 
 void Avida::Systematics::Genotype::HandleUnitGestation(UnitPtr u)
 {
-  m_gestation_count.Inc();
+  m_stats->gestation_count.Inc();
   
-  m_copied_size.Add(u->Properties().Get(s_unit_prop_name_last_copied_size));
-  m_exe_size.Add(u->Properties().Get(s_unit_prop_name_last_executed_size));
+  m_stats->copied_size.Add(u->Properties().Get(s_unit_prop_atom_last_copied_size));
+  m_stats->exe_size.Add(u->Properties().Get(s_unit_prop_atom_last_executed_size));
   
-  double last_gestation_time = u->Properties().Get(s_unit_prop_name_last_gestation_time);
-  m_gestation_time.Add(last_gestation_time);
-  m_repro_rate.Add(1.0 / last_gestation_time);
-  m_merit.Add(u->Properties().Get(s_unit_prop_name_last_metabolic_rate));
-  m_fitness.Add(u->Properties().Get(s_unit_prop_name_last_fitness));
+  double last_gestation_time = u->Properties().Get(s_unit_prop_atom_last_gestation_time);
+  m_stats->gestation_time.Add(last_gestation_time);
+  m_stats->repro_rate.Add(1.0 / last_gestation_time);
+  m_stats->merit.Add(u->Properties().Get(s_unit_prop_atom_last_metabolic_rate));
+  m_stats->fitness.Add(u->Properties().Get(s_unit_prop_atom_last_fitness));
 
   // Collect all relevant action trigger counts
 //  for (int i = 0; i < m_mgr->EnvironmentActionTriggerCountIDs().GetSize(); i++) {
@@ -308,7 +324,7 @@ void Avida::Systematics::Genotype::HandleUnitGestation(UnitPtr u)
 
 void Avida::Systematics::Genotype::RemoveUnit()
 {
-  m_deaths.Inc();
+  m_stats->deaths.Inc();
   
   // Remove active reference
   m_a_refs--;
@@ -321,10 +337,112 @@ void Avida::Systematics::Genotype::RemoveUnit()
 
 const Avida::PropertyMap& Avida::Systematics::Genotype::Properties() const
 {
+  if (!m_stats) restore();
   if (!m_prop_map) setupPropertyMap();
   return *m_prop_map;
 }
 
+Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, cCheckpointReader& cp)
+: Group(in_id)
+, m_mgr(mgr)
+, m_handle(NULL)
+, m_genome_hash(0)
+, m_checkpoint_units(0)
+, m_stats(new Stats)
+, m_record(-1)
+, m_task_counts(mgr->NumEnvironmentActionTriggers())
+, m_prop_map(NULL)
+{
+  m_src.transmission_type = static_cast<TransmissionType>(cp.Read<int>());
+  m_src.external = cp.Read<bool>();
+  cString str;
+  cp.ReadString(str);
+  m_src.arguments = (const char*)str;
+  cp.ReadString(str);
+  m_genome = Genome(Apto::String((const char*)str));
+  cp.ReadString(str);
+  m_name = (const char*)str;
+  
+  cp.Read(m_threshold);
+  cp.Read(m_active);
+  cp.Read(m_generation_born);
+  cp.Read(m_update_born);
+  cp.Read(m_update_deactivated);
+  cp.Read(m_depth);
+  cp.Read(m_active_offspring_genotypes);
+  cp.Read(m_num_organisms);
+  cp.Read(m_last_num_organisms);
+  cp.Read(m_total_organisms);
+  m_checkpoint_units = (m_active) ? m_num_organisms : 0;
+  cp.Read(*m_stats);
+  cp.Read(m_last_birth_cell);
+  cp.Read(m_last_group_id);
+  cp.Read(m_last_forager_type);
+  
+  const int num_parents = cp.Read<int>();
+  if (!cp.Good() || num_parents < 0) {
+    cp.Invalidate();
+    return;
+  }
+  m_parents.Resize(num_parents);
+  for (int i = 0; i < num_parents; i++) {
+    const int parent_id = cp.Read<int>();
+    GenotypePtr g;
+    g.DynamicCastFrom(m_mgr->Group(parent_id));
+    if (!g) {
+      cp.Invalidate();
+      m_parents.Resize(i);
+      return;
+    }
+    m_parents[i] = g;
+    m_parents[i]->AddPassiveReference();
+    if (i > 0) m_parent_str += ",";
+    m_parent_str += Apto::AsStr(parent_id);
+  }
+}
+
+void Avida::Systematics::Genotype::SaveCheckpoint(cCheckpointWriter& cp) const
+{
+  // Compacted genotypes are written straight from their historic store record, as in LegacySave
+  Stats stats;
+  Genome genome;
+  Apto::String name;
+  Apto::String src_args;
+  if (m_stats) {
+    stats = *m_stats;
+    genome = m_genome;
+    name = m_name;
+    src_args = m_src.arguments;
+  } else {
+    m_mgr->m_store->Get(m_record, stats, genome, name, src_args);
+  }
+  
+  cp.Write(static_cast<int>(m_src.transmission_type));
+  cp.Write(static_cast<bool>(m_src.external));
+  cp.WriteString((const char*)src_args);
+  cp.WriteString((const char*)genome.AsString());
+  cp.WriteString((const char*)name);
+  
+  cp.Write(m_threshold);
+  cp.Write(m_active);
+  cp.Write(m_generation_born);
+  cp.Write(m_update_born);
+  cp.Write(m_update_deactivated);
+  cp.Write(m_depth);
+  cp.Write(m_active_offspring_genotypes);
+  cp.Write(m_num_organisms);
+  cp.Write(m_last_num_organisms);
+  cp.Write(m_total_organisms);
+  cp.Write(stats);
+  cp.Write(m_last_birth_cell);
+  cp.Write(m_last_group_id);
+  cp.Write(m_last_forager_type);
+  
+  cp.Write(m_parents.GetSize());
+  for (int i = 0; i < m_parents.GetSize(); i++) cp.Write(m_parents[i]->ID());
+}
+
+
 int Avida::Systematics::Genotype::Depth() const
 {
   return m_depth;
@@ -342,13 +460,29 @@ bool Avida::Systematics::Genotype::Serialize(ArchivePtr) const
 }
 
 bool Avida::Systematics::Genotype::LegacySave(void* dfp) const
+{
+  if (!m_stats) {
+    // Save straight from the historic store record, without expanding the genotype
+    Stats stats;
+    Genome genome;
+    Apto::String name;
+    Apto::String src_args;
+    m_mgr->m_store->Get(m_record, stats, genome, name, src_args);
+    return legacySave(dfp, stats, genome, src_args);
+  }
+  
+  return legacySave(dfp, *m_stats, m_genome, m_src.arguments);
+}
+
+bool Avida::Systematics::Genotype::legacySave(void* dfp, const Stats& stats, const Genome& genome,
+                                              const Apto::String& src_args) const
 {
   Avida::Output::File& df = *static_cast<Avida::Output::File*>(dfp);
   df.Write(m_id, "ID", "id");
   
   df.Write(m_src.AsString(), "Source", "src");
   
-  df.Write(m_src.arguments.GetSize() ? (const char*)m_src.arguments : "(none)", "Source Args", "src_args");
+  df.Write(src_args.GetSize() ? (const char*)src_args : "(none)", "Source Args", "src_args");
   
   cString str("");
   if (m_parents.GetSize()) {
@@ -363,18 +497,18 @@ bool Avida::Systematics::Genotype::LegacySave(void* dfp) const
   df.Write(m_total_organisms, "Total number of organisms that ever existed", "total_units");
   
   ConstInstructionSequencePtr seq;
-  seq.DynamicCastFrom(m_genome.Representation());
+  seq.DynamicCastFrom(genome.Representation());
   df.Write(seq->GetSize(), "Genome Length", "length");
   
-  df.Write(m_merit.Average(), "Average Merit", "merit");
-  df.Write(m_gestation_time.Average(), "Average Gestation Time", "gest_time");
-  df.Write(m_fitness.Average(), "Average Fitness", "fitness");
+  df.Write(stats.merit.Average(), "Average Merit", "merit");
+  df.Write(stats.gestation_time.Average(), "Average Gestation Time", "gest_time");
+  df.Write(stats.fitness.Average(), "Average Fitness", "fitness");
   
   df.Write(m_generation_born, "Generation Born", "gen_born");
   df.Write(m_update_born, "Update Born", "update_born");
   df.Write(m_update_deactivated, "Update Deactivated", "update_deactivated");
   df.Write(m_depth, "Phylogenetic Depth", "depth");
-  m_genome.LegacySave(dfp);
+  genome.LegacySave(dfp);
   
   return false;
 }
@@ -451,7 +585,7 @@ void Avida::Systematics::Genotype::NotifyNewUnit(UnitPtr u)
       case DIVISION:
       case HORIZONTAL:
       case VERTICAL:
-        m_breed_in.Inc();
+        m_stats->breed_in.Inc();
         break;
         
       default:
@@ -469,12 +603,51 @@ void Avida::Systematics::Genotype::NotifyNewUnit(UnitPtr u)
 void Avida::Systematics::Genotype::UpdateReset()
 {
   m_last_num_organisms = m_num_organisms;
-  m_births.Next();
-  m_deaths.Next();
-  m_breed_out.Next();
-  m_breed_true.Next();
-  m_breed_in.Next();
-  m_gestation_count.Next();
+  m_stats->births.Next();
+  m_stats->deaths.Next();
+  m_stats->breed_out.Next();
+  m_stats->breed_true.Next();
+  m_stats->breed_in.Next();
+  m_stats->gestation_count.Next();
+}
+
+
+void Avida::Systematics::Genotype::Compact(HistoricGenotypeStore& store)
+{
+  if (!m_stats) return;
+  
+  // Records never change, so one kept from an earlier compaction is still current unless the genotype was reactivated
+  if (m_record < 0) {
+    const int base = (m_parents.GetSize()) ? m_parents[0]->m_record : -1;
+    m_record = store.Add(*m_stats, m_genome, m_name, m_src.arguments, base);
+  }
+  
+  delete m_prop_map;
+  m_prop_map = NULL;
+  delete m_stats;
+  m_stats = NULL;
+  
+  m_genome = Genome(m_genome.HardwareType(), m_genome.Properties(), GeneticRepresentationPtr(new InstructionSequence));
+  m_name = "";
+  m_src.arguments = "";
+  m_parent_str = "";
+  
+  // Task counts are not being collected (see HandleUnitGestation), so there is nothing to keep
+  m_task_counts.Resize(0);
+}
+
+void Avida::Systematics::Genotype::restore() const
+{
+  Genotype* nc_this = const_cast<Genotype*>(this);
+  
+  nc_this->m_stats = new Stats;
+  m_mgr->m_store->Get(m_record, *m_stats, nc_this->m_genome, nc_this->m_name, nc_this->m_src.arguments);
+  nc_this->m_task_counts.Resize(m_mgr->NumEnvironmentActionTriggers());
+  
+  for (int i = 0; i < m_parents.GetSize(); i++) {
+    if (i > 0) nc_this->m_parent_str += ",";
+    nc_this->m_parent_str += Apto::AsStr(m_parents[i]->ID());
+  }
 }
 
 
@@ -495,35 +668,35 @@ void Avida::Systematics::Genotype::setupPropertyMap() const
   ADD_REF_PROP(threshold, bool, m_threshold);
   ADD_REF_PROP(update_born, int, m_update_born);
   
-  ADD_FUN_PROP(ave_copy_size, double, GetFunctor(&m_copied_size, &cDoubleSum::Average));
-  ADD_FUN_PROP(ave_exe_size, double, GetFunctor(&m_exe_size, &cDoubleSum::Average));
-  ADD_FUN_PROP(ave_gestation_time, double, GetFunctor(&m_gestation_time, &cDoubleSum::Average));
-  ADD_FUN_PROP(ave_repro_rate, double, GetFunctor(&m_repro_rate, &cDoubleSum::Average));
-  ADD_FUN_PROP(ave_metabolic_rate, double, GetFunctor(&m_merit, &cDoubleSum::Average));
-  ADD_FUN_PROP(ave_fitness, double, GetFunctor(&m_fitness, &cDoubleSum::Average));
+  ADD_FUN_PROP(ave_copy_size, double, GetFunctor(&m_stats->copied_size, &cDoubleSum::Average));
+  ADD_FUN_PROP(ave_exe_size, double, GetFunctor(&m_stats->exe_size, &cDoubleSum::Average));
+  ADD_FUN_PROP(ave_gestation_time, double, GetFunctor(&m_stats->gestation_time, &cDoubleSum::Average));
+  ADD_FUN_PROP(ave_repro_rate, double, GetFunctor(&m_stats->repro_rate, &cDoubleSum::Average));
+  ADD_FUN_PROP(ave_metabolic_rate, double, GetFunctor(&m_stats->merit, &cDoubleSum::Average));
+  ADD_FUN_PROP(ave_fitness, double, GetFunctor(&m_stats->fitness, &cDoubleSum::Average));
 
-  ADD_FUN_PROP(max_fitness, double, GetFunctor(&m_fitness, &cDoubleSum::Max));
+  ADD_FUN_PROP(max_fitness, double, GetFunctor(&m_stats->fitness, &cDoubleSum::Max));
   
-  ADD_REF_PROP(recent_births, int, m_births.GetCur());
-  ADD_REF_PROP(recent_deaths, int, m_deaths.GetCur());
-  ADD_REF_PROP(recent_breed_true, int, m_breed_true.GetCur());
-  ADD_REF_PROP(recent_breed_in, int, m_breed_in.GetCur());
-  ADD_REF_PROP(recent_breed_out, int, m_breed_out.GetCur());
-  ADD_REF_PROP(recent_gestation_count, int, m_gestation_count.GetCur());
+  ADD_REF_PROP(recent_births, int, m_stats->births.GetCur());
+  ADD_REF_PROP(recent_deaths, int, m_stats->deaths.GetCur());
+  ADD_REF_PROP(recent_breed_true, int, m_stats->breed_true.GetCur());
+  ADD_REF_PROP(recent_breed_in, int, m_stats->breed_in.GetCur());
+  ADD_REF_PROP(recent_breed_out, int, m_stats->breed_out.GetCur());
+  ADD_REF_PROP(recent_gestation_count, int, m_stats->gestation_count.GetCur());
   
   ADD_REF_PROP(total_organisms, int, m_total_organisms);
-  ADD_REF_PROP(last_births, int, m_births.GetLast());
-  ADD_REF_PROP(last_deaths, int, m_deaths.GetLast());
-  ADD_REF_PROP(last_breed_true, int, m_breed_true.GetLast());
-  ADD_REF_PROP(last_breed_in, int, m_breed_in.GetLast());
-  ADD_REF_PROP(last_breed_out, int, m_breed_out.GetLast());
-  ADD_REF_PROP(last_gestation_count, int, m_gestation_count.GetLast());
+  ADD_REF_PROP(last_births, int, m_stats->births.GetLast());
+  ADD_REF_PROP(last_deaths, int, m_stats->deaths.GetLast());
+  ADD_REF_PROP(last_breed_true, int, m_stats->breed_true.GetLast());
+  ADD_REF_PROP(last_breed_in, int, m_stats->breed_in.GetLast());
+  ADD_REF_PROP(last_breed_out, int, m_stats->breed_out.GetLast());
+  ADD_REF_PROP(last_gestation_count, int, m_stats->gestation_count.GetLast());
   
   ADD_REF_PROP(last_birth_cell, int, m_last_birth_cell);
   ADD_REF_PROP(last_group_id, int, m_last_group_id);
   ADD_REF_PROP(last_forager_type, int, m_last_forager_type);
 
-  ADD_REF_PROP(total_gestation_count, int, m_gestation_count.GetTotal());
+  ADD_REF_PROP(total_gestation_count, int, m_stats->gestation_count.GetTotal());
 
   // Collect all relevant action trigger counts
   for (int i = 0; i < m_mgr->EnvironmentActionTriggerAverageIDs().GetSize(); i++) {
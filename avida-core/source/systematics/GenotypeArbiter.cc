@@ -23,23 +23,29 @@
 
 #include "avida/private/systematics/GenotypeArbiter.h"
 
+#include "avida/core/Context.h"
 #include "avida/core/InstructionSequence.h"
 #include "avida/data/Manager.h"
 #include "avida/data/Package.h"
 #include "avida/environment/Manager.h"
 #include "avida/output/File.h"
+#include "avida/output/Manager.h"
 
 #include "avida/private/systematics/Genotype.h"
+#include "avida/private/systematics/HistoricGenotypeStore.h"
 
+#include "cCheckpoint.h"
 #include "cDoubleSum.h"
 
 #include <cmath>
 
 
-Avida::Systematics::GenotypeArbiter::GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class)
+Avida::Systematics::GenotypeArbiter::GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class,
+                                                     int historic_store)
   : Arbiter(role)
   , m_threshold(threshold)
   , m_disable_class(disable_class)
+  , m_store(NULL)
   , m_active_sz(1)
   , m_coalescent(NULL)
   , m_best(0)
@@ -60,6 +66,12 @@ Avida::Systematics::GenotypeArbiter::GenotypeArbiter(World* world, const RoleID&
     m_env_action_count[idx] = Apto::FormatStr("environment.triggers.%s.count", (const char*)*it.Get());
   }
   setupProvidedData(world);
+  
+  if (historic_store == HISTORIC_STORE_MEMORY) {
+    m_store = new HistoricGenotypeStore("");
+  } else if (historic_store == HISTORIC_STORE_SPILL) {
+    m_store = new HistoricGenotypeStore(HistoricGenotypeStore::UniqueSpillPath(Output::Manager::Of(world)->OutputPath()));
+  }
 }
 
 Avida::Systematics::GenotypeArbiter::~GenotypeArbiter()
@@ -73,6 +85,8 @@ Avida::Systematics::GenotypeArbiter::~GenotypeArbiter()
   
   assert(m_historic.GetSize() == 0);
   assert(m_best == 0);
+  
+  delete m_store;
 }
 
 
@@ -82,24 +96,31 @@ Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::ClassifyNewUni
 }
 
 
-void Avida::Systematics::GenotypeArbiter::PerformUpdate(Context&, Update current_update)
+void Avida::Systematics::GenotypeArbiter::PerformUpdate(Context& ctx, Update current_update)
 {
+  // Records are only added here and read back after, so the store can report spill file errors to the driver
+  if (m_store) m_store->SetDriver(&ctx.Driver());
+
   m_cur_update = current_update + 1; // +1 since PerformUpdate happens at end of updates, but m_cur_update is used during
   
-  if (m_active_sz.GetSize() < HASH_SIZE) {
+  if (m_active_sz.GetSize() < m_active_hash.GetCapacity()) {
     for (int i = 0; i < m_active_sz.GetSize(); i++) {
       Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
       while (list_it.Next() != NULL) if ((*list_it.Get())->IsThreshold()) (*list_it.Get())->UpdateReset();
     }
   } else {
-    for (int i = 0; i < HASH_SIZE; i++) {
-      Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_hash[i].Begin());
-      while (list_it.Next() != NULL) if ((*list_it.Get())->IsThreshold()) (*list_it.Get())->UpdateReset();
+    for (int i = 0; i < m_active_hash.GetCapacity(); i++) {
+      GenotypePtr genotype = m_active_hash.GetSlot(i);
+      if (genotype && genotype->IsThreshold()) genotype->UpdateReset();
     }    
   }
 
+  // Historic genotypes are only compacted between updates, so property references taken during one stay valid
   Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
-  while (list_it.Next() != NULL) if (!(*list_it.Get())->ReferenceCount()) removeGenotype(*list_it.Get());
+  while (list_it.Next() != NULL) {
+    if (!(*list_it.Get())->ReferenceCount()) removeGenotype(*list_it.Get());
+    else if (m_store) (*list_it.Get())->Compact(*m_store);
+  }
 }
 
 void Avida::Systematics::GenotypeArbiter::PrintListStatus()
@@ -115,8 +136,7 @@ void Avida::Systematics::GenotypeArbiter::PrintListStatus()
 
 bool Avida::Systematics::GenotypeArbiter::Serialize(ArchivePtr) const
 {
-  // @TOOD - serialize genotype arbiter
-  assert(false);
+  // @TODO - serialize genotype arbiter; there is no archive format yet, world checkpoints use SaveCheckpoint
   return false;
 }
 
@@ -134,22 +154,119 @@ Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::LegacyLoad(voi
 {
   GenotypePtr g(new Genotype(thisPtr(), m_next_id++, props));
   m_historic.Push(g, &g->m_handle);
+  m_id_index.Insert(g->ID(), g);
   return g;
 }
 
 
 
-Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::Group(GroupID g_id)
+void Avida::Systematics::GenotypeArbiter::SaveCheckpoint(cCheckpointWriter& cp) const
 {
-  for (int i = m_best; i >= 0; i--) {
-    Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
-    while (list_it.Next() != NULL) if ((*list_it.Get())->ID() == g_id) return *list_it.Get();
+  cp.Write(m_next_id);
+  cp.Write(m_best);
+  cp.Write(m_dom_prev);
+  cp.Write(m_dom_time);
+  cp.Write(m_cur_update);
+  cp.Write(m_tot_genotypes);
+  cp.Write(m_num_threshold);
+  cp.Write(m_tot_threshold);
+  
+  // Genotypes are numbered as they are created, after their parents, so in ID order parents are loaded first
+  cp.Write(m_id_index.GetSize());
+  for (int g_id = 1; g_id < m_next_id; g_id++) {
+    const int slot = m_id_index.FirstSlot(g_id);
+    if (slot < 0) continue;
+    cp.Write(g_id);
+    m_id_index.GetSlot(slot)->SaveCheckpoint(cp);
   }
   
-  Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
-  while (list_it.Next() != NULL) if ((*list_it.Get())->ID() == g_id) return *list_it.Get();
+  // List order decides the best genotype and the order of compaction and legacy output
+  cp.Write(m_active_sz.GetSize());
+  for (int i = 0; i < m_active_sz.GetSize(); i++) {
+    cp.Write(m_active_sz[i].GetSize());
+    Apto::List<GenotypePtr, Apto::SparseVector>::ConstIterator list_it(m_active_sz[i].Begin());
+    while (list_it.Next() != NULL) cp.Write((*list_it.Get())->ID());
+  }
+  cp.Write(m_historic.GetSize());
+  Apto::List<GenotypePtr, Apto::SparseVector>::ConstIterator list_it(m_historic.Begin());
+  while (list_it.Next() != NULL) cp.Write((*list_it.Get())->ID());
+  
+  cp.Write(m_coalescent ? m_coalescent->ID() : -1);
+  cp.Write(m_coalescent_depth);
+}
+
+bool Avida::Systematics::GenotypeArbiter::LoadCheckpoint(cCheckpointReader& cp)
+{
+  if (m_active_hash.GetSize()) return false;
+  clearGenotypes();
+  
+  cp.Read(m_next_id);
+  cp.Read(m_best);
+  cp.Read(m_dom_prev);
+  cp.Read(m_dom_time);
+  cp.Read(m_cur_update);
+  cp.Read(m_tot_genotypes);
+  cp.Read(m_num_threshold);
+  cp.Read(m_tot_threshold);
+  
+  const int num_genotypes = cp.Read<int>();
+  if (!cp.Good() || num_genotypes < 0) return false;
+  for (int i = 0; i < num_genotypes; i++) {
+    const int g_id = cp.Read<int>();
+    if (!cp.Good() || g_id <= 0 || g_id >= m_next_id || m_id_index.FirstSlot(g_id) >= 0) return false;
+    
+    GenotypePtr genotype(new Genotype(thisPtr(), g_id, cp));
+    if (!cp.Good()) return false;
+    m_id_index.Insert(g_id, genotype);
+    
+    if (genotype->IsActive()) {
+      ConstInstructionSequencePtr seq;
+      seq.DynamicCastFrom(genotype->GroupGenome().Representation());
+      if (!seq) return false;
+      genotype->m_genome_hash = hashGenome(*seq);
+      m_active_hash.Insert(genotype->m_genome_hash, genotype);
+    }
+  }
+  
+  const int num_sizes = cp.Read<int>();
+  if (!cp.Good() || num_sizes < 0) return false;
+  if (num_sizes) resizeActiveList(num_sizes - 1);
+  for (int i = 0; i <= num_sizes; i++) {
+    const bool historic = (i == num_sizes);
+    const int list_size = cp.Read<int>();
+    if (!cp.Good() || list_size < 0) return false;
+    for (int j = 0; j < list_size; j++) {
+      const int slot = m_id_index.FirstSlot(cp.Read<int>());
+      if (!cp.Good() || slot < 0) return false;
+      GenotypePtr genotype = m_id_index.GetSlot(slot);
+      if (genotype->m_handle || genotype->IsActive() == historic) return false;
+      if (historic) m_historic.PushRear(genotype, &genotype->m_handle);
+      else m_active_sz[i].PushRear(genotype, &genotype->m_handle);
+    }
+  }
+  if (m_active_hash.GetSize() + m_historic.GetSize() != m_id_index.GetSize()) return false;
+  
+  const int coalescent_id = cp.Read<int>();
+  cp.Read(m_coalescent_depth);
+  if (coalescent_id >= 0) {
+    const int slot = m_id_index.FirstSlot(coalescent_id);
+    if (slot < 0) return false;
+    m_coalescent = m_id_index.GetSlot(slot);
+  }
+  if (!cp.Good()) return false;
   
-  return GroupPtr(NULL);
+  for (int i = 0; i < m_active_sz.GetSize(); i++) {
+    Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
+    while (list_it.Next() != NULL) if ((*list_it.Get())->IsThreshold()) notifyListeners(*list_it.Get(), EVENT_ADD_THRESHOLD);
+  }
+  return true;
+}
+
+
+Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::Group(GroupID g_id)
+{
+  int slot = m_id_index.FirstSlot(g_id);
+  return (slot >= 0) ? (GroupPtr)m_id_index.GetSlot(slot) : GroupPtr(NULL);
 }
 
 
@@ -283,7 +400,6 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
   ConstInstructionSequencePtr seq;
   seq.DynamicCastFrom(u->UnitGenome().Representation());
   assert(seq);
-  int list_num = hashGenome(*seq);
   
   GenotypePtr found;
 
@@ -291,52 +407,46 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
   if (hints && hints->Get("id", gid_str)) {
     int gid = Apto::StrAs(gid_str);
     
-    // Search all lists attempting to locate the referenced genotype by ID
-    for (int i = 0; i < m_active_sz.GetSize() && !found; i++) {
-      Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
-      while (list_it.Next() != NULL) {
-        if ((*list_it.Get())->ID() == gid) {
-          found = *list_it.Get();
-          found->NotifyNewUnit(u);
-          break;
-        }
-      }
-    }
-    
-    if (!found) {
-      Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
-      while (list_it.Next() != NULL) {
-        if ((*list_it.Get())->ID() == gid) {
-          found = *list_it.Get();
-          seq.DynamicCastFrom(found->GroupGenome().Representation());
-          assert(seq);
-          
-          m_active_hash[hashGenome(*seq)].Push(found);
-          found->m_handle->Remove(); // Remove from historic list
-          resizeActiveList(found->NumUnits());
-          m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
-          found->Reactivate();
-          found->NotifyNewUnit(u);
-          m_tot_genotypes++;
-          if (found->NumUnits() > m_best) {
-            m_best = found->NumUnits();
-            found->SetThreshold();
-            found->SetName(nameGenotype(seq->GetSize()));
-            m_num_threshold++;
-            m_tot_threshold++;
-            notifyListeners(found, EVENT_ADD_THRESHOLD);
-          }          
-        }
+    // Locate the referenced genotype by ID, reactivating it if it is historic
+    int slot = m_id_index.FirstSlot(gid);
+    if (slot >= 0) {
+      found = m_id_index.GetSlot(slot);
+      if (found->HasCheckpointUnits()) {
+        found->NotifyCheckpointUnit();
+      } else if (found->IsActive()) {
+        found->NotifyNewUnit(u);
+      } else {
+        seq.DynamicCastFrom(found->GroupGenome().Representation());
+        assert(seq);
+        
+        if (!found->m_genome_hash) found->m_genome_hash = hashGenome(*seq);
+        m_active_hash.Insert(found->m_genome_hash, found);
+        found->m_handle->Remove(); // Remove from historic list
+        resizeActiveList(found->NumUnits());
+        m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
+        found->Reactivate();
+        found->NotifyNewUnit(u);
+        m_tot_genotypes++;
+        if (found->NumUnits() > m_best) {
+          m_best = found->NumUnits();
+          found->SetThreshold();
+          found->SetName(nameGenotype(seq->GetSize()));
+          m_num_threshold++;
+          m_tot_threshold++;
+          notifyListeners(found, EVENT_ADD_THRESHOLD);
+        }          
       }
     }
   } 
   
   // No hints or unable to locate hinted genome, search for a matching genotype
+  unsigned long long genome_hash = 0;
   if (!found) {
-    Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_hash[list_num].Begin());
-    while (list_it.Next() != NULL) {
-      if ((*list_it.Get())->Matches(u)) {
-        found = *list_it.Get();
+    genome_hash = hashGenome(*seq);
+    for (int slot = m_active_hash.FirstSlot(genome_hash); slot >= 0; slot = m_active_hash.NextSlot(genome_hash, slot)) {
+      GenotypePtr genotype = m_active_hash.GetSlot(slot);
+      if (genotype->Matches(u)) {
+        found = genotype;
         found->NotifyNewUnit(u);
         break;
       }
@@ -350,7 +460,9 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
     } else {
       found = GenotypePtr(new Genotype(thisPtr(), m_next_id++, u, m_cur_update, ConstGroupMembershipPtr(NULL)));
     }
-    m_active_hash[list_num].Push(found);
+    found->m_genome_hash = genome_hash;
+    m_active_hash.Insert(genome_hash, found);
+    m_id_index.Insert(found->ID(), found);
     resizeActiveList(found->NumUnits());
     m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
     m_tot_genotypes++;
@@ -468,15 +580,19 @@ void Avida::Systematics::GenotypeArbiter::setupProvidedData(World* world)
 
 
 
-unsigned int Avida::Systematics::GenotypeArbiter::hashGenome(const InstructionSequence& genome) const
+// FNV-1a over the instruction ops and the sequence length, so that reordered or shifted sequences hash differently.
+// Zero is reserved to mean 'not yet computed' on the genotype.
+unsigned long long Avida::Systematics::GenotypeArbiter::hashGenome(const InstructionSequence& genome)
 {
-  unsigned int total = 0;
+  const unsigned long long FNV_PRIME = 1099511628211ULL;
+  unsigned long long hash = 14695981039346656037ULL;
   
   for (int i = 0; i < genome.GetSize(); i++) {
-    total += (genome[i].GetOp() + 3) * i;
+    hash = (hash ^ (unsigned long long)genome[i].GetOp()) * FNV_PRIME;
   }
+  hash = (hash ^ (unsigned long long)genome.GetSize()) * FNV_PRIME;
   
-  return total % HASH_SIZE;
+  return (hash) ? hash : 1;
 }
 
 Apto::String Avida::Systematics::GenotypeArbiter::nameGenotype(int size)
@@ -500,10 +616,7 @@ void Avida::Systematics::GenotypeArbiter::removeGenotype(GenotypePtr genotype)
   if (genotype->ActiveReferenceCount()) return;    
   
   if (genotype->IsActive()) {
-    ConstInstructionSequencePtr seq;
-    seq.DynamicCastFrom(genotype->GroupGenome().Representation());
-    int list_num = hashGenome(*seq);
-    m_active_hash[list_num].Remove(genotype);
+    m_active_hash.Remove(genotype->m_genome_hash, genotype);
     genotype->Deactivate(m_cur_update);
     m_historic.Push(genotype, &genotype->m_handle);
   }
@@ -527,11 +640,30 @@ void Avida::Systematics::GenotypeArbiter::removeGenotype(GenotypePtr genotype)
   
   assert(genotype->m_handle);
   genotype->m_handle->Remove(); // Remove from historic list
+  m_id_index.Remove(genotype->ID(), genotype);
   
   delete genotype->m_handle;
   genotype->m_handle = NULL;
 }
 
+void Avida::Systematics::GenotypeArbiter::clearGenotypes()
+{
+  // Only historic genotypes remain when there are no units; their parents go with them
+  assert(m_active_hash.GetSize() == 0);
+  Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
+  while (list_it.Next() != NULL) {
+    GenotypePtr genotype = *list_it.Get();
+    genotype->m_handle->Remove();
+    delete genotype->m_handle;
+    genotype->m_handle = NULL;
+    m_id_index.Remove(genotype->ID(), genotype);
+  }
+  
+  m_coalescent = GenotypePtr(NULL);
+  m_coalescent_depth = -1;
+  m_best = 0;
+}
+
 void Avida::Systematics::GenotypeArbiter::updateCoalescent()
 {
   if (m_coalescent && (m_coalescent->ActiveReferenceCount() > 0 || m_coalescent->PassiveReferenceCount() > 1)) return;
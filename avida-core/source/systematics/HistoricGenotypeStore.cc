@@ -0,0 +1,284 @@
+/*
+ *  private/systematics/HistoricGenotypeStore.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/private/systematics/HistoricGenotypeStore.h"
+
+#include "avida/core/Feedback.h"
+#include "avida/core/Properties.h"
+
+#include "apto/platform.h"
+
+#include "cHardwareManager.h"
+#include "cString.h"
+
+#include <cerrno>
+#include <cstring>
+
+#if APTO_PLATFORM(WINDOWS)
+# include <process.h>
+#else
+# include <sys/types.h>
+# include <unistd.h>
+#endif
+
+
+static const Avida::PropertyID s_prop_id_instset("instset");
+static const Avida::PropertyAtom s_prop_atom_instset = Avida::PropertyAtoms::Intern(s_prop_id_instset);
+
+
+Avida::Systematics::HistoricGenotypeStore::HistoricGenotypeStore(const Apto::String& spill_path)
+  : m_offsets(1024)
+  , m_num_records(0)
+  , m_size(0)
+  , m_spill_path(spill_path)
+  , m_fp(NULL)
+  , m_driver(NULL)
+{
+  if (m_spill_path.GetSize()) m_fp = fopen(m_spill_path, "w+b");
+}
+
+Avida::Systematics::HistoricGenotypeStore::~HistoricGenotypeStore()
+{
+  if (m_fp) {
+    fclose(m_fp);
+    remove(m_spill_path);
+  }
+  for (int i = 0; i < m_chunks.GetSize(); i++) delete [] m_chunks[i];
+}
+
+
+Apto::String Avida::Systematics::HistoricGenotypeStore::UniqueSpillPath(const Apto::String& dir)
+{
+  static int s_num_stores = 0;
+#if APTO_PLATFORM(WINDOWS)
+  const int pid = _getpid();
+#else
+  const int pid = static_cast<int>(getpid());
+#endif
+  return dir + Apto::FormatStr("historic_genotypes.%d-%d.tmp", pid, s_num_stores++);
+}
+
+
+void Avida::Systematics::HistoricGenotypeStore::SetDriver(WorldDriver* driver)
+{
+  if (m_driver == driver) return;
+  m_driver = driver;
+  if (m_driver && m_spill_path.GetSize() && !m_fp) {
+    m_driver->Feedback().Warning("unable to create historic genotype spill file '%s', keeping records in memory",
+                                 (const char*)m_spill_path);
+    m_spill_path = "";
+  }
+}
+
+
+int Avida::Systematics::HistoricGenotypeStore::Add(const Genotype::Stats& stats, const Genome& genome,
+                                                   const Apto::String& name, const Apto::String& src_args, int base)
+{
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(genome.Representation());
+  assert(seq);
+
+  Apto::String inst_set(genome.Properties().Get(s_prop_atom_instset).StringValue());
+
+  Record rec;
+  rec.hw_type = genome.HardwareType();
+  rec.length = seq->GetSize();
+  rec.base = -1;
+  rec.chain = 0;
+  rec.prefix = 0;
+  rec.suffix = 0;
+  rec.name_size = name.GetSize();
+  rec.src_args_size = src_args.GetSize();
+  rec.inst_set_size = inst_set.GetSize();
+  rec.stats = stats;
+
+  if (base >= 0) {
+    const int chain = GetChainLength(base);
+    if (chain < MAX_DELTA_CHAIN) {
+      InstructionSequence base_seq;
+      GetSequence(base, base_seq);
+
+      const int shared = (rec.length < base_seq.GetSize()) ? rec.length : base_seq.GetSize();
+      while (rec.prefix < shared && (*seq)[rec.prefix] == base_seq[rec.prefix]) rec.prefix++;
+      while (rec.suffix < shared - rec.prefix &&
+             (*seq)[rec.length - rec.suffix - 1] == base_seq[base_seq.GetSize() - rec.suffix - 1]) rec.suffix++;
+
+      // Only worth a link in the chain if something is shared
+      if (rec.prefix || rec.suffix) {
+        rec.base = base;
+        rec.chain = chain + 1;
+      }
+    }
+  }
+
+  const int literal = rec.length - rec.prefix - rec.suffix;
+  const int size = sizeof(Record) + rec.name_size + rec.src_args_size + rec.inst_set_size + literal;
+
+  Apto::Array<char> bytes(size);
+  char* pos = &bytes[0];
+  memcpy(pos, &rec, sizeof(Record));
+  pos += sizeof(Record);
+  memcpy(pos, (const char*)name, rec.name_size);
+  pos += rec.name_size;
+  memcpy(pos, (const char*)src_args, rec.src_args_size);
+  pos += rec.src_args_size;
+  memcpy(pos, (const char*)inst_set, rec.inst_set_size);
+  pos += rec.inst_set_size;
+  for (int i = 0; i < literal; i++) pos[i] = static_cast<char>((*seq)[rec.prefix + i].GetOp());
+
+  if (m_num_records == m_offsets.GetSize()) m_offsets.Resize(m_num_records * 2);
+  m_offsets[m_num_records] = m_size;
+  write(&bytes[0], size);
+
+  return m_num_records++;
+}
+
+
+void Avida::Systematics::HistoricGenotypeStore::Get(int record, Genotype::Stats& stats, Genome& genome,
+                                                    Apto::String& name, Apto::String& src_args) const
+{
+  const char* bytes = read(record);
+  Record rec;
+  memcpy(&rec, bytes, sizeof(Record));
+  bytes += sizeof(Record);
+
+  stats = rec.stats;
+  name = (const char*)cString(bytes, rec.name_size);
+  bytes += rec.name_size;
+  src_args = (const char*)cString(bytes, rec.src_args_size);
+  bytes += rec.src_args_size;
+  Apto::String inst_set((const char*)cString(bytes, rec.inst_set_size));
+
+  InstructionSequence* seq = new InstructionSequence;
+  GeneticRepresentationPtr rep(seq);
+  GetSequence(record, *seq);
+
+  HashPropertyMap prop_map;
+  cHardwareManager::SetupPropertyMap(prop_map, inst_set);
+  genome = Genome(rec.hw_type, prop_map, rep);
+}
+
+
+void Avida::Systematics::HistoricGenotypeStore::GetSequence(int record, InstructionSequence& seq) const
+{
+  const char* bytes = read(record);
+  Record rec;
+  memcpy(&rec, bytes, sizeof(Record));
+  bytes += sizeof(Record) + rec.name_size + rec.src_args_size + rec.inst_set_size;
+
+  // Decoding the base may reuse the read buffer, so take the literal ops first
+  const int literal = rec.length - rec.prefix - rec.suffix;
+  Apto::Array<char> ops(literal);
+  if (literal) memcpy(&ops[0], bytes, literal);
+
+  InstructionSequence base_seq;
+  if (rec.base >= 0) GetSequence(rec.base, base_seq);
+
+  if (rec.length) seq.Resize(rec.length);
+  for (int i = 0; i < rec.prefix; i++) seq[i] = base_seq[i];
+  for (int i = 0; i < literal; i++) seq[rec.prefix + i].SetOp(static_cast<unsigned char>(ops[i]));
+  for (int i = 1; i <= rec.suffix; i++) seq[rec.length - i] = base_seq[base_seq.GetSize() - i];
+}
+
+
+int Avida::Systematics::HistoricGenotypeStore::GetChainLength(int record) const
+{
+  Record rec;
+  memcpy(&rec, read(record), sizeof(Record));
+  return rec.chain;
+}
+
+
+const char* Avida::Systematics::HistoricGenotypeStore::read(int record) const
+{
+  assert(record >= 0 && record < m_num_records);
+
+  const size_t offset = m_offsets[record];
+  const size_t end = (record + 1 < m_num_records) ? m_offsets[record + 1] : m_size;
+  const int size = static_cast<int>(end - offset);
+
+  if (!m_fp) {
+    // Records that fit within their chunk are read in place, others are gathered into the buffer
+    const size_t chunk_offset = offset % CHUNK_SIZE;
+    if (chunk_offset + size <= CHUNK_SIZE) return m_chunks[static_cast<int>(offset / CHUNK_SIZE)] + chunk_offset;
+
+    if (m_buffer.GetSize() < size) m_buffer.Resize(size);
+    size_t pos = offset;
+    for (int copied = 0; copied < size;) {
+      const size_t in_chunk = pos % CHUNK_SIZE;
+      int count = static_cast<int>(CHUNK_SIZE - in_chunk);
+      if (count > size - copied) count = size - copied;
+      memcpy(&m_buffer[copied], m_chunks[static_cast<int>(pos / CHUNK_SIZE)] + in_chunk, count);
+      copied += count;
+      pos += count;
+    }
+    return &m_buffer[0];
+  }
+
+  if (m_buffer.GetSize() < size) m_buffer.Resize(size);
+  if (!seek(offset)) {
+    ioError("seek in");
+    memset(&m_buffer[0], 0, size);
+  } else if (fread(&m_buffer[0], 1, size, m_fp) != static_cast<size_t>(size)) {
+    ioError("read from");
+    memset(&m_buffer[0], 0, size);
+  }
+  return &m_buffer[0];
+}
+
+void Avida::Systematics::HistoricGenotypeStore::write(const char* bytes, int size)
+{
+  if (m_fp) {
+    if (!seek(m_size)) ioError("seek in");
+    else if (fwrite(bytes, 1, size, m_fp) != static_cast<size_t>(size)) ioError("write to");
+  } else {
+    for (int copied = 0; copied < size;) {
+      const size_t pos = m_size + copied;
+      const size_t in_chunk = pos % CHUNK_SIZE;
+      if (in_chunk == 0 && static_cast<int>(pos / CHUNK_SIZE) == m_chunks.GetSize()) m_chunks.Push(new char[CHUNK_SIZE]);
+      int count = static_cast<int>(CHUNK_SIZE - in_chunk);
+      if (count > size - copied) count = size - copied;
+      memcpy(m_chunks[static_cast<int>(pos / CHUNK_SIZE)] + in_chunk, bytes + copied, count);
+      copied += count;
+    }
+  }
+  m_size += size;
+}
+
+
+bool Avida::Systematics::HistoricGenotypeStore::seek(size_t offset) const
+{
+  // Spill files may outgrow the range of long, which is all that fseek takes on some platforms
+#if APTO_PLATFORM(WINDOWS)
+  return _fseeki64(m_fp, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+  return fseeko(m_fp, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+void Avida::Systematics::HistoricGenotypeStore::ioError(const char* operation) const
+{
+  const int err = errno;
+  assert(m_driver);
+  if (!m_driver) return;
+  m_driver->Feedback().Error("unable to %s historic genotype spill file '%s': %s", operation, (const char*)m_spill_path,
+                             strerror(err));
+  m_driver->Abort(IO_ERROR);
+}
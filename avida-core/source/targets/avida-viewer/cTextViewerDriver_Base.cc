@@ -86,7 +86,7 @@ void cTextViewerDriver_Base::StdIOFeedback::Error(const char* fmt, ...)
   printf("error: ");
   va_list args;
   va_start(args, fmt);
-  printf(fmt, args);
+  vprintf(fmt, args);
   va_end(args);
   printf("\n");
 }
@@ -96,7 +96,7 @@ void cTextViewerDriver_Base::StdIOFeedback::Warning(const char* fmt, ...)
   printf("warning: ");
   va_list args;
   va_start(args, fmt);
-  printf(fmt, args);
+  vprintf(fmt, args);
   va_end(args);
   printf("\n");
 }
@@ -105,7 +105,7 @@ void cTextViewerDriver_Base::StdIOFeedback::Notify(const char* fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
-  printf(fmt, args);
+  vprintf(fmt, args);
   va_end(args);
   printf("\n");
 }
@@ -26,6 +26,7 @@
 
 #include "avida/core/Context.h"
 #include "avida/core/World.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Group.h"
 
 #include "cAnalyze.h"
@@ -33,8 +34,10 @@
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cOrganism.h"
+#include "cPhaseProfiler.h"
 #include "cPopulation.h"
 #include "cPopulationCell.h"
+#include "cPopulationTileEngine.h"
 #include "cStats.h"
 #include "cWorld.h"
 
@@ -85,21 +88,49 @@ void Avida2Driver::Run()
     ActiveProcessStep = &cPopulation::ProcessStepSpeculative;
   }
   
+  // Parallel pre-execution builds on speculative execution, so it is only available when the latter is active
+  // Instruction profiles are recorded without locking, so organisms may not be pre-executed on other threads
+  // Implicit reproduction divides from the tail of SingleProcess, which would give birth from a worker thread
+  cPopulationTileEngine* tile_engine = NULL;
+  if (ActiveProcessStep == &cPopulation::ProcessStepSpeculative && m_world->GetConfig().PARALLEL_UPDATE_THREADS.Get() != 0) {
+    const bool implicit_repro = m_world->GetConfig().IMPLICIT_REPRO_BONUS.Get() ||
+                                m_world->GetConfig().IMPLICIT_REPRO_CPU_CYCLES.Get() ||
+                                m_world->GetConfig().IMPLICIT_REPRO_TIME.Get() ||
+                                m_world->GetConfig().IMPLICIT_REPRO_END.Get() ||
+                                m_world->GetConfig().IMPLICIT_REPRO_ENERGY.Get() != 0.0;
+    if (m_world->GetConfig().PROFILE_INSTRUCTIONS.Get()) {
+      Feedback().Warning("PROFILE_INSTRUCTIONS is set, ignoring PARALLEL_UPDATE_THREADS (organisms run on one thread)");
+    } else if (implicit_repro) {
+      Feedback().Warning("IMPLICIT_REPRO_* is set, ignoring PARALLEL_UPDATE_THREADS (organisms run on one thread)");
+    } else {
+      tile_engine = new cPopulationTileEngine(m_world, m_world->GetConfig().PARALLEL_UPDATE_THREADS.Get());
+      population.SetTileEngine(tile_engine);
+    }
+  }
+  
   cAvidaContext& ctx = m_world->GetDefaultContext();
   Avida::Context new_ctx(this, &m_world->GetRandom());
+  cPhaseProfiler& profiler = m_world->GetPhaseProfiler();
   
   while (!m_done) {
-    m_world->GetEvents(ctx);
+    {
+      cPhaseProfiler::cScope profile(&profiler, cPhaseProfiler::EVENTS);
+      m_world->GetEvents(ctx);
+    }
     if(m_done == true) break;
     
     // Increment the Update.
     stats.IncCurrentUpdate();
     
-    population.ProcessPreUpdate();
+    {
+      cPhaseProfiler::cScope profile(&profiler, cPhaseProfiler::UPDATE_PROCESSING);
+      population.ProcessPreUpdate();
+    }
 
     // Handle all data collection for previous update.
     if (stats.GetUpdate() > 0) {
       // Tell the stats object to do update calculations and printing.
+      cPhaseProfiler::cScope profile(&profiler, cPhaseProfiler::STATS);
       stats.ProcessUpdate();
     }
     
@@ -108,17 +139,27 @@ void Avida2Driver::Run()
     const int UD_size = m_world->CalculateUpdateSize();
     const double step_size = 1.0 / (double) UD_size;
     
-    for (int i = 0; i < UD_size; i++) {
-      if(population.GetNumOrganisms() == 0) {
-        break;
+    {
+      cPhaseProfiler::cScope profile(&profiler, cPhaseProfiler::PROCESS_STEPS);
+      
+      if (tile_engine && population.GetNumOrganisms() > 0) tile_engine->Execute();
+      
+      for (int i = 0; i < UD_size; i++) {
+        if(population.GetNumOrganisms() == 0) {
+          break;
+        }
+        (population.*ActiveProcessStep)(ctx, step_size, population.ScheduleOrganism());
       }
-      (population.*ActiveProcessStep)(ctx, step_size, population.ScheduleOrganism());
     }
     
-    // end of update stats...
-    population.ProcessPostUpdate(ctx);
-    
-		m_world->ProcessPostUpdate(ctx);
+    {
+      cPhaseProfiler::cScope profile(&profiler, cPhaseProfiler::UPDATE_PROCESSING);
+      
+      // end of update stats...
+      population.ProcessPostUpdate(ctx);
+      
+      m_world->ProcessPostUpdate(ctx);
+    }
         
     // No viewer; print out status for this update....
     if (m_world->GetVerbosity() > VERBOSE_SILENT) {
@@ -145,6 +186,7 @@ void Avida2Driver::Run()
     
     // Do Point Mutations
     if (point_mut_prob > 0 ) {
+      cPhaseProfiler::cScope profile(&profiler, cPhaseProfiler::UPDATE_PROCESSING);
       for (int i = 0; i < population.GetSize(); i++) {
         if (population.GetCell(i).IsOccupied()) {
           int num_mut = population.GetCell(i).GetOrganism()->GetHardware().PointMutate(ctx);
@@ -153,17 +195,37 @@ void Avida2Driver::Run()
       }
     }
     
-    m_new_world->PerformUpdate(new_ctx, stats.GetUpdate());
+    {
+      cPhaseProfiler::cScope profile(&profiler, cPhaseProfiler::SYSTEMATICS);
+      m_new_world->PerformPreDataUpdate(new_ctx, stats.GetUpdate());
+    }
+    
+    // Close the profile before the data manager collects it
+    profiler.EndUpdate();
+    {
+      cPhaseProfiler::cScope profile(&profiler, cPhaseProfiler::OUTPUT);
+      m_new_world->PerformDataUpdate(new_ctx, stats.GetUpdate());
+    }
+    profiler.EndOutput();
     
     // Exit conditons...
     if((population.GetNumOrganisms()==0) && m_world->AllowsEarlyExit()) {
 			m_done = true;
 		}
   }
+  
+  population.SetTileEngine(NULL);
+  delete tile_engine;
+  
+  // The driver and world are not destroyed on exit, so output still queued for the background writers must be waited for
+  Output::Manager::Of(m_new_world)->WaitForWrites();
+  m_world->FinishGridDump();
 }
 
 void Avida2Driver::Abort(Avida::AbortCondition condition)
 {
+  Output::Manager::Of(m_new_world)->WaitForWrites();
+  m_world->FinishGridDump();
   exit(condition);
 }
 
@@ -172,7 +234,7 @@ void Avida2Driver::StdIOFeedback::Error(const char* fmt, ...)
   printf("error: ");
   va_list args;
   va_start(args, fmt);
-  printf(fmt, args);
+  vprintf(fmt, args);
   va_end(args);
   printf("\n");
 }
@@ -182,7 +244,7 @@ void Avida2Driver::StdIOFeedback::Warning(const char* fmt, ...)
   printf("warning: ");
   va_list args;
   va_start(args, fmt);
-  printf(fmt, args);
+  vprintf(fmt, args);
   va_end(args);
   printf("\n");
 }
@@ -191,7 +253,7 @@ void Avida2Driver::StdIOFeedback::Notify(const char* fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
-  printf(fmt, args);
+  vprintf(fmt, args);
   va_end(args);
   printf("\n");
 }
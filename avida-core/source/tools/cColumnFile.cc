@@ -0,0 +1,447 @@
+/*
+ *  cColumnFile.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cColumnFile.h"
+
+#include "apto/core/FileSystem.h"
+#include "apto/core/Thread.h"
+#include "apto/platform.h"
+
+#include <cstdlib>
+#include <cstring>
+
+
+namespace {
+  const char EMPTY_TEXT[] = "";
+
+  inline bool isWhitespace(char c) { return (c == ' ' || c == '\t' || c == '\r' || c == '\n'); }
+
+  // Does the line (starting with '#') hold the named directive?
+  bool isDirective(const char* line, const char* line_end, const char* name)
+  {
+    const int len = static_cast<int>(strlen(name));
+    if (line_end - line < len || strncmp(line, name, len) != 0) return false;
+    return (line + len == line_end || isWhitespace(line[len]));
+  }
+};
+
+
+class cColumnFile::cPart
+{
+public:
+  const Apto::Array<sColumn>& columns;
+  char* begin;
+  char* end;
+
+  int num_lines;
+  int error_line;         // line within the part, -1 if none
+  const char* error;
+
+  Apto::Array<int, Apto::Smart> row_fields;
+  Apto::Array<sColumnData> data;
+
+private:
+  Apto::Array<char*, Apto::Smart> m_tokens;
+
+  cPart(); // @not_implemented
+  cPart(const cPart&); // @not_implemented
+  cPart& operator=(const cPart&); // @not_implemented
+
+  void addRow(int num_fields);
+
+public:
+  cPart(const Apto::Array<sColumn>& in_columns)
+    : columns(in_columns), begin(NULL), end(NULL), num_lines(0), error_line(-1), error(NULL), data(in_columns.GetSize()) { ; }
+
+  void Parse();
+};
+
+
+void cColumnFile::cPart::Parse()
+{
+  char* line = begin;
+  while (line < end) {
+    char* line_end = static_cast<char*>(memchr(line, '\n', end - line));
+    assert(line_end);
+
+    if (*line == '#') {
+      // Directives are only read from the header, any others are ignored
+      if (isDirective(line, line_end, "#filetype") || isDirective(line, line_end, "#format")) {
+        error_line = num_lines;
+        error = "format directive after the first data line";
+        return;
+      }
+      if (isDirective(line, line_end, "#include") || isDirective(line, line_end, "#import") ||
+          isDirective(line, line_end, "#define")) {
+        error_line = num_lines;
+        error = "directive not supported in data files";
+        return;
+      }
+    } else {
+      // Split the line in place, up to any comment
+      m_tokens.Resize(0);
+      char* pos = line;
+      while (pos < line_end) {
+        while (pos < line_end && isWhitespace(*pos)) pos++;
+        if (pos == line_end || *pos == '#') break;
+        m_tokens.Push(pos);
+        while (pos < line_end && !isWhitespace(*pos) && *pos != '#') pos++;
+        const bool comment = (*pos == '#');
+        *pos = '\0';
+        if (comment) break;
+        pos++;
+      }
+
+      if (m_tokens.GetSize()) {
+        const char* last = m_tokens[m_tokens.GetSize() - 1];
+        if (last[strlen(last) - 1] == '\\') {
+          error_line = num_lines;
+          error = "line continuation not supported in data files";
+          return;
+        }
+        addRow(m_tokens.GetSize());
+      }
+    }
+
+    num_lines++;
+    line = line_end + 1;
+  }
+}
+
+
+void cColumnFile::cPart::addRow(int num_fields)
+{
+  row_fields.Push(num_fields);
+
+  for (int c = 0; c < columns.GetSize(); c++) {
+    sColumnData& col = data[c];
+    int position = columns[c].position;
+    for (int i = columns[c].shadowed.GetSize() - 1; position >= num_fields && i >= 0; i--) position = columns[c].shadowed[i];
+    const char* token = (position < num_fields) ? m_tokens[position] : EMPTY_TEXT;
+
+    switch (columns[c].type) {
+      case TEXT_COLUMN:
+        col.texts.Push(token);
+        break;
+
+      case INT_COLUMN:
+        col.ints.Push(static_cast<int>(strtol(token, NULL, 0)));
+        break;
+
+      case DOUBLE_COLUMN:
+        col.doubles.Push(strtod(token, NULL));
+        break;
+
+      case INT_LIST_COLUMN:
+      case DOUBLE_LIST_COLUMN:
+        {
+          // Same elements as repeated cString::Pop(','), a trailing comma does not add an element
+          col.list_starts.Push((columns[c].type == INT_LIST_COLUMN) ? col.ints.GetSize() : col.doubles.GetSize());
+          const char* value = token;
+          while (*value) {
+            if (columns[c].type == INT_LIST_COLUMN) col.ints.Push(static_cast<int>(strtol(value, NULL, 0)));
+            else col.doubles.Push(strtod(value, NULL));
+            while (*value && *value != ',') value++;
+            if (*value == ',') value++;
+          }
+        }
+        break;
+    }
+  }
+}
+
+
+class cColumnFile::cWorker : public Apto::Thread
+{
+private:
+  cPart* m_part;
+
+  void Run() { m_part->Parse(); }
+
+public:
+  cWorker(cPart* part) : m_part(part) { ; }
+};
+
+
+cColumnFile::cColumnFile(const cString& filename, const cString& working_dir, Feedback& feedback, int num_threads)
+  : m_filename(filename), m_fp(NULL), m_opened(false), m_failed(false), m_eof(false), m_num_threads(num_threads)
+  , m_report(feedback), m_ftype("unknown"), m_buffer(BLOCK_SIZE + 1), m_size(0), m_next(0), m_line_num(0), m_num_rows(0)
+{
+  open(working_dir);
+}
+
+cColumnFile::cColumnFile(const cString& filename, const cString& working_dir, int num_threads)
+  : m_filename(filename), m_fp(NULL), m_opened(false), m_failed(false), m_eof(false), m_num_threads(num_threads)
+  , m_report(m_feedback), m_ftype("unknown"), m_buffer(BLOCK_SIZE + 1), m_size(0), m_next(0), m_line_num(0), m_num_rows(0)
+{
+  open(working_dir);
+}
+
+cColumnFile::~cColumnFile()
+{
+  if (m_fp) fclose(m_fp);
+}
+
+
+void cColumnFile::open(const cString& working_dir)
+{
+  if (m_num_threads < 1 || m_num_threads > Apto::Platform::AvailableCPUs()) m_num_threads = Apto::Platform::AvailableCPUs();
+
+  cString path = cString(Apto::FileSystem::GetAbsolutePath(Apto::String(m_filename), Apto::String(working_dir)));
+  m_fp = fopen(path, "rb");
+  if (!m_fp) {
+    m_report.Error("unable to open file '%s'.", (const char*)m_filename);
+    return;
+  }
+
+  m_opened = readHeader();
+  if (!m_opened) m_failed = true;
+}
+
+
+bool cColumnFile::fillBuffer()
+{
+  // Keep the unparsed tail, growing the buffer if it holds a single unfinished line
+  if (m_next > 0) {
+    memmove(&m_buffer[0], &m_buffer[m_next], m_size - m_next);
+    m_size -= m_next;
+    m_next = 0;
+  }
+  if (m_size == m_buffer.GetSize() - 1) m_buffer.Resize(m_buffer.GetSize() * 2);
+
+  const size_t num_read = fread(&m_buffer[m_size], 1, m_buffer.GetSize() - 1 - m_size, m_fp);
+  m_size += static_cast<int>(num_read);
+  if (num_read == 0) {
+    if (ferror(m_fp)) {
+      m_report.Error("%s: read error", (const char*)m_filename);
+      return false;
+    }
+    m_eof = true;
+  }
+
+  // The last line of the file may not be terminated; the spare byte holds its newline
+  if (m_eof && m_size > m_next && m_buffer[m_size - 1] != '\n') m_buffer[m_size++] = '\n';
+
+  return true;
+}
+
+
+int cColumnFile::findLineEnd(int pos) const
+{
+  const void* line_end = memchr(&m_buffer[pos], '\n', m_size - pos);
+  return line_end ? static_cast<int>(static_cast<const char*>(line_end) - &m_buffer[0]) : -1;
+}
+
+
+bool cColumnFile::readHeader()
+{
+  // Process directives and skip blank lines, up to the first data line
+  while (true) {
+    int line_end = (m_next < m_size) ? findLineEnd(m_next) : -1;
+    if (line_end < 0) {
+      if (m_eof) return true;
+      if (!fillBuffer()) return false;
+      continue;
+    }
+
+    cString line(&m_buffer[m_next], line_end - m_next);
+    m_line_num++;
+
+    if (line.GetSize() && line[0] == '#') {
+      if (!processDirective(line)) return false;
+    } else {
+      int comment_pos = line.Find('#');
+      if (comment_pos >= 0) line.Clip(comment_pos);
+      if (line.CountNumWords() > 0) {
+        m_line_num--;
+        return true;
+      }
+    }
+
+    m_next = line_end + 1;
+  }
+}
+
+
+bool cColumnFile::processDirective(cString line)
+{
+  cString cmd = line.PopWord();
+
+  if (cmd == "#filetype") {
+    cString ft = line.PopWord();
+    if (m_ftype != "unknown" && m_ftype != ft) {
+      m_report.Error("%s:%d: duplicate filetype directive", (const char*)m_filename, m_line_num);
+      return false;
+    }
+    m_ftype = ft;
+  } else if (cmd == "#format") {
+    if (m_format.GetSize() != 0) {
+      m_report.Error("%s:%d: duplicate format directive", (const char*)m_filename, m_line_num);
+      return false;
+    }
+    m_format.Load(line);
+  } else if (cmd == "#include" || cmd == "#import" || cmd == "#define") {
+    m_report.Error("%s:%d: %s directive not supported in data files", (const char*)m_filename, m_line_num, (const char*)cmd);
+    return false;
+  }
+
+  return true;
+}
+
+
+int cColumnFile::RequestColumn(const cString& name, eColumnType type)
+{
+  // As with cInitFile::GetLineAsDict, the last column of a repeated name wins, among those present in the row
+  Apto::Array<int> positions;
+  for (int i = 0; i < m_format.GetSize(); i++) if (m_format.GetLine(i) == name) positions.Push(i);
+  if (positions.GetSize() == 0) return -1;
+  
+  const int column = RequestColumn(positions[positions.GetSize() - 1], type);
+  m_columns[column].shadowed.Resize(positions.GetSize() - 1);
+  for (int i = 0; i < positions.GetSize() - 1; i++) m_columns[column].shadowed[i] = positions[i];
+  return column;
+}
+
+int cColumnFile::RequestColumn(int position, eColumnType type)
+{
+  assert(m_num_rows == 0);
+  m_columns.Push(sColumn(position, type));
+  m_data.Resize(m_columns.GetSize());
+  return m_columns.GetSize() - 1;
+}
+
+
+bool cColumnFile::ReadBlock()
+{
+  m_num_rows = 0;
+  m_row_fields.Resize(0);
+  for (int c = 0; c < m_data.GetSize(); c++) {
+    m_data[c].ints.Resize(0);
+    m_data[c].doubles.Resize(0);
+    m_data[c].texts.Resize(0);
+    m_data[c].list_starts.Resize(0);
+  }
+  if (!m_opened || m_failed) return false;
+
+  while (true) {
+    if (!m_eof && !fillBuffer()) {
+      m_failed = true;
+      return false;
+    }
+    if (m_next == m_size) return false;
+
+    // Parse through the last complete line in the buffer
+    int end = m_size;
+    while (end > m_next && m_buffer[end - 1] != '\n') end--;
+    if (end == m_next) continue;   // a single line longer than the buffer, fillBuffer() will grow it
+
+    // Split the block into parts at line boundaries, one per thread
+    const int block_size = end - m_next;
+    int num_parts = block_size / MIN_PART_SIZE;
+    if (num_parts > m_num_threads) num_parts = m_num_threads;
+    if (num_parts < 1) num_parts = 1;
+
+    Apto::Array<cPart*> parts(num_parts);
+    int part_begin = m_next;
+    for (int i = 0; i < num_parts; i++) {
+      int part_end = end;
+      if (i < num_parts - 1) {
+        part_end = m_next + static_cast<int>(static_cast<long long>(block_size) * (i + 1) / num_parts);
+        if (part_end <= part_begin) part_end = part_begin;
+        part_end = (part_end < end) ? findLineEnd(part_end) + 1 : end;
+      }
+      parts[i] = new cPart(m_columns);
+      parts[i]->begin = &m_buffer[part_begin];
+      parts[i]->end = &m_buffer[part_end];
+      part_begin = part_end;
+    }
+
+    Apto::Array<cWorker*> workers(num_parts);
+    workers.SetAll(NULL);
+    for (int i = 1; i < num_parts; i++) {
+      if (parts[i]->begin == parts[i]->end) continue;
+      workers[i] = new cWorker(parts[i]);
+      workers[i]->Start();
+    }
+    parts[0]->Parse();
+    for (int i = 1; i < num_parts; i++) {
+      if (!workers[i]) continue;
+      workers[i]->Join();
+      delete workers[i];
+    }
+
+    for (int i = 0; i < num_parts && !m_failed; i++) {
+      if (parts[i]->error) {
+        m_report.Error("%s:%d: %s", (const char*)m_filename, m_line_num + parts[i]->error_line + 1, parts[i]->error);
+        m_failed = true;
+      } else {
+        appendPart(*parts[i]);
+        m_line_num += parts[i]->num_lines;
+      }
+    }
+    for (int i = 0; i < num_parts; i++) delete parts[i];
+    m_next = end;
+
+    if (m_failed) return false;
+    if (m_num_rows > 0) {
+      // Close the list offsets
+      for (int c = 0; c < m_columns.GetSize(); c++) {
+        if (m_columns[c].type == INT_LIST_COLUMN) m_data[c].list_starts.Push(m_data[c].ints.GetSize());
+        else if (m_columns[c].type == DOUBLE_LIST_COLUMN) m_data[c].list_starts.Push(m_data[c].doubles.GetSize());
+      }
+      return true;
+    }
+  }
+}
+
+
+void cColumnFile::appendPart(const cPart& part)
+{
+  for (int i = 0; i < part.row_fields.GetSize(); i++) m_row_fields.Push(part.row_fields[i]);
+  m_num_rows += part.row_fields.GetSize();
+
+  for (int c = 0; c < m_columns.GetSize(); c++) {
+    sColumnData& col = m_data[c];
+    const sColumnData& part_col = part.data[c];
+
+    const int list_offset = (m_columns[c].type == DOUBLE_LIST_COLUMN) ? col.doubles.GetSize() : col.ints.GetSize();
+    for (int i = 0; i < part_col.list_starts.GetSize(); i++) col.list_starts.Push(list_offset + part_col.list_starts[i]);
+    for (int i = 0; i < part_col.ints.GetSize(); i++) col.ints.Push(part_col.ints[i]);
+    for (int i = 0; i < part_col.doubles.GetSize(); i++) col.doubles.Push(part_col.doubles[i]);
+    for (int i = 0; i < part_col.texts.GetSize(); i++) col.texts.Push(part_col.texts[i]);
+  }
+}
+
+
+void cColumnFile::GetList(int row, int column, Apto::Array<int>& list) const
+{
+  const sColumnData& col = m_data[column];
+  const int start = col.list_starts[row];
+  list.Resize(col.list_starts[row + 1] - start);
+  for (int i = 0; i < list.GetSize(); i++) list[i] = col.ints[start + i];
+}
+
+void cColumnFile::GetList(int row, int column, Apto::Array<double>& list) const
+{
+  const sColumnData& col = m_data[column];
+  const int start = col.list_starts[row];
+  list.Resize(col.list_starts[row + 1] - start);
+  for (int i = 0; i < list.GetSize(); i++) list[i] = col.doubles[start + i];
+}
@@ -0,0 +1,152 @@
+/*
+ *  cColumnFile.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cColumnFile_h
+#define cColumnFile_h
+
+#include "apto/core.h"
+
+#include "cString.h"
+#include "cStringList.h"
+#include "cUserFeedback.h"
+
+#include <cstdio>
+
+
+// cColumnFile - Streaming reader for column data files (population saves, genotype detail files)
+//
+// cInitFile keeps every line of a file in memory and builds a dictionary per row.  This reader instead streams the
+// file in blocks of BLOCK_SIZE bytes.  The #filetype and #format directives are read from the header, and the columns a
+// loader needs are requested once, by name or position, with the type to convert them to.  Each block is split at line
+// boundaries among the worker threads, which tokenize their lines in place in the block buffer and convert the requested
+// columns into typed arrays.  Rows are numbered within the current block, in file order.
+//
+// Fields are whitespace separated, and anything after a '#' is a comment, as with cInitFile.  Values convert as
+// cString::AsInt and AsDouble would, and list columns hold comma separated values, split as by cString::Pop(',').
+// Data files are machine written, so the cInitFile extensions for hand written files (#include, #import, #define,
+// variable substitution and '\' line continuation) are reported as errors.  So are #filetype and #format directives
+// after the first data row.
+
+class cColumnFile
+{
+public:
+  enum eColumnType { TEXT_COLUMN, INT_COLUMN, DOUBLE_COLUMN, INT_LIST_COLUMN, DOUBLE_LIST_COLUMN };
+
+  static const int BLOCK_SIZE = 1 << 22;
+  static const int MIN_PART_SIZE = 1 << 16;  // blocks are not split into parts smaller than this
+
+private:
+  struct sColumn
+  {
+    int position;
+    eColumnType type;
+    Apto::Array<int> shadowed;  // earlier positions of a repeated name, read by rows that stop short of position
+
+    sColumn() : position(-1), type(TEXT_COLUMN) { ; }
+    sColumn(int in_position, eColumnType in_type) : position(in_position), type(in_type) { ; }
+
+    int FirstPosition() const { return shadowed.GetSize() ? shadowed[0] : position; }
+  };
+
+  // Converted values of one column; lists are flattened, with row i's values at list_starts[i] through list_starts[i + 1] - 1
+  struct sColumnData
+  {
+    Apto::Array<int, Apto::Smart> ints;
+    Apto::Array<double, Apto::Smart> doubles;
+    Apto::Array<const char*, Apto::Smart> texts;
+    Apto::Array<int, Apto::Smart> list_starts;
+  };
+
+  class cPart;
+  class cWorker;
+
+  cString m_filename;
+  FILE* m_fp;
+  bool m_opened;
+  bool m_failed;
+  bool m_eof;
+  int m_num_threads;
+  mutable cUserFeedback m_feedback;
+  Feedback& m_report;   // m_feedback, unless the caller supplied feedback
+
+  cString m_ftype;
+  cStringList m_format;
+  Apto::Array<sColumn> m_columns;
+
+  Apto::Array<char> m_buffer;   // [m_next, m_size) has not been parsed yet
+  int m_size;
+  int m_next;
+  int m_line_num;   // lines before m_next
+
+  int m_num_rows;
+  Apto::Array<int, Apto::Smart> m_row_fields;
+  Apto::Array<sColumnData> m_data;
+
+
+  cColumnFile(); // @not_implemented
+  cColumnFile(const cColumnFile&); // @not_implemented
+  cColumnFile& operator=(const cColumnFile&); // @not_implemented
+
+  void open(const cString& working_dir);
+  bool fillBuffer();
+  int findLineEnd(int pos) const;
+  bool readHeader();
+  bool processDirective(cString line);
+  void appendPart(const cPart& part);
+
+public:
+  // num_threads < 1 uses all available processors
+  cColumnFile(const cString& filename, const cString& working_dir, Feedback& feedback, int num_threads = 1);
+  cColumnFile(const cString& filename, const cString& working_dir, int num_threads = 1);
+  ~cColumnFile();
+
+  bool WasOpened() const { return m_opened; }
+  bool HadError() const { return m_failed; }
+  const cUserFeedback& GetFeedback() const { return m_feedback; }
+
+  const cString& GetFiletype() const { return m_ftype; }
+  const cStringList& GetFormat() const { return m_format; }
+  bool HasColumn(const cString& name) const { return m_format.HasString(name); }
+
+  // Request conversion of a column, before the first block is read.  Returns the column's handle, or -1 if the
+  // format does not name it.  A repeated name refers to the last of its columns that each row reaches, as with
+  // cInitFile::GetLineAsDict.  Positions need not be named by the format.
+  int RequestColumn(const cString& name, eColumnType type);
+  int RequestColumn(int position, eColumnType type);
+
+  // Parse the next block of rows.  Returns false at the end of the file, or on error.  Text values point into the
+  // block buffer, and are only valid until the next call.
+  bool ReadBlock();
+
+  int GetNumRows() const { return m_num_rows; }
+
+  // Does the row have a field for the column?  Missing fields read as 0, "" or an empty list.
+  bool HasValue(int row, int column) const { return m_columns[column].FirstPosition() < m_row_fields[row]; }
+
+  int GetInt(int row, int column) const { return m_data[column].ints[row]; }
+  double GetDouble(int row, int column) const { return m_data[column].doubles[row]; }
+  const char* GetText(int row, int column) const { return m_data[column].texts[row]; }
+
+  int GetListSize(int row, int column) const { return m_data[column].list_starts[row + 1] - m_data[column].list_starts[row]; }
+  void GetList(int row, int column, Apto::Array<int>& list) const;
+  void GetList(int row, int column, Apto::Array<double>& list) const;
+};
+
+#endif
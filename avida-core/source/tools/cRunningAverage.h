@@ -68,6 +68,30 @@ public:
   // Notation Shortcuts
   double Ave() const { return Average(); }
   double Var() const { return Variance(); }
+  
+  // Binary checkpoint support (see cCheckpoint); the window size comes from the constructor and must match
+  template <class W> void SaveCheckpoint(W& cp) const
+  {
+    cp.Write(m_window_size);
+    for (int i = 0; i < m_window_size; i++) cp.Write(m_values[i]);
+    cp.Write(m_s1);
+    cp.Write(m_s2);
+    cp.Write(m_pointer);
+    cp.Write(m_n);
+  }
+  template <class R> void LoadCheckpoint(R& cp)
+  {
+    if (cp.template Read<int>() != m_window_size) {
+      cp.Invalidate();
+      return;
+    }
+    for (int i = 0; i < m_window_size; i++) cp.Read(m_values[i]);
+    cp.Read(m_s1);
+    cp.Read(m_s2);
+    cp.Read(m_pointer);
+    cp.Read(m_n);
+    if (m_pointer < 0 || m_pointer >= m_window_size || m_n < 0 || m_n > m_window_size) cp.Invalidate();
+  }
 };
 
 #endif
@@ -81,6 +81,23 @@ public:
   int GetTotal() const { return total; }
   int GetNumStored() const { return (total <= data.GetSize()) ? total : data.GetSize(); }
   int GetNum() const { return total - last_total; }
+
+  // Binary checkpoint support (see cCheckpoint); templated on the stream so that this header stays free of it
+  template <class W> void SaveCheckpoint(W& cp) const
+  {
+    cp.WriteArray(data);
+    cp.Write(offset);
+    cp.Write(total);
+    cp.Write(last_total);
+  }
+  template <class R> void LoadCheckpoint(R& cp)
+  {
+    cp.ReadArray(data);
+    cp.Read(offset);
+    cp.Read(total);
+    cp.Read(last_total);
+    if (data.GetSize() == 0 || offset < 0 || offset >= data.GetSize()) cp.Invalidate();
+  }
 };
 
 #endif
@@ -0,0 +1,222 @@
+// This program reads the binary grid containers written by the Dump*Grid
+// actions when GRID_DUMP_FORMAT is set (see main/cGridDump.h for the layout)
+// and converts frames back to the text layout of the per-update grid files.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+struct sFrameEntry {
+  int update;
+  unsigned long long offset;
+};
+
+class cGridContainer {
+private:
+  ifstream m_fp;
+  unsigned int m_type;
+  unsigned int m_rows;
+  unsigned int m_cols;
+  unsigned int m_flags;
+  vector<sFrameEntry> m_frames;
+
+  unsigned int readU32() {
+    unsigned char b[4] = { 0, 0, 0, 0 };
+    m_fp.read(reinterpret_cast<char*>(b), 4);
+    return b[0] | (b[1] << 8) | (b[2] << 16) | (static_cast<unsigned int>(b[3]) << 24);
+  }
+  unsigned long long readU64() {
+    unsigned long long low = readU32();
+    unsigned long long high = readU32();
+    return low | (high << 32);
+  }
+
+public:
+  cGridContainer(const char* filename) : m_fp(filename, ios::in | ios::binary) { ; }
+
+  bool Load() {
+    char magic[8];
+    m_fp.read(magic, 8);
+    if (!m_fp || memcmp(magic, "AVGRID01", 8) != 0) return false;
+    m_type = readU32();
+    m_rows = readU32();
+    m_cols = readU32();
+    m_flags = readU32();
+    const unsigned long long index_offset = readU64();
+    if (!m_fp) return false;
+
+    if (index_offset) {
+      m_fp.seekg(index_offset);
+      const unsigned int num_frames = readU32();
+      for (unsigned int i = 0; i < num_frames && m_fp; i++) {
+        sFrameEntry entry;
+        entry.update = static_cast<int>(readU32());
+        entry.offset = readU64();
+        m_frames.push_back(entry);
+      }
+    } else {
+      // No index (the run did not finish cleanly); scan the complete frames
+      m_fp.seekg(0, ios::end);
+      const unsigned long long end = m_fp.tellg();
+      unsigned long long pos = 32;
+      while (pos + 12 <= end) {
+        m_fp.seekg(pos);
+        sFrameEntry entry;
+        entry.update = static_cast<int>(readU32());
+        entry.offset = pos;
+        readU32();
+        const unsigned long long size = readU32();
+        if (pos + 12 + size > end) break;
+        m_frames.push_back(entry);
+        pos += 12 + size;
+      }
+    }
+    m_fp.clear();
+    return true;
+  }
+
+  int GetNumFrames() const { return m_frames.size(); }
+  int GetUpdate(int idx) const { return m_frames[idx].update; }
+  unsigned int GetRows() const { return m_rows; }
+  unsigned int GetCols() const { return m_cols; }
+  bool IsDouble() const { return m_type == 1; }
+  bool HasDeltaFrames() const { return m_flags & 1; }
+
+  int FindFrame(int update) const {
+    for (unsigned int i = 0; i < m_frames.size(); i++) if (m_frames[i].update == update) return i;
+    return -1;
+  }
+
+  // Decode frame idx into plane; prev must hold the plane of frame idx - 1 when idx is a delta frame
+  bool ReadPlane(int idx, vector<unsigned char>& plane) {
+    const size_t plane_size = static_cast<size_t>(m_rows) * m_cols * (IsDouble() ? 8 : 4);
+    m_fp.seekg(m_frames[idx].offset);
+    readU32();
+    const unsigned int frame_flags = readU32();
+    const unsigned int size = readU32();
+    vector<unsigned char> payload(size);
+    if (size) m_fp.read(reinterpret_cast<char*>(&payload[0]), size);
+    if (!m_fp) return false;
+
+    if (!HasDeltaFrames()) {
+      if (payload.size() != plane_size) return false;
+      plane.swap(payload);
+      return true;
+    }
+
+    if (!(frame_flags & 1)) plane.assign(plane_size, 0);
+    if (plane.size() != plane_size) return false;
+    size_t in = 0, out = 0;
+    while (in < payload.size()) {
+      unsigned int counts[2] = { 0, 0 };
+      for (int c = 0; c < 2; c++) {
+        int shift = 0;
+        while (in < payload.size()) {
+          const unsigned char b = payload[in++];
+          counts[c] |= static_cast<unsigned int>(b & 0x7f) << shift;
+          shift += 7;
+          if (!(b & 0x80)) break;
+        }
+      }
+      out += counts[0];
+      if (out + counts[1] > plane_size || in + counts[1] > payload.size()) return false;
+      for (unsigned int i = 0; i < counts[1]; i++) plane[out++] ^= payload[in++];
+    }
+    return true;
+  }
+
+  // Decode frame idx, starting from the closest key frame
+  bool ReadFrame(int idx, vector<unsigned char>& plane) {
+    int start = idx;
+    if (HasDeltaFrames()) {
+      for (; start > 0; start--) {
+        m_fp.seekg(m_frames[start].offset + 4);
+        if (!(readU32() & 1)) break;
+      }
+    }
+    for (int i = start; i <= idx; i++) if (!ReadPlane(i, plane)) return false;
+    return true;
+  }
+
+  void WriteText(const vector<unsigned char>& plane, ostream& out) const {
+    const int width = IsDouble() ? 8 : 4;
+    for (unsigned int r = 0; r < m_rows; r++) {
+      for (unsigned int c = 0; c < m_cols; c++) {
+        const unsigned char* v = &plane[(static_cast<size_t>(r) * m_cols + c) * width];
+        unsigned long long bits = 0;
+        for (int i = width - 1; i >= 0; i--) bits = (bits << 8) | v[i];
+        if (IsDouble()) {
+          double value;
+          memcpy(&value, &bits, sizeof(value));
+          out << value << " ";
+        } else {
+          out << static_cast<int>(static_cast<unsigned int>(bits)) << " ";
+        }
+      }
+      out << "\n";
+    }
+  }
+};
+
+
+int main(int argc, char * argv[])
+{
+  if (argc < 2 || argc > 4) {
+    cerr << "Format: " << argv[0] << " container [update | all pattern]" << endl;
+    cerr << "  With only a container, lists its grid shape and frames." << endl;
+    cerr << "  With an update, writes that frame to standard out in the text grid layout." << endl;
+    cerr << "  With 'all', writes every frame to a file named by pattern, where %d is" << endl;
+    cerr << "  replaced by the update (e.g. grid_fitness-%d.dat)." << endl;
+    return 1;
+  }
+
+  cGridContainer container(argv[1]);
+  if (!container.Load()) {
+    cerr << "Error: unable to read grid container '" << argv[1] << "'" << endl;
+    return 1;
+  }
+
+  if (argc == 2) {
+    cout << "rows: " << container.GetRows() << endl;
+    cout << "cols: " << container.GetCols() << endl;
+    cout << "values: " << (container.IsDouble() ? "double" : "int") << endl;
+    cout << "delta frames: " << (container.HasDeltaFrames() ? "yes" : "no") << endl;
+    cout << "frames: " << container.GetNumFrames() << endl;
+    for (int i = 0; i < container.GetNumFrames(); i++) cout << container.GetUpdate(i) << endl;
+    return 0;
+  }
+
+  vector<unsigned char> plane;
+  if (argc == 3) {
+    const int idx = container.FindFrame(atoi(argv[2]));
+    if (idx < 0 || !container.ReadFrame(idx, plane)) {
+      cerr << "Error: no readable frame for update " << argv[2] << endl;
+      return 1;
+    }
+    container.WriteText(plane, cout);
+    return 0;
+  }
+
+  if (string(argv[2]) != "all") {
+    cerr << "Error: unknown mode '" << argv[2] << "'" << endl;
+    return 1;
+  }
+  for (int i = 0; i < container.GetNumFrames(); i++) {
+    if (!container.ReadPlane(i, plane)) {
+      cerr << "Error: frame " << i << " is corrupt" << endl;
+      return 1;
+    }
+    char filename[4096];
+    snprintf(filename, sizeof(filename), argv[3], container.GetUpdate(i));
+    ofstream fp(filename);
+    container.WriteText(plane, fp);
+  }
+  return 0;
+}
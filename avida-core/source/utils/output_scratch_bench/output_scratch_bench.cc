@@ -0,0 +1,313 @@
+// This program measures the resource bookkeeping that cOrganism::doOutput
+// performs on every IO, as it was before per-organism scratch storage was
+// added and as it is now.  Before, each IO built the global and deme
+// resource change arrays and two concatenated copies of the resource counts
+// and changes.  Now these arrays live in cOrganism::sOutputScratch and are
+// only resized when the number of resources changes.
+//
+// Both versions run the same stream of IOs through a reduced logic-9 task
+// check, taking resources as the reactions of the environment do.  The
+// arrays copy the allocation behavior of Apto::Array: a buffer is allocated
+// for any nonzero size, by construction, copy, concatenation or a resize to
+// a different size.  Allocations are counted by replacing operator new[].
+// Two environments are measured:
+//
+//   logic9       support/config/environment.cfg (reactions without resources)
+//   logic9-res   support/config/misc/environment-9resource.cfg
+//
+// Without resources both versions do the same work: the old arrays are
+// empty, so they never allocate, and the new arrays are never resized.  The
+// timings of the logic9 case differ only by run to run noise.
+//
+// Usage: output_scratch_bench [num_ios]
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+
+using namespace std;
+
+
+static long long s_allocs = 0;
+
+void* operator new[](size_t size)
+{
+  s_allocs++;
+  return ::operator new(size);
+}
+
+void operator delete[](void* ptr) throw() { ::operator delete(ptr); }
+void operator delete[](void* ptr, size_t) throw() { ::operator delete(ptr); }
+
+
+// Buffer handling of Apto::Array's default storage
+template <class T> class tArray
+{
+private:
+  T* m_data;
+  int m_size;
+
+public:
+  explicit tArray(int size = 0) : m_data(size ? new T[size] : NULL), m_size(size) { ; }
+  tArray(const tArray& rhs) : m_data(rhs.m_size ? new T[rhs.m_size] : NULL), m_size(rhs.m_size)
+  {
+    for (int i = 0; i < m_size; i++) m_data[i] = rhs.m_data[i];
+  }
+  ~tArray() { delete [] m_data; }
+
+  tArray& operator=(const tArray& rhs)
+  {
+    if (m_size != rhs.m_size) Resize(rhs.m_size);
+    for (int i = 0; i < m_size; i++) m_data[i] = rhs.m_data[i];
+    return *this;
+  }
+
+  tArray operator+(const tArray& rhs) const
+  {
+    tArray out(m_size + rhs.m_size);
+    for (int i = 0; i < m_size; i++) out.m_data[i] = m_data[i];
+    for (int i = 0; i < rhs.m_size; i++) out.m_data[m_size + i] = rhs.m_data[i];
+    return out;
+  }
+
+  void Resize(int size)
+  {
+    T* data = size ? new T[size] : NULL;
+    for (int i = 0; i < size && i < m_size; i++) data[i] = m_data[i];
+    delete [] m_data;
+    m_data = data;
+    m_size = size;
+  }
+
+  int GetSize() const { return m_size; }
+  void SetAll(const T& value) { for (int i = 0; i < m_size; i++) m_data[i] = value; }
+  T& operator[](int i) { return m_data[i]; }
+  const T& operator[](int i) const { return m_data[i]; }
+};
+
+
+// ---- Reduced logic-9 environment ----------------------------------------------------------------------------------
+
+static const int NUM_REACTIONS = 9;
+static const int NUM_IO_PATTERNS = 4096;
+
+struct sEnvironment {
+  int num_resources;            // global resources; logic-9 environments have no deme resources
+  int logic_reaction[256];      // reaction completed by each three input logic ID, or -1
+  double value[NUM_REACTIONS];
+};
+
+struct sIO {
+  int inputs[3];
+  int output;
+};
+
+static int twoInputLogic(int task, int a, int b)
+{
+  switch (task) {
+    case 0: return ~a;
+    case 1: return ~(a & b);
+    case 2: return a & b;
+    case 3: return a | ~b;
+    case 4: return a | b;
+    case 5: return a & ~b;
+    case 6: return ~(a | b);
+    case 7: return a ^ b;
+    default: return ~(a ^ b);
+  }
+}
+
+// The truth table of the output over the three inputs, as cTaskContext computes it, or -1 if it is inconsistent
+static int logicID(const int inputs[3], int output)
+{
+  int table[8];
+  for (int i = 0; i < 8; i++) table[i] = -1;
+  for (int bit = 0; bit < 32; bit++) {
+    const int row = ((inputs[0] >> bit) & 1) | (((inputs[1] >> bit) & 1) << 1) | (((inputs[2] >> bit) & 1) << 2);
+    const int out = (output >> bit) & 1;
+    if (table[row] == -1) table[row] = out;
+    else if (table[row] != out) return -1;
+  }
+  int id = 0;
+  for (int i = 0; i < 8; i++) if (table[i] == 1) id |= (1 << i);
+  return id;
+}
+
+static void setupEnvironment(sEnvironment& env, bool with_resources)
+{
+  env.num_resources = with_resources ? NUM_REACTIONS : 0;
+  for (int i = 0; i < 256; i++) env.logic_reaction[i] = -1;
+  const int inputs[3] = { 0x0F0F0F0F, 0x33333333, 0x55555555 };
+  for (int task = 0; task < NUM_REACTIONS; task++) {
+    env.value[task] = (task / 2) + 1.0;
+    for (int a = 0; a < 3; a++) {
+      for (int b = 0; b < 3; b++) {
+        const int id = logicID(inputs, twoInputLogic(task, inputs[a], inputs[b]));
+        if (id >= 0 && env.logic_reaction[id] == -1) env.logic_reaction[id] = task;
+      }
+    }
+  }
+}
+
+// Half of the outputs perform one of the nine tasks, the rest are arbitrary values
+static void setupIOs(sIO* ios)
+{
+  srand(1);
+  for (int i = 0; i < NUM_IO_PATTERNS; i++) {
+    for (int j = 0; j < 3; j++) ios[i].inputs[j] = 0x0F000000 | (rand() & 0xFFFFFF);
+    const int task = rand() % (2 * NUM_REACTIONS);
+    if (task < NUM_REACTIONS) ios[i].output = twoInputLogic(task, ios[i].inputs[rand() % 3], ios[i].inputs[rand() % 3]);
+    else ios[i].output = rand();
+  }
+}
+
+// Stands in for cPhenotype::TestOutput: completes the reaction for the output's logic ID, taking its resource
+static double testOutput(const sEnvironment& env, const sIO& io, const tArray<double>& res_count, tArray<double>& res_change)
+{
+  const int id = logicID(io.inputs, io.output);
+  if (id < 0 || env.logic_reaction[id] < 0) return 0.0;
+  const int task = env.logic_reaction[id];
+  if (env.num_resources == 0) return env.value[task];
+
+  double consumed = res_count[task] * 0.0025;
+  if (consumed > 25.0) consumed = 25.0;
+  res_change[task] -= consumed;
+  return env.value[task] * consumed;
+}
+
+
+// ---- The two versions of the doOutput bookkeeping ---------------------------------------------------------------
+
+struct sResourceState {
+  tArray<double> global_count;
+  tArray<double> deme_count;
+  sResourceState(int num_global) : global_count(num_global), deme_count(0) { global_count.SetAll(10000.0); }
+
+  void Apply(const tArray<double>& global_change)
+  {
+    for (int i = 0; i < global_count.GetSize(); i++) global_count[i] += global_change[i];
+  }
+};
+
+static double oldOutput(const sEnvironment& env, const sIO& io, sResourceState& res)
+{
+  tArray<double> global_res_change(res.global_count.GetSize());
+  global_res_change.SetAll(0.0);
+  tArray<double> deme_res_change(res.deme_count.GetSize());
+  deme_res_change.SetAll(0.0);
+
+  tArray<double> globalAndDeme_resource_count = res.global_count + res.deme_count;
+  tArray<double> globalAndDeme_res_change = global_res_change + deme_res_change;
+
+  const double bonus = testOutput(env, io, globalAndDeme_resource_count, globalAndDeme_res_change);
+
+  for (int i = 0; i < global_res_change.GetSize(); i++) global_res_change[i] = globalAndDeme_res_change[i];
+  for (int i = 0; i < deme_res_change.GetSize(); i++) {
+    deme_res_change[i] = globalAndDeme_res_change[i + global_res_change.GetSize()];
+  }
+  res.Apply(global_res_change);
+  return bonus;
+}
+
+struct sOutputScratch {
+  tArray<double> res_count;
+  tArray<double> res_change;
+  tArray<double> global_res_change;
+  tArray<double> deme_res_change;
+};
+
+static double newOutput(const sEnvironment& env, const sIO& io, sResourceState& res, sOutputScratch& scratch)
+{
+  const int num_global_res = res.global_count.GetSize();
+  const int num_deme_res = res.deme_count.GetSize();
+
+  tArray<double>& global_res_change = scratch.global_res_change;
+  tArray<double>& deme_res_change = scratch.deme_res_change;
+  if (global_res_change.GetSize() != num_global_res) global_res_change.Resize(num_global_res);
+  if (deme_res_change.GetSize() != num_deme_res) deme_res_change.Resize(num_deme_res);
+
+  tArray<double>& globalAndDeme_resource_count = scratch.res_count;
+  tArray<double>& globalAndDeme_res_change = scratch.res_change;
+  if (globalAndDeme_resource_count.GetSize() != num_global_res + num_deme_res) {
+    globalAndDeme_resource_count.Resize(num_global_res + num_deme_res);
+    globalAndDeme_res_change.Resize(num_global_res + num_deme_res);
+  }
+  for (int i = 0; i < num_global_res; i++) globalAndDeme_resource_count[i] = res.global_count[i];
+  for (int i = 0; i < num_deme_res; i++) globalAndDeme_resource_count[num_global_res + i] = res.deme_count[i];
+  globalAndDeme_res_change.SetAll(0.0);
+
+  const double bonus = testOutput(env, io, globalAndDeme_resource_count, globalAndDeme_res_change);
+
+  for (int i = 0; i < num_global_res; i++) global_res_change[i] = globalAndDeme_res_change[i];
+  for (int i = 0; i < num_deme_res; i++) deme_res_change[i] = globalAndDeme_res_change[i + num_global_res];
+  res.Apply(global_res_change);
+  return bonus;
+}
+
+
+// ---- Driver -------------------------------------------------------------------------------------------------------
+
+// The versions alternate for NUM_ROUNDS rounds and the fastest round of each is reported, so that frequency scaling
+// and other load affect both alike
+static const int NUM_ROUNDS = 5;
+
+static bool runCase(const char* name, bool with_resources, const sIO* ios, int num_ios)
+{
+  sEnvironment env;
+  setupEnvironment(env, with_resources);
+
+  double old_secs = 0.0, new_secs = 0.0;
+  long long old_allocs = 0, new_allocs = 0;
+  bool same = true;
+  for (int round = 0; round < NUM_ROUNDS; round++) {
+    sResourceState old_res(env.num_resources);
+    double old_bonus = 0.0;
+    long long allocs = s_allocs;
+    clock_t start = clock();
+    for (int i = 0; i < num_ios; i++) old_bonus += oldOutput(env, ios[i % NUM_IO_PATTERNS], old_res);
+    const double old_round = double(clock() - start) / CLOCKS_PER_SEC;
+    old_allocs = s_allocs - allocs;
+
+    sResourceState new_res(env.num_resources);
+    sOutputScratch scratch;
+    double new_bonus = 0.0;
+    allocs = s_allocs;
+    start = clock();
+    for (int i = 0; i < num_ios; i++) new_bonus += newOutput(env, ios[i % NUM_IO_PATTERNS], new_res, scratch);
+    const double new_round = double(clock() - start) / CLOCKS_PER_SEC;
+    new_allocs = s_allocs - allocs;
+
+    if (round == 0 || old_round < old_secs) old_secs = old_round;
+    if (round == 0 || new_round < new_secs) new_secs = new_round;
+
+    same = same && (old_bonus == new_bonus);
+    for (int i = 0; i < env.num_resources; i++) same = same && (old_res.global_count[i] == new_res.global_count[i]);
+  }
+
+  printf("%-11s %2d res   old %6.2f allocs/IO %7.1f ns/IO   new %6.4f allocs/IO %7.1f ns/IO   speedup %5.2fx   %s\n",
+         name, env.num_resources, double(old_allocs) / num_ios, old_secs * 1.0e9 / num_ios,
+         double(new_allocs) / num_ios, new_secs * 1.0e9 / num_ios, (new_secs > 0.0) ? (old_secs / new_secs) : 0.0,
+         same ? "identical" : "MISMATCH");
+  return same;
+}
+
+int main(int argc, char* argv[])
+{
+  const int num_ios = (argc > 1) ? atoi(argv[1]) : 10000000;
+  if (num_ios <= 0) {
+    fprintf(stderr, "Usage: %s [num_ios]\n", argv[0]);
+    return 1;
+  }
+
+  sIO* ios = new sIO[NUM_IO_PATTERNS];
+  setupIOs(ios);
+
+  bool ok = true;
+  ok &= runCase("logic9", false, ios, num_ios);
+  ok &= runCase("logic9-res", true, ios, num_ios);
+
+  delete [] ios;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,303 @@
+// This program times the spatial resource update kernel (Source, Sink,
+// FlowAll and StateAll) with the grid of cSpatialCountElem objects that
+// cSpatialResCount used before it stored resources as contiguous planes,
+// and with cSpatialResCount itself.  The previous layout no longer exists
+// in main/, so it is kept here as a copy reduced to plain containers; the
+// current one is the real class, linked from avida-core.  The final amounts
+// of the two are compared bit for bit before any times are reported.
+//
+// Usage: spatial_flow_bench [world_x world_y resources updates]
+
+#include "cSpatialResCount.h"
+#include "nGeometry.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+using namespace std;
+
+
+static const int GEOM_GRID = nGeometry::GRID;
+static const int GEOM_TORUS = nGeometry::TORUS;
+
+static const double SQRT2 = sqrt(2.0);
+
+
+static inline int Mod(int x, int y)
+{
+  const int r = x % y;
+  return (r < 0) ? (r + y) : r;
+}
+
+static inline int GridNeighbor(int cell, int sx, int sy, int dx, int dy)
+{
+  return Mod((cell % sx) + dx, sx) + Mod((cell / sx) + dy, sy) * sx;
+}
+
+
+// Parameters shared by both versions of a resource
+struct sResParams {
+  double xdiffuse, ydiffuse, xgravity, ygravity;
+  double inflow, decay;
+  int inflowX1, inflowX2, inflowY1, inflowY2;
+  int outflowX1, outflowX2, outflowY1, outflowY2;
+};
+
+
+// ---- Previous layout: one element per cell, each holding eight neighbor links -------------------------------------
+
+static const int MAXFLOWPTS = 8;
+
+class cOldElem {
+public:
+  double amount, delta, initial;
+  vector<int> elempt, xdist, ydist;
+  vector<double> dist;
+
+  cOldElem() : amount(0.0), delta(0.0), initial(0.0),
+    elempt(MAXFLOWPTS), xdist(MAXFLOWPTS), ydist(MAXFLOWPTS), dist(MAXFLOWPTS) { ; }
+
+  void SetPtr(int n, int e, int xd, int yd, double d) { elempt[n] = e; xdist[n] = xd; ydist[n] = yd; dist[n] = d; }
+};
+
+static void FlowMatter(cOldElem& elem1, cOldElem& elem2, double inxdiffuse, double inydiffuse, double inxgravity,
+                       double inygravity, int xdist, int ydist, double dist)
+{
+  double diff, flowamt, xgravity, xdiffuse, ygravity, ydiffuse;
+
+  if (((elem1.amount == 0.0) && (elem2.amount == 0.0)) && (dist < 0.0)) return;
+  diff = (elem1.amount - elem2.amount);
+  if (xdist != 0) {
+    if (((xdist > 0) && (inxgravity > 0.0)) || ((xdist < 0) && (inxgravity < 0.0))) {
+      xgravity = elem1.amount * fabs(inxgravity) / 3.0;
+    } else {
+      xgravity = -elem2.amount * fabs(inxgravity) / 3.0;
+    }
+    xdiffuse = inxdiffuse * diff / 16.0;
+  } else {
+    xdiffuse = 0.0;
+    xgravity = 0.0;
+  }
+  if (ydist != 0) {
+    if (((ydist > 0) && (inygravity > 0.0)) || ((ydist < 0) && (inygravity < 0.0))) {
+      ygravity = elem1.amount * fabs(inygravity) / 3.0;
+    } else {
+      ygravity = -elem2.amount * fabs(inygravity) / 3.0;
+    }
+    ydiffuse = inydiffuse * diff / 16.0;
+  } else {
+    ydiffuse = 0.0;
+    ygravity = 0.0;
+  }
+
+  flowamt = ((xdiffuse + ydiffuse + xgravity + ygravity) / (fabs(xdist * 1.0) + fabs(ydist * 1.0))) / dist;
+  elem1.delta -= flowamt;
+  elem2.delta += flowamt;
+}
+
+class cOldRes {
+private:
+  sResParams p;
+  int world_x, world_y, num_cells;
+  vector<cOldElem> grid;
+
+public:
+  cOldRes(const sResParams& in_p, int x, int y, int geometry)
+    : p(in_p), world_x(x), world_y(y), num_cells(x * y), grid(x * y)
+  {
+    for (int i = 0; i < num_cells; i++) {
+      grid[i].SetPtr(0, GridNeighbor(i, world_x, world_y, -1, -1), -1, -1, SQRT2);
+      grid[i].SetPtr(1, GridNeighbor(i, world_x, world_y,  0, -1),  0, -1, 1.0);
+      grid[i].SetPtr(2, GridNeighbor(i, world_x, world_y, +1, -1), +1, -1, SQRT2);
+      grid[i].SetPtr(3, GridNeighbor(i, world_x, world_y, +1,  0), +1,  0, 1.0);
+      grid[i].SetPtr(4, GridNeighbor(i, world_x, world_y, +1, +1), +1, +1, SQRT2);
+      grid[i].SetPtr(5, GridNeighbor(i, world_x, world_y,  0, +1),  0, +1, 1.0);
+      grid[i].SetPtr(6, GridNeighbor(i, world_x, world_y, -1, +1), -1, +1, SQRT2);
+      grid[i].SetPtr(7, GridNeighbor(i, world_x, world_y, -1,  0), -1,  0, 1.0);
+    }
+    if (geometry == GEOM_GRID) {
+      for (int i = 0; i < world_x; i++) {
+        grid[i].SetPtr(0, -99, -99, -99, -99.0);
+        grid[i].SetPtr(1, -99, -99, -99, -99.0);
+        grid[i].SetPtr(2, -99, -99, -99, -99.0);
+        const int ii = num_cells - 1 - i;
+        grid[ii].SetPtr(4, -99, -99, -99, -99.0);
+        grid[ii].SetPtr(5, -99, -99, -99, -99.0);
+        grid[ii].SetPtr(6, -99, -99, -99, -99.0);
+      }
+      for (int i = 0; i < world_y; i++) {
+        int ii = i * world_x;
+        grid[ii].SetPtr(0, -99, -99, -99, -99.0);
+        grid[ii].SetPtr(7, -99, -99, -99, -99.0);
+        grid[ii].SetPtr(6, -99, -99, -99, -99.0);
+        ii = ((i + 1) * world_x) - 1;
+        grid[ii].SetPtr(2, -99, -99, -99, -99.0);
+        grid[ii].SetPtr(3, -99, -99, -99, -99.0);
+        grid[ii].SetPtr(4, -99, -99, -99, -99.0);
+      }
+    }
+  }
+
+  void Source(double amount)
+  {
+    const double totalcells = (p.inflowY2 - p.inflowY1 + 1) * (p.inflowX2 - p.inflowX1 + 1) * 1.0;
+    amount /= totalcells;
+    for (int i = p.inflowY1; i <= p.inflowY2; i++) {
+      for (int j = p.inflowX1; j <= p.inflowX2; j++) {
+        grid[(Mod(i, world_y) * world_x) + Mod(j, world_x)].delta += amount;
+      }
+    }
+  }
+
+  void Sink(double decay)
+  {
+    for (int i = p.outflowY1; i <= p.outflowY2; i++) {
+      for (int j = p.outflowX1; j <= p.outflowX2; j++) {
+        cOldElem& elem = grid[(Mod(i, world_y) * world_x) + Mod(j, world_x)];
+        const double deltaamount = elem.amount * (1.0 - decay);
+        elem.delta -= (deltaamount > 0.0) ? deltaamount : 0.0;
+      }
+    }
+  }
+
+  void FlowAll()
+  {
+    if ((p.xdiffuse == 0.0) && (p.ydiffuse == 0.0) && (p.xgravity == 0.0) && (p.ygravity == 0.0)) return;
+    for (int i = 0; i < num_cells; i++) {
+      for (int k = 3; k <= 6; k++) {
+        const int ii = grid[i].elempt[k];
+        if (ii >= 0) {
+          FlowMatter(grid[i], grid[ii], p.xdiffuse, p.ydiffuse, p.xgravity, p.ygravity,
+                     grid[i].xdist[k], grid[i].ydist[k], grid[i].dist[k]);
+        }
+      }
+    }
+  }
+
+  void StateAll()
+  {
+    for (int i = 0; i < num_cells; i++) {
+      grid[i].amount += grid[i].delta;
+      grid[i].delta = 0.0;
+    }
+  }
+
+  void Step() { Source(p.inflow); Sink(p.decay); FlowAll(); StateAll(); }
+  double GetAmount(int i) const { return grid[i].amount; }
+};
+
+
+// ---- Current layout: cSpatialResCount from main/ ------------------------------------------------------------------
+
+class cNewRes {
+private:
+  sResParams p;
+  cSpatialResCount res;
+
+public:
+  cNewRes(const sResParams& in_p, int x, int y, int geometry)
+    : p(in_p), res(x, y, geometry, in_p.xdiffuse, in_p.ydiffuse, in_p.xgravity, in_p.ygravity)
+  {
+    res.SetInflowX1(p.inflowX1);
+    res.SetInflowX2(p.inflowX2);
+    res.SetInflowY1(p.inflowY1);
+    res.SetInflowY2(p.inflowY2);
+    res.SetOutflowX1(p.outflowX1);
+    res.SetOutflowX2(p.outflowX2);
+    res.SetOutflowY1(p.outflowY1);
+    res.SetOutflowY2(p.outflowY2);
+  }
+
+  void Step() { res.Source(p.inflow); res.Sink(p.decay); res.FlowAll(); res.StateAll(); }
+  double GetAmount(int i) const { return res.GetElementAmount(i); }
+};
+
+
+// ---- Driver -------------------------------------------------------------------------------------------------------
+
+// Resources differ in their diffusion, gravity and inflow/outflow rectangles so that every branch of the flow kernel
+// is taken
+static sResParams MakeParams(int r, int x, int y)
+{
+  sResParams p;
+  p.xdiffuse = 0.2 + 0.6 * ((r * 37) % 11) / 10.0;
+  p.ydiffuse = 0.1 + 0.8 * ((r * 53) % 7) / 6.0;
+  p.xgravity = ((r % 3) - 1) * 0.05;
+  p.ygravity = (((r / 3) % 3) - 1) * 0.03;
+  p.inflow = 10.0 + r;
+  p.decay = 0.99 - 0.001 * (r % 5);
+  p.inflowX1 = (r * 7) % x;
+  p.inflowX2 = p.inflowX1 + x / 8;
+  p.inflowY1 = (r * 13) % y;
+  p.inflowY2 = p.inflowY1 + y / 8;
+  p.outflowX1 = (r * 11 + x / 2) % x;
+  p.outflowX2 = p.outflowX1 + x / 4;
+  p.outflowY1 = (r * 5 + y / 2) % y;
+  p.outflowY2 = p.outflowY1 + y / 4;
+  return p;
+}
+
+template <class T> static double RunAll(vector<T*>& res, int updates)
+{
+  const clock_t start = clock();
+  for (int u = 0; u < updates; u++) {
+    for (size_t r = 0; r < res.size(); r++) res[r]->Step();
+  }
+  return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static bool RunCase(const char* name, int geometry, int x, int y, int num_res, int updates)
+{
+  vector<cOldRes*> old_res;
+  vector<cNewRes*> new_res;
+  for (int r = 0; r < num_res; r++) {
+    old_res.push_back(new cOldRes(MakeParams(r, x, y), x, y, geometry));
+    new_res.push_back(new cNewRes(MakeParams(r, x, y), x, y, geometry));
+  }
+
+  const double old_secs = RunAll(old_res, updates);
+  const double new_secs = RunAll(new_res, updates);
+
+  int mismatches = 0;
+  for (int r = 0; r < num_res; r++) {
+    for (int i = 0; i < x * y; i++) {
+      const double a = old_res[r]->GetAmount(i);
+      const double b = new_res[r]->GetAmount(i);
+      if (memcmp(&a, &b, sizeof(double)) != 0) mismatches++;
+    }
+    delete old_res[r];
+    delete new_res[r];
+  }
+
+  const double steps = double(updates) * num_res;
+  printf("%-6s %4dx%-4d %3d res %5d upd   old %9.3f us/step   new %9.3f us/step   speedup %5.2fx   %s\n",
+         name, x, y, num_res, updates, old_secs * 1.0e6 / steps, new_secs * 1.0e6 / steps,
+         (new_secs > 0.0) ? (old_secs / new_secs) : 0.0, (mismatches == 0) ? "identical" : "MISMATCH");
+  if (mismatches) printf("  %d of %d cell amounts differ\n", mismatches, x * y * num_res);
+
+  return (mismatches == 0);
+}
+
+int main(int argc, char* argv[])
+{
+  bool ok = true;
+  if (argc == 5) {
+    const int x = atoi(argv[1]), y = atoi(argv[2]), num_res = atoi(argv[3]), updates = atoi(argv[4]);
+    ok &= RunCase("torus", GEOM_TORUS, x, y, num_res, updates);
+    ok &= RunCase("grid", GEOM_GRID, x, y, num_res, updates);
+  } else if (argc == 1) {
+    ok &= RunCase("torus", GEOM_TORUS, 60, 60, 4, 2000);
+    ok &= RunCase("grid", GEOM_GRID, 60, 60, 4, 2000);
+    ok &= RunCase("torus", GEOM_TORUS, 200, 200, 4, 200);
+    ok &= RunCase("grid", GEOM_GRID, 200, 200, 4, 200);
+    ok &= RunCase("torus", GEOM_TORUS, 1000, 1000, 2, 20);
+  } else {
+    fprintf(stderr, "Usage: %s [world_x world_y resources updates]\n", argv[0]);
+    return 1;
+  }
+  return ok ? 0 : 1;
+}
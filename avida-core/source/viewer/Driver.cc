@@ -473,7 +473,7 @@ void Avida::Viewer::Driver::StdIOFeedback::Error(const char* fmt, ...)
   printf("error: ");
   va_list args;
   va_start(args, fmt);
-  printf(fmt, args);
+  vprintf(fmt, args);
   va_end(args);
   printf("\n");
 }
@@ -483,7 +483,7 @@ void Avida::Viewer::Driver::StdIOFeedback::Warning(const char* fmt, ...)
   printf("warning: ");
   va_list args;
   va_start(args, fmt);
-  printf(fmt, args);
+  vprintf(fmt, args);
   va_end(args);
   printf("\n");
 }
@@ -492,7 +492,7 @@ void Avida::Viewer::Driver::StdIOFeedback::Notify(const char* fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
-  printf(fmt, args);
+  vprintf(fmt, args);
   va_end(args);
   printf("\n");
 }
@@ -51,6 +51,7 @@ private:
   static const double MAX_RESCALE_FACTOR;
 private:
   const Apto::String m_prop_id;
+  const Avida::PropertyAtom m_prop_atom;
   Apto::String m_prop_desc;
   Apto::String m_prop_desc_rescale;
   
@@ -66,7 +67,7 @@ private:
   
 public:
   DoublePropMapMode(cWorld* world, const Apto::String& prop_id, const Apto::String& prop_desc)
-  : m_prop_id(prop_id), m_prop_desc(prop_desc), m_color_count(SCALE_MAX + Avida::Viewer::MAP_RESERVED_COLORS), m_scale_labels(SCALE_LABELS)
+  : m_prop_id(prop_id), m_prop_atom(Avida::PropertyAtoms::Intern(prop_id)), m_prop_desc(prop_desc), m_color_count(SCALE_MAX + Avida::Viewer::MAP_RESERVED_COLORS), m_scale_labels(SCALE_LABELS)
   , m_cur_min(0.0), m_cur_max(0.0), m_target_max(0.0), m_rescale_rate_min(0.0), m_rescale_rate_max(0.0)
   {
     m_color_grid.Resize(world->GetPopulation().GetSize());
@@ -118,7 +119,7 @@ void DoublePropMapMode::Update(cPopulation& pop)
   for (int i = 0; i < pop.GetSize(); i++) {
     cOrganism* org = pop.GetCell(i).GetOrganism();
     if (org == NULL) continue;
-    double fit = org->Properties().Get(m_prop_id);
+    double fit = org->Properties().Get(m_prop_atom);
     if (fit == 0.0) continue;
     if (fit > max_fit) max_fit = fit;
     if (fit < min_fit) min_fit = fit;
@@ -174,7 +175,7 @@ void DoublePropMapMode::Update(cPopulation& pop)
       continue;
     }
     
-    double fit = org->Properties().Get(m_prop_id);
+    double fit = org->Properties().Get(m_prop_atom);
     if (fit == 0.0) {
       m_color_grid[i] = Avida::Viewer::MAP_RESERVED_COLOR_DARK_GRAY;
       m_color_count[Avida::Viewer::MAP_RESERVED_COLORS - Avida::Viewer::MAP_RESERVED_COLOR_DARK_GRAY]++;
@@ -0,0 +1,37 @@
+#!/bin/sh
+#
+# Runs the experiment straight through, saving a checkpoint at update 10, and again restored from that checkpoint.
+# Every data file and population dump the restored run writes must match the straight run from update 11 on; the
+# result is recorded in restore_check.txt, which the test compares against expected/.
+#
+# usage: restore_check.sh <avida>
+
+avida="$1"
+
+"$avida" -s 100 -set CHECKPOINT_RNG_STREAMS 1 -set EVENT_FILE events-full.cfg -set DATA_DIR full || exit 1
+"$avida" -s 100 -set CHECKPOINT_RNG_STREAMS 1 -set EVENT_FILE events-restored.cfg -set DATA_DIR restored || exit 1
+
+# Rows of a data file after the checkpoint, without the comment header (which includes the time of the run)
+rows()
+{
+  case "$1" in
+    *.dat) awk '!/^#/ && NF > 0 && $1 > 10' "$1" ;;
+    *) awk '!/^#/ && NF > 0' "$1" ;;
+  esac
+}
+
+status=0
+: > restore_check.txt
+for file in average.dat count.dat time.dat tasks.dat resource.dat dominant.dat detail-20.spop detail-30.spop; do
+  if [ ! -s "full/$file" ] || [ ! -s "restored/$file" ]; then
+    echo "$file: missing" >> restore_check.txt
+    status=1
+  elif [ "`rows full/$file`" = "`rows restored/$file`" ]; then
+    echo "$file: identical" >> restore_check.txt
+  else
+    echo "$file: differs" >> restore_check.txt
+    status=1
+  fi
+done
+
+exit $status
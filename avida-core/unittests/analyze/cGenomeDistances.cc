@@ -0,0 +1,110 @@
+/*
+ *  unittests/analyze/cGenomeDistances.cc
+ *  avida-core
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "apto/rng.h"
+#include "avida/core/InstructionSequence.h"
+
+#include "cGenomeDistances.h"
+
+#include "gtest/gtest.h"
+
+using namespace Avida;
+
+
+// Sequence lengths around the 64 row word boundaries of the bit-parallel kernel
+static const int s_lengths[] = { 0, 1, 2, 31, 63, 64, 65, 100, 127, 128, 129, 200 };
+static const int s_num_lengths = sizeof(s_lengths) / sizeof(s_lengths[0]);
+
+
+static InstructionSequence randomSequence(Apto::Random& rng, int size, int alphabet)
+{
+  InstructionSequence seq(size);
+  for (int i = 0; i < size; i++) seq[i] = Instruction(rng.GetUInt(alphabet));
+  return seq;
+}
+
+// A few random point mutations, insertions and deletions, so that distances stay small
+static InstructionSequence mutateSequence(Apto::Random& rng, const InstructionSequence& seq, int alphabet)
+{
+  InstructionSequence mut(seq);
+  const int num_muts = rng.GetUInt(5);
+  for (int i = 0; i < num_muts; i++) {
+    switch (rng.GetUInt(3)) {
+      case 0: if (mut.GetSize()) mut[rng.GetUInt(mut.GetSize())] = Instruction(rng.GetUInt(alphabet)); break;
+      case 1: mut.Insert(rng.GetUInt(mut.GetSize() + 1), Instruction(rng.GetUInt(alphabet))); break;
+      case 2: if (mut.GetSize()) mut.Remove(rng.GetUInt(mut.GetSize())); break;
+    }
+  }
+  return mut;
+}
+
+static void expectSameDistances(const InstructionSequence& seq1, const InstructionSequence& seq2)
+{
+  SCOPED_TRACE((const char*)(seq1.AsString() + " / " + seq2.AsString()));
+  EXPECT_EQ(InstructionSequence::FindEditDistance(seq1, seq2),
+            cGenomeDistances::CalcDistance(cGenomeDistances::EDIT, seq1, seq2));
+  EXPECT_EQ(InstructionSequence::FindHammingDistance(seq1, seq2),
+            cGenomeDistances::CalcDistance(cGenomeDistances::HAMMING, seq1, seq2));
+}
+
+
+TEST(cGenomeDistances, EmptySequences)
+{
+  Apto::RNG::AvidaRNG rng(1);
+  const InstructionSequence empty;
+  expectSameDistances(empty, empty);
+  for (int i = 1; i < s_num_lengths; i++) {
+    const InstructionSequence seq = randomSequence(rng, s_lengths[i], 26);
+    expectSameDistances(empty, seq);
+    expectSameDistances(seq, empty);
+  }
+}
+
+TEST(cGenomeDistances, MatchesDynamicProgramming)
+{
+  Apto::RNG::AvidaRNG rng(1);
+
+  // Unrelated sequences over a small and a full alphabet, for every pair of lengths
+  const int alphabets[] = { 2, 4, 26, 256 };
+  for (int a = 0; a < 4; a++) {
+    for (int i = 0; i < s_num_lengths; i++) {
+      for (int j = 0; j < s_num_lengths; j++) {
+        expectSameDistances(randomSequence(rng, s_lengths[i], alphabets[a]),
+                            randomSequence(rng, s_lengths[j], alphabets[a]));
+      }
+    }
+  }
+}
+
+TEST(cGenomeDistances, MatchesDynamicProgrammingOnRelatives)
+{
+  Apto::RNG::AvidaRNG rng(2);
+
+  // Close relatives, where the distance is far below the length and differences sit on either side of word boundaries
+  for (int i = 0; i < s_num_lengths; i++) {
+    for (int trial = 0; trial < 200; trial++) {
+      const InstructionSequence seq = randomSequence(rng, s_lengths[i], 26);
+      const InstructionSequence mut = mutateSequence(rng, seq, 26);
+      expectSameDistances(seq, mut);
+      expectSameDistances(mut, seq);
+    }
+  }
+}
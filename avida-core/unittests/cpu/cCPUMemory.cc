@@ -0,0 +1,155 @@
+/*
+ *  unittests/cpu/cCPUMemory.cc
+ *  avida-core
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "apto/rng.h"
+
+#include "cAvidaConfig.h"
+#include "cCPUMemory.h"
+#include "cHardwareExperimental.h"
+#include "cInstSet.h"
+#include "cStringList.h"
+#include "cUserFeedback.h"
+#include "cWorld.h"
+
+#include "gtest/gtest.h"
+
+using namespace Avida;
+
+
+// The instruction set only needs the world for its configuration.  The world is not set up, so it is never destroyed.
+class cConfigOnlyWorld : public cWorld
+{
+public:
+  cConfigOnlyWorld() : cWorld(new cAvidaConfig, "") { ; }
+};
+
+// Three nops, a label and two other instructions (ops 0-2 are nops, op 3 is the label)
+static cInstSet* buildInstSet()
+{
+  static cConfigOnlyWorld* world = new cConfigOnlyWorld;
+  cInstSet* inst_set = new cInstSet(world, "test", 0, cHardwareExperimental::GetInstLib(), 10, 1);
+
+  cStringList sl;
+  sl.PushRear("INST nop-A");
+  sl.PushRear("INST nop-B");
+  sl.PushRear("INST nop-C");
+  sl.PushRear("INST label");
+  sl.PushRear("INST inc");
+  sl.PushRear("INST dec");
+  cUserFeedback feedback;
+  EXPECT_TRUE(inst_set->LoadWithStringList(sl, &feedback));
+  return inst_set;
+}
+
+static InstructionSequence randomSequence(Apto::Random& rng, const cInstSet& inst_set, int size)
+{
+  InstructionSequence seq(size);
+  for (int i = 0; i < size; i++) seq[i] = Instruction(rng.GetUInt(inst_set.GetSize()));
+  return seq;
+}
+
+// Compare the label index against a scan of the memory with the same instruction set
+static void checkIndex(const cCPUMemory& mem, const cInstSet& inst_set)
+{
+  const Apto::Array<cCPUMemory::sNopRun, Apto::Smart>& runs = mem.GetNopRuns(inst_set);
+  const Apto::Array<int, Apto::Smart>& labels = mem.GetLabelSites(inst_set);
+
+  int run = 0;
+  int label = 0;
+  for (int pos = 0; pos < mem.GetSize(); pos++) {
+    if (inst_set.IsLabel(mem[pos])) {
+      ASSERT_LT(label, labels.GetSize());
+      EXPECT_EQ(pos, labels[label++]);
+    }
+    if (inst_set.IsNop(mem[pos]) && (pos == 0 || !inst_set.IsNop(mem[pos - 1]))) {
+      int end = pos;
+      while (end < mem.GetSize() && inst_set.IsNop(mem[end])) end++;
+      ASSERT_LT(run, runs.GetSize());
+      EXPECT_EQ(pos, runs[run].start);
+      EXPECT_EQ(end, runs[run].end);
+      run++;
+    }
+  }
+  EXPECT_EQ(label, labels.GetSize());
+  EXPECT_EQ(run, runs.GetSize());
+}
+
+
+TEST(cCPUMemory, LabelIndexFollowsEdits)
+{
+  cInstSet* inst_set = buildInstSet();
+  Apto::RNG::AvidaRNG rng(1);
+
+  cCPUMemory mem(randomSequence(rng, *inst_set, 50));
+  checkIndex(mem, *inst_set);
+
+  for (int step = 0; step < 5000; step++) {
+    const int size = mem.GetSize();
+    const int pos = rng.GetUInt(size);
+
+    switch (rng.GetUInt(10)) {
+      case 0: mem[pos] = Instruction(rng.GetUInt(inst_set->GetSize())); break;
+      case 1: mem.Insert(rng.GetUInt(size + 1), Instruction(rng.GetUInt(inst_set->GetSize()))); break;
+      case 2: mem.Insert(rng.GetUInt(size + 1), randomSequence(rng, *inst_set, 1 + rng.GetUInt(5))); break;
+      case 3: if (size > 10) mem.Remove(pos, 1 + rng.GetUInt(Apto::Min(5, size - pos))); break;
+      case 4: mem.Replace(pos, rng.GetUInt(Apto::Min(5, size - pos) + 1), randomSequence(rng, *inst_set, rng.GetUInt(6))); break;
+      case 5: {
+        // Circular replacement; begin > end wraps around the end of the memory
+        const int end = rng.GetUInt(size);
+        mem.Replace(randomSequence(rng, *inst_set, 1 + rng.GetUInt(6)), pos, end);
+        break;
+      }
+      case 6: mem.Rotate(rng.GetUInt(size)); break;
+      case 7: mem.Copy(rng.GetUInt(size), pos); break;
+      case 8: mem.Resize(Apto::Max(10, size + static_cast<int>(rng.GetUInt(11)) - 5)); break;
+      case 9: mem = randomSequence(rng, *inst_set, 20 + rng.GetUInt(60)); break;
+    }
+
+    // Keep the memory from shrinking away or growing without bound
+    if (mem.GetSize() < 10) mem.Insert(0, randomSequence(rng, *inst_set, 10));
+    if (mem.GetSize() > 200) mem.Remove(0, mem.GetSize() - 100);
+
+    checkIndex(mem, *inst_set);
+    if (HasFailure()) break;
+  }
+
+  delete inst_set;
+}
+
+TEST(cCPUMemory, LabelIndexFollowsBaseClassEdits)
+{
+  // Edits through a reference to the base class reach the overrides as well
+  cInstSet* inst_set = buildInstSet();
+  Apto::RNG::AvidaRNG rng(2);
+
+  cCPUMemory mem(randomSequence(rng, *inst_set, 40));
+  InstructionSequence& seq = mem;
+
+  checkIndex(mem, *inst_set);
+  seq.Rotate(17);
+  checkIndex(mem, *inst_set);
+  seq.Replace(randomSequence(rng, *inst_set, 12), 35, 5);
+  checkIndex(mem, *inst_set);
+  seq.Replace(randomSequence(rng, *inst_set, 3), 10, 10);
+  checkIndex(mem, *inst_set);
+
+  delete inst_set;
+}
@@ -0,0 +1,185 @@
+/*
+ *  unittests/cpu/cTestCPU.cc
+ *  avida-core
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "apto/rng.h"
+#include "avida/Avida.h"
+#include "avida/core/World.h"
+
+#include "cAvidaConfig.h"
+#include "cCPUTestInfo.h"
+#include "cHardwareManager.h"
+#include "cOrganism.h"
+#include "cPhenotype.h"
+#include "cTestCPU.h"
+#include "cTestCPUSnapshots.h"
+#include "cUserFeedback.h"
+#include "cWorld.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+using namespace Avida;
+
+
+// The default heads ancestor with a shorter copy loop filler, in the symbols of instset-heads.cfg
+static const char* s_ancestor = "0,heads_default,wzcagcccccccccccccccccccczvfcaxgab";
+static const char* s_inst_names[] = {
+  "nop-A", "nop-B", "nop-C", "if-n-equ", "if-less", "if-label", "mov-head", "jmp-head", "get-head", "set-flow",
+  "shift-r", "shift-l", "inc", "dec", "push", "pop", "swap-stk", "swap", "add", "sub", "nand", "h-copy", "h-alloc",
+  "h-divide", "IO", "h-search"
+};
+static const int s_num_insts = sizeof(s_inst_names) / sizeof(s_inst_names[0]);
+
+static const char* s_cfg_files[] = { "avida.cfg", "environment.cfg", "events.cfg" };
+
+
+// Write a heads configuration with the logic-9 environment to a scratch directory and build a world from it
+static cWorld* buildWorld(cString& dir)
+{
+  char dir_template[] = "/tmp/avida-testcpu-XXXXXX";
+  if (mkdtemp(dir_template) == NULL) return NULL;
+  dir = dir_template;
+
+  std::ofstream cfg(dir + "/avida.cfg");
+  cfg << "WORLD_X 5" << std::endl << "WORLD_Y 5" << std::endl << "RANDOM_SEED 1" << std::endl;
+  cfg << "TEST_CPU_SNAPSHOT_INTERVAL 10" << std::endl << "TEST_CPU_CACHE_SIZE 0" << std::endl;
+  cfg << "ENVIRONMENT_FILE environment.cfg" << std::endl << "EVENT_FILE events.cfg" << std::endl;
+  cfg << "INSTSET heads_default:hw_type=0" << std::endl;
+  for (int i = 0; i < s_num_insts; i++) cfg << "INST " << s_inst_names[i] << std::endl;
+  cfg.close();
+
+  std::ofstream env(dir + "/environment.cfg");
+  const char* tasks[] = { "not", "nand", "and", "orn", "or", "andn", "nor", "xor", "equ" };
+  for (int i = 0; i < 9; i++) {
+    env << "REACTION R" << i << " " << tasks[i] << " process:value=" << (1 + i / 2) << ".0:type=pow requisite:max_count=1";
+    env << std::endl;
+  }
+  env.close();
+
+  std::ofstream events(dir + "/events.cfg");
+  events.close();
+
+  Avida::Initialize();
+  cAvidaConfig* cfg_obj = new cAvidaConfig();
+  cUserFeedback feedback;
+  if (!cfg_obj->Load("avida.cfg", dir, &feedback)) {
+    delete cfg_obj;
+    return NULL;
+  }
+  return cWorld::Initialize(cfg_obj, dir, new World(), &feedback);
+}
+
+static void removeWorldDir(cString dir)
+{
+  const int num_files = sizeof(s_cfg_files) / sizeof(s_cfg_files[0]);
+  for (int i = 0; i < num_files; i++) std::remove(dir + "/" + s_cfg_files[i]);
+  rmdir(dir + "/data");
+  rmdir(dir);
+}
+
+// The results of a test resumed from a snapshot must match a from-scratch test of the same genome in every respect
+static void expectSameResults(cCPUTestInfo& resumed, cCPUTestInfo& scratch)
+{
+  EXPECT_EQ(scratch.IsViable(), resumed.IsViable());
+  EXPECT_EQ(scratch.GetMaxDepth(), resumed.GetMaxDepth());
+  EXPECT_EQ(scratch.GetDepthFound(), resumed.GetDepthFound());
+  EXPECT_EQ(scratch.GetMaxCycle(), resumed.GetMaxCycle());
+  EXPECT_EQ(scratch.GetCycleTo(), resumed.GetCycleTo());
+  EXPECT_EQ(scratch.GetGenotypeFitness(), resumed.GetGenotypeFitness());
+  EXPECT_EQ(scratch.GetColonyFitness(), resumed.GetColonyFitness());
+  EXPECT_EQ(scratch.GetColonyMerit(), resumed.GetColonyMerit());
+  EXPECT_EQ(scratch.GetColonyGestationTime(), resumed.GetColonyGestationTime());
+
+  const Apto::Array<int>& scratch_tasks = scratch.GetColonyTaskCounts();
+  const Apto::Array<int>& resumed_tasks = resumed.GetColonyTaskCounts();
+  ASSERT_EQ(scratch_tasks.GetSize(), resumed_tasks.GetSize());
+  for (int i = 0; i < scratch_tasks.GetSize(); i++) EXPECT_EQ(scratch_tasks[i], resumed_tasks[i]);
+
+  // The parent gestation is the part that was resumed, so compare its outcome directly as well
+  cPhenotype& scratch_phen = scratch.GetTestPhenotype(0);
+  cPhenotype& resumed_phen = resumed.GetTestPhenotype(0);
+  ASSERT_EQ(scratch_phen.GetNumDivides(), resumed_phen.GetNumDivides());
+  EXPECT_EQ(scratch_phen.GetGestationTime(), resumed_phen.GetGestationTime());
+  EXPECT_EQ(scratch_phen.GetCPUCyclesUsed(), resumed_phen.GetCPUCyclesUsed());
+  if (scratch_phen.GetNumDivides() > 0) {
+    EXPECT_EQ(scratch.GetTestOrganism(0)->OffspringGenome().AsString(),
+              resumed.GetTestOrganism(0)->OffspringGenome().AsString());
+  }
+}
+
+
+TEST(cTestCPU, ResumedMutantsMatchFullTests)
+{
+  cString dir;
+  cWorld* world = buildWorld(dir);
+  ASSERT_TRUE(world != NULL);
+  cAvidaContext& ctx = world->GetDefaultContext();
+  cTestCPU* test_cpu = world->GetHardwareManager().CreateTestCPU(ctx);
+
+  const Genome base_genome(s_ancestor);
+  ConstInstructionSequencePtr base_seq_p;
+  base_seq_p.DynamicCastFrom(base_genome.Representation());
+  const InstructionSequence& base_seq = *base_seq_p;
+
+  cTestCPUSnapshots snapshots;
+  cCPUTestInfo base_info;
+  test_cpu->RecordSnapshots(ctx, base_info, base_genome, snapshots);
+  ASSERT_TRUE(base_info.IsViable());
+  ASSERT_GT(snapshots.GetSize(), 0);
+
+  // Every single point mutant, followed by random two-step mutants
+  Apto::RNG::AvidaRNG rng(1);
+  int resumed_count = 0;
+  const int num_single = base_seq.GetSize() * s_num_insts;
+  for (int test = 0; test < num_single + 500; test++) {
+    Genome mutant(base_genome);
+    InstructionSequencePtr seq;
+    seq.DynamicCastFrom(mutant.Representation());
+    if (test < num_single) {
+      (*seq)[test / s_num_insts] = Instruction(test % s_num_insts);
+    } else {
+      (*seq)[rng.GetUInt(seq->GetSize())] = Instruction(rng.GetUInt(s_num_insts));
+      (*seq)[rng.GetUInt(seq->GetSize())] = Instruction(rng.GetUInt(s_num_insts));
+    }
+
+    SCOPED_TRACE((const char*)mutant.AsString());
+    if (snapshots.GetResumePoint(mutant) >= 0) resumed_count++;
+
+    cCPUTestInfo resumed_info;
+    test_cpu->TestGenome(ctx, resumed_info, mutant, snapshots);
+    cCPUTestInfo scratch_info;
+    test_cpu->TestGenome(ctx, scratch_info, mutant);
+
+    expectSameResults(resumed_info, scratch_info);
+    if (HasFailure()) break;
+  }
+
+  // Mutations late in the genome are not touched until the copy loop, so many tests must have been resumed
+  EXPECT_GT(resumed_count, num_single / 4);
+
+  delete test_cpu;
+  delete world;
+  removeWorldDir(dir);
+}
@@ -0,0 +1,256 @@
+/*
+ *  unittests/main/cEnvironment.cc
+ *  avida-core
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "apto/rng.h"
+#include "avida/Avida.h"
+#include "avida/core/World.h"
+
+#include "cAvidaConfig.h"
+#include "cAvidaContext.h"
+#include "cEnvironment.h"
+#include "cEnvReqs.h"
+#include "cReaction.h"
+#include "cReactionLib.h"
+#include "cReactionResult.h"
+#include "cTaskContext.h"
+#include "cTaskEntry.h"
+#include "cTaskLib.h"
+#include "cUserFeedback.h"
+#include "cWorld.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+using namespace Avida;
+
+
+// Every task that depends only on the logic ID, plus two that do not
+static Apto::Array<cString> taskNames()
+{
+  static const char* logic_tasks[] = { "not", "nand", "and", "orn", "or", "andn", "nor", "xor", "equ" };
+  Apto::Array<cString> names;
+  for (int i = 0; i < 9; i++) {
+    names.Push(logic_tasks[i]);
+    names.Push(cString(logic_tasks[i]) + "_dup");
+  }
+  for (int i = 0; i < 68; i++) names.Push(cStringUtil::Stringf("logic_3%c%c", 'A' + i / 26, 'A' + i % 26));
+  names.Push("echo");
+  names.Push("add");
+  return names;
+}
+
+// The logic ID as computed by the original cTaskLib::SetupTests, one bit position at a time
+static int referenceLogicId(const tBuffer<int>& input_buffer, const tBuffer<int>& output_buffer)
+{
+  const int num_inputs = input_buffer.GetNumStored();
+  int test_inputs[3];
+  for (int i = 0; i < 3; i++) test_inputs[i] = (num_inputs > i) ? input_buffer[i] : 0;
+  int test_output = output_buffer.GetNumStored() ? output_buffer[0] : 0;
+
+  int logic_out[8];
+  for (int i = 0; i < 8; i++) logic_out[i] = -1;
+  for (int test_pos = 0; test_pos < 32; test_pos++) {
+    int logic_pos = 0;
+    for (int i = 0; i < 3; i++) logic_pos += (test_inputs[i] & 1) << i;
+    if (logic_out[logic_pos] != -1 && logic_out[logic_pos] != (test_output & 1)) return -1;
+    logic_out[logic_pos] = test_output & 1;
+    test_output >>= 1;
+    for (int i = 0; i < 3; i++) test_inputs[i] >>= 1;
+  }
+
+  if (num_inputs < 1) logic_out[1] = logic_out[0];
+  if (num_inputs < 2) {
+    logic_out[2] = logic_out[0];
+    logic_out[3] = logic_out[1];
+  }
+  if (num_inputs < 3) {
+    for (int i = 4; i < 8; i++) logic_out[i] = logic_out[i - 4];
+  }
+
+  int logic_id = 0;
+  for (int i = 0; i < 8; i++) logic_id += logic_out[i] << i;
+  return logic_id;
+}
+
+// Inputs as cEnvironment::SetupInputs makes them, so that every input combination occurs, and an output that is
+// sometimes a logic function of them and sometimes not
+static void randomTest(Apto::Random& rng, tBuffer<int>& inputs, tBuffer<int>& outputs)
+{
+  const int num_inputs = (rng.GetUInt(4) == 0) ? 1 + rng.GetUInt(2) : 3;
+  const int in[3] = { (15 << 24) + (int)rng.GetUInt(1 << 24), (51 << 24) + (int)rng.GetUInt(1 << 24),
+                      (85 << 24) + (int)rng.GetUInt(1 << 24) };
+  for (int i = 0; i < num_inputs; i++) inputs.Add(in[i]);
+
+  const unsigned int a = inputs[0];
+  const unsigned int b = (num_inputs > 1) ? inputs[1] : 0;
+  const unsigned int c = (num_inputs > 2) ? inputs[2] : 0;
+  int output = 0;
+  switch (rng.GetUInt(4)) {
+    case 0: {
+      const int logic_id = rng.GetUInt(256);
+      unsigned int out = 0;
+      for (int pos = 0; pos < 8; pos++) {
+        if (logic_id & (1 << pos)) out |= ((pos & 1) ? a : ~a) & ((pos & 2) ? b : ~b) & ((pos & 4) ? c : ~c);
+      }
+      output = out;
+      break;
+    }
+    case 1: output = rng.GetUInt(0xffffffff); break;
+    case 2: output = inputs[rng.GetUInt(num_inputs)]; break;
+    case 3: output = inputs[0] + inputs[num_inputs - 1]; break;
+  }
+  outputs.Add(output);
+}
+
+// Write a configuration with one reaction per task to a scratch directory and build a world from it
+static cWorld* buildWorld(cString& dir)
+{
+  char dir_template[] = "/tmp/avida-environment-XXXXXX";
+  if (mkdtemp(dir_template) == NULL) return NULL;
+  dir = dir_template;
+
+  std::ofstream cfg(dir + "/avida.cfg");
+  cfg << "WORLD_X 5" << std::endl << "WORLD_Y 5" << std::endl << "RANDOM_SEED 1" << std::endl;
+  cfg << "ENVIRONMENT_FILE environment.cfg" << std::endl << "EVENT_FILE events.cfg" << std::endl;
+  cfg << "INSTSET heads_default:hw_type=0" << std::endl << "INST nop-A" << std::endl << "INST nop-B" << std::endl;
+  cfg << "INST nop-C" << std::endl << "INST h-alloc" << std::endl << "INST h-copy" << std::endl;
+  cfg << "INST h-divide" << std::endl << "INST IO" << std::endl;
+  cfg.close();
+
+  std::ofstream env(dir + "/environment.cfg");
+  const Apto::Array<cString> names = taskNames();
+  for (int i = 0; i < names.GetSize(); i++) {
+    env << "REACTION R" << i << " " << (const char*)names[i] << " process:value=1.0:type=pow";
+    env << std::endl;
+  }
+  env.close();
+
+  std::ofstream events(dir + "/events.cfg");
+  events.close();
+
+  Avida::Initialize();
+  cAvidaConfig* cfg_obj = new cAvidaConfig();
+  cUserFeedback feedback;
+  if (!cfg_obj->Load("avida.cfg", dir, &feedback)) {
+    delete cfg_obj;
+    return NULL;
+  }
+  return cWorld::Initialize(cfg_obj, dir, new World(), &feedback);
+}
+
+static void removeWorldDir(cString dir)
+{
+  std::remove(dir + "/avida.cfg");
+  std::remove(dir + "/environment.cfg");
+  std::remove(dir + "/events.cfg");
+  rmdir(dir + "/data");
+  rmdir(dir);
+}
+
+
+TEST(cEnvironment, LogicIdTableMatchesTaskFunctions)
+{
+  cTaskLib tasklib(NULL);
+  cEnvReqs envreqs;
+  cUserFeedback feedback;
+  const Apto::Array<cString> names = taskNames();
+  for (int i = 0; i < names.GetSize(); i++) ASSERT_TRUE(tasklib.AddTask(names[i], "", envreqs, feedback) != NULL);
+
+  // Only the logic tasks get a logic ID table
+  for (int i = 0; i < tasklib.GetSize(); i++) {
+    const cTaskEntry& task = tasklib.GetTask(i);
+    EXPECT_EQ(task.GetName() != "echo" && task.GetName() != "add", task.IsLogicOnly()) << (const char*)task.GetName();
+  }
+
+  Apto::RNG::AvidaRNG rng(1);
+  tList<tBuffer<int> > other_buffers;
+  Apto::Array<int, Apto::Smart> ext_mem;
+  for (int trial = 0; trial < 20000; trial++) {
+    tBuffer<int> inputs(3);
+    tBuffer<int> outputs(1);
+    randomTest(rng, inputs, outputs);
+    cTaskContext ctx(NULL, inputs, outputs, other_buffers, other_buffers, ext_mem);
+
+    tasklib.SetupTests(ctx);
+    const int logic_id = ctx.GetLogicId();
+    ASSERT_EQ(referenceLogicId(inputs, outputs), logic_id) << "output " << outputs[0];
+
+    // Evaluating the task itself must agree with the table for every logic task
+    for (int i = 0; i < tasklib.GetSize(); i++) {
+      cTaskEntry* task = tasklib.GetTaskReference(i);
+      if (!task->IsLogicOnly()) continue;
+      ctx.SetTaskEntry(task);
+      EXPECT_EQ(tasklib.TestOutput(ctx) > 0.0, task->IsSatisfiedBy(logic_id))
+        << (const char*)task->GetName() << " logic id " << logic_id;
+    }
+    if (HasFailure()) break;
+  }
+}
+
+TEST(cEnvironment, DispatchMatchesFullEvaluation)
+{
+  cString dir;
+  cWorld* world = buildWorld(dir);
+  ASSERT_TRUE(world != NULL);
+  cAvidaContext& ctx = world->GetDefaultContext();
+  const cEnvironment& env = world->GetEnvironment();
+  const cReactionLib& reactions = env.GetReactionLib();
+  ASSERT_EQ(taskNames().GetSize(), reactions.GetSize());
+
+  // Task functions are evaluated directly through a separate library, as TestOutput did for every reaction
+  cTaskLib tasklib(NULL);
+  Apto::RNG::AvidaRNG rng(2);
+  tList<tBuffer<int> > other_buffers;
+  Apto::Array<int, Apto::Smart> ext_mem;
+  Apto::Array<int> task_count(env.GetNumTasks());
+  task_count.SetAll(0);
+  Apto::Array<double> resource_count;
+  Apto::Array<double> rbins_count;
+
+  for (int trial = 0; trial < 20000; trial++) {
+    tBuffer<int> inputs(3);
+    tBuffer<int> outputs(1);
+    randomTest(rng, inputs, outputs);
+    cTaskContext taskctx(NULL, inputs, outputs, other_buffers, other_buffers, ext_mem);
+
+    // As a parasite with PARASITE_SKIP_REACTIONS set, reactions mark their tasks without running their processes,
+    // which would need an organism
+    Apto::Array<int> reaction_count(reactions.GetSize());
+    reaction_count.SetAll(0);
+    cReactionResult result(env.GetResourceLib().GetSize(), env.GetNumTasks(), reactions.GetSize());
+    env.TestOutput(ctx, result, taskctx, task_count, reaction_count, resource_count, rbins_count, true, NULL);
+
+    for (int i = 0; i < reactions.GetSize(); i++) {
+      cTaskEntry* task = reactions.GetReaction(i)->GetTask();
+      taskctx.SetTaskEntry(task);
+      const bool performed = ((tasklib.*(task->GetTestFun()))(taskctx) > 0.0);
+      EXPECT_EQ(performed, result.TaskDone(task->GetID())) << (const char*)task->GetName() << " output " << outputs[0];
+    }
+    if (HasFailure()) break;
+  }
+
+  delete world;
+  removeWorldDir(dir);
+}
@@ -0,0 +1,180 @@
+/*
+ *  unittests/main/cGenomeUtil.cc
+ *  avida-core
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "apto/rng.h"
+#include "avida/core/InstructionSequence.h"
+
+#include "cAvidaContext.h"
+#include "cGenomeUtil.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using namespace Avida;
+
+
+// Pattern and text lengths around the 64 row word boundaries of the bit-parallel matcher
+static const int s_lengths[] = { 0, 1, 2, 31, 63, 64, 65, 100, 128, 129 };
+static const int s_num_lengths = sizeof(s_lengths) / sizeof(s_lengths[0]);
+
+
+// The original dynamic programming matcher, which tracks the beginning of the match in every cell of the table
+static cGenomeUtil::substring_match referenceSubstringMatch(const InstructionSequence& base,
+                                                            const InstructionSequence& substring)
+{
+  const int rows = substring.GetSize() + 1;
+  const int cols = base.GetSize() + 1;
+  std::vector<cGenomeUtil::substring_match> m0(cols), m1(cols);
+  cGenomeUtil::substring_match* c = &m0[0];
+  cGenomeUtil::substring_match* p = &m1[0];
+
+  for (int j = 1; j < cols; ++j) p[j].begin = j;
+
+  for (int i = 1; i < rows; ++i) {
+    c[0].cost = i;
+    for (int j = 1; j < cols; ++j) {
+      cGenomeUtil::substring_match l[3] = {p[j - 1], p[j], c[j - 1]};
+      cGenomeUtil::substring_match* s = &l[0];
+      if (substring[i - 1] == base[j - 1]) {
+        c[j].cost = s->cost;
+      } else {
+        s = std::min_element(l, l + 3);
+        c[j].cost = s->cost + 1;
+      }
+      c[j].begin = s->begin;
+      c[j].end = j;
+    }
+    std::swap(c, p);
+  }
+
+  cGenomeUtil::substring_match match = *std::min_element(p, p + cols);
+  match.size = base.GetSize();
+  return match;
+}
+
+// The original circular matcher, which matches against a rotated copy of the genome extended by the pattern size
+static cGenomeUtil::substring_match referenceCircularMatch(cAvidaContext& ctx, const InstructionSequence& base,
+                                                           const InstructionSequence& substring)
+{
+  InstructionSequence circ(base);
+  const int rotate = ctx.GetRandom().GetInt(circ.GetSize());
+  circ.Rotate(rotate);
+  InstructionSequence head = circ.Crop(0, substring.GetSize());
+  circ.Append(head);
+
+  cGenomeUtil::substring_match location = referenceSubstringMatch(circ, substring);
+  location.resize(base.GetSize());
+  location.rotate(-rotate, base.GetSize());
+  return location;
+}
+
+
+static InstructionSequence randomSequence(Apto::Random& rng, int size, int alphabet)
+{
+  InstructionSequence seq(size);
+  for (int i = 0; i < size; i++) seq[i] = Instruction(rng.GetUInt(alphabet));
+  return seq;
+}
+
+// A fragment of base, lightly mutated, so that a close match exists somewhere in the text
+static InstructionSequence randomFragment(Apto::Random& rng, const InstructionSequence& base, int size, int alphabet)
+{
+  InstructionSequence frag(size);
+  const int start = rng.GetUInt(base.GetSize());
+  for (int i = 0; i < size; i++) frag[i] = base[(start + i) % base.GetSize()];
+  for (int i = 0; i < size / 10; i++) frag[rng.GetUInt(size)] = Instruction(rng.GetUInt(alphabet));
+  return frag;
+}
+
+static void expectSameMatch(const cGenomeUtil::substring_match& expected, const cGenomeUtil::substring_match& found)
+{
+  EXPECT_EQ(expected.begin, found.begin);
+  EXPECT_EQ(expected.end, found.end);
+  EXPECT_EQ(expected.cost, found.cost);
+  EXPECT_EQ(expected.size, found.size);
+}
+
+
+TEST(cGenomeUtil, SubstringMatchEmptyInputs)
+{
+  Apto::RNG::AvidaRNG rng(1);
+  const InstructionSequence empty;
+  expectSameMatch(referenceSubstringMatch(empty, empty), cGenomeUtil::FindSubstringMatch(empty, empty));
+  for (int i = 1; i < s_num_lengths; i++) {
+    const InstructionSequence seq = randomSequence(rng, s_lengths[i], 4);
+    expectSameMatch(referenceSubstringMatch(seq, empty), cGenomeUtil::FindSubstringMatch(seq, empty));
+    expectSameMatch(referenceSubstringMatch(empty, seq), cGenomeUtil::FindSubstringMatch(empty, seq));
+  }
+}
+
+TEST(cGenomeUtil, SubstringMatchesDynamicProgramming)
+{
+  Apto::RNG::AvidaRNG rng(1);
+
+  // Small alphabets produce many equal-cost matches, which exercises the tie breaking
+  const int alphabets[] = { 2, 4, 26 };
+  for (int a = 0; a < 3; a++) {
+    for (int i = 0; i < s_num_lengths; i++) {
+      for (int j = 0; j < s_num_lengths; j++) {
+        for (int trial = 0; trial < 4; trial++) {
+          const InstructionSequence base = randomSequence(rng, s_lengths[i] + s_lengths[j], alphabets[a]);
+          const InstructionSequence substring = (trial < 2 || base.GetSize() == 0 || s_lengths[j] == 0) ?
+            randomSequence(rng, s_lengths[j], alphabets[a]) : randomFragment(rng, base, s_lengths[j], alphabets[a]);
+
+          SCOPED_TRACE((const char*)(base.AsString() + " / " + substring.AsString()));
+          expectSameMatch(referenceSubstringMatch(base, substring), cGenomeUtil::FindSubstringMatch(base, substring));
+          if (HasFailure()) return;
+        }
+      }
+    }
+  }
+}
+
+TEST(cGenomeUtil, CircularMatchesDynamicProgramming)
+{
+  Apto::RNG::AvidaRNG rng(2);
+
+  // The circular matcher draws its rotation from the context, so both matchers get identically seeded generators
+  const int alphabets[] = { 2, 4, 26 };
+  for (int a = 0; a < 3; a++) {
+    for (int i = 1; i < s_num_lengths; i++) {
+      for (int j = 1; j < s_num_lengths && s_lengths[j] <= s_lengths[i]; j++) {
+        for (int trial = 0; trial < 4; trial++) {
+          const InstructionSequence base = randomSequence(rng, s_lengths[i], alphabets[a]);
+          const InstructionSequence substring = (trial < 2) ?
+            randomSequence(rng, s_lengths[j], alphabets[a]) : randomFragment(rng, base, s_lengths[j], alphabets[a]);
+
+          const int seed = rng.GetUInt(1000000) + 1;
+          Apto::RNG::AvidaRNG ref_rng(seed);
+          cAvidaContext ref_ctx(NULL, ref_rng);
+          Apto::RNG::AvidaRNG match_rng(seed);
+          cAvidaContext match_ctx(NULL, match_rng);
+
+          SCOPED_TRACE((const char*)(base.AsString() + " / " + substring.AsString()));
+          expectSameMatch(referenceCircularMatch(ref_ctx, base, substring),
+                          cGenomeUtil::FindUnbiasedCircularMatch(match_ctx, base, substring));
+          if (HasFailure()) return;
+        }
+      }
+    }
+  }
+}
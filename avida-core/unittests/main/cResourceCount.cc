@@ -0,0 +1,110 @@
+/*
+ *  unittests/main/cResourceCount.cc
+ *  avida-core
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cAvidaContext.h"
+#include "cResourceCount.h"
+
+#include "gtest/gtest.h"
+
+
+// A single global resource, named "", that flows in at one unit per update and never decays
+static void setupInflow(cResourceCount& res)
+{
+  res.SetDecay("", 1.0);
+  res.SetInflow("", 1.0);
+}
+
+
+TEST(cResourceCount, ClockDrivesInflow)
+{
+  Apto::RNG::AvidaRNG rng(1);
+  cAvidaContext ctx(NULL, rng);
+
+  cResourceClock clock;
+  clock.SetStepSize(1.0);
+
+  cResourceCount res(1);
+  setupInflow(res);
+  res.SetClock(&clock);
+
+  clock.Advance();
+  const double level1 = res.Get(ctx, 0);
+  clock.Advance();
+  const double level2 = res.Get(ctx, 0);
+
+  EXPECT_NEAR(1.0, level1, 1e-6);
+  EXPECT_NEAR(2.0, level2, 1e-6);
+}
+
+
+TEST(cResourceCount, AssignmentKeepsClock)
+{
+  Apto::RNG::AvidaRNG rng(1);
+  cAvidaContext ctx(NULL, rng);
+
+  cResourceClock clock;
+  clock.SetStepSize(1.0);
+
+  // Deme resources are attached to the clock, then replaced by a freshly configured count (cDeme::SetDemeResourceCount)
+  cResourceCount res(1);
+  res.SetClock(&clock);
+  clock.Advance();
+
+  cResourceCount tmp(1);
+  setupInflow(tmp);
+  res = tmp;
+
+  // Steps taken before the assignment belong to the old value, so the level only changes with the steps that follow
+  EXPECT_NEAR(0.0, res.Get(ctx, 0), 1e-6);
+
+  double last = res.Get(ctx, 0);
+  for (int update = 1; update <= 3; update++) {
+    clock.Advance();
+    const double level = res.Get(ctx, 0);
+    EXPECT_GT(level, last);
+    EXPECT_NEAR((double)update, level, 1e-6);
+    last = level;
+  }
+}
+
+
+TEST(cResourceCount, StepSizeChange)
+{
+  Apto::RNG::AvidaRNG rng(1);
+  cAvidaContext ctx(NULL, rng);
+
+  cResourceClock clock;
+  clock.SetStepSize(0.5);
+
+  cResourceCount res(1);
+  setupInflow(res);
+  res.SetClock(&clock);
+
+  clock.Advance();
+  clock.Advance();
+
+  // The clock owner syncs attached counts before changing the step size (cPopulation::AdvanceDemeClock)
+  res.SyncClock();
+  clock.SetStepSize(1.0);
+  clock.Advance();
+
+  EXPECT_NEAR(2.0, res.Get(ctx, 0), 1e-6);
+}
@@ -0,0 +1,134 @@
+/*
+ *  unittests/systematics/GenotypeTable.cc
+ *  avida-core
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "apto/rng.h"
+
+#include "avida/private/systematics/GenotypeTable.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace Avida::Systematics;
+
+
+// The table only needs non-null pointers to distinguish entries, so these tests store pointers into an array of ints
+typedef GenotypeTable<int*> tTable;
+typedef std::multimap<unsigned long long, int*> tReference;
+
+// Every key's entries, found through FirstSlot/NextSlot, must be exactly those of the reference
+static void checkTable(const tTable& table, const tReference& reference, unsigned long long max_key)
+{
+  ASSERT_EQ((int)reference.size(), table.GetSize());
+  ASSERT_LE(table.GetSize() * 2, table.GetCapacity());
+
+  for (unsigned long long key = 0; key <= max_key; key++) {
+    std::vector<int*> found;
+    for (int slot = table.FirstSlot(key); slot >= 0; slot = table.NextSlot(key, slot)) found.push_back(table.GetSlot(slot));
+
+    std::vector<int*> expected;
+    std::pair<tReference::const_iterator, tReference::const_iterator> range = reference.equal_range(key);
+    for (tReference::const_iterator it = range.first; it != range.second; ++it) expected.push_back(it->second);
+
+    std::sort(found.begin(), found.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_TRUE(found == expected) << "key " << key;
+  }
+}
+
+// Random inserts and removals over a range of keys small enough that keys repeat and probe runs overlap
+static void runRandomOperations(int seed, unsigned long long max_key, int steps)
+{
+  Apto::RNG::AvidaRNG rng(seed);
+  std::vector<int> values(steps);
+  tTable table;
+  tReference reference;
+
+  for (int step = 0; step < steps; step++) {
+    const int op = rng.GetUInt(10);
+    if (op < 6 || reference.empty()) {
+      const unsigned long long key = rng.GetUInt((unsigned int)max_key + 1);
+      table.Insert(key, &values[step]);
+      reference.insert(std::make_pair(key, &values[step]));
+    } else if (op < 9) {
+      tReference::iterator it = reference.begin();
+      std::advance(it, rng.GetUInt(reference.size()));
+      EXPECT_TRUE(table.Remove(it->first, it->second));
+      reference.erase(it);
+    } else {
+      // Entries that are not in the table, under both a present and an absent key, cannot be removed
+      const unsigned long long key = rng.GetUInt((unsigned int)max_key + 1);
+      EXPECT_FALSE(table.Remove(key, &values[step]));
+    }
+
+    if (step % 97 == 0) checkTable(table, reference, max_key);
+    if (::testing::Test::HasFailure()) return;
+  }
+  checkTable(table, reference, max_key);
+
+  // Drain the table completely
+  while (!reference.empty()) {
+    EXPECT_TRUE(table.Remove(reference.begin()->first, reference.begin()->second));
+    reference.erase(reference.begin());
+  }
+  checkTable(table, reference, max_key);
+}
+
+
+TEST(GenotypeTable, EmptyTable)
+{
+  tTable table;
+  EXPECT_EQ(0, table.GetSize());
+  EXPECT_EQ(-1, table.FirstSlot(0));
+  EXPECT_EQ(-1, table.FirstSlot(12345));
+  int value = 0;
+  EXPECT_FALSE(table.Remove(0, &value));
+}
+
+TEST(GenotypeTable, MatchesReferenceWithRepeatedKeys)
+{
+  // Genome hashes: few distinct keys, many entries per key
+  runRandomOperations(1, 40, 20000);
+}
+
+TEST(GenotypeTable, MatchesReferenceWithSparseKeys)
+{
+  // Genotype IDs: mostly unique keys, across several resizes
+  runRandomOperations(2, 100000, 20000);
+}
+
+TEST(GenotypeTable, SequentialIdsWithRemovals)
+{
+  // The ID index receives ascending IDs and loses old ones as historic genotypes are dropped
+  std::vector<int> values(5000);
+  tTable table;
+  tReference reference;
+  for (int id = 1; id < 5000; id++) {
+    table.Insert(id, &values[id]);
+    reference.insert(std::make_pair((unsigned long long)id, &values[id]));
+    if (id % 3 == 0) {
+      EXPECT_TRUE(table.Remove(id / 2, &values[id / 2]) == (reference.erase(id / 2) > 0));
+    }
+  }
+  checkTable(table, reference, 5000);
+}
@@ -0,0 +1,207 @@
+/*
+ *  unittests/tools/cColumnFile.cc
+ *  avida-core
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cColumnFile.h"
+#include "cInitFile.h"
+#include "cString.h"
+#include "cStringList.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+
+// The population loaders used to read every row through cInitFile::GetLineAsDict.  These tests read the same files
+// with both readers and check that every column converts to the same values, whether requested by name or by position.
+
+static FILE* createTempFile(cString& path)
+{
+  char name[] = "/tmp/avida_cColumnFile_XXXXXX";
+  const int fd = mkstemp(name);
+  path = (fd < 0) ? "" : name;
+  return (fd < 0) ? NULL : fdopen(fd, "w");
+}
+
+static cString writeTempFile(const cString& contents)
+{
+  cString path;
+  FILE* fp = createTempFile(path);
+  if (!fp) return "";
+  fwrite((const char*)contents, 1, contents.GetSize(), fp);
+  fclose(fp);
+  return path;
+}
+
+// Request a column under every type, returning -1 for names the format lacks, as LoadPopulation does
+struct sColumnHandles
+{
+  int text, i, d, ilist, dlist;
+
+  sColumnHandles(cColumnFile& file, const cString& name)
+    : text(file.RequestColumn(name, cColumnFile::TEXT_COLUMN))
+    , i(file.RequestColumn(name, cColumnFile::INT_COLUMN))
+    , d(file.RequestColumn(name, cColumnFile::DOUBLE_COLUMN))
+    , ilist(file.RequestColumn(name, cColumnFile::INT_LIST_COLUMN))
+    , dlist(file.RequestColumn(name, cColumnFile::DOUBLE_LIST_COLUMN)) { ; }
+};
+
+static void expectRowMatches(const cColumnFile& file, int row, const sColumnHandles& cols, const cString& name,
+                             Apto::Map<Apto::String, Apto::String>& dict, int line)
+{
+  const bool has = dict.Has((const char*)name);
+  const bool col_has = (cols.text >= 0 && file.HasValue(row, cols.text));
+  ASSERT_EQ(has, col_has) << "column '" << name << "' on line " << line;
+  if (!has) return;
+
+  const cString value(dict.Get((const char*)name));
+  EXPECT_STREQ((const char*)value, file.GetText(row, cols.text)) << "line " << line;
+  EXPECT_EQ(value.AsInt(), file.GetInt(row, cols.i)) << "line " << line;
+  EXPECT_EQ(value.AsDouble(), file.GetDouble(row, cols.d)) << "line " << line;
+
+  Apto::Array<int> old_ints, new_ints;
+  Apto::Array<double> old_doubles, new_doubles;
+  cString liststr(value);
+  while (liststr.GetSize()) old_ints.Push(liststr.Pop(',').AsInt());
+  liststr = value;
+  while (liststr.GetSize()) old_doubles.Push(liststr.Pop(',').AsDouble());
+  file.GetList(row, cols.ilist, new_ints);
+  file.GetList(row, cols.dlist, new_doubles);
+
+  ASSERT_EQ(old_ints.GetSize(), new_ints.GetSize()) << "line " << line;
+  for (int i = 0; i < old_ints.GetSize(); i++) EXPECT_EQ(old_ints[i], new_ints[i]) << "line " << line;
+  ASSERT_EQ(old_doubles.GetSize(), new_doubles.GetSize()) << "line " << line;
+  for (int i = 0; i < old_doubles.GetSize(); i++) EXPECT_EQ(old_doubles[i], new_doubles[i]) << "line " << line;
+}
+
+// Compare both readers on the given file, for the named columns plus any the loader may look for.  The file is removed.
+static void expectSameParse(const cString& path, const cStringList& extra_names, int num_threads)
+{
+  ASSERT_TRUE(path.GetSize() > 0);
+
+  cInitFile old_file(path, "/");
+  cColumnFile new_file(path, "/", num_threads);
+  ASSERT_TRUE(old_file.WasOpened());
+  ASSERT_TRUE(new_file.WasOpened());
+  EXPECT_STREQ((const char*)old_file.GetFiletype(), (const char*)new_file.GetFiletype());
+
+  cStringList names(old_file.GetFormat());
+  for (int i = 0; i < extra_names.GetSize(); i++) names.PushRear(extra_names.GetLine(i));
+
+  Apto::Array<sColumnHandles*> cols;
+  Apto::Array<int> position_cols;
+  for (int i = 0; i < names.GetSize(); i++) cols.Push(new sColumnHandles(new_file, names.GetLine(i)));
+  for (int i = 0; i < old_file.GetFormat().GetSize(); i++) {
+    position_cols.Push(new_file.RequestColumn(i, cColumnFile::TEXT_COLUMN));
+  }
+
+  int line = 0;
+  while (new_file.ReadBlock()) {
+    for (int row = 0; row < new_file.GetNumRows(); row++, line++) {
+      ASSERT_LT(line, old_file.GetNumLines());
+      Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > dict = old_file.GetLineAsDict(line);
+      for (int i = 0; i < names.GetSize(); i++) expectRowMatches(new_file, row, *cols[i], names.GetLine(i), *dict, line);
+
+      cString cur_line = old_file.GetLine(line);
+      for (int i = 0; i < position_cols.GetSize(); i++) {
+        const cString word = cur_line.PopWord();
+        EXPECT_EQ(word.GetSize() > 0, new_file.HasValue(row, position_cols[i])) << "line " << line;
+        EXPECT_STREQ((const char*)word, new_file.GetText(row, position_cols[i])) << "line " << line;
+      }
+    }
+  }
+  EXPECT_FALSE(new_file.HadError());
+  EXPECT_EQ(old_file.GetNumLines(), line);
+
+  for (int i = 0; i < cols.GetSize(); i++) delete cols[i];
+  unlink(path);
+}
+
+
+TEST(cColumnFile, MatchesInitFile)
+{
+  cString contents;
+  contents += "#filetype genotype_data\n";
+  contents += "#format id src_args inst_set hw_type sequence num_units merit gest_time cells gest_offset lineage\n";
+  contents += "# Comment lines and blank lines are skipped\n";
+  contents += "\n";
+  contents += "1 div:int (none) 0 abc 2 12.5 389 0,1 5,-3 0,0\n";
+  contents += "7   div:mut   (none)  0  bcd  1  1e-3  .25  99  0  2   # trailing comment\n";
+  contents += "12 div:ext (none) 0 cde 3 -4 0 3,4,5 ,1,,2 1,2,\n";
+
+  cStringList extra;
+  extra.PushRear("num_cpus");
+  extra.PushRear("birth_cell");
+  expectSameParse(writeTempFile(contents), extra, 1);
+}
+
+
+TEST(cColumnFile, MissingColumns)
+{
+  // Rows may stop short of the format, and the format may lack columns the loader asks for
+  cString contents;
+  contents += "#filetype genotype_data\n";
+  contents += "#format id num_cpus sequence cells lineage group_id\n";
+  contents += "1 3 abc 0,1,2 0,0,0 4,4,4\n";
+  contents += "2 1 bcd 3\n";
+  contents += "3 2\n";
+  contents += "4\n";
+
+  cStringList extra;
+  extra.PushRear("num_units");
+  extra.PushRear("merit");
+  extra.PushRear("gest_offset");
+  extra.PushRear("parent_merit");
+  expectSameParse(writeTempFile(contents), extra, 1);
+}
+
+
+TEST(cColumnFile, RepeatedColumnName)
+{
+  // The last column of a repeated name wins in both readers
+  cString contents;
+  contents += "#format id merit merit\n";
+  contents += "1 2.5 3.5\n";
+  contents += "2 4.5\n";
+
+  expectSameParse(writeTempFile(contents), cStringList(), 1);
+}
+
+
+TEST(cColumnFile, MatchesInitFileAcrossBlocksAndThreads)
+{
+  // Enough rows to span several blocks, each split among worker threads
+  cString path;
+  FILE* fp = createTempFile(path);
+  ASSERT_TRUE(fp != NULL);
+  fprintf(fp, "#filetype genotype_data\n#format id num_units merit sequence cells parent_merit\n");
+  const int num_rows = (cColumnFile::BLOCK_SIZE / 48) * 2 + 17;
+  for (int i = 0; i < num_rows; i++) {
+    if (i % 5 == 3) fprintf(fp, "%d %d\n", i, i % 7);
+    else fprintf(fp, "%d %d %g seq%d %d,%d %g,%g\n", i, i % 7, i * 0.125, i, i, -i, i / 3.0, -i / 7.0);
+  }
+  fclose(fp);
+
+  cStringList extra;
+  extra.PushRear("lineage");
+  expectSameParse(path, extra, 4);
+}